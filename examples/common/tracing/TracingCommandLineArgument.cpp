@@ -20,6 +20,7 @@
 #include <lib/support/StringSplitter.h>
 #include <lib/support/logging/CHIPLogging.h>
 #include <tracing/json/json_tracing.h>
+#include <tracing/metrics/metrics_tracing.h>
 #include <tracing/registry.h>
 
 #if ENABLE_PERFETTO_TRACING
@@ -47,6 +48,9 @@ bool StartsWith(CharSpan argument, const char * prefix)
     return argument.data_equal(CharSpan(prefix, prefix_len));
 }
 
+// How often metrics snapshots are written when enabled from the command line
+constexpr System::Clock::Seconds32 kMetricsOutputInterval(10);
+
 } // namespace
 
 void TracingSetup::EnableTracingFor(const char * cliArg)
@@ -74,6 +78,26 @@ void TracingSetup::EnableTracingFor(const char * cliArg)
             }
             chip::Tracing::Register(mJsonBackend);
         }
+        else if (StartsWith(value, "metrics:") || StartsWith(value, "metrics-json:"))
+        {
+            using chip::Tracing::Metrics::MetricsBackend;
+
+            MetricsBackend::OutputFormat format = MetricsBackend::OutputFormat::kPrometheus;
+            size_t prefixLength                 = 8;
+            if (StartsWith(value, "metrics-json:"))
+            {
+                format       = MetricsBackend::OutputFormat::kJson;
+                prefixLength = 13;
+            }
+            std::string fileName(value.data() + prefixLength, value.size() - prefixLength);
+
+            CHIP_ERROR err = mMetricsBackend.StartPeriodicOutput(fileName.c_str(), format, kMetricsOutputInterval);
+            if (err != CHIP_NO_ERROR)
+            {
+                ChipLogError(AppServer, "Failed to start metrics output: %" CHIP_ERROR_FORMAT, err.Format());
+            }
+            chip::Tracing::Register(mMetricsBackend);
+        }
 #if ENABLE_PERFETTO_TRACING
         else if (value.data_equal(CharSpan::fromCharString("perfetto")))
         {
@@ -112,6 +136,7 @@ void TracingSetup::StopTracing()
 
 #endif
 
+    chip::Tracing::Unregister(mMetricsBackend);
     chip::Tracing::Unregister(mJsonBackend);
 }
 
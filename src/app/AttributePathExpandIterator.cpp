@@ -21,6 +21,7 @@
 #include <app/AttributePathParams.h>
 #include <app/ConcreteAttributePath.h>
 #include <app/EventManagement.h>
+#include <app/FlattenedAttributeTree.h>
 #include <app/GlobalAttributes.h>
 #include <app/att-storage.h>
 #include <lib/core/CHIPCore.h>
@@ -29,6 +30,8 @@
 #include <lib/support/DLLUtil.h>
 #include <lib/support/logging/CHIPLogging.h>
 
+#include <algorithm>
+
 using namespace chip;
 
 // TODO: Need to make it so that declarations of things that don't depend on generated files are not intermixed in af.h with
@@ -48,6 +51,7 @@ extern Optional<AttributeId> emberAfGetServerAttributeIdByIndex(chip::EndpointId
                                                                 uint16_t attributeIndex);
 extern uint8_t emberAfClusterIndex(EndpointId endpoint, ClusterId clusterId, EmberAfClusterMask mask);
 extern bool emberAfEndpointIndexIsEnabled(uint16_t index);
+extern uint32_t emberAfMetadataStructureGeneration();
 
 namespace chip {
 namespace app {
@@ -67,16 +71,19 @@ AttributePathExpandIterator::AttributePathExpandIterator(ObjectList<AttributePat
                   "If this changes audit all uses where we set to UINT8_MAX");
     mGlobalAttributeIndex = UINT8_MAX;
 
+    mStructureGeneration = emberAfMetadataStructureGeneration();
+
     // Make the iterator ready to emit the first valid path in the list.
     Next();
 }
 
-void AttributePathExpandIterator::PrepareEndpointIndexRange(const AttributePathParams & aAttributePath)
+void AttributePathExpandIterator::PrepareEndpointIndexRange(const AttributePathParams & aAttributePath,
+                                                            const FlattenedAttributeTree * aTree)
 {
     if (aAttributePath.HasWildcardEndpointId())
     {
         mEndpointIndex    = 0;
-        mEndEndpointIndex = emberAfEndpointCount();
+        mEndEndpointIndex = aTree != nullptr ? aTree->EndpointCount() : emberAfEndpointCount();
     }
     else
     {
@@ -87,12 +94,14 @@ void AttributePathExpandIterator::PrepareEndpointIndexRange(const AttributePathP
     }
 }
 
-void AttributePathExpandIterator::PrepareClusterIndexRange(const AttributePathParams & aAttributePath, EndpointId aEndpointId)
+void AttributePathExpandIterator::PrepareClusterIndexRange(const AttributePathParams & aAttributePath, EndpointId aEndpointId,
+                                                           const FlattenedAttributeTree * aTree)
 {
     if (aAttributePath.HasWildcardClusterId())
     {
         mClusterIndex    = 0;
-        mEndClusterIndex = emberAfClusterCount(aEndpointId, true /* server */);
+        mEndClusterIndex =
+            aTree != nullptr ? aTree->ClusterCount(mEndpointIndex) : emberAfClusterCount(aEndpointId, true /* server */);
     }
     else
     {
@@ -104,12 +113,13 @@ void AttributePathExpandIterator::PrepareClusterIndexRange(const AttributePathPa
 }
 
 void AttributePathExpandIterator::PrepareAttributeIndexRange(const AttributePathParams & aAttributePath, EndpointId aEndpointId,
-                                                             ClusterId aClusterId)
+                                                             ClusterId aClusterId, const FlattenedAttributeTree * aTree)
 {
     if (aAttributePath.HasWildcardAttributeId())
     {
-        mAttributeIndex          = 0;
-        mEndAttributeIndex       = emberAfGetServerAttributeCount(aEndpointId, aClusterId);
+        mAttributeIndex    = 0;
+        mEndAttributeIndex = aTree != nullptr ? aTree->AttributeCount(mEndpointIndex, mClusterIndex)
+                                              : emberAfGetServerAttributeCount(aEndpointId, aClusterId);
         mGlobalAttributeIndex    = 0;
         mGlobalAttributeEndIndex = ArraySize(GlobalAttributesNotInMetadata);
     }
@@ -144,6 +154,34 @@ void AttributePathExpandIterator::PrepareAttributeIndexRange(const AttributePath
     }
 }
 
+void AttributePathExpandIterator::RevalidateIndexRanges(const FlattenedAttributeTree * aTree)
+{
+    // Nothing to revalidate if the ranges of the current path have not been prepared yet.
+    VerifyOrReturn(mpAttributePath != nullptr && mEndpointIndex != UINT16_MAX);
+
+    const uint16_t endpointCount = aTree != nullptr ? aTree->EndpointCount() : emberAfEndpointCount();
+    mEndEndpointIndex            = std::min(mEndEndpointIndex, endpointCount);
+    VerifyOrReturn(mEndpointIndex < mEndEndpointIndex && mClusterIndex != UINT8_MAX);
+
+    // Stop expanding the clusters of an endpoint that has been disabled.
+    const bool endpointEnabled =
+        aTree != nullptr ? aTree->EndpointIsEnabled(mEndpointIndex) : emberAfEndpointIndexIsEnabled(mEndpointIndex);
+    const EndpointId endpointId = aTree != nullptr ? aTree->EndpointIdAt(mEndpointIndex) : emberAfEndpointFromIndex(mEndpointIndex);
+    uint8_t clusterCount        = 0;
+    if (endpointEnabled)
+    {
+        clusterCount = aTree != nullptr ? aTree->ClusterCount(mEndpointIndex) : emberAfClusterCount(endpointId, true /* server */);
+    }
+    mEndClusterIndex = std::min(mEndClusterIndex, clusterCount);
+    VerifyOrReturn(mClusterIndex < mEndClusterIndex && mAttributeIndex != UINT16_MAX);
+
+    const ClusterId clusterId = aTree != nullptr ? aTree->ClusterIdAt(mEndpointIndex, mClusterIndex)
+                                                 : emberAfGetNthClusterId(endpointId, mClusterIndex, true /* server */).Value();
+    const uint16_t attributeCount = aTree != nullptr ? aTree->AttributeCount(mEndpointIndex, mClusterIndex)
+                                                     : emberAfGetServerAttributeCount(endpointId, clusterId);
+    mEndAttributeIndex = std::min(mEndAttributeIndex, attributeCount);
+}
+
 void AttributePathExpandIterator::ResetCurrentCluster()
 {
     // If this is a null iterator, or the attribute id of current cluster info is not a wildcard attribute id, then this function
@@ -167,6 +205,17 @@ void AttributePathExpandIterator::ResetCurrentCluster()
 
 bool AttributePathExpandIterator::Next()
 {
+    // When available, the wildcard expansion reads ids from the flattened attribute tree instead of looking up the endpoint,
+    // cluster and attribute metadata for every emitted path.  Both are addressed by the same indices.
+    const FlattenedAttributeTree * tree = FlattenedAttributeTree::Current();
+
+    const uint32_t structureGeneration = emberAfMetadataStructureGeneration();
+    if (structureGeneration != mStructureGeneration)
+    {
+        RevalidateIndexRanges(tree);
+        mStructureGeneration = structureGeneration;
+    }
+
     for (; mpAttributePath != nullptr; (mpAttributePath = mpAttributePath->mpNext, mEndpointIndex = UINT16_MAX))
     {
         mOutputPath.mExpanded = mpAttributePath->mValue.IsWildcardPath();
@@ -185,24 +234,24 @@ bool AttributePathExpandIterator::Next()
                 return true;
             }
 
-            PrepareEndpointIndexRange(mpAttributePath->mValue);
+            PrepareEndpointIndexRange(mpAttributePath->mValue, tree);
             mClusterIndex = UINT8_MAX;
         }
 
         for (; mEndpointIndex < mEndEndpointIndex;
              (mEndpointIndex++, mClusterIndex = UINT8_MAX, mAttributeIndex = UINT16_MAX, mGlobalAttributeIndex = UINT8_MAX))
         {
-            if (!emberAfEndpointIndexIsEnabled(mEndpointIndex))
+            if (!(tree != nullptr ? tree->EndpointIsEnabled(mEndpointIndex) : emberAfEndpointIndexIsEnabled(mEndpointIndex)))
             {
                 // Not an enabled endpoint; skip it.
                 continue;
             }
 
-            EndpointId endpointId = emberAfEndpointFromIndex(mEndpointIndex);
+            EndpointId endpointId = tree != nullptr ? tree->EndpointIdAt(mEndpointIndex) : emberAfEndpointFromIndex(mEndpointIndex);
 
             if (mClusterIndex == UINT8_MAX)
             {
-                PrepareClusterIndexRange(mpAttributePath->mValue, endpointId);
+                PrepareClusterIndexRange(mpAttributePath->mValue, endpointId, tree);
                 mAttributeIndex       = UINT16_MAX;
                 mGlobalAttributeIndex = UINT8_MAX;
             }
@@ -212,17 +261,21 @@ bool AttributePathExpandIterator::Next()
             {
                 // emberAfGetNthClusterId must return a valid cluster id here since we have verified the mClusterIndex does
                 // not exceed the mEndClusterIndex.
-                ClusterId clusterId = emberAfGetNthClusterId(endpointId, mClusterIndex, true /* server */).Value();
+                ClusterId clusterId = tree != nullptr
+                    ? tree->ClusterIdAt(mEndpointIndex, mClusterIndex)
+                    : emberAfGetNthClusterId(endpointId, mClusterIndex, true /* server */).Value();
                 if (mAttributeIndex == UINT16_MAX && mGlobalAttributeIndex == UINT8_MAX)
                 {
-                    PrepareAttributeIndexRange(mpAttributePath->mValue, endpointId, clusterId);
+                    PrepareAttributeIndexRange(mpAttributePath->mValue, endpointId, clusterId, tree);
                 }
 
                 if (mAttributeIndex < mEndAttributeIndex)
                 {
                     // GetServerAttributeIdByIdex must return a valid attribute here since we have verified the mAttributeIndex does
                     // not exceed the mEndAttributeIndex.
-                    mOutputPath.mAttributeId = emberAfGetServerAttributeIdByIndex(endpointId, clusterId, mAttributeIndex).Value();
+                    mOutputPath.mAttributeId = tree != nullptr
+                        ? tree->AttributeIdAt(mEndpointIndex, mClusterIndex, mAttributeIndex)
+                        : emberAfGetServerAttributeIdByIndex(endpointId, clusterId, mAttributeIndex).Value();
                     mOutputPath.mClusterId   = clusterId;
                     mOutputPath.mEndpointId  = endpointId;
                     mAttributeIndex++;
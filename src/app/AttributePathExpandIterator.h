@@ -27,6 +27,7 @@
 #include <app/AttributePathParams.h>
 #include <app/ConcreteAttributePath.h>
 #include <app/EventManagement.h>
+#include <app/FlattenedAttributeTree.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/core/TLVDebug.h>
 #include <lib/support/CodeUtils.h>
@@ -118,6 +119,9 @@ private:
     // metadata.
     uint8_t mGlobalAttributeIndex, mGlobalAttributeEndIndex;
 
+    // emberAfMetadataStructureGeneration() when the index ranges above were last validated.
+    uint32_t mStructureGeneration;
+
     /**
      * Prepare*IndexRange will update mBegin*Index and mEnd*Index variables.
      * If AttributePathParams contains a wildcard field, it will set mBegin*Index to 0 and mEnd*Index to count.
@@ -125,11 +129,22 @@ private:
      *
      * If the Endpoint/Cluster/Attribute does not exist, mBegin*Index will be UINT*_MAX, and mEnd*Inde will be 0.
      *
-     * The index can be used with emberAfEndpointFromIndex, emberAfGetNthClusterId and emberAfGetServerAttributeIdByIndex.
+     * The index can be used with emberAfEndpointFromIndex, emberAfGetNthClusterId and emberAfGetServerAttributeIdByIndex, or
+     * with the matching accessors of aTree.  When aTree is not null, the wildcard ranges are taken from it.
+     */
+    void PrepareEndpointIndexRange(const AttributePathParams & aAttributePath, const FlattenedAttributeTree * aTree);
+    void PrepareClusterIndexRange(const AttributePathParams & aAttributePath, EndpointId aEndpointId,
+                                  const FlattenedAttributeTree * aTree);
+    void PrepareAttributeIndexRange(const AttributePathParams & aAttributePath, EndpointId aEndpointId, ClusterId aClusterId,
+                                    const FlattenedAttributeTree * aTree);
+
+    /**
+     * Clamp the end of the index ranges being iterated to the current endpoint, cluster and attribute counts.
+     *
+     * The ranges are cached across report chunks, so they must be revalidated when endpoints were added, removed, enabled or
+     * disabled in between: the indices are only meaningful for the structure they were computed from.
      */
-    void PrepareEndpointIndexRange(const AttributePathParams & aAttributePath);
-    void PrepareClusterIndexRange(const AttributePathParams & aAttributePath, EndpointId aEndpointId);
-    void PrepareAttributeIndexRange(const AttributePathParams & aAttributePath, EndpointId aEndpointId, ClusterId aClusterId);
+    void RevalidateIndexRanges(const FlattenedAttributeTree * aTree);
 };
 } // namespace app
 } // namespace chip
@@ -19,11 +19,26 @@
 #include "system/SystemPacketBuffer.h"
 #include <app/ClusterStateCache.h>
 #include <app/InteractionModelEngine.h>
+#include <lib/support/SafeInt.h>
 #include <tuple>
 
 namespace chip {
 namespace app {
 
+constexpr uint16_t ClusterStateCache::kSnapshotFormatVersion;
+constexpr TLV::Tag ClusterStateCache::kFormatVersionTag;
+constexpr TLV::Tag ClusterStateCache::kHighestEventNumberTag;
+constexpr TLV::Tag ClusterStateCache::kClustersTag;
+constexpr TLV::Tag ClusterStateCache::kEndpointIdTag;
+constexpr TLV::Tag ClusterStateCache::kClusterIdTag;
+constexpr TLV::Tag ClusterStateCache::kDataVersionTag;
+constexpr TLV::Tag ClusterStateCache::kAttributesTag;
+constexpr TLV::Tag ClusterStateCache::kAttributeIdTag;
+constexpr TLV::Tag ClusterStateCache::kAttributeDataTag;
+constexpr TLV::Tag ClusterStateCache::kAttributeStatusTag;
+constexpr TLV::Tag ClusterStateCache::kAttributeClusterStatusTag;
+constexpr TLV::Tag ClusterStateCache::kAttributeDataSizeTag;
+
 namespace {
 
 // Determine how much space a StatusIB takes up on the wire.
@@ -51,26 +66,120 @@ size_t SizeOfStatusIB(const StatusIB & aStatus)
 
 CHIP_ERROR ClusterStateCache::GetElementTLVSize(TLV::TLVReader * apData, size_t & aSize)
 {
+    // Copy into a buffer sized from the element itself rather than from the rest of the report or snapshot.
+    size_t maxSize = 0;
+    ReturnErrorOnFailure(CompactClusterStateStorage::GetMaxElementSize(*apData, maxSize));
+
     Platform::ScopedMemoryBufferWithSize<uint8_t> backingBuffer;
     TLV::TLVReader reader;
     reader.Init(*apData);
-    size_t totalBufSize = reader.GetTotalLength();
-    backingBuffer.Calloc(totalBufSize);
+    backingBuffer.Calloc(maxSize);
     VerifyOrReturnError(backingBuffer.Get() != nullptr, CHIP_ERROR_NO_MEMORY);
-    TLV::ScopedBufferTLVWriter writer(std::move(backingBuffer), totalBufSize);
+    TLV::ScopedBufferTLVWriter writer(std::move(backingBuffer), maxSize);
     ReturnErrorOnFailure(writer.CopyElement(TLV::AnonymousTag(), reader));
     aSize = writer.GetLengthWritten();
     ReturnErrorOnFailure(writer.Finalize(backingBuffer));
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR ClusterStateCache::StoreAttribute(const ConcreteAttributePath & aPath, TLV::TLVReader * apData,
+                                             const StatusIB & aStatus)
+{
+    AttributeState state;
+    const size_t previousSize = GetCachedAttributeSize(aPath);
+
+    if (apData)
+    {
+        if (mCacheData && mStorageMode == StorageMode::kCompact)
+        {
+            // The compact storage copies the element straight into its arena, without sizing it first.
+            ReturnErrorOnFailure(mCompactStorage.SetData(aPath, *apData));
+        }
+        else
+        {
+            size_t elementSize = 0;
+            ReturnErrorOnFailure(GetElementTLVSize(apData, elementSize));
+
+            if (mCacheData)
+            {
+                Platform::ScopedMemoryBufferWithSize<uint8_t> backingBuffer;
+                backingBuffer.Calloc(elementSize);
+                VerifyOrReturnError(backingBuffer.Get() != nullptr, CHIP_ERROR_NO_MEMORY);
+                TLV::ScopedBufferTLVWriter writer(std::move(backingBuffer), elementSize);
+                ReturnErrorOnFailure(writer.CopyElement(TLV::AnonymousTag(), *apData));
+                ReturnErrorOnFailure(writer.Finalize(backingBuffer));
+
+                state.Set<AttributeData>(std::move(backingBuffer));
+            }
+            else
+            {
+                state.Set<size_t>(elementSize);
+            }
+        }
+    }
+    else
+    {
+        if (mCacheData)
+        {
+            state.Set<StatusIB>(aStatus);
+        }
+        else
+        {
+            state.Set<size_t>(SizeOfStatusIB(aStatus));
+        }
+    }
+
+    if (mStorageMode == StorageMode::kTree)
+    {
+        mCache[aPath.mEndpointId][aPath.mClusterId].mAttributes[aPath.mAttributeId] = std::move(state);
+    }
+    else if (state.Is<StatusIB>())
+    {
+        mCompactStorage.SetStatus(aPath, state.Get<StatusIB>());
+    }
+    else if (state.Is<size_t>())
+    {
+        mCompactStorage.SetDataSize(aPath, state.Get<size_t>());
+    }
+
+    NoteAttributeSizeChange(aPath, previousSize);
+    return CHIP_NO_ERROR;
+}
+
+void ClusterStateCache::StoreAttributeDataSize(const ConcreteAttributePath & aPath, size_t aSize)
+{
+    const size_t previousSize = GetCachedAttributeSize(aPath);
+
+    if (mStorageMode == StorageMode::kTree)
+    {
+        mCache[aPath.mEndpointId][aPath.mClusterId].mAttributes[aPath.mAttributeId].Set<size_t>(aSize);
+    }
+    else
+    {
+        mCompactStorage.SetDataSize(aPath, aSize);
+    }
+
+    NoteAttributeSizeChange(aPath, previousSize);
+}
+
+void ClusterStateCache::NoteAttributeSizeChange(const ConcreteAttributePath & aPath, size_t aPreviousSize)
+{
+    const size_t size = GetCachedAttributeSize(aPath);
+    if (size != aPreviousSize)
+    {
+        const ClusterKey cluster(aPath.mEndpointId, aPath.mClusterId);
+        FilterPriority priority = mFilterPriorities[cluster];
+        priority.mDataSize      = priority.mDataSize - aPreviousSize + size;
+        SetFilterPriority(cluster, priority);
+    }
+}
+
 CHIP_ERROR ClusterStateCache::UpdateCache(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData,
                                           const StatusIB & aStatus)
 {
-    AttributeState state;
     bool endpointIsNew = false;
 
-    if (mCache.find(aPath.mEndpointId) == mCache.end())
+    if (!HasEndpoint(aPath.mEndpointId))
     {
         //
         // Since we might potentially be creating a new entry at mCache[aPath.mEndpointId][aPath.mClusterId] that
@@ -80,31 +189,15 @@ CHIP_ERROR ClusterStateCache::UpdateCache(const ConcreteDataAttributePath & aPat
         endpointIsNew = true;
     }
 
+    ReturnErrorOnFailure(StoreAttribute(aPath, apData, aStatus));
+
     if (apData)
     {
-        size_t elementSize = 0;
-        ReturnErrorOnFailure(GetElementTLVSize(apData, elementSize));
-
-        if (mCacheData)
-        {
-            Platform::ScopedMemoryBufferWithSize<uint8_t> backingBuffer;
-            backingBuffer.Calloc(elementSize);
-            VerifyOrReturnError(backingBuffer.Get() != nullptr, CHIP_ERROR_NO_MEMORY);
-            TLV::ScopedBufferTLVWriter writer(std::move(backingBuffer), elementSize);
-            ReturnErrorOnFailure(writer.CopyElement(TLV::AnonymousTag(), *apData));
-            ReturnErrorOnFailure(writer.Finalize(backingBuffer));
-
-            state.Set<AttributeData>(std::move(backingBuffer));
-        }
-        else
-        {
-            state.Set<size_t>(elementSize);
-        }
         //
         // Clear out the committed data version and only set it again once we have received all data for this cluster.
         // Otherwise, we may have incomplete data that looks like it's complete since it has a valid data version.
         //
-        mCache[aPath.mEndpointId][aPath.mClusterId].mCommittedDataVersion.ClearValue();
+        GetOrCreateClusterVersions(aPath).mCommittedDataVersion.ClearValue();
 
         // This commits a pending data version if the last report path is valid and it is different from the current path.
         if (mLastReportDataPath.IsValidConcreteClusterPath() && mLastReportDataPath != aPath)
@@ -125,22 +218,11 @@ CHIP_ERROR ClusterStateCache::UpdateCache(const ConcreteDataAttributePath & aPat
         // if this data item is encompassed by a wildcard path, let's go ahead and update its pending data version.
         if (foundEncompassingWildcardPath)
         {
-            mCache[aPath.mEndpointId][aPath.mClusterId].mPendingDataVersion = aPath.mDataVersion;
+            GetOrCreateClusterVersions(aPath).mPendingDataVersion = aPath.mDataVersion;
         }
 
         mLastReportDataPath = aPath;
     }
-    else
-    {
-        if (mCacheData)
-        {
-            state.Set<StatusIB>(aStatus);
-        }
-        else
-        {
-            state.Set<size_t>(SizeOfStatusIB(aStatus));
-        }
-    }
 
     //
     // if the endpoint didn't exist previously, let's track the insertion
@@ -151,13 +233,21 @@ CHIP_ERROR ClusterStateCache::UpdateCache(const ConcreteDataAttributePath & aPat
         mAddedEndpoints.push_back(aPath.mEndpointId);
     }
 
-    mCache[aPath.mEndpointId][aPath.mClusterId].mAttributes[aPath.mAttributeId] = std::move(state);
-
     if (mCacheData)
     {
         mChangedAttributeSet.insert(aPath);
     }
 
+    if (!mFiltersAwaitingReport.empty())
+    {
+        auto filter = mFiltersAwaitingReport.find(ClusterKey(aPath.mEndpointId, aPath.mClusterId));
+        if (filter != mFiltersAwaitingReport.end())
+        {
+            mFilterStats.mClustersMismatched++;
+            mFiltersAwaitingReport.erase(filter);
+        }
+    }
+
     return CHIP_NO_ERROR;
 }
 
@@ -223,7 +313,7 @@ void ClusterStateCache::CommitPendingDataVersion()
         return;
     }
 
-    auto & lastClusterInfo = mCache[mLastReportDataPath.mEndpointId][mLastReportDataPath.mClusterId];
+    auto & lastClusterInfo = GetOrCreateClusterVersions(mLastReportDataPath);
     if (lastClusterInfo.mPendingDataVersion.HasValue())
     {
         lastClusterInfo.mCommittedDataVersion = lastClusterInfo.mPendingDataVersion;
@@ -262,6 +352,20 @@ void ClusterStateCache::OnReportEnd()
 
 CHIP_ERROR ClusterStateCache::Get(const ConcreteAttributePath & path, TLV::TLVReader & reader) const
 {
+    if (mStorageMode == StorageMode::kCompact)
+    {
+        const auto * entry = mCompactStorage.FindAttribute(path);
+        VerifyOrReturnError(entry != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+        if (entry->mKind == CompactClusterStateStorage::AttributeKind::kStatus)
+        {
+            return CHIP_ERROR_IM_STATUS_CODE_RECEIVED;
+        }
+        VerifyOrReturnError(entry->mKind == CompactClusterStateStorage::AttributeKind::kData, CHIP_ERROR_KEY_NOT_FOUND);
+
+        reader.Init(mCompactStorage.GetData(*entry));
+        return reader.Next();
+    }
+
     CHIP_ERROR err;
     auto attributeState = GetAttributeState(path.mEndpointId, path.mClusterId, path.mAttributeId, err);
     ReturnErrorOnFailure(err);
@@ -295,6 +399,34 @@ CHIP_ERROR ClusterStateCache::Get(EventNumber eventNumber, TLV::TLVReader & read
     return CHIP_NO_ERROR;
 }
 
+bool ClusterStateCache::HasEndpoint(EndpointId endpointId) const
+{
+    if (mStorageMode == StorageMode::kCompact)
+    {
+        return mCompactStorage.HasEndpoint(endpointId);
+    }
+    return mCache.find(endpointId) != mCache.end();
+}
+
+ClusterStateCache::ClusterVersions & ClusterStateCache::GetOrCreateClusterVersions(const ConcreteClusterPath & path)
+{
+    if (mStorageMode == StorageMode::kCompact)
+    {
+        return mCompactStorage.GetOrCreateCluster(path);
+    }
+    return mCache[path.mEndpointId][path.mClusterId];
+}
+
+const ClusterStateCache::ClusterVersions * ClusterStateCache::FindClusterVersions(const ConcreteClusterPath & path) const
+{
+    if (mStorageMode == StorageMode::kCompact)
+    {
+        return mCompactStorage.FindCluster(path);
+    }
+    CHIP_ERROR err;
+    return GetClusterState(path.mEndpointId, path.mClusterId, err);
+}
+
 const ClusterStateCache::EndpointState * ClusterStateCache::GetEndpointState(EndpointId endpointId, CHIP_ERROR & err) const
 {
     auto endpointIter = mCache.find(endpointId);
@@ -397,10 +529,9 @@ void ClusterStateCache::OnAttributeData(const ConcreteDataAttributePath & aPath,
 CHIP_ERROR ClusterStateCache::GetVersion(const ConcreteClusterPath & aPath, Optional<DataVersion> & aVersion) const
 {
     VerifyOrReturnError(aPath.IsValidConcreteClusterPath(), CHIP_ERROR_INVALID_ARGUMENT);
-    CHIP_ERROR err;
-    auto clusterState = GetClusterState(aPath.mEndpointId, aPath.mClusterId, err);
-    ReturnErrorOnFailure(err);
-    aVersion = clusterState->mCommittedDataVersion;
+    auto clusterVersions = FindClusterVersions(aPath);
+    VerifyOrReturnError(clusterVersions != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+    aVersion = clusterVersions->mCommittedDataVersion;
     return CHIP_NO_ERROR;
 }
 
@@ -420,6 +551,15 @@ void ClusterStateCache::OnEventData(const EventHeader & aEventHeader, TLV::TLVRe
 
 CHIP_ERROR ClusterStateCache::GetStatus(const ConcreteAttributePath & path, StatusIB & status) const
 {
+    if (mStorageMode == StorageMode::kCompact)
+    {
+        const auto * entry = mCompactStorage.FindAttribute(path);
+        VerifyOrReturnError(entry != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+        VerifyOrReturnError(entry->mKind == CompactClusterStateStorage::AttributeKind::kStatus, CHIP_ERROR_INVALID_ARGUMENT);
+        status = entry->GetStatus();
+        return CHIP_NO_ERROR;
+    }
+
     CHIP_ERROR err;
 
     auto attributeState = GetAttributeState(path.mEndpointId, path.mClusterId, path.mAttributeId, err);
@@ -446,63 +586,62 @@ CHIP_ERROR ClusterStateCache::GetStatus(const ConcreteEventPath & path, StatusIB
     return CHIP_NO_ERROR;
 }
 
-void ClusterStateCache::GetSortedFilters(std::vector<std::pair<DataVersionFilter, size_t>> & aVector) const
+size_t ClusterStateCache::GetCachedAttributeSize(const ConcreteAttributePath & path) const
 {
-    for (auto const & endpointIter : mCache)
+    if (mStorageMode == StorageMode::kCompact)
     {
-        EndpointId endpointId = endpointIter.first;
-        for (auto const & clusterIter : endpointIter.second)
+        const auto * entry = mCompactStorage.FindAttribute(path);
+        if (entry == nullptr)
         {
-            if (!clusterIter.second.mCommittedDataVersion.HasValue())
-            {
-                continue;
-            }
-            DataVersion dataVersion = clusterIter.second.mCommittedDataVersion.Value();
-            size_t clusterSize      = 0;
-            ClusterId clusterId     = clusterIter.first;
+            return 0;
+        }
+        return (entry->mKind == CompactClusterStateStorage::AttributeKind::kStatus) ? SizeOfStatusIB(entry->GetStatus())
+                                                                                     : entry->mLength;
+    }
 
-            for (auto const & attributeIter : clusterIter.second.mAttributes)
-            {
-                if (attributeIter.second.Is<StatusIB>())
-                {
-                    clusterSize += SizeOfStatusIB(attributeIter.second.Get<StatusIB>());
-                }
-                else if (attributeIter.second.Is<size_t>())
-                {
-                    clusterSize += attributeIter.second.Get<size_t>();
-                }
-                else
-                {
-                    VerifyOrDie(attributeIter.second.Is<AttributeData>());
-                    TLV::TLVReader bufReader;
-                    bufReader.Init(attributeIter.second.Get<AttributeData>().Get(),
-                                   attributeIter.second.Get<AttributeData>().AllocatedSize());
-                    ReturnOnFailure(bufReader.Next());
-                    // Skip to the end of the element.
-                    ReturnOnFailure(bufReader.Skip());
-
-                    // Compute the amount of value data
-                    clusterSize += bufReader.GetLengthRead();
-                }
-            }
+    CHIP_ERROR err;
+    auto attributeState = GetAttributeState(path.mEndpointId, path.mClusterId, path.mAttributeId, err);
+    if (err != CHIP_NO_ERROR)
+    {
+        return 0;
+    }
+    if (attributeState->Is<StatusIB>())
+    {
+        return SizeOfStatusIB(attributeState->Get<StatusIB>());
+    }
+    if (attributeState->Is<size_t>())
+    {
+        return attributeState->Get<size_t>();
+    }
 
-            if (clusterSize == 0)
-            {
-                // No data in this cluster, so no point in sending a dataVersion
-                // along at all.
-                continue;
-            }
+    // The buffer is allocated to the exact size of the element.
+    VerifyOrDie(attributeState->Is<AttributeData>());
+    return attributeState->Get<AttributeData>().AllocatedSize();
+}
 
-            DataVersionFilter filter(endpointId, clusterId, dataVersion);
+void ClusterStateCache::SetFilterPriority(const ClusterKey & cluster, const FilterPriority & priority)
+{
+    FilterPriority & current = mFilterPriorities[cluster];
+    if (current.mDataSize != 0)
+    {
+        mFilterQueue.erase(FilterQueueEntry{ current.Weight(), cluster });
+    }
 
-            aVector.push_back(std::make_pair(filter, clusterSize));
-        }
+    current = priority;
+    if (current.mDataSize != 0)
+    {
+        mFilterQueue.insert(FilterQueueEntry{ current.Weight(), cluster });
     }
+}
 
-    std::sort(aVector.begin(), aVector.end(),
-              [](const std::pair<DataVersionFilter, size_t> & x, const std::pair<DataVersionFilter, size_t> & y) {
-                  return x.second > y.second;
-              });
+void ClusterStateCache::ResolveFiltersAwaitingReport()
+{
+    for (const auto & filter : mFiltersAwaitingReport)
+    {
+        mFilterStats.mClustersMatched++;
+        mFilterStats.mBytesAvoided += filter.second;
+    }
+    mFiltersAwaitingReport.clear();
 }
 
 CHIP_ERROR ClusterStateCache::OnUpdateDataVersionFilterList(DataVersionFilterIBs::Builder & aDataVersionFilterIBsBuilder,
@@ -542,38 +681,60 @@ CHIP_ERROR ClusterStateCache::OnUpdateDataVersionFilterList(DataVersionFilterIBs
         }
     }
 
-    std::vector<std::pair<DataVersionFilter, size_t>> filterVector;
-    GetSortedFilters(filterVector);
+    // A filter is worth sending for every cluster with a complete, versioned copy in the cache that the request covers.
+    auto getFilter = [this, &aAttributePaths](const ClusterKey & cluster, DataVersionFilter & filter) {
+        const ClusterVersions * versions = FindClusterVersions(ConcreteClusterPath(std::get<0>(cluster), std::get<1>(cluster)));
+        if (versions == nullptr || !versions->mCommittedDataVersion.HasValue())
+        {
+            return false;
+        }
 
-    aEncodedDataVersionList = false;
-    for (auto & filter : filterVector)
-    {
-        bool intersected = false;
-        aDataVersionFilterIBsBuilder.Checkpoint(backup);
+        filter = DataVersionFilter(std::get<0>(cluster), std::get<1>(cluster), versions->mCommittedDataVersion.Value());
 
         // if the particular cached cluster does not intersect with user provided attribute paths, skip the cached one
         for (const auto & attributePath : aAttributePaths)
         {
-            if (attributePath.IncludesAttributesInCluster(filter.first))
+            if (attributePath.IncludesAttributesInCluster(filter))
             {
-                intersected = true;
-                break;
+                return true;
             }
         }
-        if (!intersected)
+        return false;
+    };
+
+    // mFilterQueue is kept in priority order as the cache is updated, so the filters are encoded straight from it.
+    std::vector<ClusterKey> encodedAfterOmission;
+    std::vector<ClusterKey> omitted;
+    auto entry = mFilterQueue.begin();
+
+    aEncodedDataVersionList = false;
+    mFiltersAwaitingReport.clear();
+    for (; entry != mFilterQueue.end(); ++entry)
+    {
+        DataVersionFilter filter;
+        if (!getFilter(entry->mCluster, filter))
         {
             continue;
         }
 
+        aDataVersionFilterIBsBuilder.Checkpoint(backup);
+
         DataVersionFilterIB::Builder & filterIB = aDataVersionFilterIBsBuilder.CreateDataVersionFilter();
         SuccessOrExit(err = aDataVersionFilterIBsBuilder.GetError());
         ClusterPathIB::Builder & filterPath = filterIB.CreatePath();
         SuccessOrExit(err = filterIB.GetError());
-        SuccessOrExit(err = filterPath.Endpoint(filter.first.mEndpointId).Cluster(filter.first.mClusterId).EndOfClusterPathIB());
-        SuccessOrExit(err = filterIB.DataVersion(filter.first.mDataVersion.Value()).EndOfDataVersionFilterIB());
+        SuccessOrExit(err = filterPath.Endpoint(filter.mEndpointId).Cluster(filter.mClusterId).EndOfClusterPathIB());
+        SuccessOrExit(err = filterIB.DataVersion(filter.mDataVersion.Value()).EndOfDataVersionFilterIB());
         ChipLogProgress(DataManagement, "Update DataVersionFilter: Endpoint=%u Cluster=" ChipLogFormatMEI " Version=%" PRIu32,
-                        filter.first.mEndpointId, ChipLogValueMEI(filter.first.mClusterId), filter.first.mDataVersion.Value());
+                        filter.mEndpointId, ChipLogValueMEI(filter.mClusterId), filter.mDataVersion.Value());
 
+        const FilterPriority & priority         = mFilterPriorities[entry->mCluster];
+        mFiltersAwaitingReport[entry->mCluster] = priority.mDataSize;
+        if (priority.mOmittedCount != 0)
+        {
+            encodedAfterOmission.push_back(entry->mCluster);
+        }
+        mFilterStats.mFiltersEncoded++;
         aEncodedDataVersionList = true;
     }
 
@@ -583,10 +744,303 @@ exit:
         ChipLogProgress(DataManagement, "OnUpdateDataVersionFilterList out of space; rolling back");
         aDataVersionFilterIBsBuilder.Rollback(backup);
         err = CHIP_NO_ERROR;
+
+        // None of the remaining filters made it into the request; raise their priority for the next one.
+        for (; entry != mFilterQueue.end(); ++entry)
+        {
+            DataVersionFilter filter;
+            if (getFilter(entry->mCluster, filter))
+            {
+                omitted.push_back(entry->mCluster);
+            }
+        }
+    }
+
+    // Update the priorities only now, since that reorders mFilterQueue.
+    for (const auto & cluster : encodedAfterOmission)
+    {
+        FilterPriority priority = mFilterPriorities[cluster];
+        priority.mOmittedCount  = 0;
+        SetFilterPriority(cluster, priority);
     }
+    for (const auto & cluster : omitted)
+    {
+        FilterPriority priority = mFilterPriorities[cluster];
+        priority.mOmittedCount++;
+        SetFilterPriority(cluster, priority);
+        mFilterStats.mFiltersOmitted++;
+    }
+
     return err;
 }
 
+void ClusterStateCache::ClearAttributeState()
+{
+    mCache.clear();
+    mCompactStorage.Clear();
+    mFilterPriorities.clear();
+    mFilterQueue.clear();
+    mFiltersAwaitingReport.clear();
+}
+
+CHIP_ERROR ClusterStateCache::SaveSnapshot(TLV::TLVWriter & writer) const
+{
+    TLV::TLVType snapshotType;
+    TLV::TLVType clustersType;
+    TLV::TLVType clusterType;
+    TLV::TLVType attributesType;
+    TLV::TLVType attributeType;
+
+    ReturnErrorOnFailure(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, snapshotType));
+    ReturnErrorOnFailure(writer.Put(kFormatVersionTag, kSnapshotFormatVersion));
+    if (mHighestReceivedEventNumber.HasValue())
+    {
+        ReturnErrorOnFailure(writer.Put(kHighestEventNumberTag, mHighestReceivedEventNumber.Value()));
+    }
+    ReturnErrorOnFailure(writer.StartContainer(kClustersTag, TLV::kTLVType_Array, clustersType));
+
+    // Only committed data versions are saved: a pending one belongs to a report that is still in progress.
+    auto startCluster = [&](const ConcreteClusterPath & path, const ClusterVersions & versions) {
+        ReturnErrorOnFailure(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, clusterType));
+        ReturnErrorOnFailure(writer.Put(kEndpointIdTag, path.mEndpointId));
+        ReturnErrorOnFailure(writer.Put(kClusterIdTag, path.mClusterId));
+        if (versions.mCommittedDataVersion.HasValue())
+        {
+            ReturnErrorOnFailure(writer.Put(kDataVersionTag, versions.mCommittedDataVersion.Value()));
+        }
+        return writer.StartContainer(kAttributesTag, TLV::kTLVType_Array, attributesType);
+    };
+    auto endCluster = [&]() {
+        ReturnErrorOnFailure(writer.EndContainer(attributesType));
+        return writer.EndContainer(clusterType);
+    };
+
+    // An attribute holds exactly one of its data, its status or the size of its data.
+    auto saveData = [&](AttributeId attributeId, const ByteSpan & data) {
+        TLV::TLVReader reader;
+        reader.Init(data);
+        ReturnErrorOnFailure(reader.Next());
+        ReturnErrorOnFailure(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, attributeType));
+        ReturnErrorOnFailure(writer.Put(kAttributeIdTag, attributeId));
+        ReturnErrorOnFailure(writer.CopyElement(kAttributeDataTag, reader));
+        return writer.EndContainer(attributeType);
+    };
+    auto saveStatus = [&](AttributeId attributeId, const StatusIB & status) {
+        ReturnErrorOnFailure(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, attributeType));
+        ReturnErrorOnFailure(writer.Put(kAttributeIdTag, attributeId));
+        ReturnErrorOnFailure(writer.Put(kAttributeStatusTag, to_underlying(status.mStatus)));
+        if (status.mClusterStatus.HasValue())
+        {
+            ReturnErrorOnFailure(writer.Put(kAttributeClusterStatusTag, status.mClusterStatus.Value()));
+        }
+        return writer.EndContainer(attributeType);
+    };
+    auto saveDataSize = [&](AttributeId attributeId, size_t size) {
+        ReturnErrorOnFailure(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, attributeType));
+        ReturnErrorOnFailure(writer.Put(kAttributeIdTag, attributeId));
+        ReturnErrorOnFailure(writer.Put(kAttributeDataSizeTag, static_cast<uint64_t>(size)));
+        return writer.EndContainer(attributeType);
+    };
+
+    if (mStorageMode == StorageMode::kCompact)
+    {
+        auto saveAttribute = [&](const CompactClusterStateStorage::AttributeEntry & entry) {
+            switch (entry.mKind)
+            {
+            case CompactClusterStateStorage::AttributeKind::kData:
+                return saveData(entry.mAttributeId, mCompactStorage.GetData(entry));
+            case CompactClusterStateStorage::AttributeKind::kStatus:
+                return saveStatus(entry.mAttributeId, entry.GetStatus());
+            default:
+                return saveDataSize(entry.mAttributeId, entry.mLength);
+            }
+        };
+        auto saveCluster = [&](const ConcreteClusterPath & path, const ClusterVersions & versions) {
+            ReturnErrorOnFailure(startCluster(path, versions));
+            ReturnErrorOnFailure(mCompactStorage.ForEachAttributeEntry(path.mEndpointId, path.mClusterId, saveAttribute));
+            return endCluster();
+        };
+        ReturnErrorOnFailure(mCompactStorage.ForEachCluster(saveCluster));
+    }
+    else
+    {
+        for (const auto & endpointIter : mCache)
+        {
+            for (const auto & clusterIter : endpointIter.second)
+            {
+                ReturnErrorOnFailure(startCluster(ConcreteClusterPath(endpointIter.first, clusterIter.first), clusterIter.second));
+                for (const auto & attributeIter : clusterIter.second.mAttributes)
+                {
+                    const AttributeState & state = attributeIter.second;
+                    if (state.Is<AttributeData>())
+                    {
+                        const AttributeData & data = state.Get<AttributeData>();
+                        ReturnErrorOnFailure(saveData(attributeIter.first, ByteSpan(data.Get(), data.AllocatedSize())));
+                    }
+                    else if (state.Is<StatusIB>())
+                    {
+                        ReturnErrorOnFailure(saveStatus(attributeIter.first, state.Get<StatusIB>()));
+                    }
+                    else
+                    {
+                        ReturnErrorOnFailure(saveDataSize(attributeIter.first, state.Get<size_t>()));
+                    }
+                }
+                ReturnErrorOnFailure(endCluster());
+            }
+        }
+    }
+
+    ReturnErrorOnFailure(writer.EndContainer(clustersType));
+    return writer.EndContainer(snapshotType);
+}
+
+CHIP_ERROR ClusterStateCache::LoadSnapshot(const ByteSpan & snapshot)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    TLV::TLVReader reader;
+    TLV::TLVType snapshotType;
+    uint16_t formatVersion = 0;
+    Optional<EventNumber> highestEventNumber;
+
+    reader.Init(snapshot);
+    SuccessOrExit(err = reader.Next(TLV::kTLVType_Structure, TLV::AnonymousTag()));
+    SuccessOrExit(err = reader.EnterContainer(snapshotType));
+
+    SuccessOrExit(err = reader.Next(kFormatVersionTag));
+    SuccessOrExit(err = reader.Get(formatVersion));
+    VerifyOrExit(formatVersion == kSnapshotFormatVersion, err = CHIP_ERROR_VERSION_MISMATCH);
+
+    SuccessOrExit(err = reader.Next());
+    if (reader.GetTag() == kHighestEventNumberTag)
+    {
+        EventNumber eventNumber;
+        SuccessOrExit(err = reader.Get(eventNumber));
+        highestEventNumber.SetValue(eventNumber);
+        SuccessOrExit(err = reader.Next());
+    }
+
+    VerifyOrExit(reader.GetTag() == kClustersTag && reader.GetType() == TLV::kTLVType_Array,
+                 err = CHIP_ERROR_INVALID_TLV_ELEMENT);
+    SuccessOrExit(err = LoadSnapshotClusters(reader));
+    SuccessOrExit(err = reader.ExitContainer(snapshotType));
+
+    // The snapshot holds the whole state, so drop the capacity the storage grew by while it was loaded.
+    if (mStorageMode == StorageMode::kCompact)
+    {
+        mCompactStorage.ShrinkToFit();
+    }
+
+    if (highestEventNumber.HasValue() &&
+        (!mHighestReceivedEventNumber.HasValue() || mHighestReceivedEventNumber.Value() < highestEventNumber.Value()))
+    {
+        mHighestReceivedEventNumber = highestEventNumber;
+    }
+
+exit:
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DataManagement, "Failed to load ClusterStateCache snapshot: %" CHIP_ERROR_FORMAT, err.Format());
+        ClearAttributeState();
+    }
+    return err;
+}
+
+CHIP_ERROR ClusterStateCache::LoadSnapshotClusters(TLV::TLVReader & reader)
+{
+    CHIP_ERROR err;
+    TLV::TLVType clustersType;
+
+    ReturnErrorOnFailure(reader.EnterContainer(clustersType));
+    while ((err = reader.Next(TLV::kTLVType_Structure, TLV::AnonymousTag())) == CHIP_NO_ERROR)
+    {
+        TLV::TLVType clusterType;
+        TLV::TLVType attributesType;
+        ConcreteClusterPath path;
+        Optional<DataVersion> dataVersion;
+
+        ReturnErrorOnFailure(reader.EnterContainer(clusterType));
+        ReturnErrorOnFailure(reader.Next(kEndpointIdTag));
+        ReturnErrorOnFailure(reader.Get(path.mEndpointId));
+        ReturnErrorOnFailure(reader.Next(kClusterIdTag));
+        ReturnErrorOnFailure(reader.Get(path.mClusterId));
+
+        ReturnErrorOnFailure(reader.Next());
+        if (reader.GetTag() == kDataVersionTag)
+        {
+            DataVersion version;
+            ReturnErrorOnFailure(reader.Get(version));
+            dataVersion.SetValue(version);
+            ReturnErrorOnFailure(reader.Next());
+        }
+
+        VerifyOrReturnError(reader.GetTag() == kAttributesTag && reader.GetType() == TLV::kTLVType_Array,
+                            CHIP_ERROR_INVALID_TLV_ELEMENT);
+        ReturnErrorOnFailure(reader.EnterContainer(attributesType));
+        while ((err = reader.Next(TLV::kTLVType_Structure, TLV::AnonymousTag())) == CHIP_NO_ERROR)
+        {
+            ReturnErrorOnFailure(LoadSnapshotAttribute(reader, path));
+        }
+        VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+        ReturnErrorOnFailure(reader.ExitContainer(attributesType));
+        ReturnErrorOnFailure(reader.ExitContainer(clusterType));
+
+        // This also creates clusters that had a version but no attributes cached.
+        GetOrCreateClusterVersions(path).mCommittedDataVersion = dataVersion;
+    }
+    VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+
+    return reader.ExitContainer(clustersType);
+}
+
+CHIP_ERROR ClusterStateCache::LoadSnapshotAttribute(TLV::TLVReader & reader, const ConcreteClusterPath & clusterPath)
+{
+    TLV::TLVType attributeType;
+    ConcreteAttributePath path(clusterPath.mEndpointId, clusterPath.mClusterId, kInvalidAttributeId);
+
+    ReturnErrorOnFailure(reader.EnterContainer(attributeType));
+    ReturnErrorOnFailure(reader.Next(kAttributeIdTag));
+    ReturnErrorOnFailure(reader.Get(path.mAttributeId));
+
+    ReturnErrorOnFailure(reader.Next());
+    if (reader.GetTag() == kAttributeDataTag)
+    {
+        ReturnErrorOnFailure(StoreAttribute(path, &reader, StatusIB()));
+    }
+    else if (reader.GetTag() == kAttributeStatusTag)
+    {
+        uint8_t status;
+        ReturnErrorOnFailure(reader.Get(status));
+        StatusIB statusIB(static_cast<Protocols::InteractionModel::Status>(status));
+
+        CHIP_ERROR err = reader.Next(kAttributeClusterStatusTag);
+        if (err == CHIP_NO_ERROR)
+        {
+            ClusterStatus clusterStatus;
+            ReturnErrorOnFailure(reader.Get(clusterStatus));
+            statusIB.mClusterStatus.SetValue(clusterStatus);
+        }
+        else
+        {
+            VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+        }
+        ReturnErrorOnFailure(StoreAttribute(path, nullptr, statusIB));
+    }
+    else if (reader.GetTag() == kAttributeDataSizeTag)
+    {
+        uint64_t size;
+        ReturnErrorOnFailure(reader.Get(size));
+        VerifyOrReturnError(CanCastTo<size_t>(size), CHIP_ERROR_INVALID_INTEGER_VALUE);
+        StoreAttributeDataSize(path, static_cast<size_t>(size));
+    }
+    else
+    {
+        return CHIP_ERROR_INVALID_TLV_TAG;
+    }
+
+    return reader.ExitContainer(attributeType);
+}
+
 CHIP_ERROR ClusterStateCache::GetLastReportDataPath(ConcreteClusterPath & aPath)
 {
     if (mLastReportDataPath.IsValidConcreteClusterPath())
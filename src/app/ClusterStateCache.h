@@ -23,6 +23,7 @@
 #include "system/TLVPacketBufferBackingStore.h"
 #include <app/AttributePathParams.h>
 #include <app/BufferedReadCallback.h>
+#include <app/CompactClusterStateStorage.h>
 #include <app/ReadClient.h>
 #include <app/data-model/DecodableList.h>
 #include <app/data-model/Decode.h>
@@ -31,6 +32,7 @@
 #include <map>
 #include <queue>
 #include <set>
+#include <tuple>
 #include <vector>
 
 namespace chip {
@@ -59,6 +61,14 @@ namespace app {
  * through to a registered callback. In addition, it provides its own enhancements to the base ReadClient::Callback
  * to make it easier to know what has changed in the cache.
  *
+ * Attribute state can be kept in one of two storage modes, chosen at construction:
+ *  - StorageMode::kTree (the default) keeps nested maps of endpoints, clusters and attributes, with a separate
+ *    heap allocation for the TLV of every attribute.
+ *  - StorageMode::kCompact keeps sorted flat vectors keyed by (endpoint, cluster, attribute), with the TLV of all
+ *    attributes in one arena per cache (see CompactClusterStateStorage). This takes a fraction of the memory of
+ *    kTree for caches holding full wildcard subscriptions, at the cost of weaker pointer stability: a value read
+ *    from the cache is only valid until any cached attribute is updated, not just the one that was read.
+ *
  * **NOTE**
  * 1. This already includes the BufferedReadCallback, so there is no need to add that to the ReadClient callback chain.
  * 2. The same cache cannot be used by multiple subscribe/read interactions at the same time.
@@ -86,6 +96,12 @@ public:
         virtual void OnEndpointAdded(ClusterStateCache * cache, EndpointId endpointId){};
     };
 
+    enum class StorageMode : uint8_t
+    {
+        kTree,
+        kCompact,
+    };
+
     /**
      *
      * @param [in] callback the derived callback which inherit from ReadClient::Callback
@@ -93,11 +109,12 @@ public:
      *             less than or equal to this value, skip those events
      * @param [in] cacheData boolean to decide whether this cache would store attribute/event data/status,
      *             the default is true.
+     * @param [in] storageMode how attribute state is stored, the default is StorageMode::kTree.
      */
     ClusterStateCache(Callback & callback, Optional<EventNumber> highestReceivedEventNumber = Optional<EventNumber>::Missing(),
-                      bool cacheData = true) :
+                      bool cacheData = true, StorageMode storageMode = StorageMode::kTree) :
         mCallback(callback),
-        mBufferedReader(*this), mCacheData(cacheData)
+        mBufferedReader(*this), mCacheData(cacheData), mStorageMode(storageMode)
     {
         mHighestReceivedEventNumber = highestReceivedEventNumber;
     }
@@ -120,8 +137,8 @@ public:
      *
      * For some types of attributes, the value for the attribute is directly backed by the underlying TLV buffer
      * and has pointers into that buffer. (e.g octet strings, char strings and lists).  This buffer only remains
-     * valid until the cached value for that path is updated, so it must not be held
-     * across any async call boundaries.
+     * valid until the cached value for that path is updated (for StorageMode::kCompact, any cached value), so it
+     * must not be held across any async call boundaries.
      *
      * The template parameter AttributeObjectTypeT is generally expected to be a
      * ClusterName::Attributes::AttributeName::DecodableType, but any
@@ -192,8 +209,8 @@ public:
      *
      * For some types of attributes, the value for the attribute is directly backed by the underlying TLV buffer
      * and has pointers into that buffer. (e.g octet strings, char strings and lists).  This buffer only remains
-     * valid until the cached value for that path is updated, so it must not be held
-     * across any async call boundaries.
+     * valid until the cached value for that path is updated (for StorageMode::kCompact, any cached value), so it
+     * must not be held across any async call boundaries.
      *
      * The template parameter ClusterObjectT is generally expected to be a
      * ClusterName::Attributes::DecodableType, but any
@@ -351,6 +368,13 @@ public:
     template <typename IteratorFunc>
     CHIP_ERROR ForEachAttribute(EndpointId endpointId, ClusterId clusterId, IteratorFunc func) const
     {
+        if (mStorageMode == StorageMode::kCompact)
+        {
+            return mCompactStorage.ForEachAttributeEntry(
+                endpointId, clusterId,
+                [&func](const CompactClusterStateStorage::AttributeEntry & entry) { return func(entry.GetPath()); });
+        }
+
         CHIP_ERROR err;
 
         auto clusterState = GetClusterState(endpointId, clusterId, err);
@@ -381,6 +405,12 @@ public:
     template <typename IteratorFunc>
     CHIP_ERROR ForEachAttribute(ClusterId clusterId, IteratorFunc func) const
     {
+        if (mStorageMode == StorageMode::kCompact)
+        {
+            return mCompactStorage.ForEachAttributeEntry(
+                clusterId, [&func](const CompactClusterStateStorage::AttributeEntry & entry) { return func(entry.GetPath()); });
+        }
+
         for (auto & endpointIter : mCache)
         {
             for (auto & clusterIter : endpointIter.second)
@@ -414,8 +444,13 @@ public:
     template <typename IteratorFunc>
     CHIP_ERROR ForEachCluster(EndpointId endpointId, IteratorFunc func) const
     {
+        if (mStorageMode == StorageMode::kCompact)
+        {
+            return mCompactStorage.ForEachCluster(endpointId, func);
+        }
+
         auto endpointIter = mCache.find(endpointId);
-        if (endpointIter->first == endpointId)
+        if (endpointIter != mCache.end())
         {
             for (auto & clusterIter : endpointIter->second)
             {
@@ -510,6 +545,54 @@ public:
      */
     CHIP_ERROR GetLastReportDataPath(ConcreteClusterPath & aPath);
 
+    /*
+     * Counters for the DataVersionFilters this cache puts into read and subscribe requests.
+     *
+     * A filtered cluster is matched when the publisher does not send any of its attributes in response to the request,
+     * i.e. the cached data version was still current. mBytesAvoided adds up the cached attribute TLV of those clusters,
+     * which approximates the report payload the filters saved.
+     */
+    struct DataVersionFilterStats
+    {
+        uint32_t mFiltersEncoded     = 0; /**< DataVersionFilters put into requests. */
+        uint32_t mFiltersOmitted     = 0; /**< DataVersionFilters left out of requests for lack of space. */
+        uint32_t mClustersMatched    = 0; /**< Filtered clusters the publisher did not send again. */
+        uint32_t mClustersMismatched = 0; /**< Filtered clusters the publisher sent again. */
+        uint64_t mBytesAvoided       = 0; /**< Cached attribute bytes of the matched clusters. */
+    };
+
+    const DataVersionFilterStats & GetDataVersionFilterStats() const { return mFilterStats; }
+    void ResetDataVersionFilterStats() { mFilterStats = DataVersionFilterStats(); }
+
+    /*
+     * Write a snapshot of the cached attribute state to the writer: the attribute data and statuses, the data version of
+     * every cluster, and the highest received event number. Cached event data and statuses are not included.
+     *
+     * The snapshot is a single anonymous TLV structure. Writing it through a TLVWriter backed by a TLVBackingStore
+     * streams it to a file without holding a full copy in memory.
+     */
+    CHIP_ERROR SaveSnapshot(TLV::TLVWriter & writer) const;
+
+    /*
+     * Restore the cached attribute state from a snapshot written by SaveSnapshot, e.g. by a previous run of the
+     * controller. The snapshot is read in place in a single pass, so it can point straight into a memory-mapped file,
+     * which only has to stay mapped for the duration of the call. The snapshot can be loaded into a cache of either
+     * storage mode, whatever the mode of the cache that saved it.
+     *
+     * The restored data versions and event number are used in the next read or subscribe request on this cache, so the
+     * publisher only sends what changed since the snapshot was taken. No change callbacks are called for the restored
+     * state.
+     *
+     * This must be called on a cache that has no attribute state yet, before it is used for any request. If the snapshot
+     * cannot be parsed, an error is returned and the cache is left empty.
+     */
+    CHIP_ERROR LoadSnapshot(const ByteSpan & snapshot);
+
+    /*
+     * Bytes reserved on the heap for the attribute state in StorageMode::kCompact; always 0 in StorageMode::kTree.
+     */
+    size_t GetCompactStorageHeapSize() const { return mCompactStorage.GetHeapSize(); }
+
 private:
     // An attribute state can be one of three things:
     // * If we got a path-specific error for the attribute, the corresponding
@@ -526,11 +609,10 @@ private:
     // mCurrentDataVersion represents a known data version for a cluster.  In order for this to have a
     // value the cluster must be included in a path in mRequestPathSet that has a wildcard attribute
     // and we must not be in the middle of receiving reports for that cluster.
-    struct ClusterState
+    using ClusterVersions = CompactClusterStateStorage::ClusterVersions;
+    struct ClusterState : public ClusterVersions
     {
         std::map<AttributeId, AttributeState> mAttributes;
-        Optional<DataVersion> mPendingDataVersion;
-        Optional<DataVersion> mCommittedDataVersion;
     };
     using EndpointState = std::map<ClusterId, ClusterState>;
     using NodeState     = std::map<EndpointId, EndpointState>;
@@ -543,6 +625,34 @@ private:
         }
     };
 
+    using ClusterKey = std::tuple<EndpointId, ClusterId>;
+
+    //
+    // The DataVersionFilter priority of a cluster. Clusters with the most cached data go first, since they save the most
+    // on the wire when their version still matches. Every request a cluster's filter is left out of for lack of space
+    // adds its size to its weight once more, so every cached cluster gets a filter within a few requests even if the
+    // filters of all of them never fit in one.
+    //
+    struct FilterPriority
+    {
+        size_t mDataSize       = 0; // Wire size of the cached data and statuses of the cluster.
+        uint32_t mOmittedCount = 0; // Consecutive requests the filter of the cluster was left out of.
+
+        uint64_t Weight() const { return static_cast<uint64_t>(mDataSize) * (static_cast<uint64_t>(mOmittedCount) + 1); }
+    };
+
+    struct FilterQueueEntry
+    {
+        uint64_t mWeight;
+        ClusterKey mCluster;
+
+        // Highest weight first; ties in path order.
+        bool operator<(const FilterQueueEntry & other) const
+        {
+            return mWeight > other.mWeight || (mWeight == other.mWeight && mCluster < other.mCluster);
+        }
+    };
+
     using EventData = std::pair<EventHeader, System::PacketBufferHandle>;
 
     //
@@ -576,6 +686,48 @@ private:
 
     const EventData * GetEventData(EventNumber number, CHIP_ERROR & err) const;
 
+    /*
+     * Cluster-level state, whatever the storage mode.
+     */
+    bool HasEndpoint(EndpointId endpointId) const;
+    ClusterVersions & GetOrCreateClusterVersions(const ConcreteClusterPath & path);
+    const ClusterVersions * FindClusterVersions(const ConcreteClusterPath & path) const;
+
+    /*
+     * The number of bytes the cached state of an attribute stands for on the wire, 0 if nothing is cached for it.
+     */
+    size_t GetCachedAttributeSize(const ConcreteAttributePath & path) const;
+
+    /*
+     * Store the state of an attribute in the storage of the cache: the data the reader is positioned on if apData is not
+     * null (only its size if the cache does not store data), otherwise aStatus. Versions are left alone.
+     */
+    CHIP_ERROR StoreAttribute(const ConcreteAttributePath & aPath, TLV::TLVReader * apData, const StatusIB & aStatus);
+
+    /*
+     * Store an attribute that is only known by the size of its data.
+     */
+    void StoreAttributeDataSize(const ConcreteAttributePath & aPath, size_t aSize);
+
+    /*
+     * Update the filter priority of the cluster of an attribute whose cached state was just replaced.
+     */
+    void NoteAttributeSizeChange(const ConcreteAttributePath & aPath, size_t aPreviousSize);
+
+    /*
+     * Drop all attribute state, including data versions and filter priorities.
+     */
+    void ClearAttributeState();
+
+    CHIP_ERROR LoadSnapshotClusters(TLV::TLVReader & reader);
+    CHIP_ERROR LoadSnapshotAttribute(TLV::TLVReader & reader, const ConcreteClusterPath & clusterPath);
+
+    /*
+     * Replace the filter priority of a cluster, keeping mFilterQueue in order. Clusters without any cached data are
+     * kept out of the queue.
+     */
+    void SetFilterPriority(const ClusterKey & cluster, const FilterPriority & priority);
+
     /*
      * Updates the state of an attribute in the cache given a reader. If the reader is null, the state is updated
      * with the provided status.
@@ -597,18 +749,25 @@ private:
     void OnReportBegin() override;
     void OnReportEnd() override;
     void OnAttributeData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData, const StatusIB & aStatus) override;
-    void OnError(CHIP_ERROR aError) override { return mCallback.OnError(aError); }
+    void OnError(CHIP_ERROR aError) override
+    {
+        // The response to the request is incomplete, so it tells nothing about which filters matched.
+        mFiltersAwaitingReport.clear();
+        return mCallback.OnError(aError);
+    }
 
     void OnEventData(const EventHeader & aEventHeader, TLV::TLVReader * apData, const StatusIB * apStatus) override;
 
     void OnDone(ReadClient * apReadClient) override
     {
+        ResolveFiltersAwaitingReport();
         mRequestPathSet.clear();
         return mCallback.OnDone(apReadClient);
     }
 
     void OnSubscriptionEstablished(SubscriptionId aSubscriptionId) override
     {
+        ResolveFiltersAwaitingReport();
         mCallback.OnSubscriptionEstablished(aSubscriptionId);
     }
 
@@ -634,15 +793,30 @@ private:
     // Commit the pending cluster data version, if there is one.
     void CommitPendingDataVersion();
 
-    // Get our list of data version filters, sorted from larges to smallest by the total size of the TLV
-    // payload for the filter's cluster.  Applying filters in this order should maximize space savings
-    // on the wire if not all filters can be applied.
-    void GetSortedFilters(std::vector<std::pair<DataVersionFilter, size_t>> & aVector) const;
+    // Count the filtered clusters the publisher did not send again as matched, once the initial reports in response
+    // to a request are complete.
+    void ResolveFiltersAwaitingReport();
 
     CHIP_ERROR GetElementTLVSize(TLV::TLVReader * apData, size_t & aSize);
 
+    // Snapshot format, see SaveSnapshot.
+    static constexpr uint16_t kSnapshotFormatVersion     = 1;
+    static constexpr TLV::Tag kFormatVersionTag          = TLV::ContextTag(1);
+    static constexpr TLV::Tag kHighestEventNumberTag     = TLV::ContextTag(2);
+    static constexpr TLV::Tag kClustersTag               = TLV::ContextTag(3);
+    static constexpr TLV::Tag kEndpointIdTag             = TLV::ContextTag(4);
+    static constexpr TLV::Tag kClusterIdTag              = TLV::ContextTag(5);
+    static constexpr TLV::Tag kDataVersionTag            = TLV::ContextTag(6);
+    static constexpr TLV::Tag kAttributesTag             = TLV::ContextTag(7);
+    static constexpr TLV::Tag kAttributeIdTag            = TLV::ContextTag(8);
+    static constexpr TLV::Tag kAttributeDataTag          = TLV::ContextTag(9);
+    static constexpr TLV::Tag kAttributeStatusTag        = TLV::ContextTag(10);
+    static constexpr TLV::Tag kAttributeClusterStatusTag = TLV::ContextTag(11);
+    static constexpr TLV::Tag kAttributeDataSizeTag      = TLV::ContextTag(12);
+
     Callback & mCallback;
     NodeState mCache;
+    CompactClusterStateStorage mCompactStorage;
     std::set<ConcreteAttributePath> mChangedAttributeSet;
     std::set<AttributePathParams, Comparator> mRequestPathSet; // wildcard attribute request path only
     std::vector<EndpointId> mAddedEndpoints;
@@ -650,9 +824,14 @@ private:
     std::set<EventData, EventDataCompare> mEventDataCache;
     Optional<EventNumber> mHighestReceivedEventNumber;
     std::map<ConcreteEventPath, StatusIB> mEventStatusCache;
+    std::map<ClusterKey, FilterPriority> mFilterPriorities;
+    std::set<FilterQueueEntry> mFilterQueue;
+    std::map<ClusterKey, size_t> mFiltersAwaitingReport; // cluster -> cached size when its filter was sent
+    DataVersionFilterStats mFilterStats;
     BufferedReadCallback mBufferedReader;
     ConcreteClusterPath mLastReportDataPath = ConcreteClusterPath(kInvalidEndpointId, kInvalidClusterId);
     const bool mCacheData                   = true;
+    const StorageMode mStorageMode          = StorageMode::kTree;
 };
 
 }; // namespace app
@@ -37,6 +37,7 @@
 #include <lib/support/TypeTraits.h>
 #include <platform/LockTracker.h>
 #include <protocols/secure_channel/Constants.h>
+#include <tracing/macros.h>
 
 namespace chip {
 namespace app {
@@ -99,6 +100,7 @@ void CommandHandler::OnInvokeCommandRequest(Messaging::ExchangeContext * ec, con
 
 Status CommandHandler::ProcessInvokeRequest(System::PacketBufferHandle && payload, bool isTimedInvoke)
 {
+    MATTER_TRACE_SCOPE("ProcessInvokeRequest", "CommandHandler");
     CHIP_ERROR err = CHIP_NO_ERROR;
     System::PacketBufferTLVReader reader;
     TLV::TLVReader invokeRequestsReader;
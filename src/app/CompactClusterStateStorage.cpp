@@ -0,0 +1,290 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/CompactClusterStateStorage.h>
+
+#include <lib/core/TLVWriter.h>
+#include <lib/support/SafeInt.h>
+
+#include <algorithm>
+#include <string.h>
+
+namespace chip {
+namespace app {
+
+namespace {
+
+// Control byte and the largest length field or scalar value; an anonymous tag takes no space.
+constexpr size_t kMaxAnonymousElementHeadSize = 1 + sizeof(uint64_t);
+
+} // namespace
+
+StatusIB CompactClusterStateStorage::AttributeEntry::GetStatus() const
+{
+    StatusIB status(mStatus);
+    if (mHasClusterStatus)
+    {
+        status.mClusterStatus.SetValue(mClusterStatus);
+    }
+    return status;
+}
+
+CompactClusterStateStorage::AttributeIterator CompactClusterStateStorage::LowerBound(EndpointId endpointId, ClusterId clusterId,
+                                                                                     AttributeId attributeId) const
+{
+    const uint64_t clusterKey = ClusterKey(endpointId, clusterId);
+    return std::lower_bound(mAttributes.begin(), mAttributes.end(), attributeId,
+                            [clusterKey](const AttributeEntry & entry, AttributeId id) {
+                                uint64_t entryKey = ClusterKey(entry.mEndpointId, entry.mClusterId);
+                                return entryKey < clusterKey || (entryKey == clusterKey && entry.mAttributeId < id);
+                            });
+}
+
+CompactClusterStateStorage::ClusterIterator CompactClusterStateStorage::LowerBound(EndpointId endpointId,
+                                                                                   ClusterId clusterId) const
+{
+    return std::lower_bound(mClusters.begin(), mClusters.end(), ClusterKey(endpointId, clusterId),
+                            [](const ClusterEntry & entry, uint64_t key) {
+                                return ClusterKey(entry.mEndpointId, entry.mClusterId) < key;
+                            });
+}
+
+bool CompactClusterStateStorage::HasEndpoint(EndpointId endpointId) const
+{
+    auto it = LowerBound(endpointId, 0);
+    return it != mClusters.end() && it->mEndpointId == endpointId;
+}
+
+CompactClusterStateStorage::ClusterVersions & CompactClusterStateStorage::GetOrCreateCluster(const ConcreteClusterPath & path)
+{
+    const uint64_t key = ClusterKey(path.mEndpointId, path.mClusterId);
+
+    // Reports are in path order, so a new cluster almost always goes at the end.
+    if (mClusters.empty() || ClusterKey(mClusters.back().mEndpointId, mClusters.back().mClusterId) < key)
+    {
+        mClusters.push_back(ClusterEntry{ path.mClusterId, path.mEndpointId, ClusterVersions() });
+        return mClusters.back().mVersions;
+    }
+
+    auto it = mClusters.begin() + (LowerBound(path.mEndpointId, path.mClusterId) - mClusters.cbegin());
+    if (it == mClusters.end() || ClusterKey(it->mEndpointId, it->mClusterId) != key)
+    {
+        it = mClusters.insert(it, ClusterEntry{ path.mClusterId, path.mEndpointId, ClusterVersions() });
+    }
+    return it->mVersions;
+}
+
+const CompactClusterStateStorage::ClusterVersions * CompactClusterStateStorage::FindCluster(const ConcreteClusterPath & path) const
+{
+    auto it = LowerBound(path.mEndpointId, path.mClusterId);
+    if (it == mClusters.end() || it->mEndpointId != path.mEndpointId || it->mClusterId != path.mClusterId)
+    {
+        return nullptr;
+    }
+    return &it->mVersions;
+}
+
+CompactClusterStateStorage::AttributeEntry & CompactClusterStateStorage::GetOrCreateAttribute(const ConcreteAttributePath & path)
+{
+    GetOrCreateCluster(path);
+
+    AttributeEntry newEntry;
+    newEntry.mClusterId        = path.mClusterId;
+    newEntry.mAttributeId      = path.mAttributeId;
+    newEntry.mOffset           = 0;
+    newEntry.mLength           = 0;
+    newEntry.mEndpointId       = path.mEndpointId;
+    newEntry.mKind             = AttributeKind::kDataSize;
+    newEntry.mStatus           = Protocols::InteractionModel::Status::Success;
+    newEntry.mClusterStatus    = 0;
+    newEntry.mHasClusterStatus = false;
+
+    const uint64_t clusterKey = ClusterKey(path.mEndpointId, path.mClusterId);
+    if (mAttributes.empty())
+    {
+        mAttributes.push_back(newEntry);
+        return mAttributes.back();
+    }
+
+    const AttributeEntry & last = mAttributes.back();
+    const uint64_t lastKey      = ClusterKey(last.mEndpointId, last.mClusterId);
+    if (lastKey < clusterKey || (lastKey == clusterKey && last.mAttributeId < path.mAttributeId))
+    {
+        mAttributes.push_back(newEntry);
+        return mAttributes.back();
+    }
+
+    auto it = mAttributes.begin() + (LowerBound(path.mEndpointId, path.mClusterId, path.mAttributeId) - mAttributes.cbegin());
+    if (it == mAttributes.end() || it->mEndpointId != path.mEndpointId || it->mClusterId != path.mClusterId ||
+        it->mAttributeId != path.mAttributeId)
+    {
+        it = mAttributes.insert(it, newEntry);
+    }
+    return *it;
+}
+
+const CompactClusterStateStorage::AttributeEntry *
+CompactClusterStateStorage::FindAttribute(const ConcreteAttributePath & path) const
+{
+    auto it = LowerBound(path.mEndpointId, path.mClusterId, path.mAttributeId);
+    if (it == mAttributes.end() || it->mEndpointId != path.mEndpointId || it->mClusterId != path.mClusterId ||
+        it->mAttributeId != path.mAttributeId)
+    {
+        return nullptr;
+    }
+    return &(*it);
+}
+
+CHIP_ERROR CompactClusterStateStorage::GetMaxElementSize(const TLV::TLVReader & data, size_t & maxSize)
+{
+    // The reader usually sits in the middle of a report, so size the element by skipping it rather than from the
+    // remaining length. Skipping covers everything after its head, and its head re-encoded without a tag is no longer
+    // than kMaxAnonymousElementHeadSize.
+    TLV::TLVReader elementEnd;
+    elementEnd.Init(data);
+    ReturnErrorOnFailure(elementEnd.Skip());
+
+    maxSize = (elementEnd.GetLengthRead() - data.GetLengthRead()) + kMaxAnonymousElementHeadSize;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CompactClusterStateStorage::SetData(const ConcreteAttributePath & path, const TLV::TLVReader & data)
+{
+    TLV::TLVReader reader;
+    reader.Init(data);
+
+    size_t maxLength = 0;
+    ReturnErrorOnFailure(GetMaxElementSize(data, maxLength));
+
+    // Write the element at the end of the arena, then trim the arena down to what was actually written.
+    const size_t start = mArena.size();
+    VerifyOrReturnError(CanCastTo<uint32_t>(start + maxLength), CHIP_ERROR_NO_MEMORY);
+    mArena.resize(start + maxLength);
+
+    TLV::TLVWriter writer;
+    writer.Init(mArena.data() + start, maxLength);
+    CHIP_ERROR err = writer.CopyElement(TLV::AnonymousTag(), reader);
+    if (err == CHIP_NO_ERROR)
+    {
+        err = writer.Finalize();
+    }
+    if (err != CHIP_NO_ERROR)
+    {
+        mArena.resize(start);
+        return err;
+    }
+
+    const uint32_t length  = writer.GetLengthWritten();
+    AttributeEntry & entry = GetOrCreateAttribute(path);
+    if (entry.mKind == AttributeKind::kData && entry.mLength == length)
+    {
+        memcpy(mArena.data() + entry.mOffset, mArena.data() + start, length);
+        mArena.resize(start);
+        return CHIP_NO_ERROR;
+    }
+
+    ReleaseData(entry);
+    entry.mKind   = AttributeKind::kData;
+    entry.mOffset = static_cast<uint32_t>(start);
+    entry.mLength = length;
+    mArena.resize(start + length);
+
+    if (mUnusedArenaBytes > mArena.size() / 2)
+    {
+        CompactArena();
+    }
+    return CHIP_NO_ERROR;
+}
+
+void CompactClusterStateStorage::SetStatus(const ConcreteAttributePath & path, const StatusIB & status)
+{
+    AttributeEntry & entry = GetOrCreateAttribute(path);
+    ReleaseData(entry);
+    entry.mKind             = AttributeKind::kStatus;
+    entry.mStatus           = status.mStatus;
+    entry.mHasClusterStatus = status.mClusterStatus.HasValue();
+    entry.mClusterStatus    = status.mClusterStatus.ValueOr(0);
+}
+
+void CompactClusterStateStorage::SetDataSize(const ConcreteAttributePath & path, size_t size)
+{
+    AttributeEntry & entry = GetOrCreateAttribute(path);
+    ReleaseData(entry);
+    entry.mKind   = AttributeKind::kDataSize;
+    entry.mLength = CanCastTo<uint32_t>(size) ? static_cast<uint32_t>(size) : UINT32_MAX;
+}
+
+void CompactClusterStateStorage::ReleaseData(AttributeEntry & entry)
+{
+    if (entry.mKind == AttributeKind::kData)
+    {
+        mUnusedArenaBytes += entry.mLength;
+        entry.mLength = 0;
+    }
+}
+
+void CompactClusterStateStorage::CompactArena()
+{
+    // Copying the live values in path order also keeps the values of a cluster next to each other.
+    std::vector<uint8_t> arena;
+    arena.reserve(mArena.size() - mUnusedArenaBytes);
+    for (auto & entry : mAttributes)
+    {
+        if (entry.mKind == AttributeKind::kData)
+        {
+            const size_t offset = arena.size();
+            arena.insert(arena.end(), mArena.begin() + entry.mOffset, mArena.begin() + entry.mOffset + entry.mLength);
+            entry.mOffset = static_cast<uint32_t>(offset);
+        }
+    }
+    mArena.swap(arena);
+    mUnusedArenaBytes = 0;
+}
+
+void CompactClusterStateStorage::Clear()
+{
+    mAttributes.clear();
+    mAttributes.shrink_to_fit();
+    mClusters.clear();
+    mClusters.shrink_to_fit();
+    mArena.clear();
+    mArena.shrink_to_fit();
+    mUnusedArenaBytes = 0;
+}
+
+void CompactClusterStateStorage::ShrinkToFit()
+{
+    mAttributes.shrink_to_fit();
+    mClusters.shrink_to_fit();
+    if (mUnusedArenaBytes > 0)
+    {
+        CompactArena();
+    }
+    else
+    {
+        mArena.shrink_to_fit();
+    }
+}
+
+size_t CompactClusterStateStorage::GetHeapSize() const
+{
+    return mAttributes.capacity() * sizeof(AttributeEntry) + mClusters.capacity() * sizeof(ClusterEntry) + mArena.capacity();
+}
+
+} // namespace app
+} // namespace chip
@@ -0,0 +1,207 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/ConcreteAttributePath.h>
+#include <app/MessageDef/StatusIB.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/core/Optional.h>
+#include <lib/core/TLVReader.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/Span.h>
+
+#include <stdint.h>
+#include <vector>
+
+namespace chip {
+namespace app {
+
+/*
+ * Flat storage for the attribute state of one node, used by ClusterStateCache in StorageMode::kCompact.
+ *
+ * Attributes are kept in a single vector sorted by (endpoint, cluster, attribute), and clusters in a second vector
+ * sorted by (endpoint, cluster). The TLV of every cached attribute value lives in one arena shared by the whole node,
+ * instead of one heap allocation per attribute. Reports list attributes in path order, so the common insertion is an
+ * append at the end of the vectors.
+ *
+ * An attribute value that keeps its encoded size is overwritten in place. Otherwise the new value is appended to the
+ * arena and the old bytes are reclaimed once they make up more than half of it. Either way, any update may move the
+ * arena, so a value read from this storage is only valid until the next update of any attribute.
+ */
+class CompactClusterStateStorage
+{
+public:
+    struct ClusterVersions
+    {
+        Optional<DataVersion> mPendingDataVersion;
+        Optional<DataVersion> mCommittedDataVersion;
+    };
+
+    enum class AttributeKind : uint8_t
+    {
+        kStatus,   // A path-specific status was received for the attribute.
+        kData,     // The attribute value is stored in the arena.
+        kDataSize, // Data was received but not stored; only its size is kept.
+    };
+
+    struct AttributeEntry
+    {
+        ClusterId mClusterId;
+        AttributeId mAttributeId;
+        uint32_t mOffset; // kData only: offset of the value TLV in the arena.
+        uint32_t mLength; // kData and kDataSize: size of the value TLV.
+        EndpointId mEndpointId;
+        AttributeKind mKind;
+        Protocols::InteractionModel::Status mStatus;
+        ClusterStatus mClusterStatus;
+        bool mHasClusterStatus;
+
+        ConcreteAttributePath GetPath() const { return ConcreteAttributePath(mEndpointId, mClusterId, mAttributeId); }
+        StatusIB GetStatus() const;
+    };
+
+    bool HasEndpoint(EndpointId endpointId) const;
+
+    ClusterVersions & GetOrCreateCluster(const ConcreteClusterPath & path);
+    const ClusterVersions * FindCluster(const ConcreteClusterPath & path) const;
+
+    /*
+     * Copy the TLV element the reader is positioned on into the arena as the value of the attribute.
+     */
+    CHIP_ERROR SetData(const ConcreteAttributePath & path, const TLV::TLVReader & data);
+
+    /*
+     * Bound the size of the TLV element the reader is positioned on once copied with an anonymous tag. This only skips
+     * over the element, so it does not depend on how much of the buffer follows it.
+     */
+    static CHIP_ERROR GetMaxElementSize(const TLV::TLVReader & data, size_t & maxSize);
+    void SetStatus(const ConcreteAttributePath & path, const StatusIB & status);
+    void SetDataSize(const ConcreteAttributePath & path, size_t size);
+
+    const AttributeEntry * FindAttribute(const ConcreteAttributePath & path) const;
+
+    /*
+     * The value TLV of an AttributeEntry of kind kData.
+     */
+    ByteSpan GetData(const AttributeEntry & entry) const { return ByteSpan(mArena.data() + entry.mOffset, entry.mLength); }
+
+    void Clear();
+
+    /*
+     * Give back the spare capacity of the vectors and the arena, including the bytes of replaced values.
+     */
+    void ShrinkToFit();
+
+    /*
+     * Bytes reserved by this storage on the heap.
+     */
+    size_t GetHeapSize() const;
+
+    /*
+     * Call func(const AttributeEntry &) for every attribute of a cluster, in attribute ID order.
+     * Returns CHIP_ERROR_KEY_NOT_FOUND if the cluster is not in the storage.
+     */
+    template <typename IteratorFunc>
+    CHIP_ERROR ForEachAttributeEntry(EndpointId endpointId, ClusterId clusterId, IteratorFunc func) const
+    {
+        VerifyOrReturnError(FindCluster(ConcreteClusterPath(endpointId, clusterId)) != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+
+        for (auto it = LowerBound(endpointId, clusterId, 0);
+             it != mAttributes.end() && it->mEndpointId == endpointId && it->mClusterId == clusterId; ++it)
+        {
+            ReturnErrorOnFailure(func(*it));
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    /*
+     * Call func(const AttributeEntry &) for every attribute of the given cluster across all endpoints.
+     */
+    template <typename IteratorFunc>
+    CHIP_ERROR ForEachAttributeEntry(ClusterId clusterId, IteratorFunc func) const
+    {
+        for (const auto & entry : mAttributes)
+        {
+            if (entry.mClusterId == clusterId)
+            {
+                ReturnErrorOnFailure(func(entry));
+            }
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    /*
+     * Call func(const ConcreteClusterPath &, const ClusterVersions &) for every cluster, in path order.
+     */
+    template <typename IteratorFunc>
+    CHIP_ERROR ForEachCluster(IteratorFunc func) const
+    {
+        for (const auto & cluster : mClusters)
+        {
+            ReturnErrorOnFailure(func(ConcreteClusterPath(cluster.mEndpointId, cluster.mClusterId), cluster.mVersions));
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    /*
+     * Call func(ClusterId) for every cluster of an endpoint.
+     */
+    template <typename IteratorFunc>
+    CHIP_ERROR ForEachCluster(EndpointId endpointId, IteratorFunc func) const
+    {
+        for (auto it = LowerBound(endpointId, 0); it != mClusters.end() && it->mEndpointId == endpointId; ++it)
+        {
+            ReturnErrorOnFailure(func(it->mClusterId));
+        }
+        return CHIP_NO_ERROR;
+    }
+
+private:
+    struct ClusterEntry
+    {
+        ClusterId mClusterId;
+        EndpointId mEndpointId;
+        ClusterVersions mVersions;
+    };
+
+    using AttributeIterator = std::vector<AttributeEntry>::const_iterator;
+    using ClusterIterator   = std::vector<ClusterEntry>::const_iterator;
+
+    static uint64_t ClusterKey(EndpointId endpointId, ClusterId clusterId)
+    {
+        return (static_cast<uint64_t>(endpointId) << 32) | clusterId;
+    }
+
+    AttributeIterator LowerBound(EndpointId endpointId, ClusterId clusterId, AttributeId attributeId) const;
+    ClusterIterator LowerBound(EndpointId endpointId, ClusterId clusterId) const;
+
+    // Find the entry for the path, inserting a kDataSize entry of size 0 if there is none.
+    AttributeEntry & GetOrCreateAttribute(const ConcreteAttributePath & path);
+    void ReleaseData(AttributeEntry & entry);
+    void CompactArena();
+
+    std::vector<AttributeEntry> mAttributes;
+    std::vector<ClusterEntry> mClusters;
+    std::vector<uint8_t> mArena;
+    size_t mUnusedArenaBytes = 0;
+};
+
+} // namespace app
+} // namespace chip
@@ -0,0 +1,161 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/FlattenedAttributeTree.h>
+
+#include <lib/core/Optional.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+
+using namespace chip;
+
+// See the note in AttributePathExpandIterator.cpp on why these are declared here instead of including af.h.
+extern uint16_t emberAfEndpointCount();
+extern uint8_t emberAfClusterCount(EndpointId endpoint, bool server);
+extern uint16_t emberAfGetServerAttributeCount(chip::EndpointId endpoint, chip::ClusterId cluster);
+extern chip::EndpointId emberAfEndpointFromIndex(uint16_t index);
+extern Optional<ClusterId> emberAfGetNthClusterId(chip::EndpointId endpoint, uint8_t n, bool server);
+extern Optional<AttributeId> emberAfGetServerAttributeIdByIndex(chip::EndpointId endpoint, chip::ClusterId cluster,
+                                                                uint16_t attributeIndex);
+extern bool emberAfEndpointIndexIsEnabled(uint16_t index);
+extern uint32_t emberAfMetadataStructureGeneration();
+
+namespace chip {
+namespace app {
+
+namespace {
+FlattenedAttributeTree sTree;
+} // namespace
+
+const FlattenedAttributeTree * FlattenedAttributeTree::Current()
+{
+    VerifyOrReturnValue(sTree.mEnabled, nullptr);
+
+    uint32_t generation = emberAfMetadataStructureGeneration();
+    if (!sTree.mValid || sTree.mGeneration != generation)
+    {
+        VerifyOrReturnValue(sTree.Build(generation), nullptr);
+    }
+    return &sTree;
+}
+
+void FlattenedAttributeTree::SetEnabled(bool aEnabled)
+{
+    sTree.mEnabled = aEnabled;
+    if (!aEnabled)
+    {
+        Release();
+    }
+}
+
+void FlattenedAttributeTree::Release()
+{
+    sTree.Free();
+}
+
+void FlattenedAttributeTree::Free()
+{
+    Platform::MemoryFree(mEndpoints);
+    Platform::MemoryFree(mClusters);
+    Platform::MemoryFree(mAttributes);
+    mEndpoints         = nullptr;
+    mClusters          = nullptr;
+    mAttributes        = nullptr;
+    mEndpointCapacity  = 0;
+    mClusterCapacity   = 0;
+    mAttributeCapacity = 0;
+    mEndpointCount     = 0;
+    mValid             = false;
+}
+
+template <typename T>
+bool FlattenedAttributeTree::Reserve(T *& apArray, size_t & aCapacity, size_t aCount)
+{
+    VerifyOrReturnValue(aCount > aCapacity, true);
+
+    size_t newCapacity = aCapacity * 2;
+    if (newCapacity < aCount)
+    {
+        newCapacity = aCount;
+    }
+
+    auto * array = static_cast<T *>(Platform::MemoryRealloc(apArray, newCapacity * sizeof(T)));
+    VerifyOrReturnValue(array != nullptr, false);
+
+    apArray   = array;
+    aCapacity = newCapacity;
+    return true;
+}
+
+bool FlattenedAttributeTree::Build(uint32_t aGeneration)
+{
+    mValid = false;
+
+    uint16_t endpointCount  = emberAfEndpointCount();
+    uint32_t clusterCount   = 0;
+    uint32_t attributeCount = 0;
+
+    if (!Reserve(mEndpoints, mEndpointCapacity, endpointCount))
+    {
+        Free();
+        return false;
+    }
+
+    for (uint16_t endpointIndex = 0; endpointIndex < endpointCount; endpointIndex++)
+    {
+        Endpoint & endpoint    = mEndpoints[endpointIndex];
+        endpoint.mFirstCluster = clusterCount;
+        endpoint.mEnabled      = emberAfEndpointIndexIsEnabled(endpointIndex);
+        endpoint.mId           = endpoint.mEnabled ? emberAfEndpointFromIndex(endpointIndex) : kInvalidEndpointId;
+        endpoint.mClusterCount = endpoint.mEnabled ? emberAfClusterCount(endpoint.mId, true /* server */) : 0;
+
+        if (!Reserve(mClusters, mClusterCapacity, clusterCount + endpoint.mClusterCount))
+        {
+            Free();
+            return false;
+        }
+
+        for (uint8_t clusterIndex = 0; clusterIndex < endpoint.mClusterCount; clusterIndex++)
+        {
+            Cluster & cluster       = mClusters[clusterCount++];
+            cluster.mFirstAttribute = attributeCount;
+            cluster.mId             = emberAfGetNthClusterId(endpoint.mId, clusterIndex, true /* server */).Value();
+            cluster.mAttributeCount = emberAfGetServerAttributeCount(endpoint.mId, cluster.mId);
+
+            if (!Reserve(mAttributes, mAttributeCapacity, attributeCount + cluster.mAttributeCount))
+            {
+                Free();
+                return false;
+            }
+
+            for (uint16_t attributeIndex = 0; attributeIndex < cluster.mAttributeCount; attributeIndex++)
+            {
+                mAttributes[attributeCount++] =
+                    emberAfGetServerAttributeIdByIndex(endpoint.mId, cluster.mId, attributeIndex).Value();
+            }
+        }
+    }
+
+    mEndpointCount = endpointCount;
+    mGeneration    = aGeneration;
+    mValid         = true;
+    return true;
+}
+
+} // namespace app
+} // namespace chip
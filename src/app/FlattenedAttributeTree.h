@@ -0,0 +1,127 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *   Defines a flattened copy of the endpoint / server cluster / attribute ids exposed by the attribute storage, used to expand
+ *   wildcard attribute paths without querying the attribute storage for every emitted path.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/DataModelTypes.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * FlattenedAttributeTree mirrors, in three contiguous arrays, what the attribute storage reports through
+ * emberAfEndpointCount / emberAfEndpointIndexIsEnabled / emberAfEndpointFromIndex / emberAfGetNthClusterId /
+ * emberAfGetServerAttributeIdByIndex.  Endpoints, clusters and attributes are addressed by the same indices as in the attribute
+ * storage.
+ *
+ * The tree is built lazily and tagged with emberAfMetadataStructureGeneration(); it is rebuilt on the first use after the
+ * attribute storage reports a structural change (endpoints added, removed, enabled or disabled).
+ */
+class FlattenedAttributeTree
+{
+public:
+    /**
+     * Returns the tree matching the current attribute storage, building it if needed.
+     *
+     * Returns nullptr when the tree is disabled or could not be allocated, in which case the attribute storage must be queried
+     * directly.
+     */
+    static const FlattenedAttributeTree * Current();
+
+    /**
+     * Enable or disable the use of the tree.  It is enabled by default when CHIP_IM_FLATTENED_ATTRIBUTE_TREE is set.  Disabling
+     * it releases its memory.
+     */
+    static void SetEnabled(bool aEnabled);
+
+    /**
+     * Release the memory of the tree.  It will be rebuilt on the next call to Current().
+     */
+    static void Release();
+
+    uint16_t EndpointCount() const { return mEndpointCount; }
+    bool EndpointIsEnabled(uint16_t aEndpointIndex) const { return mEndpoints[aEndpointIndex].mEnabled; }
+    EndpointId EndpointIdAt(uint16_t aEndpointIndex) const { return mEndpoints[aEndpointIndex].mId; }
+    uint8_t ClusterCount(uint16_t aEndpointIndex) const { return mEndpoints[aEndpointIndex].mClusterCount; }
+
+    ClusterId ClusterIdAt(uint16_t aEndpointIndex, uint8_t aClusterIndex) const
+    {
+        return mClusters[ClusterSlot(aEndpointIndex, aClusterIndex)].mId;
+    }
+
+    uint16_t AttributeCount(uint16_t aEndpointIndex, uint8_t aClusterIndex) const
+    {
+        return mClusters[ClusterSlot(aEndpointIndex, aClusterIndex)].mAttributeCount;
+    }
+
+    AttributeId AttributeIdAt(uint16_t aEndpointIndex, uint8_t aClusterIndex, uint16_t aAttributeIndex) const
+    {
+        return mAttributes[mClusters[ClusterSlot(aEndpointIndex, aClusterIndex)].mFirstAttribute + aAttributeIndex];
+    }
+
+private:
+    struct Endpoint
+    {
+        uint32_t mFirstCluster;
+        EndpointId mId;
+        uint8_t mClusterCount;
+        bool mEnabled;
+    };
+
+    struct Cluster
+    {
+        uint32_t mFirstAttribute;
+        ClusterId mId;
+        uint16_t mAttributeCount;
+    };
+
+    uint32_t ClusterSlot(uint16_t aEndpointIndex, uint8_t aClusterIndex) const
+    {
+        return mEndpoints[aEndpointIndex].mFirstCluster + aClusterIndex;
+    }
+
+    bool Build(uint32_t aGeneration);
+    void Free();
+
+    template <typename T>
+    static bool Reserve(T *& apArray, size_t & aCapacity, size_t aCount);
+
+    Endpoint * mEndpoints     = nullptr;
+    Cluster * mClusters       = nullptr;
+    AttributeId * mAttributes = nullptr;
+    size_t mEndpointCapacity  = 0;
+    size_t mClusterCapacity   = 0;
+    size_t mAttributeCapacity = 0;
+    uint16_t mEndpointCount   = 0;
+    uint32_t mGeneration      = 0;
+    bool mValid               = false;
+    bool mEnabled             = CHIP_IM_FLATTENED_ATTRIBUTE_TREE;
+};
+
+} // namespace app
+} // namespace chip
@@ -0,0 +1,306 @@
+/*
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines a SubscriptionResumptionStorage that keeps an in-memory
+ *      index of the subscriptions persisted by SimpleSubscriptionResumptionStorage.
+ */
+
+#include <app/IndexedSubscriptionResumptionStorage.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/SafeInt.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+namespace chip {
+namespace app {
+
+namespace {
+
+// 64-bit FNV-1a, only used to tell whether a subscription is saved again with the same encoding.
+uint64_t HashEncoding(ByteSpan encoded)
+{
+    uint64_t hash = 0xcbf29ce484222325;
+    for (uint8_t byte : encoded)
+    {
+        hash ^= byte;
+        hash *= 0x100000001b3;
+    }
+    return hash;
+}
+
+} // namespace
+
+IndexedSubscriptionResumptionStorage::IndexedSubscriptionInfoIterator::IndexedSubscriptionInfoIterator(
+    IndexedSubscriptionResumptionStorage & storage) :
+    mStorage(storage)
+{
+    mNextIndex = 0;
+}
+
+size_t IndexedSubscriptionResumptionStorage::IndexedSubscriptionInfoIterator::Count()
+{
+    return static_cast<size_t>(mStorage.IndexedCount());
+}
+
+bool IndexedSubscriptionResumptionStorage::IndexedSubscriptionInfoIterator::Next(SubscriptionInfo & output)
+{
+    for (; mNextIndex < CHIP_IM_MAX_NUM_SUBSCRIPTIONS; mNextIndex++)
+    {
+        if (!mStorage.mIndex[mNextIndex].mInUse)
+        {
+            continue;
+        }
+
+        CHIP_ERROR err = mStorage.LoadIndexed(mNextIndex, output);
+        if (err == CHIP_NO_ERROR)
+        {
+            // increment index for the next call
+            mNextIndex++;
+            return true;
+        }
+
+        ChipLogError(DataManagement, "Failed to load subscription at index %u error %" CHIP_ERROR_FORMAT,
+                     static_cast<unsigned>(mNextIndex), err.Format());
+        mStorage.DeleteIndexed(mNextIndex);
+    }
+
+    return false;
+}
+
+void IndexedSubscriptionResumptionStorage::IndexedSubscriptionInfoIterator::Release()
+{
+    mStorage.mIndexedSubscriptionInfoIterators.ReleaseObject(this);
+}
+
+CHIP_ERROR IndexedSubscriptionResumptionStorage::Init(PersistentStorageDelegate * storage)
+{
+    ReturnErrorOnFailure(SimpleSubscriptionResumptionStorage::Init(storage));
+
+    // Single pass over the persisted subscriptions to build the index
+    for (uint16_t subscriptionIndex = 0; subscriptionIndex < CHIP_IM_MAX_NUM_SUBSCRIPTIONS; subscriptionIndex++)
+    {
+        mIndex[subscriptionIndex].mInUse = false;
+
+        SubscriptionInfo subscriptionInfo;
+        CHIP_ERROR err = LoadIndexed(subscriptionIndex, subscriptionInfo);
+        if (err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND)
+        {
+            continue;
+        }
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(DataManagement, "Failed to load subscription at index %u error %" CHIP_ERROR_FORMAT,
+                         static_cast<unsigned>(subscriptionIndex), err.Format());
+            SimpleSubscriptionResumptionStorage::Delete(subscriptionIndex);
+            continue;
+        }
+
+        // The fingerprint is taken from the re-encoded subscription, so that the next Save() of the same subscription
+        // is recognized as unchanged even if the persisted entry carries fields this version does not know about.
+        Platform::ScopedMemoryBuffer<uint8_t> buffer;
+        uint16_t length = 0;
+        if (Encode(subscriptionInfo, buffer, length) != CHIP_NO_ERROR)
+        {
+            length = 0;
+        }
+        SetIndexEntry(subscriptionIndex, subscriptionInfo, ByteSpan(buffer.Get(), length));
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+SubscriptionResumptionStorage::SubscriptionInfoIterator * IndexedSubscriptionResumptionStorage::IterateSubscriptions()
+{
+    return mIndexedSubscriptionInfoIterators.CreateObject(*this);
+}
+
+uint16_t IndexedSubscriptionResumptionStorage::FindIndex(NodeId nodeId, FabricIndex fabricIndex,
+                                                         SubscriptionId subscriptionId) const
+{
+    for (uint16_t subscriptionIndex = 0; subscriptionIndex < CHIP_IM_MAX_NUM_SUBSCRIPTIONS; subscriptionIndex++)
+    {
+        const IndexEntry & entry = mIndex[subscriptionIndex];
+        if (entry.mInUse && (entry.mNodeId == nodeId) && (entry.mFabricIndex == fabricIndex) &&
+            (entry.mSubscriptionId == subscriptionId))
+        {
+            return subscriptionIndex;
+        }
+    }
+    return kInvalidIndex;
+}
+
+uint16_t IndexedSubscriptionResumptionStorage::FindFreeIndex() const
+{
+    for (uint16_t subscriptionIndex = 0; subscriptionIndex < CHIP_IM_MAX_NUM_SUBSCRIPTIONS; subscriptionIndex++)
+    {
+        if (!mIndex[subscriptionIndex].mInUse)
+        {
+            return subscriptionIndex;
+        }
+    }
+    return kInvalidIndex;
+}
+
+uint16_t IndexedSubscriptionResumptionStorage::IndexedCount() const
+{
+    uint16_t subscriptionCount = 0;
+    for (const auto & entry : mIndex)
+    {
+        if (entry.mInUse)
+        {
+            subscriptionCount++;
+        }
+    }
+    return subscriptionCount;
+}
+
+void IndexedSubscriptionResumptionStorage::SetIndexEntry(uint16_t subscriptionIndex, const SubscriptionInfo & subscriptionInfo,
+                                                         ByteSpan encoded)
+{
+    IndexEntry & entry    = mIndex[subscriptionIndex];
+    entry.mNodeId         = subscriptionInfo.mNodeId;
+    entry.mFabricIndex    = subscriptionInfo.mFabricIndex;
+    entry.mSubscriptionId = subscriptionInfo.mSubscriptionId;
+    entry.mEncodedLength  = static_cast<uint16_t>(encoded.size());
+    entry.mEncodedHash    = HashEncoding(encoded);
+    entry.mInUse          = true;
+}
+
+CHIP_ERROR IndexedSubscriptionResumptionStorage::Encode(SubscriptionInfo & subscriptionInfo,
+                                                        Platform::ScopedMemoryBuffer<uint8_t> & buffer, uint16_t & length)
+{
+    Platform::ScopedMemoryBuffer<uint8_t> backingBuffer;
+    backingBuffer.Calloc(MaxSubscriptionSize());
+    ReturnErrorCodeIf(backingBuffer.Get() == nullptr, CHIP_ERROR_NO_MEMORY);
+
+    TLV::ScopedBufferTLVWriter writer(std::move(backingBuffer), MaxSubscriptionSize());
+
+    ReturnErrorOnFailure(SimpleSubscriptionResumptionStorage::Save(writer, subscriptionInfo));
+
+    const auto len = writer.GetLengthWritten();
+    VerifyOrReturnError(CanCastTo<uint16_t>(len), CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    writer.Finalize(buffer);
+    length = static_cast<uint16_t>(len);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR IndexedSubscriptionResumptionStorage::LoadIndexed(uint16_t subscriptionIndex, SubscriptionInfo & subscriptionInfo)
+{
+    mStats.mStorageReads++;
+    return Load(subscriptionIndex, subscriptionInfo);
+}
+
+CHIP_ERROR IndexedSubscriptionResumptionStorage::DeleteIndexed(uint16_t subscriptionIndex)
+{
+    CHIP_ERROR err = SimpleSubscriptionResumptionStorage::Delete(subscriptionIndex);
+    if (err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND)
+    {
+        err = CHIP_NO_ERROR;
+    }
+    // Keep the entry indexed if it could not be deleted, so that the index still reflects the persistent storage
+    if (err == CHIP_NO_ERROR)
+    {
+        mIndex[subscriptionIndex].mInUse = false;
+    }
+    return err;
+}
+
+CHIP_ERROR IndexedSubscriptionResumptionStorage::Save(SubscriptionInfo & subscriptionInfo)
+{
+    Platform::ScopedMemoryBuffer<uint8_t> buffer;
+    uint16_t length = 0;
+    ReturnErrorOnFailure(Encode(subscriptionInfo, buffer, length));
+    ByteSpan encoded(buffer.Get(), length);
+
+    uint16_t subscriptionIndex =
+        FindIndex(subscriptionInfo.mNodeId, subscriptionInfo.mFabricIndex, subscriptionInfo.mSubscriptionId);
+    if (subscriptionIndex != kInvalidIndex)
+    {
+        // Re-established with the same parameters and paths: what is persisted is already up to date
+        const IndexEntry & entry = mIndex[subscriptionIndex];
+        if ((entry.mEncodedLength == length) && (entry.mEncodedHash == HashEncoding(encoded)))
+        {
+            mStats.mUnchangedSaves++;
+            return CHIP_NO_ERROR;
+        }
+    }
+    else
+    {
+        subscriptionIndex = FindFreeIndex();
+        // Fail if no empty space
+        VerifyOrReturnError(subscriptionIndex != kInvalidIndex, CHIP_ERROR_NO_MEMORY);
+    }
+
+    ReturnErrorOnFailure(mStorage->SyncSetKeyValue(DefaultStorageKeyAllocator::SubscriptionResumption(subscriptionIndex).KeyName(),
+                                                   buffer.Get(), length));
+    mStats.mStorageWrites++;
+
+    SetIndexEntry(subscriptionIndex, subscriptionInfo, encoded);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR IndexedSubscriptionResumptionStorage::Delete(NodeId nodeId, FabricIndex fabricIndex, SubscriptionId subscriptionId)
+{
+    uint16_t subscriptionIndex = FindIndex(nodeId, fabricIndex, subscriptionId);
+    VerifyOrReturnError(subscriptionIndex != kInvalidIndex, CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+
+    CHIP_ERROR err = DeleteIndexed(subscriptionIndex);
+
+    // if there are no persisted subscriptions, the MaxCount can also be deleted
+    if (IndexedCount() == 0)
+    {
+        DeleteMaxCount();
+    }
+
+    return err;
+}
+
+CHIP_ERROR IndexedSubscriptionResumptionStorage::DeleteAll(FabricIndex fabricIndex)
+{
+    CHIP_ERROR deleteErr = CHIP_NO_ERROR;
+
+    for (uint16_t subscriptionIndex = 0; subscriptionIndex < CHIP_IM_MAX_NUM_SUBSCRIPTIONS; subscriptionIndex++)
+    {
+        if (mIndex[subscriptionIndex].mInUse && (mIndex[subscriptionIndex].mFabricIndex == fabricIndex))
+        {
+            CHIP_ERROR err = DeleteIndexed(subscriptionIndex);
+            if (err != CHIP_NO_ERROR)
+            {
+                deleteErr = err;
+            }
+        }
+    }
+
+    // if there are no persisted subscriptions, the MaxCount can also be deleted
+    if (IndexedCount() == 0)
+    {
+        CHIP_ERROR err = DeleteMaxCount();
+
+        if ((err != CHIP_NO_ERROR) && (err != CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND))
+        {
+            deleteErr = err;
+        }
+    }
+
+    return deleteErr;
+}
+
+} // namespace app
+} // namespace chip
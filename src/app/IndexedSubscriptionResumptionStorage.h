@@ -0,0 +1,107 @@
+/*
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines a SubscriptionResumptionStorage that keeps an in-memory
+ *      index of the subscriptions persisted by SimpleSubscriptionResumptionStorage.
+ */
+
+#pragma once
+
+#include <app/SimpleSubscriptionResumptionStorage.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * A SimpleSubscriptionResumptionStorage that reads every persisted subscription once in Init() and remembers which
+ * storage index holds which subscription, together with a fingerprint of its encoding.
+ *
+ * With the index, Save() writes a single key and skips the write entirely when the subscription is re-established
+ * with the same parameters and paths; Delete() and DeleteAll() only delete the matching keys; and iterating only reads
+ * the indices that hold a subscription. None of them has to read every index of the persistent storage.
+ *
+ * The storage keys and TLV layout are the ones of SimpleSubscriptionResumptionStorage, so either implementation can
+ * read subscriptions persisted by the other. The persistent storage must not be modified behind this object's back
+ * after Init().
+ */
+class IndexedSubscriptionResumptionStorage : public SimpleSubscriptionResumptionStorage
+{
+public:
+    struct Stats
+    {
+        uint32_t mStorageReads   = 0; /**< Subscription entries read from the persistent storage. */
+        uint32_t mStorageWrites  = 0; /**< Subscriptions written to the persistent storage. */
+        uint32_t mUnchangedSaves = 0; /**< Saves skipped because the persisted subscription was already up to date. */
+    };
+
+    CHIP_ERROR Init(PersistentStorageDelegate * storage);
+
+    SubscriptionInfoIterator * IterateSubscriptions() override;
+
+    CHIP_ERROR Save(SubscriptionInfo & subscriptionInfo) override;
+
+    CHIP_ERROR Delete(NodeId nodeId, FabricIndex fabricIndex, SubscriptionId subscriptionId) override;
+
+    CHIP_ERROR DeleteAll(FabricIndex fabricIndex) override;
+
+    const Stats & GetStats() const { return mStats; }
+    void ResetStats() { mStats = Stats(); }
+
+protected:
+    class IndexedSubscriptionInfoIterator : public SubscriptionInfoIterator
+    {
+    public:
+        IndexedSubscriptionInfoIterator(IndexedSubscriptionResumptionStorage & storage);
+        size_t Count() override;
+        bool Next(SubscriptionInfo & output) override;
+        void Release() override;
+
+    private:
+        IndexedSubscriptionResumptionStorage & mStorage;
+        uint16_t mNextIndex;
+    };
+
+private:
+    struct IndexEntry
+    {
+        NodeId mNodeId;
+        SubscriptionId mSubscriptionId;
+        FabricIndex mFabricIndex;
+        bool mInUse = false;
+        uint16_t mEncodedLength;
+        uint64_t mEncodedHash;
+    };
+
+    static constexpr uint16_t kInvalidIndex = CHIP_IM_MAX_NUM_SUBSCRIPTIONS;
+
+    uint16_t FindIndex(NodeId nodeId, FabricIndex fabricIndex, SubscriptionId subscriptionId) const;
+    uint16_t FindFreeIndex() const;
+    uint16_t IndexedCount() const;
+    void SetIndexEntry(uint16_t subscriptionIndex, const SubscriptionInfo & subscriptionInfo, ByteSpan encoded);
+    CHIP_ERROR Encode(SubscriptionInfo & subscriptionInfo, Platform::ScopedMemoryBuffer<uint8_t> & buffer, uint16_t & length);
+    CHIP_ERROR LoadIndexed(uint16_t subscriptionIndex, SubscriptionInfo & subscriptionInfo);
+    CHIP_ERROR DeleteIndexed(uint16_t subscriptionIndex);
+
+    IndexEntry mIndex[CHIP_IM_MAX_NUM_SUBSCRIPTIONS];
+    ObjectPool<IndexedSubscriptionInfoIterator, kIteratorsMax> mIndexedSubscriptionInfoIterators;
+    Stats mStats;
+};
+
+} // namespace app
+} // namespace chip
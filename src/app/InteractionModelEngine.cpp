@@ -25,10 +25,12 @@
 
 #include "InteractionModelEngine.h"
 
+#include <algorithm>
 #include <cinttypes>
 
 #include "access/RequestPath.h"
 #include "access/SubjectDescriptor.h"
+#include <app/FlattenedAttributeTree.h>
 #include <app/RequiredPrivilege.h>
 #include <app/util/af-types.h>
 #include <app/util/endpoint-config-api.h>
@@ -104,6 +106,8 @@ void InteractionModelEngine::Shutdown()
     mTimedHandlers.ReleaseAll();
 
     mReadHandlers.ReleaseAll();
+    mReadHandlerInterestIndex.ReleaseAll();
+    FlattenedAttributeTree::Release();
 
     // Shut down any subscription clients that are still around.  They won't be
     // able to work after this point anyway, since we're about to drop our refs
@@ -1455,6 +1459,23 @@ void InteractionModelEngine::RemoveDuplicateConcreteAttributePath(ObjectList<Att
     }
 }
 
+CHIP_ERROR InteractionModelEngine::AddReadHandlerInterest(ReadHandler & aReadHandler)
+{
+    mReadHandlerInterestIndex.Remove(aReadHandler);
+    CHIP_ERROR err = mReadHandlerInterestIndex.Add(aReadHandler, aReadHandler.GetAttributePathList());
+    if (err == CHIP_ERROR_NO_MEMORY)
+    {
+        ChipLogError(InteractionModel, "ReadHandler interest index full");
+        return CHIP_IM_GLOBAL_STATUS(PathsExhausted);
+    }
+    return err;
+}
+
+void InteractionModelEngine::RemoveReadHandlerInterest(const ReadHandler & aReadHandler)
+{
+    mReadHandlerInterestIndex.Remove(aReadHandler);
+}
+
 void InteractionModelEngine::ReleaseEventPathList(ObjectList<EventPathParams> *& aEventPathList)
 {
     ReleasePool(aEventPathList, mEventPathPool);
@@ -1794,20 +1815,33 @@ void InteractionModelEngine::ResumeSubscriptionsTimerCallback(System::Layer * ap
 #if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
     VerifyOrReturn(apAppState != nullptr);
     InteractionModelEngine * imEngine = static_cast<InteractionModelEngine *>(apAppState);
+
+    // If subscription happens between reboot and this timer callback, it's already live and should skip resumption.
+    // Collect the live subscription IDs once, so that resuming stays linear in the number of persisted subscriptions.
+    Platform::ScopedMemoryBufferWithSize<SubscriptionId> liveSubscriptionIds;
+    size_t liveSubscriptionCount = 0;
+    if (imEngine->mReadHandlers.Allocated() > 0)
+    {
+        liveSubscriptionIds.Calloc(imEngine->mReadHandlers.Allocated());
+        VerifyOrReturn(liveSubscriptionIds.Get() != nullptr,
+                       ChipLogError(InteractionModel, "no memory for Subscription resumption"));
+        imEngine->mReadHandlers.ForEachActiveObject([&](ReadHandler * handler) {
+            if (handler->IsType(ReadHandler::InteractionType::Subscribe) &&
+                liveSubscriptionCount < liveSubscriptionIds.AllocatedSize())
+            {
+                handler->GetSubscriptionId(liveSubscriptionIds[liveSubscriptionCount++]);
+            }
+            return Loop::Continue;
+        });
+        std::sort(liveSubscriptionIds.Get(), liveSubscriptionIds.Get() + liveSubscriptionCount);
+    }
+
     SubscriptionResumptionStorage::SubscriptionInfo subscriptionInfo;
     auto * iterator = imEngine->mpSubscriptionResumptionStorage->IterateSubscriptions();
     while (iterator->Next(subscriptionInfo))
     {
-        // If subscription happens between reboot and this timer callback, it's already live and should skip resumption
-        if (Loop::Break == imEngine->mReadHandlers.ForEachActiveObject([&](ReadHandler * handler) {
-                SubscriptionId subscriptionId;
-                handler->GetSubscriptionId(subscriptionId);
-                if (subscriptionId == subscriptionInfo.mSubscriptionId)
-                {
-                    return Loop::Break;
-                }
-                return Loop::Continue;
-            }))
+        if (std::binary_search(liveSubscriptionIds.Get(), liveSubscriptionIds.Get() + liveSubscriptionCount,
+                               subscriptionInfo.mSubscriptionId))
         {
             ChipLogProgress(InteractionModel, "Skip resuming live subscriptionId %" PRIu32, subscriptionInfo.mSubscriptionId);
             continue;
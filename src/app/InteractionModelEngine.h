@@ -57,6 +57,7 @@
 #include <app/WriteClient.h>
 #include <app/WriteHandler.h>
 #include <app/reporting/Engine.h>
+#include <app/reporting/ReadHandlerInterestIndex.h>
 #include <app/util/attribute-metadata.h>
 #include <app/util/basic-types.h>
 
@@ -187,6 +188,17 @@ public:
     // the path SHALL be removed from the list.
     void RemoveDuplicateConcreteAttributePath(ObjectList<AttributePathParams> *& aAttributePaths);
 
+    /**
+     * Index the attribute paths of the given ReadHandler, so that marking an intersecting path dirty notifies it.  Must be
+     * called once the attribute path list of the handler is final; calling it again re-indexes the current list.
+     */
+    CHIP_ERROR AddReadHandlerInterest(ReadHandler & aReadHandler);
+
+    /**
+     * Remove the attribute paths of the given ReadHandler from the index.  Must be called before its path list is released.
+     */
+    void RemoveReadHandlerInterest(const ReadHandler & aReadHandler);
+
     void ReleaseEventPathList(ObjectList<EventPathParams> *& aEventPathList);
 
     CHIP_ERROR PushFrontEventPathParamsList(ObjectList<EventPathParams> *& aEventPathList, EventPathParams & aEventPath);
@@ -594,6 +606,9 @@ private:
 
     ObjectPool<ReadHandler, CHIP_IM_MAX_NUM_READS + CHIP_IM_MAX_NUM_SUBSCRIPTIONS> mReadHandlers;
 
+    // The ReadHandlers interested in each attribute path, used by reporting::Engine::SetDirty.
+    reporting::ReadHandlerInterestIndex mReadHandlerInterestIndex;
+
     ReadClient * mpActiveReadClientList = nullptr;
 
     ReadHandler::ApplicationCallback * mpReadHandlerApplicationCallback = nullptr;
@@ -32,6 +32,7 @@
 #include <lib/support/FibonacciUtils.h>
 #include <messaging/ReliableMessageMgr.h>
 #include <messaging/ReliableMessageProtocolConfig.h>
+#include <tracing/macros.h>
 
 namespace chip {
 namespace app {
@@ -60,6 +61,7 @@ ReadClient::ReadClient(InteractionModelEngine * apImEngine, Messaging::ExchangeM
 void ReadClient::ClearActiveSubscriptionState()
 {
     mIsReporting                  = false;
+    mIsStreamingList              = false;
     mWaitingForFirstPrimingReport = true;
     mPendingMoreChunks            = false;
     mMinIntervalFloorSeconds      = 0;
@@ -248,6 +250,7 @@ CHIP_ERROR ReadClient::SendRequest(ReadPrepareParams & aReadPrepareParams)
 
 CHIP_ERROR ReadClient::SendReadRequest(ReadPrepareParams & aReadPrepareParams)
 {
+    MATTER_TRACE_SCOPE("SendReadRequest", "ReadClient");
     CHIP_ERROR err = CHIP_NO_ERROR;
 
     ChipLogDetail(DataManagement, "%s ReadClient[%p]: Sending Read Request", __func__, this);
@@ -506,6 +509,7 @@ void ReadClient::OnUnsolicitedReportData(Messaging::ExchangeContext * apExchange
 
 CHIP_ERROR ReadClient::ProcessReportData(System::PacketBufferHandle && aPayload, ReportType aReportType)
 {
+    MATTER_TRACE_SCOPE("ProcessReportData", "ReadClient");
     CHIP_ERROR err = CHIP_NO_ERROR;
     ReportDataMessage::Parser report;
     bool suppressResponse         = true;
@@ -594,6 +598,7 @@ CHIP_ERROR ReadClient::ProcessReportData(System::PacketBufferHandle && aPayload,
 
     if (mIsReporting && !mPendingMoreChunks)
     {
+        EndStreamingList();
         mpCallback.OnReportEnd();
         mIsReporting = false;
     }
@@ -650,7 +655,50 @@ void ReadClient::NoteReportingData()
     if (!mIsReporting)
     {
         mpCallback.OnReportBegin();
-        mIsReporting = true;
+        mIsReporting     = true;
+        mIsStreamingList = false;
+    }
+}
+
+CHIP_ERROR ReadClient::StreamListAttributeData(const ConcreteDataAttributePath & aPath, TLV::TLVReader & aDataReader)
+{
+    // Chunked lists arrive as a ReplaceAll followed by AppendItem reports for the same path, which continue the open list.
+    if (aPath.mListOp == ConcreteDataAttributePath::ListOperation::ReplaceAll || !mIsStreamingList || mStreamingListPath != aPath)
+    {
+        EndStreamingList();
+        mStreamingListPath = aPath;
+        mIsStreamingList   = true;
+        mpCallback.OnListAttributeBegin(aPath);
+    }
+
+    if (aPath.mListOp == ConcreteDataAttributePath::ListOperation::AppendItem)
+    {
+        mpCallback.OnListAttributeItem(aPath, aDataReader);
+        return CHIP_NO_ERROR;
+    }
+
+    ConcreteDataAttributePath itemPath = aPath;
+    itemPath.mListOp                   = ConcreteDataAttributePath::ListOperation::AppendItem;
+
+    CHIP_ERROR err;
+    TLV::TLVType containerType;
+    ReturnErrorOnFailure(aDataReader.EnterContainer(containerType));
+    while (CHIP_NO_ERROR == (err = aDataReader.Next()))
+    {
+        // Hand out a copy so that the callback is free to descend into the item.
+        TLV::TLVReader itemReader = aDataReader;
+        mpCallback.OnListAttributeItem(itemPath, itemReader);
+    }
+    VerifyOrReturnError(CHIP_END_OF_TLV == err, err);
+    return aDataReader.ExitContainer(containerType);
+}
+
+void ReadClient::EndStreamingList()
+{
+    if (mIsStreamingList)
+    {
+        mIsStreamingList = false;
+        mpCallback.OnListAttributeEnd(mStreamingListPath);
     }
 }
 
@@ -679,6 +727,7 @@ CHIP_ERROR ReadClient::ProcessAttributeReportIBs(TLV::TLVReader & aAttributeRepo
             ReturnErrorOnFailure(status.GetErrorStatus(&errorStatus));
             ReturnErrorOnFailure(errorStatus.DecodeStatusIB(statusIB));
             NoteReportingData();
+            EndStreamingList();
             mpCallback.OnAttributeData(attributePath, nullptr, statusIB);
         }
         else if (CHIP_END_OF_TLV == err)
@@ -705,7 +754,17 @@ CHIP_ERROR ReadClient::ProcessAttributeReportIBs(TLV::TLVReader & aAttributeRepo
             }
 
             NoteReportingData();
-            mpCallback.OnAttributeData(attributePath, &dataReader, statusIB);
+            if ((attributePath.mListOp == ConcreteDataAttributePath::ListOperation::ReplaceAll ||
+                 attributePath.mListOp == ConcreteDataAttributePath::ListOperation::AppendItem) &&
+                mpCallback.IsListItemStreamingEnabled())
+            {
+                ReturnErrorOnFailure(StreamListAttributeData(attributePath, dataReader));
+            }
+            else
+            {
+                EndStreamingList();
+                mpCallback.OnAttributeData(attributePath, &dataReader, statusIB);
+            }
         }
     }
 
@@ -950,6 +1009,7 @@ CHIP_ERROR ReadClient::SendSubscribeRequest(const ReadPrepareParams & aReadPrepa
 
 CHIP_ERROR ReadClient::SendSubscribeRequestImpl(const ReadPrepareParams & aReadPrepareParams)
 {
+    MATTER_TRACE_SCOPE("SendSubscribeRequest", "ReadClient");
     VerifyOrReturnError(ClientState::Idle == mState, CHIP_ERROR_INCORRECT_STATE);
 
     if (&aReadPrepareParams != &mReadPrepareParams)
@@ -126,6 +126,52 @@ public:
          */
         virtual void OnAttributeData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData, const StatusIB & aStatus) {}
 
+        /**
+         * Used to opt into receiving list attributes one item at a time through OnListAttributeBegin, OnListAttributeItem
+         * and OnListAttributeEnd, instead of as whole lists and appended items through OnAttributeData.
+         *
+         * Items are handed out straight from the received report, so a list of any length, chunked or not, can be consumed
+         * without being copied or reassembled. Consumers that need a whole list at once should keep using BufferedReadCallback.
+         *
+         * Non-list attribute data and attribute statuses are still delivered through OnAttributeData.
+         *
+         * The returned value must not change for the lifetime of the ReadClient.
+         */
+        virtual bool IsListItemStreamingEnabled() { return false; }
+
+        /**
+         * Used to signal the start of a list attribute when list item streaming is enabled. The items follow through
+         * OnListAttributeItem, and OnListAttributeEnd is called once the last of them has been delivered, even when the list
+         * spans several chunked reports.
+         *
+         * aPath.mListOp is ReplaceAll when the received items replace the current content of the list. It is AppendItem in the
+         * unusual case where the publisher appends to a list without first replacing it within the same report.
+         *
+         * @param[in] aPath        The attribute path field in report response, including the data version.
+         */
+        virtual void OnListAttributeBegin(const ConcreteDataAttributePath & aPath) {}
+
+        /**
+         * Used to deliver a single list item when list item streaming is enabled.
+         *
+         * The reader points into the received message and is only valid for the duration of this call.
+         *
+         * @param[in] aPath        The attribute path of the list, with mListOp set to AppendItem.
+         * @param[in] aItem        A TLVReader positioned right on the item.
+         */
+        virtual void OnListAttributeItem(const ConcreteDataAttributePath & aPath, TLV::TLVReader & aItem) {}
+
+        /**
+         * Used to signal that all the items of a list attribute have been delivered. This is called before any data for
+         * another attribute is delivered and before OnReportEnd.
+         *
+         * If OnError is called while a list is being delivered, OnListAttributeEnd is not called for that list and the items
+         * received so far should be discarded.
+         *
+         * @param[in] aPath        The attribute path that was passed to OnListAttributeBegin.
+         */
+        virtual void OnListAttributeEnd(const ConcreteDataAttributePath & aPath) {}
+
         /**
          * OnSubscriptionEstablished will be called when a subscription is established for the given subscription transaction.
          * If using auto resubscription, OnSubscriptionEstablished will be called whenever resubscription is established.
@@ -518,6 +564,11 @@ private:
     // Called to ensure OnReportBegin is called before calling OnEventData or OnAttributeData
     void NoteReportingData();
 
+    // Delivers list data item by item to a callback that has list item streaming enabled.
+    CHIP_ERROR StreamListAttributeData(const ConcreteDataAttributePath & aPath, TLV::TLVReader & aDataReader);
+    // Called to ensure OnListAttributeEnd is called for a streamed list before delivering anything else.
+    void EndStreamingList();
+
     /*
      * Called internally to signal the completion of all work on this object, gracefully close the
      * exchange and finally, signal to the application that it's
@@ -554,6 +605,10 @@ private:
     InteractionType mInteractionType = InteractionType::Read;
     Timestamp mEventTimestamp;
 
+    // Whether a streamed list is waiting for OnListAttributeEnd, and the path it was started with.
+    bool mIsStreamingList = false;
+    ConcreteDataAttributePath mStreamingListPath;
+
     bool mForceCaseOnNextResub      = true;
     bool mIsResubscriptionScheduled = false;
 
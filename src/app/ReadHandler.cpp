@@ -30,6 +30,7 @@
 #include <app/MessageDef/SubscribeResponseMessage.h>
 #include <lib/core/TLVUtilities.h>
 #include <messaging/ExchangeContext.h>
+#include <tracing/macros.h>
 
 #include <app/ReadHandler.h>
 #include <app/reporting/Engine.h>
@@ -117,6 +118,11 @@ void ReadHandler::ResumeSubscription(CASESessionManager & caseSessionManager,
             return;
         }
     }
+    if (InteractionModelEngine::GetInstance()->AddReadHandlerInterest(*this) != CHIP_NO_ERROR)
+    {
+        Close();
+        return;
+    }
     for (size_t i = 0; i < subscriptionInfo.mEventPaths.AllocatedSize(); i++)
     {
         EventPathParams eventPathParams = subscriptionInfo.mEventPaths[i].GetParams();
@@ -163,6 +169,7 @@ ReadHandler::~ReadHandler()
     {
         InteractionModelEngine::GetInstance()->GetReportingEngine().OnReportConfirm();
     }
+    InteractionModelEngine::GetInstance()->RemoveReadHandlerInterest(*this);
     InteractionModelEngine::GetInstance()->ReleaseAttributePathList(mpAttributePathList);
     InteractionModelEngine::GetInstance()->ReleaseEventPathList(mpEventPathList);
     InteractionModelEngine::GetInstance()->ReleaseDataVersionFilterList(mpDataVersionFilterList);
@@ -186,6 +193,7 @@ void ReadHandler::Close(CloseOptions options)
 
 void ReadHandler::OnInitialRequest(System::PacketBufferHandle && aPayload)
 {
+    MATTER_TRACE_SCOPE("OnInitialRequest", "ReadHandler");
     CHIP_ERROR err = CHIP_NO_ERROR;
     System::PacketBufferHandle response;
 
@@ -301,6 +309,7 @@ CHIP_ERROR ReadHandler::SendStatusReport(Protocols::InteractionModel::Status aSt
 
 CHIP_ERROR ReadHandler::SendReportData(System::PacketBufferHandle && aPayload, bool aMoreChunks)
 {
+    MATTER_TRACE_SCOPE("SendReportData", "ReadHandler");
     VerifyOrReturnLogError(IsReportableNow(), CHIP_ERROR_INCORRECT_STATE);
     VerifyOrDie(!IsAwaitingReportResponse()); // Should not be reportable!
     if (IsPriming() || IsChunkedReport())
@@ -511,7 +520,7 @@ CHIP_ERROR ReadHandler::ProcessAttributePaths(AttributePathIBs::Parser & aAttrib
     {
         InteractionModelEngine::GetInstance()->RemoveDuplicateConcreteAttributePath(mpAttributePathList);
         mAttributePathExpandIterator = AttributePathExpandIterator(mpAttributePathList);
-        err                          = CHIP_NO_ERROR;
+        err                          = InteractionModelEngine::GetInstance()->AddReadHandlerInterest(*this);
     }
     return err;
 }
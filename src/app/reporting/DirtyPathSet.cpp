@@ -0,0 +1,257 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/reporting/DirtyPathSet.h>
+#include <app/reporting/SortedAttributePaths.h>
+
+#include <lib/support/CHIPMem.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <algorithm>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+using namespace internal;
+
+DirtyPathSetBase::~DirtyPathSetBase()
+{
+    if (mUseHeap && mEntries != nullptr)
+    {
+        Platform::MemoryFree(mEntries);
+        mEntries = nullptr;
+    }
+}
+
+size_t DirtyPathSetBase::LowerBound(const AttributePathParams & aPath) const
+{
+    return static_cast<size_t>(std::lower_bound(mEntries, mEntries + mCount, aPath, PathLess) - mEntries);
+}
+
+bool DirtyPathSetBase::Find(const AttributePathParams & aPath, size_t & aIndex) const
+{
+    aIndex = LowerBound(aPath);
+    return aIndex < mCount && !PathLess(aPath, mEntries[aIndex]);
+}
+
+bool DirtyPathSetBase::IsDirtySince(const ConcreteAttributePath & aPath, uint64_t aGeneration) const
+{
+    return IntersectsSince(AttributePathParams(aPath.mEndpointId, aPath.mClusterId, aPath.mAttributeId), aGeneration);
+}
+
+bool DirtyPathSetBase::IntersectsSince(const AttributePathParams & aPath, uint64_t aGeneration) const
+{
+    return ForEachIntersectingPath(mEntries, mEntries + mCount, aPath, [aGeneration](const Entry & entry) {
+               return entry.mGeneration > aGeneration ? Loop::Break : Loop::Continue;
+           }) == Loop::Break;
+}
+
+bool DirtyPathSetBase::IntersectsSince(const ObjectList<AttributePathParams> * aPathList, uint64_t aGeneration) const
+{
+    for (auto path = aPathList; path != nullptr; path = path->mpNext)
+    {
+        if (IntersectsSince(path->mValue, aGeneration))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void DirtyPathSetBase::InsertAt(size_t aIndex, const AttributePathParams & aPath, uint64_t aGeneration)
+{
+    VerifyOrDie(HasRoom() && aIndex <= mCount);
+
+    std::move_backward(mEntries + aIndex, mEntries + mCount, mEntries + mCount + 1);
+    mEntries[aIndex]             = aPath;
+    mEntries[aIndex].mGeneration = aGeneration;
+    mCount++;
+}
+
+bool DirtyPathSetBase::RemoveSubsetsOf(const AttributePathParams & aPath)
+{
+    // The paths covered by aPath share its leading concrete components.
+    auto range = SubsetCandidateRange(mEntries, mEntries + mCount, aPath);
+
+    size_t begin = static_cast<size_t>(range.first - mEntries);
+    size_t end   = static_cast<size_t>(range.second - mEntries);
+    size_t kept  = begin;
+    for (size_t i = begin; i < end; i++)
+    {
+        if (!aPath.IsAttributePathSupersetOf(mEntries[i]))
+        {
+            mEntries[kept++] = mEntries[i];
+        }
+    }
+
+    VerifyOrReturnValue(kept != end, false);
+
+    std::move(mEntries + end, mEntries + mCount, mEntries + kept);
+    mCount -= end - kept;
+    return true;
+}
+
+bool DirtyPathSetBase::MergeOverlappedPath(const AttributePathParams & aPath, uint64_t aGeneration)
+{
+    AttributePathParams path = aPath;
+    path.mListIndex          = kInvalidListIndex;
+
+    // Look for a path covering the new path: it can only be the new path itself with some of its concrete components replaced
+    // by wildcards.
+    for (uint8_t mask = 0; mask < (1 << kLevelCount); mask++)
+    {
+        AttributePathParams candidate = path;
+        bool skip                     = false;
+        if (mask & (1 << kEndpointLevel))
+        {
+            skip = skip || candidate.HasWildcardEndpointId();
+            candidate.SetWildcardEndpointId();
+        }
+        if (mask & (1 << kClusterLevel))
+        {
+            skip = skip || candidate.HasWildcardClusterId();
+            candidate.SetWildcardClusterId();
+        }
+        if (mask & (1 << kAttributeLevel))
+        {
+            skip = skip || candidate.HasWildcardAttributeId();
+            candidate.SetWildcardAttributeId();
+        }
+        if (skip)
+        {
+            // Already covered by a mask that leaves this component alone.
+            continue;
+        }
+
+        size_t index;
+        if (Find(candidate, index))
+        {
+            mEntries[index].mGeneration = aGeneration;
+            return true;
+        }
+    }
+
+    // Look for paths covered by the new path, they are all replaced by it.
+    if (path.IsWildcardPath() && RemoveSubsetsOf(path))
+    {
+        InsertAt(LowerBound(path), path, aGeneration);
+        return true;
+    }
+
+    return false;
+}
+
+bool DirtyPathSetBase::Grow()
+{
+    VerifyOrReturnValue(mUseHeap, false);
+
+    size_t newCapacity = (mEntries == nullptr) ? mCapacity : mCapacity * 2;
+    VerifyOrReturnValue(newCapacity > 0, false);
+
+    auto * entries = static_cast<Entry *>(Platform::MemoryRealloc(mEntries, newCapacity * sizeof(Entry)));
+    VerifyOrReturnValue(entries != nullptr, false);
+
+    mEntries  = entries;
+    mCapacity = newCapacity;
+    return true;
+}
+
+bool DirtyPathSetBase::MergePathsUnderSameCluster()
+{
+    size_t kept = 0;
+    for (size_t i = 0; i < mCount;)
+    {
+        Entry merged = mEntries[i];
+        size_t next  = i + 1;
+        if (!merged.HasWildcardClusterId())
+        {
+            for (; next < mCount && mEntries[next].mEndpointId == merged.mEndpointId &&
+                 mEntries[next].mClusterId == merged.mClusterId;
+                 next++)
+            {
+                merged.mGeneration = std::max(merged.mGeneration, mEntries[next].mGeneration);
+                merged.SetWildcardAttributeId();
+            }
+        }
+        mEntries[kept++] = merged;
+        i                = next;
+    }
+
+    VerifyOrReturnValue(kept != mCount, false);
+    mCount = kept;
+    return true;
+}
+
+bool DirtyPathSetBase::MergePathsUnderSameEndpoint()
+{
+    size_t kept = 0;
+    for (size_t i = 0; i < mCount;)
+    {
+        Entry merged = mEntries[i];
+        size_t next  = i + 1;
+        if (!merged.HasWildcardEndpointId())
+        {
+            for (; next < mCount && mEntries[next].mEndpointId == merged.mEndpointId; next++)
+            {
+                merged.mGeneration = std::max(merged.mGeneration, mEntries[next].mGeneration);
+                merged.SetWildcardClusterId();
+                merged.SetWildcardAttributeId();
+            }
+        }
+        mEntries[kept++] = merged;
+        i                = next;
+    }
+
+    VerifyOrReturnValue(kept != mCount, false);
+    mCount = kept;
+    return true;
+}
+
+CHIP_ERROR DirtyPathSetBase::Insert(const AttributePathParams & aPath, uint64_t aGeneration)
+{
+    AttributePathParams path = aPath;
+    path.mListIndex          = kInvalidListIndex;
+
+    ReturnErrorCodeIf(MergeOverlappedPath(path, aGeneration), CHIP_NO_ERROR);
+
+    if (!HasRoom() && !Grow() && !MergePathsUnderSameCluster() && !MergePathsUnderSameEndpoint())
+    {
+        ChipLogDetail(DataManagement, "Global dirty set pool exhausted, merge all paths.");
+        mCount = 0;
+        VerifyOrReturnError(HasRoom(), CHIP_ERROR_NO_MEMORY);
+        InsertAt(0, AttributePathParams(), aGeneration);
+    }
+
+    ReturnErrorCodeIf(MergeOverlappedPath(path, aGeneration), CHIP_NO_ERROR);
+    ChipLogDetail(DataManagement, "Cannot merge the new path into any existing path, create one.");
+
+    if (!HasRoom())
+    {
+        // This should not happen, this path should be merged into the wildcard endpoint at least.
+        ChipLogError(DataManagement, "mGlobalDirtySet pool full, cannot handle more entries!");
+        return CHIP_ERROR_NO_MEMORY;
+    }
+
+    InsertAt(LowerBound(path), path, aGeneration);
+    return CHIP_NO_ERROR;
+}
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
@@ -0,0 +1,184 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/AttributePathParams.h>
+#include <app/ConcreteAttributePath.h>
+#include <app/ObjectList.h>
+#include <lib/core/CHIPError.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/Pool.h>
+#include <system/SystemConfig.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+struct AttributePathParamsWithGeneration : public AttributePathParams
+{
+    AttributePathParamsWithGeneration() {}
+    AttributePathParamsWithGeneration(const AttributePathParams aPath) : AttributePathParams(aPath) {}
+    uint64_t mGeneration = 0;
+};
+
+/**
+ * @brief
+ *   The set of attribute paths that have been marked dirty, indexed by (endpoint, cluster, attribute).
+ *
+ *   Paths are kept sorted by endpoint, then cluster, then attribute id.  Wildcards compare greater than any concrete id, so
+ *   all paths under a given endpoint (or endpoint + cluster) form a contiguous range, followed by the wildcard entries for
+ *   that level.  This lets the reporting engine answer "is this concrete path dirty" with a handful of binary searches
+ *   instead of a scan of the whole set.
+ *
+ *   The set never contains two paths where one is a superset of the other: inserting a path that is already covered only
+ *   bumps the generation of the covering path, and inserting a wildcard path absorbs every path it covers.
+ *
+ *   List indices are not tracked, since a dirty list item always results in the whole attribute being reported.
+ *
+ *   Paths are only coarsened (merged by cluster, then by endpoint, then into a single wildcard path) when the storage is
+ *   exhausted and cannot grow.
+ */
+class DirtyPathSetBase
+{
+public:
+    DirtyPathSetBase(const DirtyPathSetBase &) = delete;
+    DirtyPathSetBase & operator=(const DirtyPathSetBase &) = delete;
+
+    size_t Allocated() const { return mCount; }
+    bool IsEmpty() const { return mCount == 0; }
+    void ReleaseAll() { mCount = 0; }
+
+    /**
+     * Mark the given path dirty at the given generation.
+     *
+     * @retval #CHIP_NO_ERROR On success, including when the path has been merged into an existing one.
+     */
+    CHIP_ERROR Insert(const AttributePathParams & aPath, uint64_t aGeneration);
+
+    /**
+     * If the given path is covered by a path of the set, or covers paths of the set, merge it into the set and update the
+     * generation of the resulting path.
+     *
+     * Returns whether the path has been merged.  When false is returned, the set is left untouched.
+     */
+    bool MergeOverlappedPath(const AttributePathParams & aPath, uint64_t aGeneration);
+
+    /**
+     * Returns whether the given concrete path is covered by a path that was marked dirty after aGeneration.
+     */
+    bool IsDirtySince(const ConcreteAttributePath & aPath, uint64_t aGeneration) const;
+
+    /**
+     * Returns whether the given (possibly wildcard) path intersects a path that was marked dirty after aGeneration.
+     */
+    bool IntersectsSince(const AttributePathParams & aPath, uint64_t aGeneration) const;
+
+    /**
+     * Returns whether any path of the given list intersects a path that was marked dirty after aGeneration.
+     */
+    bool IntersectsSince(const ObjectList<AttributePathParams> * aPathList, uint64_t aGeneration) const;
+
+    /**
+     * Call the function for each dirty path, in sorted order.  The function must not modify the set.
+     */
+    template <typename Function>
+    Loop ForEachPath(Function && function) const
+    {
+        for (size_t i = 0; i < mCount; i++)
+        {
+            if (function(&mEntries[i]) == Loop::Break)
+            {
+                return Loop::Break;
+            }
+        }
+        return Loop::Finish;
+    }
+
+protected:
+    DirtyPathSetBase(AttributePathParamsWithGeneration * apStorage, size_t aCapacity, bool aUseHeap) :
+        mEntries(apStorage), mCapacity(aCapacity), mUseHeap(aUseHeap)
+    {}
+    ~DirtyPathSetBase();
+
+private:
+    using Entry = AttributePathParamsWithGeneration;
+
+    bool HasRoom() const { return mEntries != nullptr && mCount < mCapacity; }
+    size_t LowerBound(const AttributePathParams & aPath) const;
+    bool Find(const AttributePathParams & aPath, size_t & aIndex) const;
+
+    void InsertAt(size_t aIndex, const AttributePathParams & aPath, uint64_t aGeneration);
+    bool RemoveSubsetsOf(const AttributePathParams & aPath);
+    bool Grow();
+
+    /**
+     * Collapse the paths that only differ by attribute id into one wildcard attribute path.
+     *
+     * Returns whether we have released any paths.
+     */
+    bool MergePathsUnderSameCluster();
+
+    /**
+     * Collapse the paths that only differ by cluster or attribute id into one wildcard cluster path.
+     *
+     * Returns whether we have released any paths.
+     */
+    bool MergePathsUnderSameEndpoint();
+
+    Entry * mEntries = nullptr;
+    size_t mCount    = 0;
+    // For heap storage, this is the number of paths to allocate room for on first use while mEntries is null.
+    size_t mCapacity = 0;
+    bool mUseHeap    = false;
+};
+
+template <size_t N, ObjectPoolMem P = ObjectPoolMem::kDefault>
+class DirtyPathSet;
+
+/**
+ * Dirty path set backed by a fixed array of N paths.
+ */
+template <size_t N>
+class DirtyPathSet<N, ObjectPoolMem::kInline> : public DirtyPathSetBase
+{
+public:
+    DirtyPathSet() : DirtyPathSetBase(mStorage, N, false) {}
+
+private:
+    AttributePathParamsWithGeneration mStorage[N];
+};
+
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+/**
+ * Dirty path set backed by a heap array that starts with room for N paths and grows on demand.
+ */
+template <size_t N>
+class DirtyPathSet<N, ObjectPoolMem::kHeap> : public DirtyPathSetBase
+{
+public:
+    DirtyPathSet() : DirtyPathSetBase(nullptr, N, true) {}
+};
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
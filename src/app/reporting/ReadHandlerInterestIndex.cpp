@@ -0,0 +1,94 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/reporting/ReadHandlerInterestIndex.h>
+
+#include <lib/support/CHIPMem.h>
+
+#include <algorithm>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+using namespace internal;
+
+ReadHandlerInterestIndex::~ReadHandlerInterestIndex()
+{
+    ReleaseAll();
+}
+
+void ReadHandlerInterestIndex::ReleaseAll()
+{
+    mCount = 0;
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    // The engine owning the index is usually a static, so the storage must not outlive Platform::MemoryShutdown.
+    VerifyOrReturn(mEntries != nullptr);
+    Platform::MemoryFree(mEntries);
+    mEntries  = nullptr;
+    mCapacity = 0;
+#endif
+}
+
+bool ReadHandlerInterestIndex::Reserve(size_t aCount)
+{
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    VerifyOrReturnValue(aCount > mCapacity, true);
+
+    size_t newCapacity = std::max(aCount, mCapacity * 2);
+    auto * entries     = static_cast<Entry *>(Platform::MemoryRealloc(mEntries, newCapacity * sizeof(Entry)));
+    VerifyOrReturnValue(entries != nullptr, false);
+
+    mEntries  = entries;
+    mCapacity = newCapacity;
+    return true;
+#else
+    return aCount <= kCapacity;
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+}
+
+CHIP_ERROR ReadHandlerInterestIndex::Add(ReadHandler & aReadHandler, const ObjectList<AttributePathParams> * aPathList)
+{
+    VerifyOrReturnError(aPathList != nullptr, CHIP_NO_ERROR);
+    VerifyOrReturnError(Reserve(mCount + aPathList->Count()), CHIP_ERROR_NO_MEMORY);
+
+    for (auto path = aPathList; path != nullptr; path = path->mpNext)
+    {
+        Entry entry;
+        static_cast<AttributePathParams &>(entry) = path->mValue;
+        entry.mpReadHandler                      = &aReadHandler;
+
+        Entry * position = std::upper_bound(mEntries, mEntries + mCount, entry, PathLess);
+        std::move_backward(position, mEntries + mCount, mEntries + mCount + 1);
+        *position = entry;
+        mCount++;
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+void ReadHandlerInterestIndex::Remove(const ReadHandler & aReadHandler)
+{
+    Entry * last = std::remove_if(mEntries, mEntries + mCount,
+                                  [&aReadHandler](const Entry & entry) { return entry.mpReadHandler == &aReadHandler; });
+    mCount       = static_cast<size_t>(last - mEntries);
+}
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
@@ -0,0 +1,115 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/AttributePathParams.h>
+#include <app/ObjectList.h>
+#include <app/reporting/SortedAttributePaths.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/CHIPError.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/Pool.h>
+#include <system/SystemConfig.h>
+
+#include <stddef.h>
+
+namespace chip {
+namespace app {
+
+class ReadHandler;
+
+namespace reporting {
+
+/**
+ * @brief
+ *   Reverse index from the attribute paths of the active read and subscribe requests to the ReadHandlers that requested them.
+ *
+ *   The index keeps one entry per (attribute path, ReadHandler) pair, sorted by endpoint, cluster and attribute id, so that
+ *   finding the handlers interested in a dirty path costs a few binary searches per path component instead of a walk over
+ *   every path of every handler.
+ *
+ *   It is maintained by the InteractionModelEngine: a ReadHandler is added once its attribute path list is final and removed
+ *   before that list is released.
+ */
+class ReadHandlerInterestIndex
+{
+public:
+    ReadHandlerInterestIndex() = default;
+    ~ReadHandlerInterestIndex();
+
+    ReadHandlerInterestIndex(const ReadHandlerInterestIndex &) = delete;
+    ReadHandlerInterestIndex & operator=(const ReadHandlerInterestIndex &) = delete;
+
+    /**
+     * Index every path of the given list as being of interest to the given ReadHandler.
+     *
+     * @retval #CHIP_ERROR_NO_MEMORY If there is no room for the paths, in which case the index is left untouched.
+     */
+    CHIP_ERROR Add(ReadHandler & aReadHandler, const ObjectList<AttributePathParams> * aPathList);
+
+    /**
+     * Remove every path indexed for the given ReadHandler.  This is a no-op if the handler has not been added.
+     */
+    void Remove(const ReadHandler & aReadHandler);
+
+    /**
+     * Remove every indexed path and release the storage of the index.
+     */
+    void ReleaseAll();
+
+    /**
+     * Returns the number of indexed (attribute path, ReadHandler) pairs.
+     */
+    size_t Allocated() const { return mCount; }
+
+    /**
+     * Call the function for each ReadHandler with a path intersecting aPath, until it returns Loop::Break.
+     *
+     * A ReadHandler with several paths intersecting aPath is visited once per path.
+     */
+    template <typename Function>
+    Loop ForEachInterestedReadHandler(const AttributePathParams & aPath, Function && aFunction)
+    {
+        return internal::ForEachIntersectingPath(mEntries, mEntries + mCount, aPath,
+                                                 [&aFunction](Entry & entry) { return aFunction(entry.mpReadHandler); });
+    }
+
+private:
+    struct Entry : public AttributePathParams
+    {
+        ReadHandler * mpReadHandler = nullptr;
+    };
+
+    bool Reserve(size_t aCount);
+
+    size_t mCount = 0;
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    Entry * mEntries = nullptr;
+    size_t mCapacity = 0;
+#else
+    // Every indexed path is an entry of the attribute path pool of the InteractionModelEngine.
+    static constexpr size_t kCapacity =
+        CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_READS + CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_SUBSCRIPTIONS;
+    Entry mEntries[kCapacity];
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+};
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
@@ -0,0 +1,166 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Helpers for arrays of attribute paths sorted by endpoint, then cluster, then attribute id.  Wildcards compare greater
+ *      than any concrete id, so all paths sharing a concrete prefix form a contiguous range, followed by the paths with a
+ *      wildcard at the next level.
+ */
+
+#pragma once
+
+#include <app/AttributePathParams.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/Pool.h>
+
+#include <algorithm>
+#include <stdint.h>
+#include <utility>
+
+namespace chip {
+namespace app {
+namespace reporting {
+namespace internal {
+
+constexpr uint8_t kEndpointLevel  = 0;
+constexpr uint8_t kClusterLevel   = 1;
+constexpr uint8_t kAttributeLevel = 2;
+constexpr uint8_t kLevelCount     = 3;
+
+inline uint32_t PathComponent(const AttributePathParams & aPath, uint8_t aLevel)
+{
+    switch (aLevel)
+    {
+    case kEndpointLevel:
+        return aPath.mEndpointId;
+    case kClusterLevel:
+        return aPath.mClusterId;
+    default:
+        return aPath.mAttributeId;
+    }
+}
+
+inline uint32_t WildcardComponent(uint8_t aLevel)
+{
+    switch (aLevel)
+    {
+    case kEndpointLevel:
+        return kInvalidEndpointId;
+    case kClusterLevel:
+        return kInvalidClusterId;
+    default:
+        return kInvalidAttributeId;
+    }
+}
+
+inline bool PathLess(const AttributePathParams & aLhs, const AttributePathParams & aRhs)
+{
+    for (uint8_t level = 0; level < kLevelCount; level++)
+    {
+        uint32_t lhs = PathComponent(aLhs, level);
+        uint32_t rhs = PathComponent(aRhs, level);
+        if (lhs != rhs)
+        {
+            return lhs < rhs;
+        }
+    }
+    return false;
+}
+
+/**
+ * Returns the range of [apBegin, apEnd) whose component at aLevel equals aValue.  All paths of the input range must share the
+ * components of the levels before aLevel, so that the range is sorted by the component at aLevel.
+ */
+template <typename Entry>
+std::pair<Entry *, Entry *> EqualComponentRange(Entry * apBegin, Entry * apEnd, uint8_t aLevel, uint32_t aValue)
+{
+    Entry * first = std::lower_bound(apBegin, apEnd, aValue, [aLevel](const AttributePathParams & entry, uint32_t value) {
+        return PathComponent(entry, aLevel) < value;
+    });
+    Entry * last  = std::upper_bound(first, apEnd, aValue, [aLevel](uint32_t value, const AttributePathParams & entry) {
+        return value < PathComponent(entry, aLevel);
+    });
+    return std::make_pair(first, last);
+}
+
+/**
+ * Narrows [apBegin, apEnd) to the paths that may be covered by aPath: the ones sharing its leading concrete components.
+ */
+template <typename Entry>
+std::pair<Entry *, Entry *> SubsetCandidateRange(Entry * apBegin, Entry * apEnd, const AttributePathParams & aPath)
+{
+    for (uint8_t level = 0; level < kLevelCount; level++)
+    {
+        uint32_t value = PathComponent(aPath, level);
+        if (value == WildcardComponent(level))
+        {
+            break;
+        }
+        auto range = EqualComponentRange(apBegin, apEnd, level, value);
+        apBegin    = range.first;
+        apEnd      = range.second;
+    }
+    return std::make_pair(apBegin, apEnd);
+}
+
+/**
+ * Calls the function for each path of the sorted range [apBegin, apEnd) that intersects aPath, until it returns Loop::Break.
+ *
+ * A concrete component of aPath intersects the paths with the same value and the paths with a wildcard at that level, so the
+ * range is narrowed with binary searches for as long as aPath has concrete components.
+ */
+template <typename Entry, typename Function>
+Loop ForEachIntersectingPath(Entry * apBegin, Entry * apEnd, const AttributePathParams & aPath, Function && aFunction,
+                             uint8_t aLevel = kEndpointLevel)
+{
+    if (aLevel == kLevelCount)
+    {
+        for (Entry * entry = apBegin; entry != apEnd; entry++)
+        {
+            VerifyOrReturnValue(aFunction(*entry) != Loop::Break, Loop::Break);
+        }
+        return Loop::Finish;
+    }
+
+    uint32_t value = PathComponent(aPath, aLevel);
+    if (value == WildcardComponent(aLevel))
+    {
+        // Any value intersects a wildcard, so we cannot narrow the range any further.
+        for (Entry * entry = apBegin; entry != apEnd; entry++)
+        {
+            if (entry->Intersects(aPath))
+            {
+                VerifyOrReturnValue(aFunction(*entry) != Loop::Break, Loop::Break);
+            }
+        }
+        return Loop::Finish;
+    }
+
+    auto next     = static_cast<uint8_t>(aLevel + 1);
+    auto concrete = EqualComponentRange(apBegin, apEnd, aLevel, value);
+    VerifyOrReturnValue(ForEachIntersectingPath(concrete.first, concrete.second, aPath, aFunction, next) != Loop::Break,
+                        Loop::Break);
+    auto wildcard = EqualComponentRange(concrete.second, apEnd, aLevel, WildcardComponent(aLevel));
+    return ForEachIntersectingPath(wildcard.first, wildcard.second, aPath, aFunction, next);
+}
+
+} // namespace internal
+} // namespace reporting
+} // namespace app
+} // namespace chip
@@ -81,7 +81,9 @@ public:
 
         if (changeType == ChangeType::kRemoved)
         {
-            // Shuffle down entries past index, then delete entry at last index.
+            // Shuffle down entries past index, then delete entry at last index. Storage backends that support
+            // batching persist the whole shuffle at once.
+            PersistentStorageBatch batch(mPersistentStorage);
             while (true)
             {
                 uint16_t size = static_cast<uint16_t>(sizeof(buffer));
@@ -98,6 +100,7 @@ public:
             }
             SuccessOrExit(err = mPersistentStorage->SyncDeleteKeyValue(
                               DefaultStorageKeyAllocator::AccessControlAclEntry(fabric, index).KeyName()));
+            SuccessOrExit(err = batch.Commit());
         }
         else
         {
@@ -25,8 +25,8 @@
 #include <app/CASESessionManager.h>
 #include <app/DefaultAttributePersistenceProvider.h>
 #include <app/FailSafeContext.h>
+#include <app/IndexedSubscriptionResumptionStorage.h>
 #include <app/OperationalSessionSetupPool.h>
-#include <app/SimpleSubscriptionResumptionStorage.h>
 #include <app/TestEventTriggerDelegate.h>
 #include <app/server/AclStorage.h>
 #include <app/server/AppDelegate.h>
@@ -270,7 +270,7 @@ private:
     static SimpleSessionResumptionStorage sSessionResumptionStorage;
 #endif
 #if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
-    static app::SimpleSubscriptionResumptionStorage sSubscriptionResumptionStorage;
+    static app::IndexedSubscriptionResumptionStorage sSubscriptionResumptionStorage;
 #endif
     static app::DefaultAclStorage sAclStorage;
     static Crypto::DefaultSessionKeystore sSessionKeystore;
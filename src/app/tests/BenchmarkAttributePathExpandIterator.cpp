@@ -0,0 +1,106 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Measures the expansion of a full wildcard attribute path over the mock attribute storage with 10, 100 and 500
+ *      bridged endpoints, querying the attribute storage directly and through the FlattenedAttributeTree.
+ *
+ */
+
+#include <app/AttributePathExpandIterator.h>
+#include <app/FlattenedAttributeTree.h>
+#include <app/util/mock/Functions.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+
+#include <chrono>
+#include <stdio.h>
+
+using namespace chip;
+using namespace chip::app;
+
+namespace {
+
+constexpr uint16_t kEndpointCounts[]     = { 10, 100, 500 };
+constexpr unsigned kExpansionRepeatCount = 20;
+
+using Clock = std::chrono::steady_clock;
+
+double NanosecondsSince(Clock::time_point aStart)
+{
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - aStart).count());
+}
+
+/**
+ * Expands a full wildcard path the way a wildcard read or a priming report does, and returns the number of emitted paths.
+ */
+size_t ExpandWildcard()
+{
+    ObjectList<AttributePathParams> wildcard;
+    ConcreteAttributePath path;
+    size_t paths = 0;
+    for (AttributePathExpandIterator iterator(&wildcard); iterator.Get(path); iterator.Next())
+    {
+        paths++;
+    }
+    return paths;
+}
+
+void RunScenario(const char * aName, uint16_t aEndpointCount)
+{
+    size_t paths = ExpandWildcard();
+    VerifyOrDie(paths > aEndpointCount);
+
+    Clock::time_point start = Clock::now();
+    for (unsigned repeat = 0; repeat < kExpansionRepeatCount; repeat++)
+    {
+        VerifyOrDie(ExpandWildcard() == paths);
+    }
+    double expansionNs = NanosecondsSince(start) / kExpansionRepeatCount;
+
+    printf("%-9s endpoints=%-4u paths=%-6u expansion=%12.1f ns  per path=%8.1f ns\n", aName,
+           static_cast<unsigned>(aEndpointCount), static_cast<unsigned>(paths), expansionNs,
+           expansionNs / static_cast<double>(paths));
+}
+
+} // namespace
+
+int main()
+{
+    VerifyOrDie(Platform::MemoryInit() == CHIP_NO_ERROR);
+
+    for (uint16_t endpointCount : kEndpointCounts)
+    {
+        Test::SetMockBridgedEndpointCount(endpointCount);
+
+        FlattenedAttributeTree::SetEnabled(false);
+        RunScenario("storage", endpointCount);
+
+        FlattenedAttributeTree::SetEnabled(true);
+        Clock::time_point start = Clock::now();
+        VerifyOrDie(FlattenedAttributeTree::Current() != nullptr);
+        printf("%-9s endpoints=%-4u rebuild=%12.1f ns\n", "tree", static_cast<unsigned>(endpointCount), NanosecondsSince(start));
+        RunScenario("tree", endpointCount);
+    }
+
+    Test::SetMockBridgedEndpointCount(0);
+    FlattenedAttributeTree::Release();
+    Platform::MemoryShutdown();
+    return 0;
+}
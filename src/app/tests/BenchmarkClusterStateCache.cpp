@@ -0,0 +1,219 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Compares the memory use and lookup cost of the two ClusterStateCache storage modes, for a controller that keeps
+ *      one cache per node with the result of a full wildcard subscription.
+ *
+ */
+
+#include <app/ClusterStateCache.h>
+#include <lib/core/TLVWriter.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+
+#include <chrono>
+#include <memory>
+#include <stdio.h>
+#include <vector>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+using namespace chip;
+using namespace chip::app;
+
+namespace {
+
+constexpr EndpointId kEndpointCount        = 4;
+constexpr ClusterId kClusterCount          = 12;
+constexpr AttributeId kAttributeCount      = 16;
+constexpr size_t kNodeCounts[]             = { 10, 100, 500 };
+constexpr unsigned kLookupRepeatCount      = 10;
+constexpr size_t kListEntryCount           = 8;
+constexpr const char kStringValue[]        = "Node label";
+constexpr size_t kAttributeValueBufferSize = 256;
+
+class NullCallback : public ClusterStateCache::Callback
+{
+    void OnDone(ReadClient *) override {}
+};
+
+using Clock = std::chrono::steady_clock;
+
+double NanosecondsPerOperation(Clock::time_point aStart, size_t aOperations)
+{
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - aStart).count()) /
+        static_cast<double>(aOperations);
+}
+
+size_t HeapInUse()
+{
+#if defined(__GLIBC__)
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * Encodes the value of an attribute the way it is received in a report: a mix of integers, strings and short lists.
+ */
+void EncodeValue(TLV::TLVWriter & aWriter, AttributeId aAttribute)
+{
+    switch (aAttribute % 4)
+    {
+    case 0:
+    case 1:
+        VerifyOrDie(aWriter.Put(TLV::AnonymousTag(), static_cast<uint32_t>(aAttribute * 1000)) == CHIP_NO_ERROR);
+        break;
+    case 2:
+        VerifyOrDie(aWriter.PutString(TLV::AnonymousTag(), kStringValue) == CHIP_NO_ERROR);
+        break;
+    default: {
+        TLV::TLVType listType;
+        VerifyOrDie(aWriter.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Array, listType) == CHIP_NO_ERROR);
+        for (size_t i = 0; i < kListEntryCount; i++)
+        {
+            VerifyOrDie(aWriter.Put(TLV::AnonymousTag(), static_cast<uint16_t>(i)) == CHIP_NO_ERROR);
+        }
+        VerifyOrDie(aWriter.EndContainer(listType) == CHIP_NO_ERROR);
+        break;
+    }
+    }
+}
+
+/**
+ * Feeds the priming report of a full wildcard subscription to the cache.
+ */
+size_t Prime(ClusterStateCache & aCache)
+{
+    ReadClient::Callback & callback = aCache.GetBufferedCallback();
+    size_t attributes               = 0;
+    uint8_t buffer[kAttributeValueBufferSize];
+    StatusIB status;
+
+    callback.OnReportBegin();
+    for (EndpointId endpoint = 0; endpoint < kEndpointCount; endpoint++)
+    {
+        for (ClusterId cluster = 0; cluster < kClusterCount; cluster++)
+        {
+            for (AttributeId attribute = 0; attribute < kAttributeCount; attribute++)
+            {
+                TLV::TLVWriter writer;
+                writer.Init(buffer);
+                EncodeValue(writer, attribute);
+                VerifyOrDie(writer.Finalize() == CHIP_NO_ERROR);
+
+                TLV::TLVReader reader;
+                reader.Init(buffer, writer.GetLengthWritten());
+                VerifyOrDie(reader.Next() == CHIP_NO_ERROR);
+
+                ConcreteDataAttributePath path(endpoint, cluster, attribute);
+                path.mDataVersion.SetValue(1);
+                callback.OnAttributeData(path, &reader, status);
+                attributes++;
+            }
+        }
+    }
+    callback.OnReportEnd();
+    return attributes;
+}
+
+void RunScenario(const char * aName, ClusterStateCache::StorageMode aStorageMode, size_t aNodeCount)
+{
+    NullCallback callback;
+    std::vector<std::unique_ptr<ClusterStateCache>> caches;
+    caches.reserve(aNodeCount);
+
+    size_t heapBefore       = HeapInUse();
+    size_t attributes       = 0;
+    Clock::time_point start = Clock::now();
+    for (size_t node = 0; node < aNodeCount; node++)
+    {
+        caches.emplace_back(new ClusterStateCache(callback, Optional<EventNumber>::Missing(), true, aStorageMode));
+        attributes += Prime(*caches.back());
+    }
+    double insertNs  = NanosecondsPerOperation(start, attributes);
+    size_t heapBytes = HeapInUse() - heapBefore;
+
+    size_t lookups = 0;
+    size_t found   = 0;
+    start          = Clock::now();
+    for (unsigned repeat = 0; repeat < kLookupRepeatCount; repeat++)
+    {
+        for (auto & cache : caches)
+        {
+            for (EndpointId endpoint = 0; endpoint < kEndpointCount; endpoint++)
+            {
+                for (ClusterId cluster = 0; cluster < kClusterCount; cluster++)
+                {
+                    for (AttributeId attribute = 0; attribute < kAttributeCount; attribute++)
+                    {
+                        TLV::TLVReader reader;
+                        ConcreteAttributePath path(endpoint, cluster, attribute);
+                        found += (cache->Get(path, reader) == CHIP_NO_ERROR) ? 1 : 0;
+                        lookups++;
+                    }
+                }
+            }
+        }
+    }
+    double lookupNs = NanosecondsPerOperation(start, lookups);
+    VerifyOrDie(found == lookups);
+
+    size_t iterated = 0;
+    start           = Clock::now();
+    for (auto & cache : caches)
+    {
+        for (EndpointId endpoint = 0; endpoint < kEndpointCount; endpoint++)
+        {
+            for (ClusterId cluster = 0; cluster < kClusterCount; cluster++)
+            {
+                cache->ForEachAttribute(endpoint, cluster, [&iterated](const ConcreteAttributePath &) {
+                    iterated++;
+                    return CHIP_NO_ERROR;
+                });
+            }
+        }
+    }
+    double iterateNs = NanosecondsPerOperation(start, iterated);
+    VerifyOrDie(iterated == attributes);
+
+    printf("%-8s nodes=%-4u heap=%8.1f KiB/node (%6.1f B/attribute)  insert=%7.1f ns/op  lookup=%7.1f ns/op  iterate=%6.1f ns/op\n",
+           aName, static_cast<unsigned>(aNodeCount), static_cast<double>(heapBytes) / 1024.0 / static_cast<double>(aNodeCount),
+           static_cast<double>(heapBytes) / static_cast<double>(attributes), insertNs, lookupNs, iterateNs);
+}
+
+} // namespace
+
+int main()
+{
+    VerifyOrDie(Platform::MemoryInit() == CHIP_NO_ERROR);
+
+    for (size_t nodeCount : kNodeCounts)
+    {
+        RunScenario("tree", ClusterStateCache::StorageMode::kTree, nodeCount);
+        RunScenario("compact", ClusterStateCache::StorageMode::kCompact, nodeCount);
+    }
+
+    Platform::MemoryShutdown();
+    return 0;
+}
@@ -0,0 +1,165 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Compares the indexed dirty path set of the reporting engine against the linear ObjectPool scan it replaced, for a
+ *      bridge that marks many concrete attribute paths dirty at once and then walks the paths a subscription is interested in.
+ *
+ */
+
+#include <app/reporting/DirtyPathSet.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/Pool.h>
+
+#include <chrono>
+#include <stdio.h>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::app::reporting;
+
+namespace {
+
+constexpr ClusterId kClusters[]       = { 0x0006, 0x0008, 0x0300 };
+constexpr AttributeId kAttributeCount = 8;
+constexpr size_t kEndpointCounts[]    = { 10, 50, 250 };
+constexpr unsigned kLookupRepeatCount = 10;
+
+/**
+ * The dirty set as it was before: an ObjectPool where every insertion and lookup scans all the paths.
+ */
+class LinearDirtySet
+{
+public:
+    ~LinearDirtySet() { mPool.ReleaseAll(); }
+
+    void Insert(const AttributePathParams & aPath, uint64_t aGeneration)
+    {
+        bool merged = mPool.ForEachActiveObject([&](auto * path) {
+            if (path->IsAttributePathSupersetOf(aPath))
+            {
+                path->mGeneration = aGeneration;
+                return Loop::Break;
+            }
+            if (aPath.IsAttributePathSupersetOf(*path))
+            {
+                *path             = aPath;
+                path->mGeneration = aGeneration;
+                return Loop::Break;
+            }
+            return Loop::Continue;
+        }) == Loop::Break;
+
+        if (!merged)
+        {
+            auto * path = mPool.CreateObject(aPath);
+            VerifyOrDie(path != nullptr);
+            path->mGeneration = aGeneration;
+        }
+    }
+
+    bool IsDirtySince(const ConcreteAttributePath & aPath, uint64_t aGeneration)
+    {
+        return mPool.ForEachActiveObject([&](auto * path) {
+            return (path->IsAttributePathSupersetOf(aPath) && path->mGeneration > aGeneration) ? Loop::Break : Loop::Continue;
+        }) == Loop::Break;
+    }
+
+private:
+    ObjectPool<AttributePathParamsWithGeneration, 4096> mPool;
+};
+
+using Clock = std::chrono::steady_clock;
+
+double NanosecondsPerOperation(Clock::time_point aStart, size_t aOperations)
+{
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - aStart).count()) /
+        static_cast<double>(aOperations);
+}
+
+/**
+ * Marks every other attribute of every bridged endpoint dirty, then checks every attribute of the bridge the way
+ * Engine::BuildSingleReportDataAttributeReportIBs does for a full wildcard subscription.
+ */
+template <typename Set>
+void RunScenario(const char * aName, Set & aSet, size_t aEndpointCount)
+{
+    uint64_t generation = 1;
+    size_t inserts      = 0;
+
+    Clock::time_point start = Clock::now();
+    for (EndpointId endpoint = 1; endpoint <= aEndpointCount; endpoint++)
+    {
+        for (ClusterId cluster : kClusters)
+        {
+            for (AttributeId attribute = 0; attribute < kAttributeCount; attribute += 2)
+            {
+                aSet.Insert(AttributePathParams(endpoint, cluster, attribute), ++generation);
+                inserts++;
+            }
+        }
+    }
+    double insertNs = NanosecondsPerOperation(start, inserts);
+
+    size_t lookups = 0;
+    size_t dirty   = 0;
+    start          = Clock::now();
+    for (unsigned repeat = 0; repeat < kLookupRepeatCount; repeat++)
+    {
+        for (EndpointId endpoint = 1; endpoint <= aEndpointCount; endpoint++)
+        {
+            for (ClusterId cluster : kClusters)
+            {
+                for (AttributeId attribute = 0; attribute < kAttributeCount; attribute++)
+                {
+                    dirty += aSet.IsDirtySince(ConcreteAttributePath(endpoint, cluster, attribute), 1) ? 1 : 0;
+                    lookups++;
+                }
+            }
+        }
+    }
+    double lookupNs = NanosecondsPerOperation(start, lookups);
+
+    // Every dirty path must be found; a set that had to coarsen its paths reports more.
+    VerifyOrDie(dirty >= inserts * kLookupRepeatCount);
+    printf("%-8s endpoints=%-4u dirty paths=%-5u insert=%10.1f ns/op  lookup=%10.1f ns/op\n", aName,
+           static_cast<unsigned>(aEndpointCount), static_cast<unsigned>(inserts), insertNs, lookupNs);
+}
+
+} // namespace
+
+int main()
+{
+    VerifyOrDie(Platform::MemoryInit() == CHIP_NO_ERROR);
+
+    for (size_t endpointCount : kEndpointCounts)
+    {
+        {
+            LinearDirtySet linear;
+            RunScenario("pool", linear, endpointCount);
+        }
+        {
+            DirtyPathSet<CHIP_IM_SERVER_MAX_NUM_DIRTY_SET> indexed;
+            RunScenario("indexed", indexed, endpointCount);
+        }
+    }
+
+    Platform::MemoryShutdown();
+    return 0;
+}
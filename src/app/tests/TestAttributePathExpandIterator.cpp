@@ -20,10 +20,13 @@
 #include <app/AttributePathExpandIterator.h>
 #include <app/ConcreteAttributePath.h>
 #include <app/EventManagement.h>
+#include <app/FlattenedAttributeTree.h>
 #include <app/ObjectList.h>
 #include <app/util/mock/Constants.h>
+#include <app/util/mock/Functions.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/core/TLVDebug.h>
+#include <lib/support/CHIPMem.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/DLLUtil.h>
 #include <lib/support/UnitTestRegistration.h>
@@ -417,9 +420,105 @@ void TestMultipleClusInfo(nlTestSuite * apSuite, void * apContext)
     NL_TEST_ASSERT(apSuite, index == ArraySize(paths));
 }
 
+size_t ExpandPaths(app::ObjectList<app::AttributePathParams> * apPathList, P * apPaths, size_t aMaxPaths)
+{
+    app::ConcreteAttributePath path;
+    size_t count = 0;
+    for (app::AttributePathExpandIterator iter(apPathList); iter.Get(path); iter.Next())
+    {
+        if (count < aMaxPaths)
+        {
+            apPaths[count] = path;
+        }
+        count++;
+    }
+    return count;
+}
+
+void TestFlattenedAttributeTree(nlTestSuite * apSuite, void * apContext)
+{
+    app::ObjectList<app::AttributePathParams> clusInfo1;
+
+    app::ObjectList<app::AttributePathParams> clusInfo2;
+    clusInfo2.mValue.mEndpointId = Test::kMockEndpoint3;
+
+    app::ObjectList<app::AttributePathParams> clusInfo3;
+    clusInfo3.mValue.mClusterId = Test::MockClusterId(2);
+
+    app::ObjectList<app::AttributePathParams> clusInfo4;
+    clusInfo4.mValue.mClusterId   = Test::MockClusterId(3);
+    clusInfo4.mValue.mAttributeId = Test::MockAttributeId(3);
+
+    clusInfo1.mpNext = &clusInfo2;
+    clusInfo2.mpNext = &clusInfo3;
+    clusInfo3.mpNext = &clusInfo4;
+
+    P storagePaths[128];
+    P treePaths[128];
+
+    app::FlattenedAttributeTree::SetEnabled(false);
+    NL_TEST_ASSERT(apSuite, app::FlattenedAttributeTree::Current() == nullptr);
+    size_t storagePathCount = ExpandPaths(&clusInfo1, storagePaths, ArraySize(storagePaths));
+
+    app::FlattenedAttributeTree::SetEnabled(true);
+    NL_TEST_ASSERT(apSuite, app::FlattenedAttributeTree::Current() != nullptr);
+    size_t treePathCount = ExpandPaths(&clusInfo1, treePaths, ArraySize(treePaths));
+
+    // The expansion must not depend on where the ids come from.
+    NL_TEST_ASSERT(apSuite, storagePathCount > 0 && storagePathCount <= ArraySize(storagePaths));
+    NL_TEST_ASSERT(apSuite, treePathCount == storagePathCount);
+    for (size_t i = 0; i < storagePathCount && i < treePathCount; i++)
+    {
+        NL_TEST_ASSERT(apSuite, treePaths[i] == storagePaths[i]);
+    }
+
+    app::FlattenedAttributeTree::SetEnabled(CHIP_IM_FLATTENED_ATTRIBUTE_TREE);
+}
+
+/**
+ * Start expanding a wildcard path, remove the last endpoint once the iterator reaches aEndpoint, as can happen between two
+ * report chunks, and check that the expansion goes on without emitting paths of the removed endpoint.
+ */
+void CheckEndpointRemovedDuringExpansion(nlTestSuite * apSuite, EndpointId aEndpoint)
+{
+    app::ObjectList<app::AttributePathParams> clusInfo;
+    app::ConcreteAttributePath path;
+
+    app::AttributePathExpandIterator iter(&clusInfo);
+    while (iter.Get(path) && path.mEndpointId != aEndpoint)
+    {
+        iter.Next();
+    }
+    NL_TEST_ASSERT(apSuite, iter.Valid() && path.mEndpointId == aEndpoint);
+
+    Test::SetMockEndpointCount(2);
+
+    size_t count = 0;
+    for (iter.Next(); iter.Get(path); iter.Next())
+    {
+        NL_TEST_ASSERT(apSuite, path.mEndpointId != kMockEndpoint3);
+        count++;
+    }
+    NL_TEST_ASSERT(apSuite, aEndpoint == kMockEndpoint3 || count > 0);
+
+    Test::SetMockEndpointCount(3);
+}
+
+void TestEndpointRemovedDuringExpansion(nlTestSuite * apSuite, void * apContext)
+{
+    for (bool useTree : { false, true })
+    {
+        app::FlattenedAttributeTree::SetEnabled(useTree);
+        CheckEndpointRemovedDuringExpansion(apSuite, kMockEndpoint1);
+        CheckEndpointRemovedDuringExpansion(apSuite, kMockEndpoint3);
+    }
+
+    app::FlattenedAttributeTree::SetEnabled(CHIP_IM_FLATTENED_ATTRIBUTE_TREE);
+}
+
 static int TestSetup(void * inContext)
 {
-    return SUCCESS;
+    return chip::Platform::MemoryInit() == CHIP_NO_ERROR ? SUCCESS : FAILURE;
 }
 
 /**
@@ -427,6 +526,8 @@ static int TestSetup(void * inContext)
  */
 static int TestTeardown(void * inContext)
 {
+    app::FlattenedAttributeTree::Release();
+    chip::Platform::MemoryShutdown();
     return SUCCESS;
 }
 
@@ -445,6 +546,8 @@ const nlTest sTests[] =
         NL_TEST_DEF("TestWildcardAttribute", TestWildcardAttribute),
         NL_TEST_DEF("TestNoWildcard", TestNoWildcard),
         NL_TEST_DEF("TestMultipleClusInfo", TestMultipleClusInfo),
+        NL_TEST_DEF("TestFlattenedAttributeTree", TestFlattenedAttributeTree),
+        NL_TEST_DEF("TestEndpointRemovedDuringExpansion", TestEndpointRemovedDuringExpansion),
         NL_TEST_SENTINEL()
 };
 // clang-format on
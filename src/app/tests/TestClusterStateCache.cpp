@@ -33,7 +33,9 @@
 #include <lib/support/UnitTestContext.h>
 #include <lib/support/UnitTestRegistration.h>
 #include <nlunit-test.h>
+#include <set>
 #include <string.h>
+#include <tuple>
 #include <vector>
 
 using TestContext = chip::Test::AppContext;
@@ -538,11 +540,11 @@ CacheValidator::CacheValidator(AttributeInstructionListType & instructionList,
     }
 }
 
-void RunAndValidateSequence(AttributeInstructionListType list)
+void RunAndValidateSequence(AttributeInstructionListType list, ClusterStateCache::StorageMode storageMode)
 {
     ForwardedDataCallbackValidator dataCallbackValidator;
     CacheValidator client(list, dataCallbackValidator);
-    ClusterStateCache cache(client);
+    ClusterStateCache cache(client, Optional<EventNumber>::Missing(), true, storageMode);
 
     // In order for the cache to track our data versions, we need to claim to it
     // that we are dealing with a wildcard path.  And we need to do that before
@@ -625,7 +627,7 @@ void RunAndValidateSequence(AttributeInstructionListType list)
  * E1:A1 --- Endpoint 1, Attribute A, Version 1
  *
  */
-void TestCache(nlTestSuite * apSuite, void * apContext)
+void RunAndValidateSequences(ClusterStateCache::StorageMode storageMode)
 {
     ChipLogProgress(DataManagement, "Validating various sequences of attribute data IBs...");
 
@@ -635,18 +637,20 @@ void TestCache(nlTestSuite * apSuite, void * apContext)
     ChipLogProgress(DataManagement, "E1:A1 --> E1:A1");
     RunAndValidateSequence({ AttributeInstruction(
 
-        AttributeInstruction::kAttributeA, 1, AttributeInstruction::kData) });
+        AttributeInstruction::kAttributeA, 1, AttributeInstruction::kData) }, storageMode);
 
     ChipLogProgress(DataManagement, "E1:B1 --> E1:B1");
     RunAndValidateSequence({ AttributeInstruction(
 
-        AttributeInstruction::kAttributeB, 1, AttributeInstruction::kData) });
+        AttributeInstruction::kAttributeB, 1, AttributeInstruction::kData) }, storageMode);
 
     ChipLogProgress(DataManagement, "E1:C1 --> E1:C1");
-    RunAndValidateSequence({ AttributeInstruction(AttributeInstruction::kAttributeC, 1, AttributeInstruction::kData) });
+    RunAndValidateSequence({ AttributeInstruction(AttributeInstruction::kAttributeC, 1, AttributeInstruction::kData) },
+                           storageMode);
 
     ChipLogProgress(DataManagement, "E1:D1 --> E1:D1");
-    RunAndValidateSequence({ AttributeInstruction(AttributeInstruction::kAttributeD, 1, AttributeInstruction::kData) });
+    RunAndValidateSequence({ AttributeInstruction(AttributeInstruction::kAttributeD, 1, AttributeInstruction::kData) },
+                           storageMode);
 
     //
     // Validate that a newer version of a data item over-rides the
@@ -654,40 +658,406 @@ void TestCache(nlTestSuite * apSuite, void * apContext)
     //
     ChipLogProgress(DataManagement, "E1:D1 E1:D2 --> E1:D2");
     RunAndValidateSequence({ AttributeInstruction(AttributeInstruction::kAttributeD, 1, AttributeInstruction::kData),
-                             AttributeInstruction(AttributeInstruction::kAttributeD, 1, AttributeInstruction::kData) });
+                             AttributeInstruction(AttributeInstruction::kAttributeD, 1, AttributeInstruction::kData) },
+                           storageMode);
 
     //
     // Validate that a newer StatusIB over-rides a previous data value.
     //
     ChipLogProgress(DataManagement, "E1:D1 E1:D2s --> E1:D2s");
     RunAndValidateSequence({ AttributeInstruction(AttributeInstruction::kAttributeD, 1, AttributeInstruction::kData),
-                             AttributeInstruction(AttributeInstruction::kAttributeD, 1, AttributeInstruction::kStatus) });
+                             AttributeInstruction(AttributeInstruction::kAttributeD, 1, AttributeInstruction::kStatus) },
+                           storageMode);
 
     //
     // Validate that a newer data value over-rides a previous status value.
     //
     ChipLogProgress(DataManagement, "E1:D1s E1:D2 --> E1:D2");
     RunAndValidateSequence({ AttributeInstruction(AttributeInstruction::kAttributeD, 1, AttributeInstruction::kStatus),
-                             AttributeInstruction(AttributeInstruction::kAttributeD, 1, AttributeInstruction::kData) });
+                             AttributeInstruction(AttributeInstruction::kAttributeD, 1, AttributeInstruction::kData) },
+                           storageMode);
 
     //
     // Validate data across different endpoints.
     //
     ChipLogProgress(DataManagement, "E0:D1 E1:D2 --> E0:D1 E1:D2");
     RunAndValidateSequence({ AttributeInstruction(AttributeInstruction::kAttributeD, 0, AttributeInstruction::kData),
-                             AttributeInstruction(AttributeInstruction::kAttributeD, 1, AttributeInstruction::kData) });
+                             AttributeInstruction(AttributeInstruction::kAttributeD, 1, AttributeInstruction::kData) },
+                           storageMode);
 
     ChipLogProgress(DataManagement, "E0:A1 E0:B2 E0:A3 E0:B4 --> E0:A3 E0:B4");
     RunAndValidateSequence({ AttributeInstruction(AttributeInstruction::kAttributeA, 0, AttributeInstruction::kData),
                              AttributeInstruction(AttributeInstruction::kAttributeB, 0, AttributeInstruction::kData),
                              AttributeInstruction(AttributeInstruction::kAttributeA, 0, AttributeInstruction::kData),
-                             AttributeInstruction(AttributeInstruction::kAttributeB, 0, AttributeInstruction::kData) });
+                             AttributeInstruction(AttributeInstruction::kAttributeB, 0, AttributeInstruction::kData) },
+                           storageMode);
+}
+
+void TestCache(nlTestSuite * apSuite, void * apContext)
+{
+    RunAndValidateSequences(ClusterStateCache::StorageMode::kTree);
+}
+
+void TestCacheCompact(nlTestSuite * apSuite, void * apContext)
+{
+    RunAndValidateSequences(ClusterStateCache::StorageMode::kCompact);
+}
+
+class NullCacheCallback : public ClusterStateCache::Callback
+{
+    void OnDone(ReadClient *) override {}
+};
+
+// Report a single octet string attribute of the given length, which takes length + 2 bytes of TLV.
+void ReportOctetString(ReadClient::Callback & callback, const ConcreteClusterPath & clusterPath, size_t length,
+                       DataVersion version, AttributeId attributeId = Clusters::UnitTesting::Attributes::OctetString::Id)
+{
+    uint8_t value[200] = {};
+    uint8_t buf[256];
+    TLV::TLVWriter writer;
+    writer.Init(buf);
+    NL_TEST_ASSERT(gSuite, writer.Put(TLV::AnonymousTag(), ByteSpan(value, length)) == CHIP_NO_ERROR);
+
+    TLV::TLVReader reader;
+    reader.Init(buf, writer.GetLengthWritten());
+    NL_TEST_ASSERT(gSuite, reader.Next() == CHIP_NO_ERROR);
+
+    ConcreteDataAttributePath path(clusterPath.mEndpointId, clusterPath.mClusterId, attributeId);
+    path.mDataVersion.SetValue(version);
+    callback.OnAttributeData(path, &reader, StatusIB());
+}
+
+// Have the cache encode its data version filters into a buffer of the given size, and return the filtered clusters in
+// the order they were encoded.
+std::vector<ConcreteClusterPath> EncodeFilters(ReadClient::Callback & callback, const Span<AttributePathParams> & paths,
+                                               size_t bufferSize, uint32_t * encodedLength = nullptr)
+{
+    std::vector<ConcreteClusterPath> filters;
+    uint8_t buf[256];
+    TLV::TLVWriter writer;
+    writer.Init(buf, bufferSize);
+
+    // Leave room to close the list, like ReadClient does.
+    DataVersionFilterIBs::Builder builder;
+    NL_TEST_ASSERT(gSuite, builder.Init(&writer) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(gSuite, writer.ReserveBuffer(1) == CHIP_NO_ERROR);
+    bool encodedDataVersionList = false;
+    NL_TEST_ASSERT(gSuite, callback.OnUpdateDataVersionFilterList(builder, paths, encodedDataVersionList) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(gSuite, writer.UnreserveBuffer(1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(gSuite, builder.EndOfDataVersionFilterIBs() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(gSuite, writer.Finalize() == CHIP_NO_ERROR);
+    if (encodedLength != nullptr)
+    {
+        *encodedLength = writer.GetLengthWritten();
+    }
+
+    TLV::TLVReader reader;
+    TLV::TLVType listType;
+    reader.Init(buf, writer.GetLengthWritten());
+    NL_TEST_ASSERT(gSuite, reader.Next() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(gSuite, reader.EnterContainer(listType) == CHIP_NO_ERROR);
+    while (reader.Next() == CHIP_NO_ERROR)
+    {
+        DataVersionFilterIB::Parser filter;
+        ClusterPathIB::Parser path;
+        ConcreteClusterPath clusterPath;
+        NL_TEST_ASSERT(gSuite, filter.Init(reader) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(gSuite, filter.GetPath(&path) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(gSuite, path.GetEndpoint(&clusterPath.mEndpointId) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(gSuite, path.GetCluster(&clusterPath.mClusterId) == CHIP_NO_ERROR);
+        filters.push_back(clusterPath);
+    }
+
+    NL_TEST_ASSERT(gSuite, encodedDataVersionList == !filters.empty());
+    return filters;
+}
+
+void RunDataVersionFilterSequence(ClusterStateCache::StorageMode storageMode)
+{
+    NullCacheCallback client;
+    ClusterStateCache cache(client, Optional<EventNumber>::Missing(), true, storageMode);
+    ReadClient::Callback & callback = cache.GetBufferedCallback();
+
+    const ConcreteClusterPath largeCluster(1, 0x10);
+    const ConcreteClusterPath mediumCluster(2, 0x10);
+    const ConcreteClusterPath smallCluster(1, 0x20);
+    constexpr size_t kLargeSize       = 100;
+    constexpr size_t kMediumSize      = 60;
+    constexpr size_t kSmallSize       = 30;
+    constexpr size_t kLargeBufferSize = 256;
+
+    AttributePathParams wildcardPath;
+    const Span<AttributePathParams> pathSpan(&wildcardPath, 1);
+
+    // The first request tells the cache it deals with a wildcard path, so it tracks data versions.
+    NL_TEST_ASSERT(gSuite, EncodeFilters(callback, pathSpan, kLargeBufferSize).empty());
+
+    callback.OnReportBegin();
+    ReportOctetString(callback, largeCluster, kLargeSize, 1);
+    ReportOctetString(callback, smallCluster, kSmallSize, 1);
+    ReportOctetString(callback, mediumCluster, kMediumSize, 1);
+    callback.OnReportEnd();
+    callback.OnSubscriptionEstablished(1);
+
+    // With enough space, every cluster gets a filter, the ones with the most data first.
+    uint32_t encodedLength = 0;
+    auto filters           = EncodeFilters(callback, pathSpan, kLargeBufferSize, &encodedLength);
+    NL_TEST_ASSERT(gSuite, filters.size() == 3);
+    NL_TEST_ASSERT(gSuite, filters.size() == 3 && filters[0] == largeCluster && filters[1] == mediumCluster);
+    NL_TEST_ASSERT(gSuite, filters.size() == 3 && filters[2] == smallCluster);
+
+    // The publisher only sends the medium cluster again; the other two clusters are matched by their filters.
+    cache.ResetDataVersionFilterStats();
+    filters = EncodeFilters(callback, pathSpan, kLargeBufferSize);
+    callback.OnReportBegin();
+    ReportOctetString(callback, mediumCluster, kMediumSize, 2);
+    callback.OnReportEnd();
+    callback.OnSubscriptionEstablished(2);
+
+    auto stats = cache.GetDataVersionFilterStats();
+    NL_TEST_ASSERT(gSuite, stats.mFiltersEncoded == 3);
+    NL_TEST_ASSERT(gSuite, stats.mFiltersOmitted == 0);
+    NL_TEST_ASSERT(gSuite, stats.mClustersMatched == 2);
+    NL_TEST_ASSERT(gSuite, stats.mClustersMismatched == 1);
+    NL_TEST_ASSERT(gSuite, stats.mBytesAvoided == (kLargeSize + 2) + (kSmallSize + 2));
+
+    // With room for a single filter, the largest cluster goes first, but the clusters left out gain priority with every
+    // request, so each of them gets its filter within a few requests.
+    const size_t filterLength     = (encodedLength - 2) / 3;
+    const size_t singleFilterSize = 2 + filterLength;
+    std::set<std::tuple<EndpointId, ClusterId>> filtered;
+    cache.ResetDataVersionFilterStats();
+    for (int i = 0; i < 10; i++)
+    {
+        filters = EncodeFilters(callback, pathSpan, singleFilterSize);
+        NL_TEST_ASSERT(gSuite, filters.size() == 1);
+        if (filters.size() == 1)
+        {
+            NL_TEST_ASSERT(gSuite, i != 0 || filters[0] == largeCluster);
+            filtered.insert(std::make_tuple(filters[0].mEndpointId, filters[0].mClusterId));
+        }
+    }
+    NL_TEST_ASSERT(gSuite, filtered.size() == 3);
+
+    stats = cache.GetDataVersionFilterStats();
+    NL_TEST_ASSERT(gSuite, stats.mFiltersEncoded == 10);
+    NL_TEST_ASSERT(gSuite, stats.mFiltersOmitted == 20);
+
+    // Once a filter fits again, it is sent in plain size order again.
+    filters = EncodeFilters(callback, pathSpan, kLargeBufferSize);
+    NL_TEST_ASSERT(gSuite, filters.size() == 3);
+    filters = EncodeFilters(callback, pathSpan, kLargeBufferSize);
+    NL_TEST_ASSERT(gSuite, filters.size() == 3 && filters[0] == largeCluster && filters[1] == mediumCluster);
+}
+
+void RunSnapshotSequence(ClusterStateCache::StorageMode saveStorageMode, ClusterStateCache::StorageMode loadStorageMode)
+{
+    NullCacheCallback client;
+    ClusterStateCache cache(client, Optional<EventNumber>::Missing(), true, saveStorageMode);
+    ReadClient::Callback & callback = cache.GetBufferedCallback();
+
+    const ConcreteClusterPath dataCluster(1, 0x10);
+    const ConcreteClusterPath otherDataCluster(2, 0x10);
+    const ConcreteAttributePath statusPath(1, 0x20, 3);
+    constexpr size_t kDataSize             = 40;
+    constexpr size_t kOtherDataSize        = 20;
+    constexpr ClusterStatus kClusterStatus = 7;
+
+    AttributePathParams wildcardPath;
+    const Span<AttributePathParams> pathSpan(&wildcardPath, 1);
+    NL_TEST_ASSERT(gSuite, EncodeFilters(callback, pathSpan, 256).empty());
+
+    StatusIB status(Protocols::InteractionModel::Status::Failure);
+    status.mClusterStatus.SetValue(kClusterStatus);
+    callback.OnReportBegin();
+    ReportOctetString(callback, dataCluster, kDataSize, 5);
+    callback.OnAttributeData(ConcreteDataAttributePath(statusPath.mEndpointId, statusPath.mClusterId, statusPath.mAttributeId),
+                             nullptr, status);
+    ReportOctetString(callback, otherDataCluster, kOtherDataSize, 6);
+    callback.OnReportEnd();
+    cache.SetHighestReceivedEventNumber(42);
+
+    uint8_t snapshot[512];
+    TLV::TLVWriter writer;
+    writer.Init(snapshot);
+    NL_TEST_ASSERT(gSuite, cache.SaveSnapshot(writer) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(gSuite, writer.Finalize() == CHIP_NO_ERROR);
+    const ByteSpan snapshotSpan(snapshot, writer.GetLengthWritten());
+
+    NullCacheCallback restoredClient;
+    ClusterStateCache restored(restoredClient, Optional<EventNumber>::Missing(), true, loadStorageMode);
+    NL_TEST_ASSERT(gSuite, restored.LoadSnapshot(snapshotSpan) == CHIP_NO_ERROR);
+
+    // Attribute data and statuses are restored.
+    TLV::TLVReader reader;
+    ByteSpan value;
+    const ConcreteAttributePath dataPath(dataCluster.mEndpointId, dataCluster.mClusterId,
+                                         Clusters::UnitTesting::Attributes::OctetString::Id);
+    NL_TEST_ASSERT(gSuite, restored.Get(dataPath, reader) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(gSuite, reader.Get(value) == CHIP_NO_ERROR && value.size() == kDataSize);
+
+    StatusIB restoredStatus;
+    NL_TEST_ASSERT(gSuite, restored.GetStatus(statusPath, restoredStatus) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(gSuite, restoredStatus.mStatus == Protocols::InteractionModel::Status::Failure);
+    NL_TEST_ASSERT(gSuite, restoredStatus.mClusterStatus.HasValue() && restoredStatus.mClusterStatus.Value() == kClusterStatus);
+
+    // So are the data versions and the event number, which go into the next request.
+    Optional<DataVersion> version;
+    NL_TEST_ASSERT(gSuite, restored.GetVersion(dataCluster, version) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(gSuite, version.HasValue() && version.Value() == 5);
+    NL_TEST_ASSERT(gSuite, restored.GetVersion(otherDataCluster, version) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(gSuite, version.HasValue() && version.Value() == 6);
+
+    Optional<EventNumber> eventNumber;
+    NL_TEST_ASSERT(gSuite, restored.GetHighestReceivedEventNumber(eventNumber) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(gSuite, eventNumber.HasValue() && eventNumber.Value() == 42);
+
+    auto filters = EncodeFilters(restored.GetBufferedCallback(), pathSpan, 256);
+    NL_TEST_ASSERT(gSuite, filters.size() == 2 && filters[0] == dataCluster && filters[1] == otherDataCluster);
+
+    // The restored cache saves the same snapshot again.
+    uint8_t resaved[512];
+    writer.Init(resaved);
+    NL_TEST_ASSERT(gSuite, restored.SaveSnapshot(writer) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(gSuite, writer.Finalize() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(gSuite, snapshotSpan.data_equal(ByteSpan(resaved, writer.GetLengthWritten())));
+
+    // A truncated snapshot is rejected and leaves the cache empty.
+    NullCacheCallback truncatedClient;
+    ClusterStateCache truncated(truncatedClient, Optional<EventNumber>::Missing(), true, loadStorageMode);
+    NL_TEST_ASSERT(gSuite, truncated.LoadSnapshot(snapshotSpan.SubSpan(0, snapshotSpan.size() - 3)) != CHIP_NO_ERROR);
+    NL_TEST_ASSERT(gSuite, truncated.GetVersion(dataCluster, version) == CHIP_ERROR_KEY_NOT_FOUND);
+    NL_TEST_ASSERT(gSuite, truncated.Get(dataPath, reader) == CHIP_ERROR_KEY_NOT_FOUND);
+    NL_TEST_ASSERT(gSuite, EncodeFilters(truncated.GetBufferedCallback(), pathSpan, 256).empty());
+}
+
+void TestSnapshot(nlTestSuite * apSuite, void * apContext)
+{
+    RunSnapshotSequence(ClusterStateCache::StorageMode::kTree, ClusterStateCache::StorageMode::kTree);
+    RunSnapshotSequence(ClusterStateCache::StorageMode::kCompact, ClusterStateCache::StorageMode::kCompact);
+    RunSnapshotSequence(ClusterStateCache::StorageMode::kTree, ClusterStateCache::StorageMode::kCompact);
+    RunSnapshotSequence(ClusterStateCache::StorageMode::kCompact, ClusterStateCache::StorageMode::kTree);
+}
+
+void TestSnapshotCompactHeapSize(nlTestSuite * apSuite, void * apContext)
+{
+    NullCacheCallback client;
+    ClusterStateCache cache(client, Optional<EventNumber>::Missing(), true, ClusterStateCache::StorageMode::kCompact);
+    ReadClient::Callback & callback = cache.GetBufferedCallback();
+
+    constexpr ClusterId kClusterCount           = 10;
+    constexpr AttributeId kAttributesPerCluster = 30;
+    constexpr size_t kAttributeCount            = kClusterCount * kAttributesPerCluster;
+    constexpr size_t kValueSize                 = 8;
+
+    callback.OnReportBegin();
+    for (ClusterId clusterId = 0; clusterId < kClusterCount; clusterId++)
+    {
+        for (AttributeId attributeId = 0; attributeId < kAttributesPerCluster; attributeId++)
+        {
+            ReportOctetString(callback, ConcreteClusterPath(1, clusterId), kValueSize, clusterId, attributeId);
+        }
+    }
+    callback.OnReportEnd();
+
+    std::vector<uint8_t> snapshot(16 * 1024);
+    TLV::TLVWriter writer;
+    writer.Init(snapshot.data(), snapshot.size());
+    NL_TEST_ASSERT(apSuite, cache.SaveSnapshot(writer) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, writer.Finalize() == CHIP_NO_ERROR);
+
+    NullCacheCallback restoredClient;
+    ClusterStateCache restored(restoredClient, Optional<EventNumber>::Missing(), true, ClusterStateCache::StorageMode::kCompact);
+    NL_TEST_ASSERT(apSuite, restored.LoadSnapshot(ByteSpan(snapshot.data(), writer.GetLengthWritten())) == CHIP_NO_ERROR);
+
+    TLV::TLVReader reader;
+    ByteSpan value;
+    NL_TEST_ASSERT(apSuite, restored.Get(ConcreteAttributePath(1, kClusterCount - 1, kAttributesPerCluster - 1), reader) ==
+                       CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, reader.Get(value) == CHIP_NO_ERROR && value.size() == kValueSize);
+
+    // Nothing is reserved beyond the entries and the values: no part of the snapshot that follows a value while it is
+    // stored, and no spare capacity. A cluster entry, its path and two optional data versions, takes at most 32 bytes.
+    const size_t arenaSize   = kAttributeCount * (kValueSize + 2);
+    const size_t maxHeapSize =
+        arenaSize + kAttributeCount * sizeof(CompactClusterStateStorage::AttributeEntry) + kClusterCount * 32;
+    NL_TEST_ASSERT(apSuite, restored.GetCompactStorageHeapSize() >= arenaSize);
+    NL_TEST_ASSERT(apSuite, restored.GetCompactStorageHeapSize() <= maxHeapSize);
+}
+
+void TestSnapshotTreeManyAttributes(nlTestSuite * apSuite, void * apContext)
+{
+    NullCacheCallback client;
+    ClusterStateCache cache(client, Optional<EventNumber>::Missing(), true, ClusterStateCache::StorageMode::kTree);
+    ReadClient::Callback & callback = cache.GetBufferedCallback();
+
+    // Each value is copied out of a snapshot of about 20KB, and sized without copying the rest of it.
+    constexpr ClusterId kClusterCount           = 20;
+    constexpr AttributeId kAttributesPerCluster = 20;
+    auto valueSize = [](ClusterId clusterId, AttributeId attributeId) -> size_t { return (clusterId + attributeId) % 64 + 1; };
+
+    callback.OnReportBegin();
+    for (ClusterId clusterId = 0; clusterId < kClusterCount; clusterId++)
+    {
+        for (AttributeId attributeId = 0; attributeId < kAttributesPerCluster; attributeId++)
+        {
+            ReportOctetString(callback, ConcreteClusterPath(1, clusterId), valueSize(clusterId, attributeId), clusterId,
+                              attributeId);
+        }
+    }
+    callback.OnReportEnd();
+
+    std::vector<uint8_t> snapshot(32 * 1024);
+    TLV::TLVWriter writer;
+    writer.Init(snapshot.data(), snapshot.size());
+    NL_TEST_ASSERT(apSuite, cache.SaveSnapshot(writer) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, writer.Finalize() == CHIP_NO_ERROR);
+    const uint32_t snapshotLength = writer.GetLengthWritten();
+
+    NullCacheCallback restoredClient;
+    ClusterStateCache restored(restoredClient, Optional<EventNumber>::Missing(), true, ClusterStateCache::StorageMode::kTree);
+    NL_TEST_ASSERT(apSuite, restored.LoadSnapshot(ByteSpan(snapshot.data(), snapshotLength)) == CHIP_NO_ERROR);
+
+    for (ClusterId clusterId = 0; clusterId < kClusterCount; clusterId++)
+    {
+        for (AttributeId attributeId = 0; attributeId < kAttributesPerCluster; attributeId++)
+        {
+            TLV::TLVReader reader;
+            ByteSpan value;
+            NL_TEST_ASSERT(apSuite, restored.Get(ConcreteAttributePath(1, clusterId, attributeId), reader) == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(apSuite, reader.Get(value) == CHIP_NO_ERROR && value.size() == valueSize(clusterId, attributeId));
+        }
+    }
+
+    // The restored values keep their exact encoding, so saving them again gives the same snapshot.
+    std::vector<uint8_t> resaved(snapshot.size());
+    writer.Init(resaved.data(), resaved.size());
+    NL_TEST_ASSERT(apSuite, restored.SaveSnapshot(writer) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, writer.Finalize() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, writer.GetLengthWritten() == snapshotLength);
+    NL_TEST_ASSERT(apSuite, memcmp(resaved.data(), snapshot.data(), snapshotLength) == 0);
+}
+
+void TestDataVersionFilters(nlTestSuite * apSuite, void * apContext)
+{
+    RunDataVersionFilterSequence(ClusterStateCache::StorageMode::kTree);
+}
+
+void TestDataVersionFiltersCompact(nlTestSuite * apSuite, void * apContext)
+{
+    RunDataVersionFilterSequence(ClusterStateCache::StorageMode::kCompact);
 }
 
 // clang-format off
 const nlTest sTests[] =
 {
     NL_TEST_DEF("TestCache", TestCache),
+    NL_TEST_DEF("TestCacheCompact", TestCacheCompact),
+    NL_TEST_DEF("TestDataVersionFilters", TestDataVersionFilters),
+    NL_TEST_DEF("TestDataVersionFiltersCompact", TestDataVersionFiltersCompact),
+    NL_TEST_DEF("TestSnapshot", TestSnapshot),
+    NL_TEST_DEF("TestSnapshotCompactHeapSize", TestSnapshotCompactHeapSize),
+    NL_TEST_DEF("TestSnapshotTreeManyAttributes", TestSnapshotTreeManyAttributes),
     NL_TEST_SENTINEL()
 };
 
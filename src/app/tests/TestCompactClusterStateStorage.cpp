@@ -0,0 +1,221 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the flat attribute storage of the compact ClusterStateCache.
+ *
+ */
+
+#include <app/CompactClusterStateStorage.h>
+#include <lib/core/TLVReader.h>
+#include <lib/core/TLVWriter.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/UnitTestRegistration.h>
+
+#include <nlunit-test.h>
+
+#include <string.h>
+#include <vector>
+
+using namespace chip;
+using namespace chip::app;
+
+namespace {
+
+constexpr size_t kMaxValueSize = 256;
+
+/*
+ * Store an octet string of the given length filled with fill as the value of path. When trailerLength is not 0, the
+ * string is followed by a second one of that length in the same buffer, the way a value is followed by the rest of a
+ * report.
+ */
+CHIP_ERROR SetString(CompactClusterStateStorage & storage, const ConcreteAttributePath & path, size_t length, uint8_t fill,
+                     size_t trailerLength = 0)
+{
+    uint8_t value[kMaxValueSize];
+    VerifyOrReturnError(length <= sizeof(value), CHIP_ERROR_INVALID_ARGUMENT);
+    memset(value, fill, length);
+
+    std::vector<uint8_t> trailer(trailerLength);
+    std::vector<uint8_t> buffer(length + trailerLength + 32);
+
+    TLV::TLVWriter writer;
+    writer.Init(buffer.data(), buffer.size());
+    ReturnErrorOnFailure(writer.PutBytes(TLV::AnonymousTag(), value, static_cast<uint32_t>(length)));
+    if (trailerLength != 0)
+    {
+        ReturnErrorOnFailure(writer.PutBytes(TLV::AnonymousTag(), trailer.data(), static_cast<uint32_t>(trailerLength)));
+    }
+    ReturnErrorOnFailure(writer.Finalize());
+
+    TLV::TLVReader reader;
+    reader.Init(buffer.data(), writer.GetLengthWritten());
+    ReturnErrorOnFailure(reader.Next());
+    return storage.SetData(path, reader);
+}
+
+bool HasString(const CompactClusterStateStorage & storage, const ConcreteAttributePath & path, size_t length, uint8_t fill)
+{
+    const CompactClusterStateStorage::AttributeEntry * entry = storage.FindAttribute(path);
+    if (entry == nullptr || entry->mKind != CompactClusterStateStorage::AttributeKind::kData)
+    {
+        return false;
+    }
+
+    TLV::TLVReader reader;
+    ByteSpan value;
+    reader.Init(storage.GetData(*entry));
+    if (reader.Next() != CHIP_NO_ERROR || reader.Get(value) != CHIP_NO_ERROR || value.size() != length)
+    {
+        return false;
+    }
+    for (uint8_t byte : value)
+    {
+        if (byte != fill)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void TestInsertInMiddle(nlTestSuite * apSuite, void * apContext)
+{
+    CompactClusterStateStorage storage;
+
+    // Only the first three paths arrive in order; the others go before the last cluster or attribute.
+    const ConcreteAttributePath paths[] = {
+        ConcreteAttributePath(1, 6, 0), ConcreteAttributePath(1, 6, 2), ConcreteAttributePath(1, 8, 0),
+        ConcreteAttributePath(1, 6, 1), ConcreteAttributePath(0, 6, 0), ConcreteAttributePath(1, 7, 5),
+        ConcreteAttributePath(2, 6, 0),
+    };
+    for (size_t i = 0; i < ArraySize(paths); i++)
+    {
+        NL_TEST_ASSERT(apSuite, SetString(storage, paths[i], 4 + i, static_cast<uint8_t>(i + 1)) == CHIP_NO_ERROR);
+    }
+
+    for (size_t i = 0; i < ArraySize(paths); i++)
+    {
+        NL_TEST_ASSERT(apSuite, HasString(storage, paths[i], 4 + i, static_cast<uint8_t>(i + 1)));
+    }
+    NL_TEST_ASSERT(apSuite, storage.FindAttribute(ConcreteAttributePath(1, 6, 3)) == nullptr);
+    NL_TEST_ASSERT(apSuite, storage.FindCluster(ConcreteClusterPath(0, 8)) == nullptr);
+    NL_TEST_ASSERT(apSuite, storage.HasEndpoint(0));
+    NL_TEST_ASSERT(apSuite, !storage.HasEndpoint(3));
+
+    const ConcreteClusterPath expectedClusters[] = {
+        ConcreteClusterPath(0, 6), ConcreteClusterPath(1, 6), ConcreteClusterPath(1, 7),
+        ConcreteClusterPath(1, 8), ConcreteClusterPath(2, 6),
+    };
+    size_t clusterCount = 0;
+    NL_TEST_ASSERT(apSuite,
+                   storage.ForEachCluster([&](const ConcreteClusterPath & path, const CompactClusterStateStorage::ClusterVersions &) {
+                       VerifyOrReturnError(clusterCount < ArraySize(expectedClusters), CHIP_ERROR_INTERNAL);
+                       VerifyOrReturnError(path == expectedClusters[clusterCount++], CHIP_ERROR_INTERNAL);
+                       return CHIP_NO_ERROR;
+                   }) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, clusterCount == ArraySize(expectedClusters));
+
+    AttributeId nextAttributeId = 0;
+    NL_TEST_ASSERT(apSuite, storage.ForEachAttributeEntry(1, 6, [&](const CompactClusterStateStorage::AttributeEntry & entry) {
+        VerifyOrReturnError(entry.mAttributeId == nextAttributeId++, CHIP_ERROR_INTERNAL);
+        return CHIP_NO_ERROR;
+    }) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, nextAttributeId == 3);
+
+    // A value in the middle that keeps its size is overwritten in place and leaves its neighbors alone.
+    NL_TEST_ASSERT(apSuite, SetString(storage, paths[3], 4 + 3, 0xAA) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, HasString(storage, paths[3], 4 + 3, 0xAA));
+    NL_TEST_ASSERT(apSuite, HasString(storage, paths[0], 4, 1));
+    NL_TEST_ASSERT(apSuite, HasString(storage, paths[1], 4 + 1, 2));
+}
+
+void TestArenaCompaction(nlTestSuite * apSuite, void * apContext)
+{
+    CompactClusterStateStorage storage;
+    const ConcreteAttributePath kept(1, 6, 0);
+    const ConcreteAttributePath updated(1, 6, 1);
+    const ConcreteAttributePath after(1, 6, 2);
+
+    NL_TEST_ASSERT(apSuite, SetString(storage, kept, 64, 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, SetString(storage, after, 16, 3) == CHIP_NO_ERROR);
+
+    // Each update changes the size of the value, so it is appended to the arena and the old bytes are left behind.
+    constexpr size_t kUpdateCount = 200;
+    for (size_t i = 0; i < kUpdateCount; i++)
+    {
+        const size_t length = 100 + (i % 2);
+        NL_TEST_ASSERT(apSuite, SetString(storage, updated, length, static_cast<uint8_t>(i)) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, HasString(storage, updated, length, static_cast<uint8_t>(i)));
+    }
+
+    NL_TEST_ASSERT(apSuite, HasString(storage, kept, 64, 1));
+    NL_TEST_ASSERT(apSuite, HasString(storage, after, 16, 3));
+
+    // Without compaction the arena would hold every one of the ~20KB of updates.
+    NL_TEST_ASSERT(apSuite, storage.GetHeapSize() < 2048);
+
+    storage.Clear();
+    NL_TEST_ASSERT(apSuite, storage.FindAttribute(kept) == nullptr);
+    NL_TEST_ASSERT(apSuite, storage.GetHeapSize() == 0);
+}
+
+void TestValueFollowedByReport(nlTestSuite * apSuite, void * apContext)
+{
+    CompactClusterStateStorage storage;
+
+    // Only the value itself is reserved in the arena, not the rest of the report after it.
+    NL_TEST_ASSERT(apSuite, SetString(storage, ConcreteAttributePath(1, 6, 0), 8, 1, 4096) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, HasString(storage, ConcreteAttributePath(1, 6, 0), 8, 1));
+    NL_TEST_ASSERT(apSuite, storage.GetHeapSize() < 512);
+}
+
+int Initialize(void * apContext)
+{
+    return chip::Platform::MemoryInit() == CHIP_NO_ERROR ? SUCCESS : FAILURE;
+}
+
+int Finalize(void * apContext)
+{
+    chip::Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("TestInsertInMiddle", TestInsertInMiddle),
+    NL_TEST_DEF("TestArenaCompaction", TestArenaCompaction),
+    NL_TEST_DEF("TestValueFollowedByReport", TestValueFollowedByReport),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+} // namespace
+
+int TestCompactClusterStateStorage()
+{
+    nlTestSuite theSuite = { "TestCompactClusterStateStorage", &sTests[0], Initialize, Finalize };
+
+    nlTestRunner(&theSuite, nullptr);
+
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestCompactClusterStateStorage)
@@ -0,0 +1,251 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the indexed dirty path set of the reporting engine.
+ *
+ */
+
+#include <app/reporting/DirtyPathSet.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/UnitTestRegistration.h>
+
+#include <nlunit-test.h>
+
+#include <stdlib.h>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::app::reporting;
+
+namespace {
+
+constexpr size_t kSetSize = 8;
+
+using InlineDirtyPathSet = DirtyPathSet<kSetSize, ObjectPoolMem::kInline>;
+
+size_t CountPaths(const DirtyPathSetBase & aSet)
+{
+    size_t count = 0;
+    aSet.ForEachPath([&count](auto * path) {
+        count++;
+        return Loop::Continue;
+    });
+    return count;
+}
+
+bool ContainsPath(const DirtyPathSetBase & aSet, const AttributePathParams & aPath)
+{
+    return aSet.ForEachPath([&aPath](auto * path) {
+        return (static_cast<const AttributePathParams &>(*path) == aPath) ? Loop::Break : Loop::Continue;
+    }) == Loop::Break;
+}
+
+void TestConcretePaths(nlTestSuite * apSuite, void * apContext)
+{
+    InlineDirtyPathSet set;
+
+    NL_TEST_ASSERT(apSuite, set.Insert(AttributePathParams(2, 6, 1), 2) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, set.Insert(AttributePathParams(1, 6, 1), 3) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, set.Insert(AttributePathParams(1, 8, 0), 4) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, set.Insert(AttributePathParams(1, 6, 1), 5) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, set.Allocated() == 3);
+
+    NL_TEST_ASSERT(apSuite, set.IsDirtySince(ConcreteAttributePath(1, 6, 1), 4));
+    NL_TEST_ASSERT(apSuite, !set.IsDirtySince(ConcreteAttributePath(1, 6, 1), 5));
+    NL_TEST_ASSERT(apSuite, set.IsDirtySince(ConcreteAttributePath(2, 6, 1), 1));
+    NL_TEST_ASSERT(apSuite, !set.IsDirtySince(ConcreteAttributePath(2, 6, 1), 2));
+    NL_TEST_ASSERT(apSuite, !set.IsDirtySince(ConcreteAttributePath(1, 6, 2), 0));
+    NL_TEST_ASSERT(apSuite, !set.IsDirtySince(ConcreteAttributePath(3, 6, 1), 0));
+
+    // Paths are visited in (endpoint, cluster, attribute) order.
+    AttributePathParams expected[] = { AttributePathParams(1, 6, 1), AttributePathParams(1, 8, 0), AttributePathParams(2, 6, 1) };
+    size_t index                   = 0;
+    set.ForEachPath([&](auto * path) {
+        NL_TEST_ASSERT(apSuite, static_cast<const AttributePathParams &>(*path) == expected[index]);
+        index++;
+        return Loop::Continue;
+    });
+    NL_TEST_ASSERT(apSuite, index == 3);
+}
+
+void TestWildcardPaths(nlTestSuite * apSuite, void * apContext)
+{
+    InlineDirtyPathSet set;
+
+    NL_TEST_ASSERT(apSuite, set.Insert(AttributePathParams(1, 6, 1), 2) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, set.Insert(AttributePathParams(1, 6, 2), 2) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, set.Insert(AttributePathParams(1, 8, 0), 2) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, set.Insert(AttributePathParams(2, 6, 1), 2) == CHIP_NO_ERROR);
+
+    // A wildcard attribute path absorbs all the paths of its cluster.
+    NL_TEST_ASSERT(apSuite, set.Insert(AttributePathParams(EndpointId(1), ClusterId(6)), 3) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, set.Allocated() == 3);
+    NL_TEST_ASSERT(apSuite, ContainsPath(set, AttributePathParams(EndpointId(1), ClusterId(6))));
+    NL_TEST_ASSERT(apSuite, set.IsDirtySince(ConcreteAttributePath(1, 6, 100), 2));
+    NL_TEST_ASSERT(apSuite, !set.IsDirtySince(ConcreteAttributePath(1, 8, 0), 2));
+
+    // A covered path only bumps the generation of the covering path.
+    NL_TEST_ASSERT(apSuite, set.Insert(AttributePathParams(1, 6, 5, 3), 4) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, set.Allocated() == 3);
+    NL_TEST_ASSERT(apSuite, set.IsDirtySince(ConcreteAttributePath(1, 6, 1), 3));
+
+    // A wildcard endpoint path only matches its cluster.
+    NL_TEST_ASSERT(apSuite, set.Insert(AttributePathParams(kInvalidEndpointId, 0x28, kInvalidAttributeId), 5) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, set.IsDirtySince(ConcreteAttributePath(7, 0x28, 3), 4));
+    NL_TEST_ASSERT(apSuite, !set.IsDirtySince(ConcreteAttributePath(7, 0x29, 3), 0));
+
+    NL_TEST_ASSERT(apSuite, set.IntersectsSince(AttributePathParams(EndpointId(2), kInvalidClusterId), 1));
+    NL_TEST_ASSERT(apSuite, !set.IntersectsSince(AttributePathParams(EndpointId(2), ClusterId(6)), 2));
+    NL_TEST_ASSERT(apSuite, set.IntersectsSince(AttributePathParams(kInvalidEndpointId, 6, 1), 3));
+    NL_TEST_ASSERT(apSuite, !set.IntersectsSince(AttributePathParams(kInvalidEndpointId, 7, 1), 0));
+
+    // The full wildcard path replaces everything.
+    NL_TEST_ASSERT(apSuite, set.Insert(AttributePathParams(), 6) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, set.Allocated() == 1);
+    NL_TEST_ASSERT(apSuite, set.IsDirtySince(ConcreteAttributePath(9, 9, 9), 5));
+}
+
+void TestExhaustion(nlTestSuite * apSuite, void * apContext)
+{
+    InlineDirtyPathSet set;
+
+    // Paths are kept as-is while there is room for them.
+    for (AttributeId i = 1; i <= kSetSize; i++)
+    {
+        NL_TEST_ASSERT(apSuite, set.Insert(AttributePathParams(EndpointId(1), ClusterId(6), i), i) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(apSuite, set.Allocated() == kSetSize);
+
+    // The paths under the same cluster are merged to make room for a path of another cluster.
+    NL_TEST_ASSERT(apSuite, set.Insert(AttributePathParams(2, 6, 1), kSetSize + 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, CountPaths(set) == 2);
+    NL_TEST_ASSERT(apSuite, ContainsPath(set, AttributePathParams(EndpointId(1), ClusterId(6))));
+    NL_TEST_ASSERT(apSuite, ContainsPath(set, AttributePathParams(2, 6, 1)));
+    // The merged path keeps the newest generation.
+    NL_TEST_ASSERT(apSuite, set.IsDirtySince(ConcreteAttributePath(1, 6, 1), kSetSize - 1));
+    NL_TEST_ASSERT(apSuite, !set.IsDirtySince(ConcreteAttributePath(1, 6, 1), kSetSize));
+}
+
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+void TestHeapGrowsWithoutMerging(nlTestSuite * apSuite, void * apContext)
+{
+    DirtyPathSet<kSetSize, ObjectPoolMem::kHeap> set;
+
+    for (EndpointId endpoint = 1; endpoint <= 10 * kSetSize; endpoint++)
+    {
+        NL_TEST_ASSERT(apSuite, set.Insert(AttributePathParams(endpoint, 6, endpoint), endpoint) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(apSuite, set.Allocated() == 10 * kSetSize);
+
+    for (EndpointId endpoint = 1; endpoint <= 10 * kSetSize; endpoint++)
+    {
+        NL_TEST_ASSERT(apSuite, set.IsDirtySince(ConcreteAttributePath(endpoint, 6, endpoint), endpoint - 1u));
+        NL_TEST_ASSERT(apSuite, !set.IsDirtySince(ConcreteAttributePath(endpoint, 6, endpoint), endpoint));
+        NL_TEST_ASSERT(apSuite, !set.IsDirtySince(ConcreteAttributePath(endpoint, 6, endpoint + 1u), 0));
+    }
+}
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+
+/**
+ * Compare the indexed lookups against a linear scan of the set, for random paths with random wildcards.
+ */
+void TestLookupMatchesLinearScan(nlTestSuite * apSuite, void * apContext)
+{
+    InlineDirtyPathSet set;
+
+    auto randomPath = []() {
+        AttributePathParams path(static_cast<EndpointId>(rand() % 4), static_cast<ClusterId>(rand() % 4),
+                                 static_cast<AttributeId>(rand() % 4));
+        if (rand() % 8 == 0)
+        {
+            path.SetWildcardEndpointId();
+        }
+        if (rand() % 6 == 0)
+        {
+            path.SetWildcardClusterId();
+        }
+        if (rand() % 4 == 0)
+        {
+            path.SetWildcardAttributeId();
+        }
+        return path;
+    };
+
+    srand(1);
+    for (uint64_t generation = 1; generation < 1000; generation++)
+    {
+        NL_TEST_ASSERT(apSuite, set.Insert(randomPath(), generation) == CHIP_NO_ERROR);
+
+        AttributePathParams query = randomPath();
+        uint64_t since            = static_cast<uint64_t>(rand()) % generation;
+
+        bool expected = set.ForEachPath([&](auto * path) {
+            return (path->mGeneration > since && path->Intersects(query)) ? Loop::Break : Loop::Continue;
+        }) == Loop::Break;
+        NL_TEST_ASSERT(apSuite, set.IntersectsSince(query, since) == expected);
+
+        // No path of the set is a superset of another one.
+        set.ForEachPath([&](auto * outer) {
+            set.ForEachPath([&](auto * inner) {
+                NL_TEST_ASSERT(apSuite, outer == inner || !outer->IsAttributePathSupersetOf(*inner));
+                return Loop::Continue;
+            });
+            return Loop::Continue;
+        });
+    }
+}
+
+int Initialize(void * apContext)
+{
+    return chip::Platform::MemoryInit() == CHIP_NO_ERROR ? SUCCESS : FAILURE;
+}
+
+int Finalize(void * apContext)
+{
+    chip::Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("TestConcretePaths", TestConcretePaths),
+    NL_TEST_DEF("TestWildcardPaths", TestWildcardPaths),
+    NL_TEST_DEF("TestExhaustion", TestExhaustion),
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    NL_TEST_DEF("TestHeapGrowsWithoutMerging", TestHeapGrowsWithoutMerging),
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    NL_TEST_DEF("TestLookupMatchesLinearScan", TestLookupMatchesLinearScan),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+} // namespace
+
+int TestDirtyPathSet()
+{
+    nlTestSuite theSuite = { "TestDirtyPathSet", &sTests[0], Initialize, Finalize };
+
+    nlTestRunner(&theSuite, nullptr);
+
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestDirtyPathSet)
@@ -0,0 +1,261 @@
+/*
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <lib/support/UnitTestRegistration.h>
+#include <nlunit-test.h>
+
+#include <app/IndexedSubscriptionResumptionStorage.h>
+#include <app/SimpleSubscriptionResumptionStorage.h>
+#include <lib/support/TestPersistentStorageDelegate.h>
+
+#include <lib/support/DefaultStorageKeyAllocator.h>
+
+namespace {
+
+using SubscriptionInfo = chip::app::SubscriptionResumptionStorage::SubscriptionInfo;
+
+void MakeSubscription(SubscriptionInfo & subscriptionInfo, chip::NodeId nodeId, chip::FabricIndex fabricIndex,
+                      chip::SubscriptionId subscriptionId)
+{
+    subscriptionInfo.mNodeId         = nodeId;
+    subscriptionInfo.mFabricIndex    = fabricIndex;
+    subscriptionInfo.mSubscriptionId = subscriptionId;
+    subscriptionInfo.mMinInterval    = 1;
+    subscriptionInfo.mMaxInterval    = 10;
+    subscriptionInfo.mFabricFiltered = true;
+    subscriptionInfo.mAttributePaths.Calloc(1);
+    subscriptionInfo.mAttributePaths[0].mEndpointId  = 1;
+    subscriptionInfo.mAttributePaths[0].mClusterId   = 6;
+    subscriptionInfo.mAttributePaths[0].mAttributeId = 0;
+    subscriptionInfo.mEventPaths.Calloc(1);
+    subscriptionInfo.mEventPaths[0].mEndpointId    = 0;
+    subscriptionInfo.mEventPaths[0].mClusterId     = 0x28;
+    subscriptionInfo.mEventPaths[0].mEventId       = 0;
+    subscriptionInfo.mEventPaths[0].mIsUrgentEvent = true;
+}
+
+size_t IterateAll(chip::app::SubscriptionResumptionStorage & subscriptionStorage)
+{
+    size_t count    = 0;
+    auto * iterator = subscriptionStorage.IterateSubscriptions();
+    SubscriptionInfo subscriptionInfo;
+    while (iterator->Next(subscriptionInfo))
+    {
+        count++;
+    }
+    iterator->Release();
+    return count;
+}
+
+bool IsPersisted(chip::TestPersistentStorageDelegate & storage, uint16_t subscriptionIndex)
+{
+    return storage.HasKey(chip::DefaultStorageKeyAllocator::SubscriptionResumption(subscriptionIndex).KeyName());
+}
+
+} // namespace
+
+void TestBulkLoad(nlTestSuite * inSuite, void * inContext)
+{
+    chip::TestPersistentStorageDelegate storage;
+
+    // Subscriptions persisted by the simple storage are picked up
+    chip::app::SimpleSubscriptionResumptionStorage simpleStorage;
+    NL_TEST_ASSERT(inSuite, simpleStorage.Init(&storage) == CHIP_NO_ERROR);
+    for (chip::SubscriptionId subscriptionId = 1; subscriptionId <= 3; subscriptionId++)
+    {
+        SubscriptionInfo subscriptionInfo;
+        MakeSubscription(subscriptionInfo, 1111, 1, subscriptionId);
+        NL_TEST_ASSERT(inSuite, simpleStorage.Save(subscriptionInfo) == CHIP_NO_ERROR);
+    }
+
+    chip::app::IndexedSubscriptionResumptionStorage subscriptionStorage;
+    NL_TEST_ASSERT(inSuite, subscriptionStorage.Init(&storage) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, subscriptionStorage.GetStats().mStorageReads == CHIP_IM_MAX_NUM_SUBSCRIPTIONS);
+    subscriptionStorage.ResetStats();
+
+    // Iterating only reads the indices that hold a subscription
+    auto * iterator = subscriptionStorage.IterateSubscriptions();
+    NL_TEST_ASSERT(inSuite, iterator->Count() == 3);
+    iterator->Release();
+    NL_TEST_ASSERT(inSuite, IterateAll(subscriptionStorage) == 3);
+    NL_TEST_ASSERT(inSuite, subscriptionStorage.GetStats().mStorageReads == 3);
+
+    // Saving or deleting does not read the persistent storage
+    SubscriptionInfo subscriptionInfo;
+    MakeSubscription(subscriptionInfo, 2222, 2, 4);
+    NL_TEST_ASSERT(inSuite, subscriptionStorage.Save(subscriptionInfo) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, subscriptionStorage.Delete(1111, 1, 2) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, subscriptionStorage.GetStats().mStorageReads == 3);
+    NL_TEST_ASSERT(inSuite, subscriptionStorage.GetStats().mStorageWrites == 1);
+
+    // And the result is readable by the simple storage
+    NL_TEST_ASSERT(inSuite, IterateAll(simpleStorage) == 3);
+}
+
+void TestUnchangedSave(nlTestSuite * inSuite, void * inContext)
+{
+    chip::TestPersistentStorageDelegate storage;
+    chip::app::IndexedSubscriptionResumptionStorage subscriptionStorage;
+    NL_TEST_ASSERT(inSuite, subscriptionStorage.Init(&storage) == CHIP_NO_ERROR);
+
+    SubscriptionInfo subscriptionInfo;
+    MakeSubscription(subscriptionInfo, 1111, 1, 1);
+    NL_TEST_ASSERT(inSuite, subscriptionStorage.Save(subscriptionInfo) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, subscriptionStorage.GetStats().mStorageWrites == 1);
+
+    // Re-established with the same parameters: nothing to write
+    NL_TEST_ASSERT(inSuite, subscriptionStorage.Save(subscriptionInfo) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, subscriptionStorage.GetStats().mStorageWrites == 1);
+    NL_TEST_ASSERT(inSuite, subscriptionStorage.GetStats().mUnchangedSaves == 1);
+
+    // Changed parameters are written in place
+    subscriptionInfo.mMaxInterval = 20;
+    NL_TEST_ASSERT(inSuite, subscriptionStorage.Save(subscriptionInfo) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, subscriptionStorage.GetStats().mStorageWrites == 2);
+    NL_TEST_ASSERT(inSuite, IsPersisted(storage, 0));
+    NL_TEST_ASSERT(inSuite, !IsPersisted(storage, 1));
+
+    auto * iterator = subscriptionStorage.IterateSubscriptions();
+    SubscriptionInfo loadedInfo;
+    NL_TEST_ASSERT(inSuite, iterator->Next(loadedInfo));
+    NL_TEST_ASSERT(inSuite, loadedInfo.mMaxInterval == 20);
+    NL_TEST_ASSERT(inSuite, !iterator->Next(loadedInfo));
+    iterator->Release();
+
+    // The fingerprint survives a restart
+    chip::app::IndexedSubscriptionResumptionStorage restarted;
+    NL_TEST_ASSERT(inSuite, restarted.Init(&storage) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, restarted.Save(subscriptionInfo) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, restarted.GetStats().mStorageWrites == 0);
+    NL_TEST_ASSERT(inSuite, restarted.GetStats().mUnchangedSaves == 1);
+}
+
+void TestDelete(nlTestSuite * inSuite, void * inContext)
+{
+    chip::TestPersistentStorageDelegate storage;
+    chip::app::IndexedSubscriptionResumptionStorage subscriptionStorage;
+    NL_TEST_ASSERT(inSuite, subscriptionStorage.Init(&storage) == CHIP_NO_ERROR);
+
+    SubscriptionInfo subscriptionInfo1;
+    SubscriptionInfo subscriptionInfo2;
+    SubscriptionInfo subscriptionInfo3;
+    MakeSubscription(subscriptionInfo1, 1111, 1, 1);
+    MakeSubscription(subscriptionInfo2, 1111, 1, 2);
+    MakeSubscription(subscriptionInfo3, 2222, 2, 3);
+    NL_TEST_ASSERT(inSuite, subscriptionStorage.Save(subscriptionInfo1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, subscriptionStorage.Save(subscriptionInfo2) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, subscriptionStorage.Save(subscriptionInfo3) == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, subscriptionStorage.Delete(1111, 1, 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, subscriptionStorage.Delete(1111, 1, 1) == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+    NL_TEST_ASSERT(inSuite, !IsPersisted(storage, 0));
+
+    // A freed index is reused
+    NL_TEST_ASSERT(inSuite, subscriptionStorage.Save(subscriptionInfo1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, IsPersisted(storage, 0));
+
+    NL_TEST_ASSERT(inSuite, subscriptionStorage.DeleteAll(1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, IterateAll(subscriptionStorage) == 1);
+    NL_TEST_ASSERT(inSuite, storage.HasKey(chip::DefaultStorageKeyAllocator::SubscriptionResumptionMaxCount().KeyName()));
+
+    // if there are no persisted subscriptions, the MaxCount is also deleted
+    NL_TEST_ASSERT(inSuite, subscriptionStorage.DeleteAll(2) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, IterateAll(subscriptionStorage) == 0);
+    NL_TEST_ASSERT(inSuite, storage.GetNumKeys() == 0);
+    NL_TEST_ASSERT(inSuite, subscriptionStorage.GetStats().mStorageReads == CHIP_IM_MAX_NUM_SUBSCRIPTIONS + 1);
+}
+
+void TestSubscriptionMaxCount(nlTestSuite * inSuite, void * inContext)
+{
+    chip::TestPersistentStorageDelegate storage;
+    chip::app::IndexedSubscriptionResumptionStorage subscriptionStorage;
+    NL_TEST_ASSERT(inSuite, subscriptionStorage.Init(&storage) == CHIP_NO_ERROR);
+
+    for (chip::SubscriptionId subscriptionId = 0; subscriptionId < CHIP_IM_MAX_NUM_SUBSCRIPTIONS; subscriptionId++)
+    {
+        SubscriptionInfo subscriptionInfo;
+        MakeSubscription(subscriptionInfo, 1111, 1, subscriptionId);
+        NL_TEST_ASSERT(inSuite, subscriptionStorage.Save(subscriptionInfo) == CHIP_NO_ERROR);
+    }
+
+    SubscriptionInfo subscriptionInfo;
+    MakeSubscription(subscriptionInfo, 1111, 1, CHIP_IM_MAX_NUM_SUBSCRIPTIONS);
+    NL_TEST_ASSERT(inSuite, subscriptionStorage.Save(subscriptionInfo) == CHIP_ERROR_NO_MEMORY);
+    NL_TEST_ASSERT(inSuite, IterateAll(subscriptionStorage) == CHIP_IM_MAX_NUM_SUBSCRIPTIONS);
+}
+
+// Test Suite
+
+/**
+ *  Test Suite that lists all the test functions.
+ */
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("TestBulkLoad", TestBulkLoad),
+    NL_TEST_DEF("TestUnchangedSave", TestUnchangedSave),
+    NL_TEST_DEF("TestDelete", TestDelete),
+    NL_TEST_DEF("TestSubscriptionMaxCount", TestSubscriptionMaxCount),
+
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+/**
+ *  Set up the test suite.
+ */
+int TestIndexedSubscriptionResumptionStorage_Setup(void * inContext)
+{
+    CHIP_ERROR error = chip::Platform::MemoryInit();
+    if (error != CHIP_NO_ERROR)
+    {
+        return FAILURE;
+    }
+    return SUCCESS;
+}
+
+/**
+ *  Tear down the test suite.
+ */
+int TestIndexedSubscriptionResumptionStorage_Teardown(void * inContext)
+{
+    chip::Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+// clang-format off
+static nlTestSuite sSuite =
+{
+    "Test-CHIP-IndexedSubscriptionResumptionStorage",
+    &sTests[0],
+    TestIndexedSubscriptionResumptionStorage_Setup,
+    TestIndexedSubscriptionResumptionStorage_Teardown,
+};
+// clang-format on
+
+/**
+ *  Main
+ */
+int TestIndexedSubscriptionResumptionStorage()
+{
+    // Run test suit against one context
+    nlTestRunner(&sSuite, nullptr);
+
+    return (nlTestRunnerStats(&sSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestIndexedSubscriptionResumptionStorage)
@@ -0,0 +1,202 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the index from attribute paths to the ReadHandlers interested in them.
+ *
+ */
+
+#include <app/InteractionModelEngine.h>
+#include <app/ReadHandler.h>
+#include <app/reporting/ReadHandlerInterestIndex.h>
+#include <app/tests/AppTestContext.h>
+#include <lib/support/Pool.h>
+#include <lib/support/UnitTestContext.h>
+#include <lib/support/UnitTestRegistration.h>
+
+#include <nlunit-test.h>
+
+using TestContext = chip::Test::AppContext;
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::app::reporting;
+
+namespace {
+
+class NullReadHandlerCallback : public ReadHandler::ManagementCallback
+{
+public:
+    void OnDone(ReadHandler & apReadHandlerObj) override {}
+    ReadHandler::ApplicationCallback * GetAppCallback() override { return nullptr; }
+};
+
+/**
+ * Read handlers, each on its own exchange, for the index to refer to.
+ */
+class TestReadHandlers
+{
+public:
+    static constexpr size_t kCount = 3;
+
+    TestReadHandlers(nlTestSuite * apSuite, TestContext & aCtx)
+    {
+        for (auto & handler : mHandlers)
+        {
+            handler = mPool.CreateObject(mCallback, aCtx.NewExchangeToAlice(nullptr, false), ReadHandler::InteractionType::Read);
+            NL_TEST_ASSERT(apSuite, handler != nullptr);
+        }
+    }
+
+    ~TestReadHandlers() { mPool.ReleaseAll(); }
+
+    ReadHandler & operator[](size_t aIndex) { return *mHandlers[aIndex]; }
+
+private:
+    NullReadHandlerCallback mCallback;
+    ObjectPool<ReadHandler, kCount> mPool;
+    ReadHandler * mHandlers[kCount] = {};
+};
+
+/**
+ * Returns a bitmask of the handlers interested in aPath, and counts the number of visits in aVisits.
+ */
+uint32_t InterestedHandlers(TestReadHandlers & aHandlers, ReadHandlerInterestIndex & aIndex, const AttributePathParams & aPath,
+                            size_t & aVisits)
+{
+    uint32_t handlers = 0;
+    aVisits           = 0;
+    aIndex.ForEachInterestedReadHandler(aPath, [&](ReadHandler * handler) {
+        for (size_t i = 0; i < TestReadHandlers::kCount; i++)
+        {
+            if (handler == &aHandlers[i])
+            {
+                handlers |= (1u << i);
+            }
+        }
+        aVisits++;
+        return Loop::Continue;
+    });
+    return handlers;
+}
+
+uint32_t InterestedHandlers(TestReadHandlers & aHandlers, ReadHandlerInterestIndex & aIndex, const AttributePathParams & aPath)
+{
+    size_t visits;
+    return InterestedHandlers(aHandlers, aIndex, aPath, visits);
+}
+
+void TestLookup(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    TestReadHandlers handlers(apSuite, ctx);
+    ReadHandlerInterestIndex index;
+
+    // Handler 0 subscribes to one concrete attribute and to a whole cluster of another endpoint.
+    ObjectList<AttributePathParams> handler0Paths[2];
+    handler0Paths[0].mValue = AttributePathParams(1, 6, 0);
+    handler0Paths[0].mpNext = &handler0Paths[1];
+    handler0Paths[1].mValue = AttributePathParams(EndpointId(2), ClusterId(8));
+
+    // Handler 1 subscribes to a cluster on every endpoint.
+    ObjectList<AttributePathParams> handler1Paths;
+    handler1Paths.mValue = AttributePathParams(kInvalidEndpointId, 6, kInvalidAttributeId);
+
+    // Handler 2 subscribes to everything.
+    ObjectList<AttributePathParams> handler2Paths;
+    handler2Paths.mValue = AttributePathParams();
+
+    NL_TEST_ASSERT(apSuite, index.Add(handlers[0], handler0Paths) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, index.Add(handlers[1], &handler1Paths) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, index.Add(handlers[2], &handler2Paths) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, index.Allocated() == 4);
+
+    NL_TEST_ASSERT(apSuite, InterestedHandlers(handlers, index, AttributePathParams(1, 6, 0)) == 0b111);
+    NL_TEST_ASSERT(apSuite, InterestedHandlers(handlers, index, AttributePathParams(1, 6, 1)) == 0b110);
+    NL_TEST_ASSERT(apSuite, InterestedHandlers(handlers, index, AttributePathParams(2, 8, 3)) == 0b101);
+    NL_TEST_ASSERT(apSuite, InterestedHandlers(handlers, index, AttributePathParams(3, 8, 3)) == 0b100);
+
+    // Wildcard dirty paths, as marked when a whole endpoint or cluster changes.
+    NL_TEST_ASSERT(apSuite, InterestedHandlers(handlers, index, AttributePathParams(EndpointId(2), ClusterId(6))) == 0b110);
+    AttributePathParams endpoint1;
+    endpoint1.mEndpointId = 1;
+    NL_TEST_ASSERT(apSuite, InterestedHandlers(handlers, index, endpoint1) == 0b111);
+
+    // A handler with several intersecting paths is visited once per path.
+    size_t visits;
+    NL_TEST_ASSERT(apSuite, InterestedHandlers(handlers, index, AttributePathParams(), visits) == 0b111);
+    NL_TEST_ASSERT(apSuite, visits == 4);
+
+    index.Remove(handlers[2]);
+    NL_TEST_ASSERT(apSuite, index.Allocated() == 3);
+    NL_TEST_ASSERT(apSuite, InterestedHandlers(handlers, index, AttributePathParams(3, 8, 3)) == 0);
+    NL_TEST_ASSERT(apSuite, InterestedHandlers(handlers, index, AttributePathParams(1, 6, 0)) == 0b011);
+
+    index.Remove(handlers[0]);
+    NL_TEST_ASSERT(apSuite, index.Allocated() == 1);
+    NL_TEST_ASSERT(apSuite, InterestedHandlers(handlers, index, AttributePathParams(2, 8, 3)) == 0);
+
+    // Removing a handler that is not indexed is a no-op.
+    index.Remove(handlers[0]);
+    NL_TEST_ASSERT(apSuite, index.Allocated() == 1);
+
+    index.ReleaseAll();
+    NL_TEST_ASSERT(apSuite, InterestedHandlers(handlers, index, AttributePathParams()) == 0);
+}
+
+void TestEarlyBreak(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    TestReadHandlers handlers(apSuite, ctx);
+    ReadHandlerInterestIndex index;
+
+    ObjectList<AttributePathParams> paths;
+    paths.mValue = AttributePathParams(1, 6, 0);
+    for (size_t i = 0; i < TestReadHandlers::kCount; i++)
+    {
+        NL_TEST_ASSERT(apSuite, index.Add(handlers[i], &paths) == CHIP_NO_ERROR);
+    }
+
+    size_t visits = 0;
+    NL_TEST_ASSERT(apSuite, index.ForEachInterestedReadHandler(AttributePathParams(1, 6, 0), [&visits](ReadHandler * handler) {
+        visits++;
+        return Loop::Break;
+    }) == Loop::Break);
+    NL_TEST_ASSERT(apSuite, visits == 1);
+}
+
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("TestLookup", TestLookup),
+    NL_TEST_DEF("TestEarlyBreak", TestEarlyBreak),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+} // namespace
+
+int TestReadHandlerInterestIndex()
+{
+    nlTestSuite theSuite = { "TestReadHandlerInterestIndex", &sTests[0], TestContext::Initialize, TestContext::Finalize };
+
+    return chip::ExecuteTestsWithContext<TestContext>(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestReadHandlerInterestIndex)
@@ -46,6 +46,7 @@
 #include <nlunit-test.h>
 #include <protocols/interaction_model/Constants.h>
 
+#include <string>
 #include <type_traits>
 
 namespace {
@@ -236,6 +237,56 @@ public:
     std::vector<chip::app::ConcreteAttributePath> mReceivedAttributePaths;
 };
 
+// Records the order in which list attributes are streamed, e.g. "B4 I1 I2 E4 D5 R" for a two item list in attribute 4,
+// followed by a non-list value in attribute 5 and the end of the report.
+class MockStreamingListApp : public MockInteractionModelApp
+{
+public:
+    bool IsListItemStreamingEnabled() override { return true; }
+
+    void OnListAttributeBegin(const chip::app::ConcreteDataAttributePath & aPath) override
+    {
+        mBeginListOps.push_back(aPath.mListOp);
+        Record('B', aPath.mAttributeId);
+    }
+
+    void OnListAttributeItem(const chip::app::ConcreteDataAttributePath & aPath, chip::TLV::TLVReader & aItem) override
+    {
+        uint8_t value = 0;
+        if (!aPath.IsListItemOperation() || aItem.Get(value) != CHIP_NO_ERROR)
+        {
+            mItemErrors++;
+        }
+        Record('I', value);
+    }
+
+    void OnListAttributeEnd(const chip::app::ConcreteDataAttributePath & aPath) override { Record('E', aPath.mAttributeId); }
+
+    void OnAttributeData(const chip::app::ConcreteDataAttributePath & aPath, chip::TLV::TLVReader * apData,
+                         const chip::app::StatusIB & status) override
+    {
+        Record('D', aPath.mAttributeId);
+        MockInteractionModelApp::OnAttributeData(aPath, apData, status);
+    }
+
+    void OnReportEnd() override { mLog += mLog.empty() ? "R" : " R"; }
+
+    std::string mLog;
+    std::vector<chip::app::ConcreteDataAttributePath::ListOperation> mBeginListOps;
+    int mItemErrors = 0;
+
+private:
+    void Record(char aEvent, uint32_t aValue)
+    {
+        if (!mLog.empty())
+        {
+            mLog += ' ';
+        }
+        mLog += aEvent;
+        mLog += std::to_string(aValue);
+    }
+};
+
 //
 // This dummy callback is used with a bunch of the tests below that don't go through
 // the normal call-path of having the IM engine allocate the ReadHandler object. Instead,
@@ -308,6 +359,7 @@ class TestReadInteraction
 public:
     static void TestReadClient(nlTestSuite * apSuite, void * apContext);
     static void TestReadUnexpectedSubscriptionId(nlTestSuite * apSuite, void * apContext);
+    static void TestReadClientListItemStreaming(nlTestSuite * apSuite, void * apContext);
     static void TestReadHandler(nlTestSuite * apSuite, void * apContext);
     static void TestReadClientGenerateAttributePathList(nlTestSuite * apSuite, void * apContext);
     static void TestReadClientGenerateInvalidAttributePathList(nlTestSuite * apSuite, void * apContext);
@@ -365,6 +417,16 @@ public:
 private:
     static void GenerateReportData(nlTestSuite * apSuite, void * apContext, System::PacketBufferHandle & aPayload,
                                    bool aNeedInvalidReport, bool aSuppressResponse, bool aHasSubscriptionId);
+
+    struct ListReportEntry
+    {
+        AttributeId mAttributeId;
+        ConcreteDataAttributePath::ListOperation mListOp;
+        std::vector<uint8_t> mValues;
+    };
+    static void GenerateListReportData(nlTestSuite * apSuite, System::PacketBufferHandle & aPayload,
+                                       const std::vector<ListReportEntry> & aEntries, bool aMoreChunkedMessages);
+    static void RunListReports(nlTestSuite * apSuite, void * apContext, MockInteractionModelApp & aDelegate);
 };
 
 void TestReadInteraction::GenerateReportData(nlTestSuite * apSuite, void * apContext, System::PacketBufferHandle & aPayload,
@@ -500,6 +562,130 @@ void TestReadInteraction::TestReadUnexpectedSubscriptionId(nlTestSuite * apSuite
     NL_TEST_ASSERT(apSuite, err == CHIP_ERROR_INVALID_ARGUMENT);
 }
 
+void TestReadInteraction::GenerateListReportData(nlTestSuite * apSuite, System::PacketBufferHandle & aPayload,
+                                                 const std::vector<ListReportEntry> & aEntries, bool aMoreChunkedMessages)
+{
+    System::PacketBufferTLVWriter writer;
+    writer.Init(std::move(aPayload));
+
+    ReportDataMessage::Builder reportDataMessageBuilder;
+    NL_TEST_ASSERT(apSuite, reportDataMessageBuilder.Init(&writer) == CHIP_NO_ERROR);
+
+    AttributeReportIBs::Builder & attributeReportIBsBuilder = reportDataMessageBuilder.CreateAttributeReportIBs();
+    NL_TEST_ASSERT(apSuite, reportDataMessageBuilder.GetError() == CHIP_NO_ERROR);
+
+    for (const auto & entry : aEntries)
+    {
+        AttributeReportIB::Builder & attributeReportIBBuilder = attributeReportIBsBuilder.CreateAttributeReport();
+        NL_TEST_ASSERT(apSuite, attributeReportIBsBuilder.GetError() == CHIP_NO_ERROR);
+
+        AttributeDataIB::Builder & attributeDataIBBuilder = attributeReportIBBuilder.CreateAttributeData();
+        NL_TEST_ASSERT(apSuite, attributeReportIBBuilder.GetError() == CHIP_NO_ERROR);
+
+        attributeDataIBBuilder.DataVersion(2);
+        NL_TEST_ASSERT(apSuite, attributeDataIBBuilder.GetError() == CHIP_NO_ERROR);
+
+        AttributePathIB::Builder & attributePathBuilder = attributeDataIBBuilder.CreatePath();
+        NL_TEST_ASSERT(apSuite, attributeDataIBBuilder.GetError() == CHIP_NO_ERROR);
+
+        attributePathBuilder.Node(1).Endpoint(2).Cluster(3).Attribute(entry.mAttributeId);
+        if (entry.mListOp == ConcreteDataAttributePath::ListOperation::AppendItem)
+        {
+            attributePathBuilder.ListIndex(DataModel::NullNullable);
+        }
+        attributePathBuilder.EndOfAttributePathIB();
+        NL_TEST_ASSERT(apSuite, attributePathBuilder.GetError() == CHIP_NO_ERROR);
+
+        TLV::TLVWriter * pWriter = attributeDataIBBuilder.GetWriter();
+        const TLV::Tag dataTag   = TLV::ContextTag(to_underlying(AttributeDataIB::Tag::kData));
+        if (entry.mListOp == ConcreteDataAttributePath::ListOperation::ReplaceAll)
+        {
+            TLV::TLVType listType;
+            NL_TEST_ASSERT(apSuite, pWriter->StartContainer(dataTag, TLV::kTLVType_Array, listType) == CHIP_NO_ERROR);
+            for (uint8_t value : entry.mValues)
+            {
+                NL_TEST_ASSERT(apSuite, pWriter->Put(TLV::AnonymousTag(), value) == CHIP_NO_ERROR);
+            }
+            NL_TEST_ASSERT(apSuite, pWriter->EndContainer(listType) == CHIP_NO_ERROR);
+        }
+        else
+        {
+            NL_TEST_ASSERT(apSuite, pWriter->Put(dataTag, entry.mValues[0]) == CHIP_NO_ERROR);
+        }
+
+        attributeDataIBBuilder.EndOfAttributeDataIB();
+        NL_TEST_ASSERT(apSuite, attributeDataIBBuilder.GetError() == CHIP_NO_ERROR);
+
+        attributeReportIBBuilder.EndOfAttributeReportIB();
+        NL_TEST_ASSERT(apSuite, attributeReportIBBuilder.GetError() == CHIP_NO_ERROR);
+    }
+
+    attributeReportIBsBuilder.EndOfAttributeReportIBs();
+    NL_TEST_ASSERT(apSuite, attributeReportIBsBuilder.GetError() == CHIP_NO_ERROR);
+
+    reportDataMessageBuilder.MoreChunkedMessages(aMoreChunkedMessages).SuppressResponse(true).EndOfReportDataMessage();
+    NL_TEST_ASSERT(apSuite, reportDataMessageBuilder.GetError() == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(apSuite, writer.Finalize(&aPayload) == CHIP_NO_ERROR);
+}
+
+void TestReadInteraction::RunListReports(nlTestSuite * apSuite, void * apContext, MockInteractionModelApp & aDelegate)
+{
+    using ListOperation = ConcreteDataAttributePath::ListOperation;
+
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    app::ReadClient readClient(chip::app::InteractionModelEngine::GetInstance(), &ctx.GetExchangeManager(), aDelegate,
+                               chip::app::ReadClient::InteractionType::Read);
+
+    ReadPrepareParams readPrepareParams(ctx.GetSessionBobToAlice());
+    NL_TEST_ASSERT(apSuite, readClient.SendRequest(readPrepareParams) == CHIP_NO_ERROR);
+
+    // We don't actually want to deliver that message, because we want to
+    // synthesize the read response.  But we don't want it hanging around
+    // forever either.
+    ctx.GetLoopback().mNumMessagesToDrop = 1;
+    ctx.DrainAndServiceIO();
+
+    // The list in attribute 4 is chunked across both reports.
+    System::PacketBufferHandle buf = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize);
+    GenerateListReportData(apSuite, buf,
+                           { { 4, ListOperation::ReplaceAll, { 1, 2 } }, { 4, ListOperation::AppendItem, { 3 } } },
+                           true /* aMoreChunkedMessages */);
+    NL_TEST_ASSERT(apSuite, readClient.ProcessReportData(std::move(buf), ReadClient::ReportType::kContinuingTransaction) ==
+                       CHIP_NO_ERROR);
+
+    buf = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize);
+    GenerateListReportData(apSuite, buf,
+                           { { 4, ListOperation::AppendItem, { 4 } },
+                             { 5, ListOperation::NotList, { 7 } },
+                             { 6, ListOperation::ReplaceAll, {} },
+                             { 7, ListOperation::AppendItem, { 8 } } },
+                           false /* aMoreChunkedMessages */);
+    NL_TEST_ASSERT(apSuite, readClient.ProcessReportData(std::move(buf), ReadClient::ReportType::kContinuingTransaction) ==
+                       CHIP_NO_ERROR);
+}
+
+void TestReadInteraction::TestReadClientListItemStreaming(nlTestSuite * apSuite, void * apContext)
+{
+    using ListOperation = ConcreteDataAttributePath::ListOperation;
+
+    MockStreamingListApp streamingDelegate;
+    RunListReports(apSuite, apContext, streamingDelegate);
+    NL_TEST_ASSERT(apSuite, streamingDelegate.mLog == "B4 I1 I2 I3 I4 E4 D5 B6 E6 B7 I8 E7 R");
+    NL_TEST_ASSERT(apSuite, streamingDelegate.mItemErrors == 0);
+    NL_TEST_ASSERT(apSuite, streamingDelegate.mNumArrayItems == 0);
+    NL_TEST_ASSERT(apSuite, streamingDelegate.mBeginListOps.size() == 3);
+    NL_TEST_ASSERT(apSuite, streamingDelegate.mBeginListOps[0] == ListOperation::ReplaceAll);
+    NL_TEST_ASSERT(apSuite, streamingDelegate.mBeginListOps[1] == ListOperation::ReplaceAll);
+    NL_TEST_ASSERT(apSuite, streamingDelegate.mBeginListOps[2] == ListOperation::AppendItem);
+
+    // Without streaming, the same reports are delivered as whole lists and appended items.
+    MockInteractionModelApp delegate;
+    RunListReports(apSuite, apContext, delegate);
+    NL_TEST_ASSERT(apSuite, delegate.mNumAttributeResponse == 6);
+    NL_TEST_ASSERT(apSuite, delegate.mNumArrayItems == 5);
+}
+
 void TestReadInteraction::TestReadHandler(nlTestSuite * apSuite, void * apContext)
 {
     CHIP_ERROR err    = CHIP_NO_ERROR;
@@ -4309,6 +4495,7 @@ const nlTest sTests[] =
     NL_TEST_DEF("TestSetDirtyBetweenChunks", chip::app::TestReadInteraction::TestSetDirtyBetweenChunks),
     NL_TEST_DEF("CheckReadClient", chip::app::TestReadInteraction::TestReadClient),
     NL_TEST_DEF("TestReadUnexpectedSubscriptionId", chip::app::TestReadInteraction::TestReadUnexpectedSubscriptionId),
+    NL_TEST_DEF("TestReadClientListItemStreaming", chip::app::TestReadInteraction::TestReadClientListItemStreaming),
     NL_TEST_DEF("CheckReadHandler", chip::app::TestReadInteraction::TestReadHandler),
     NL_TEST_DEF("TestReadClientGenerateAttributePathList", chip::app::TestReadInteraction::TestReadClientGenerateAttributePathList),
     NL_TEST_DEF("TestReadClientGenerateInvalidAttributePathList", chip::app::TestReadInteraction::TestReadClientGenerateInvalidAttributePathList),
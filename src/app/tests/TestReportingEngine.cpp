@@ -59,6 +59,7 @@ public:
 
 private:
     static bool InsertToDirtySet(const AttributePathParams & aPath);
+    static bool MergeOverlappedAttributePath(const AttributePathParams & aPath);
 
     struct ExpectedDirtySetContent : public AttributePathParams
     {
@@ -72,7 +73,7 @@ private:
         const int size                        = sizeof...(args);
         ExpectedDirtySetContent content[size] = { ExpectedDirtySetContent(args)... };
 
-        if (InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.ForEachActiveObject([&](auto * path) {
+        if (InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.ForEachPath([&](auto * path) {
                 for (int i = 0; i < size; i++)
                 {
                     if (static_cast<AttributePathParams>(content[i]) == static_cast<AttributePathParams>(*path))
@@ -172,18 +173,15 @@ void TestReportingEngine::TestMergeOverlappedAttributePath(nlTestSuite * apSuite
     err               = InteractionModelEngine::GetInstance()->Init(&ctx.GetExchangeManager(), &ctx.GetFabricTable());
     NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
 
-    AttributePathParams * clusterInfo = InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.CreateObject();
-    clusterInfo->mEndpointId          = 1;
-    clusterInfo->mClusterId           = 1;
-    clusterInfo->mAttributeId         = 1;
+    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.ReleaseAll();
+    NL_TEST_ASSERT(apSuite, InsertToDirtySet(AttributePathParams(1, 1, 1)));
 
     {
         AttributePathParams testClusterInfo;
         testClusterInfo.mEndpointId  = 1;
         testClusterInfo.mClusterId   = 1;
         testClusterInfo.mAttributeId = 3;
-        NL_TEST_ASSERT(apSuite,
-                       !InteractionModelEngine::GetInstance()->GetReportingEngine().MergeOverlappedAttributePath(testClusterInfo));
+        NL_TEST_ASSERT(apSuite, !MergeOverlappedAttributePath(testClusterInfo));
     }
     {
         AttributePathParams testClusterInfo;
@@ -191,8 +189,7 @@ void TestReportingEngine::TestMergeOverlappedAttributePath(nlTestSuite * apSuite
         testClusterInfo.mClusterId   = 1;
         testClusterInfo.mAttributeId = 1;
         testClusterInfo.mListIndex   = 2;
-        NL_TEST_ASSERT(apSuite,
-                       InteractionModelEngine::GetInstance()->GetReportingEngine().MergeOverlappedAttributePath(testClusterInfo));
+        NL_TEST_ASSERT(apSuite, MergeOverlappedAttributePath(testClusterInfo));
     }
 
     {
@@ -200,17 +197,16 @@ void TestReportingEngine::TestMergeOverlappedAttributePath(nlTestSuite * apSuite
         testClusterInfo.mEndpointId  = 1;
         testClusterInfo.mClusterId   = 1;
         testClusterInfo.mAttributeId = kInvalidAttributeId;
-        NL_TEST_ASSERT(apSuite,
-                       InteractionModelEngine::GetInstance()->GetReportingEngine().MergeOverlappedAttributePath(testClusterInfo));
+        NL_TEST_ASSERT(apSuite, MergeOverlappedAttributePath(testClusterInfo));
+        NL_TEST_ASSERT(apSuite, VerifyDirtySetContent(AttributePathParams(EndpointId(1), ClusterId(1))));
     }
 
     {
         AttributePathParams testClusterInfo;
         testClusterInfo.mClusterId   = kInvalidClusterId;
         testClusterInfo.mAttributeId = kInvalidAttributeId;
-        NL_TEST_ASSERT(apSuite,
-                       InteractionModelEngine::GetInstance()->GetReportingEngine().MergeOverlappedAttributePath(testClusterInfo));
-        NL_TEST_ASSERT(apSuite, clusterInfo->mClusterId == kInvalidClusterId && clusterInfo->mAttributeId == kInvalidAttributeId);
+        NL_TEST_ASSERT(apSuite, MergeOverlappedAttributePath(testClusterInfo));
+        NL_TEST_ASSERT(apSuite, VerifyDirtySetContent(AttributePathParams()));
     }
 
     {
@@ -218,22 +214,33 @@ void TestReportingEngine::TestMergeOverlappedAttributePath(nlTestSuite * apSuite
         testClusterInfo.mEndpointId  = kInvalidEndpointId;
         testClusterInfo.mClusterId   = kInvalidClusterId;
         testClusterInfo.mAttributeId = kInvalidAttributeId;
-        NL_TEST_ASSERT(apSuite,
-                       InteractionModelEngine::GetInstance()->GetReportingEngine().MergeOverlappedAttributePath(testClusterInfo));
-        NL_TEST_ASSERT(apSuite,
-                       clusterInfo->mEndpointId == kInvalidEndpointId && clusterInfo->mClusterId == kInvalidClusterId &&
-                           clusterInfo->mAttributeId == kInvalidAttributeId);
+        NL_TEST_ASSERT(apSuite, MergeOverlappedAttributePath(testClusterInfo));
+        NL_TEST_ASSERT(apSuite, VerifyDirtySetContent(AttributePathParams()));
     }
+
+    // A wildcard path replaces all the paths it covers, not only the first one.
+    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.ReleaseAll();
+    NL_TEST_ASSERT(apSuite, InsertToDirtySet(AttributePathParams(1, 1, 1)));
+    NL_TEST_ASSERT(apSuite, InsertToDirtySet(AttributePathParams(1, 2, 1)));
+    NL_TEST_ASSERT(apSuite, InsertToDirtySet(AttributePathParams(2, 1, 1)));
+    NL_TEST_ASSERT(apSuite, MergeOverlappedAttributePath(AttributePathParams(EndpointId(1), kInvalidClusterId)));
+    NL_TEST_ASSERT(apSuite,
+                   VerifyDirtySetContent(AttributePathParams(EndpointId(1), kInvalidClusterId), AttributePathParams(2, 1, 1)));
+
     InteractionModelEngine::GetInstance()->GetReportingEngine().Shutdown();
 }
 
 bool TestReportingEngine::InsertToDirtySet(const AttributePathParams & aPath)
 {
-    auto path = InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.CreateObject();
-    VerifyOrReturnError(path != nullptr, false);
-    *path             = aPath;
-    path->mGeneration = InteractionModelEngine::GetInstance()->GetReportingEngine().GetDirtySetGeneration();
-    return true;
+    Engine & engine = InteractionModelEngine::GetInstance()->GetReportingEngine();
+    VerifyOrReturnError(!engine.mGlobalDirtySet.MergeOverlappedPath(aPath, engine.GetDirtySetGeneration()), false);
+    return engine.mGlobalDirtySet.Insert(aPath, engine.GetDirtySetGeneration()) == CHIP_NO_ERROR;
+}
+
+bool TestReportingEngine::MergeOverlappedAttributePath(const AttributePathParams & aPath)
+{
+    Engine & engine = InteractionModelEngine::GetInstance()->GetReportingEngine();
+    return engine.mGlobalDirtySet.MergeOverlappedPath(aPath, engine.GetDirtySetGeneration());
 }
 
 void TestReportingEngine::TestMergeAttributePathWhenDirtySetPoolExhausted(nlTestSuite * apSuite, void * apContext)
@@ -38,6 +38,8 @@
 //           -> zap-generated/endpoint_config.h
 #include <app-common/zap-generated/callback.h>
 
+#include <algorithm>
+
 using namespace chip;
 using namespace chip::app;
 
@@ -119,6 +121,154 @@ DataVersion fixedEndpointDataVersions[ZAP_FIXED_ENDPOINT_DATA_VERSION_COUNT];
 #endif
 
 app::AttributeAccessInterface * gAttributeAccessOverrides = nullptr;
+
+constexpr uint16_t nextPowerOfTwo(uint32_t value, uint16_t result = 1)
+{
+    return (result >= value) ? result : nextPowerOfTwo(value, static_cast<uint16_t>(result * 2));
+}
+
+// Maps endpoint ids to their index in emAfEndpoints, so that looking an endpoint up does not need a scan of all the
+// endpoints.  This is an open-addressed hash table with linear probing, kept at most half full.
+//
+// If the same endpoint id is defined at several indices (e.g. a dynamic endpoint reusing the id of a fixed one), the table
+// holds the lowest index and remembers that callers must look further when that index does not suit them.
+class EndpointIndexTable
+{
+public:
+    void Clear()
+    {
+        for (auto & slot : mSlots)
+        {
+            slot = Slot();
+        }
+        mHasDuplicates = false;
+    }
+
+    // Returns the lowest index defining the endpoint, or kEmberInvalidEndpointIndex.
+    uint16_t Find(EndpointId endpoint) const
+    {
+        const Slot * slot = FindSlot(endpoint);
+        return slot->endpoint == endpoint ? slot->index : kEmberInvalidEndpointIndex;
+    }
+
+    bool HasDuplicates() const { return mHasDuplicates; }
+
+    void Add(EndpointId endpoint, uint16_t index)
+    {
+        Slot * slot = FindSlot(endpoint);
+        if (slot->endpoint == endpoint)
+        {
+            mHasDuplicates = true;
+            slot->index    = std::min(slot->index, index);
+            return;
+        }
+        slot->endpoint = endpoint;
+        slot->index    = index;
+    }
+
+    // Must be called before emAfEndpoints[index] stops defining the endpoint.
+    void Remove(EndpointId endpoint, uint16_t index)
+    {
+        Slot * slot = FindSlot(endpoint);
+        if (slot->endpoint != endpoint || slot->index != index)
+        {
+            return;
+        }
+
+        if (mHasDuplicates)
+        {
+            for (uint16_t i = static_cast<uint16_t>(index + 1); i < MAX_ENDPOINT_COUNT; i++)
+            {
+                if (emAfEndpoints[i].endpoint == endpoint)
+                {
+                    slot->index = i;
+                    return;
+                }
+            }
+        }
+
+        // Backward shift deletion: move later entries of the probe sequence into the hole when their home slot allows it.
+        uint16_t hole = static_cast<uint16_t>(slot - mSlots);
+        for (uint16_t i = Next(hole); mSlots[i].endpoint != kInvalidEndpointId; i = Next(i))
+        {
+            uint16_t home = Hash(mSlots[i].endpoint);
+            if (static_cast<uint16_t>((i - home) & kMask) >= static_cast<uint16_t>((i - hole) & kMask))
+            {
+                mSlots[hole] = mSlots[i];
+                hole         = i;
+            }
+        }
+        mSlots[hole] = Slot();
+    }
+
+private:
+    struct Slot
+    {
+        EndpointId endpoint = kInvalidEndpointId;
+        uint16_t index      = kEmberInvalidEndpointIndex;
+    };
+
+    static_assert(MAX_ENDPOINT_COUNT <= kEmberInvalidEndpointIndex / 2, "Too many endpoints for the endpoint index table");
+    static constexpr uint16_t kSize = nextPowerOfTwo(2 * MAX_ENDPOINT_COUNT);
+    static constexpr uint16_t kMask = kSize - 1;
+
+    static uint16_t Hash(EndpointId endpoint) { return static_cast<uint16_t>((endpoint * 40503u) >> 4) & kMask; }
+    static uint16_t Next(uint16_t i) { return static_cast<uint16_t>((i + 1) & kMask); }
+
+    // Returns the slot holding the endpoint, or the empty slot where it would be added.
+    Slot * FindSlot(EndpointId endpoint)
+    {
+        uint16_t i = Hash(endpoint);
+        while (mSlots[i].endpoint != kInvalidEndpointId && mSlots[i].endpoint != endpoint)
+        {
+            i = Next(i);
+        }
+        return &mSlots[i];
+    }
+    const Slot * FindSlot(EndpointId endpoint) const { return const_cast<EndpointIndexTable *>(this)->FindSlot(endpoint); }
+
+    Slot mSlots[kSize];
+    bool mHasDuplicates = false;
+};
+
+EndpointIndexTable gEndpointIndexTable;
+
+// Where an attribute of an enabled endpoint lives, as found by emAfReadOrWriteAttribute.
+struct AttributeLocation
+{
+    EndpointId endpoint                       = kInvalidEndpointId;
+    ClusterId clusterId                       = kInvalidClusterId;
+    AttributeId attributeId                   = kInvalidAttributeId;
+    uint16_t endpointIndex                    = kEmberInvalidEndpointIndex;
+    const EmberAfAttributeMetadata * metadata = nullptr;
+    uint8_t * data                            = nullptr;
+};
+
+#if EMBER_AF_ATTRIBUTE_LOCATION_CACHE_SIZE > 0
+// Direct-mapped cache of the most recently accessed attributes.  Entries are only trusted while the endpoint they point to is
+// still defined and enabled at the same index; any change to the set of endpoints drops the whole cache.
+AttributeLocation gAttributeLocationCache[EMBER_AF_ATTRIBUTE_LOCATION_CACHE_SIZE];
+
+AttributeLocation & attributeLocationCacheSlot(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId)
+{
+    uint32_t hash = (static_cast<uint32_t>(endpoint) * 31u + clusterId) * 31u + attributeId;
+    return gAttributeLocationCache[hash % EMBER_AF_ATTRIBUTE_LOCATION_CACHE_SIZE];
+}
+#endif // EMBER_AF_ATTRIBUTE_LOCATION_CACHE_SIZE > 0
+
+void invalidateAttributeLocationCache()
+{
+#if EMBER_AF_ATTRIBUTE_LOCATION_CACHE_SIZE > 0
+    for (auto & location : gAttributeLocationCache)
+    {
+        location = AttributeLocation();
+    }
+#endif // EMBER_AF_ATTRIBUTE_LOCATION_CACHE_SIZE > 0
+}
+
+// Bumped whenever the set of endpoints, or whether they are enabled, changes.  See emberAfMetadataStructureGeneration().
+uint32_t gMetadataStructureGeneration = 0;
+
 } // anonymous namespace
 
 // Initial configuration
@@ -149,6 +299,10 @@ void emberAfEndpointConfigure()
     }
 #endif // ZAP_FIXED_ENDPOINT_DATA_VERSION_COUNT > 0
 
+    gEndpointIndexTable.Clear();
+    invalidateAttributeLocationCache();
+    gMetadataStructureGeneration++;
+
     emberEndpointCount                = FIXED_ENDPOINT_COUNT;
     DataVersion * currentDataVersions = fixedEndpointDataVersions;
     for (ep = 0; ep < FIXED_ENDPOINT_COUNT; ep++)
@@ -158,6 +312,7 @@ void emberAfEndpointConfigure()
         emAfEndpoints[ep].endpointType   = endpointTypeMacro(ep);
         emAfEndpoints[ep].dataVersions   = currentDataVersions;
         emAfEndpoints[ep].bitmask        = EMBER_AF_ENDPOINT_ENABLED;
+        gEndpointIndexTable.Add(emAfEndpoints[ep].endpoint, ep);
 
         // Increment currentDataVersions by 1 (slot) for every server cluster
         // this endpoint has.
@@ -180,7 +335,12 @@ void emberAfEndpointConfigure()
 
 void emberAfSetDynamicEndpointCount(uint16_t dynamicEndpointCount)
 {
-    emberEndpointCount = static_cast<uint16_t>(FIXED_ENDPOINT_COUNT + dynamicEndpointCount);
+    uint16_t endpointCount = static_cast<uint16_t>(FIXED_ENDPOINT_COUNT + dynamicEndpointCount);
+    if (endpointCount != emberEndpointCount)
+    {
+        emberEndpointCount = endpointCount;
+        gMetadataStructureGeneration++;
+    }
 }
 
 uint16_t emberAfGetDynamicIndexFromEndpoint(EndpointId id)
@@ -190,15 +350,27 @@ uint16_t emberAfGetDynamicIndexFromEndpoint(EndpointId id)
         return kEmberInvalidEndpointIndex;
     }
 
-    uint16_t index;
-    for (index = FIXED_ENDPOINT_COUNT; index < MAX_ENDPOINT_COUNT; index++)
+    uint16_t index = gEndpointIndexTable.Find(id);
+    if (index == kEmberInvalidEndpointIndex)
+    {
+        return kEmberInvalidEndpointIndex;
+    }
+    if (index < FIXED_ENDPOINT_COUNT)
     {
-        if (emAfEndpoints[index].endpoint == id)
+        // The id is also used by a fixed endpoint, look for a dynamic one further down.
+        if (!gEndpointIndexTable.HasDuplicates())
         {
-            return static_cast<uint8_t>(index - FIXED_ENDPOINT_COUNT);
+            return kEmberInvalidEndpointIndex;
+        }
+        for (index = FIXED_ENDPOINT_COUNT; index < MAX_ENDPOINT_COUNT && emAfEndpoints[index].endpoint != id; index++)
+        {
+        }
+        if (index == MAX_ENDPOINT_COUNT)
+        {
+            return kEmberInvalidEndpointIndex;
         }
     }
-    return kEmberInvalidEndpointIndex;
+    return static_cast<uint16_t>(index - FIXED_ENDPOINT_COUNT);
 }
 
 EmberAfStatus emberAfSetDynamicEndpoint(uint16_t index, EndpointId id, const EmberAfEndpointType * ep,
@@ -223,13 +395,18 @@ EmberAfStatus emberAfSetDynamicEndpoint(uint16_t index, EndpointId id, const Emb
     }
 
     index = static_cast<uint16_t>(realIndex);
-    for (uint16_t i = FIXED_ENDPOINT_COUNT; i < MAX_ENDPOINT_COUNT; i++)
+    if (emberAfGetDynamicIndexFromEndpoint(id) != kEmberInvalidEndpointIndex)
     {
-        if (emAfEndpoints[i].endpoint == id)
-        {
-            return EMBER_ZCL_STATUS_DUPLICATE_EXISTS;
-        }
+        return EMBER_ZCL_STATUS_DUPLICATE_EXISTS;
+    }
+
+    if (emAfEndpoints[index].endpoint != kInvalidEndpointId)
+    {
+        // The slot is being reused without having been cleared.
+        gEndpointIndexTable.Remove(emAfEndpoints[index].endpoint, index);
     }
+    invalidateAttributeLocationCache();
+    gMetadataStructureGeneration++;
 
     emAfEndpoints[index].endpoint       = id;
     emAfEndpoints[index].deviceTypeList = deviceTypeList;
@@ -238,6 +415,7 @@ EmberAfStatus emberAfSetDynamicEndpoint(uint16_t index, EndpointId id, const Emb
     // Start the endpoint off as disabled.
     emAfEndpoints[index].bitmask          = EMBER_AF_ENDPOINT_DISABLED;
     emAfEndpoints[index].parentEndpointId = parentEndpointId;
+    gEndpointIndexTable.Add(id, index);
 
     emberAfSetDynamicEndpointCount(MAX_ENDPOINT_COUNT - FIXED_ENDPOINT_COUNT);
 
@@ -262,13 +440,16 @@ EndpointId emberAfClearDynamicEndpoint(uint16_t index)
 {
     EndpointId ep = 0;
 
-    index = static_cast<uint8_t>(index + FIXED_ENDPOINT_COUNT);
+    index = static_cast<uint16_t>(index + FIXED_ENDPOINT_COUNT);
 
     if ((index < MAX_ENDPOINT_COUNT) && (emAfEndpoints[index].endpoint != kInvalidEndpointId) &&
         (emberAfEndpointIndexIsEnabled(index)))
     {
         ep = emAfEndpoints[index].endpoint;
         emberAfEndpointEnableDisable(ep, false);
+        gEndpointIndexTable.Remove(ep, index);
+        invalidateAttributeLocationCache();
+        gMetadataStructureGeneration++;
         emAfEndpoints[index].endpoint = kInvalidEndpointId;
     }
 
@@ -285,6 +466,11 @@ uint16_t emberAfEndpointCount()
     return emberEndpointCount;
 }
 
+uint32_t emberAfMetadataStructureGeneration()
+{
+    return gMetadataStructureGeneration;
+}
+
 bool emberAfEndpointIndexIsEnabled(uint16_t index)
 {
     return (emAfEndpoints[index].bitmask & EMBER_AF_ENDPOINT_ENABLED);
@@ -541,6 +727,95 @@ bool emAfMatchAttribute(const EmberAfCluster * cluster, const EmberAfAttributeMe
     return (am->attributeId == attRecord->attributeId);
 }
 
+static uint16_t findIndexFromEndpoint(EndpointId endpoint, bool ignoreDisabledEndpoints);
+
+// Finds where the attribute matching the search record lives, on an enabled endpoint.
+static EmberAfStatus findAttributeLocation(EmberAfAttributeSearchRecord * attRecord, AttributeLocation & location)
+{
+    uint16_t ep = findIndexFromEndpoint(attRecord->endpoint, true /* ignoreDisabledEndpoints */);
+    if (ep == kEmberInvalidEndpointIndex)
+    {
+        return EMBER_ZCL_STATUS_UNSUPPORTED_ENDPOINT; // Sorry, endpoint was not found.
+    }
+
+    // The attribute data of fixed endpoints is laid out endpoint after endpoint.
+    // Dynamic endpoints are external and don't factor into storage size.
+    uint16_t attributeOffsetIndex = 0;
+    for (uint16_t i = 0; i < ep && i < emberAfFixedEndpointCount(); i++)
+    {
+        attributeOffsetIndex = static_cast<uint16_t>(attributeOffsetIndex + emAfEndpoints[i].endpointType->endpointSize);
+    }
+
+    const EmberAfEndpointType * endpointType = emAfEndpoints[ep].endpointType;
+    for (uint8_t clusterIndex = 0; clusterIndex < endpointType->clusterCount; clusterIndex++)
+    {
+        const EmberAfCluster * cluster = &(endpointType->cluster[clusterIndex]);
+        if (!emAfMatchCluster(cluster, attRecord))
+        {
+            // Not the cluster we are looking for
+            attributeOffsetIndex = static_cast<uint16_t>(attributeOffsetIndex + cluster->clusterSize);
+            continue;
+        }
+
+        // Got the cluster
+        for (uint16_t attrIndex = 0; attrIndex < cluster->attributeCount; attrIndex++)
+        {
+            const EmberAfAttributeMetadata * am = &(cluster->attributes[attrIndex]);
+            if (emAfMatchAttribute(cluster, am, attRecord))
+            { // Got the attribute
+                location.endpoint      = attRecord->endpoint;
+                location.clusterId     = attRecord->clusterId;
+                location.attributeId   = attRecord->attributeId;
+                location.endpointIndex = ep;
+                location.metadata      = am;
+                location.data          = (am->mask & ATTRIBUTE_MASK_SINGLETON ? singletonAttributeLocation(am)
+                                                                              : attributeData + attributeOffsetIndex);
+                return EMBER_ZCL_STATUS_SUCCESS;
+            }
+
+            // Not the attribute we are looking for
+            // Increase the index if attribute is not externally stored
+            if (!(am->mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE) && !(am->mask & ATTRIBUTE_MASK_SINGLETON))
+            {
+                attributeOffsetIndex = static_cast<uint16_t>(attributeOffsetIndex + emberAfAttributeSize(am));
+            }
+        }
+
+        // Attribute is not in the cluster.
+        return EMBER_ZCL_STATUS_UNSUPPORTED_ATTRIBUTE;
+    }
+
+    // Cluster is not in the endpoint.
+    return EMBER_ZCL_STATUS_UNSUPPORTED_CLUSTER;
+}
+
+// Same as findAttributeLocation, going through the attribute location cache.
+static EmberAfStatus findAttributeLocationCached(EmberAfAttributeSearchRecord * attRecord, AttributeLocation & location)
+{
+#if EMBER_AF_ATTRIBUTE_LOCATION_CACHE_SIZE > 0
+    // With duplicate endpoint ids, which of the endpoints is found depends on which ones are enabled: do not cache.
+    VerifyOrReturnError(!gEndpointIndexTable.HasDuplicates(), findAttributeLocation(attRecord, location));
+
+    AttributeLocation & cached = attributeLocationCacheSlot(attRecord->endpoint, attRecord->clusterId, attRecord->attributeId);
+    if (cached.endpoint == attRecord->endpoint && cached.clusterId == attRecord->clusterId &&
+        cached.attributeId == attRecord->attributeId && cached.endpointIndex < emberAfEndpointCount() &&
+        emAfEndpoints[cached.endpointIndex].endpoint == attRecord->endpoint && emberAfEndpointIndexIsEnabled(cached.endpointIndex))
+    {
+        location = cached;
+        return EMBER_ZCL_STATUS_SUCCESS;
+    }
+
+    EmberAfStatus status = findAttributeLocation(attRecord, location);
+    if (status == EMBER_ZCL_STATUS_SUCCESS)
+    {
+        cached = location;
+    }
+    return status;
+#else
+    return findAttributeLocation(attRecord, location);
+#endif // EMBER_AF_ATTRIBUTE_LOCATION_CACHE_SIZE > 0
+}
+
 // When reading non-string attributes, this function returns an error when destination
 // buffer isn't large enough to accommodate the attribute type.  For strings, the
 // function will copy at most readLength bytes.  This means the resulting string
@@ -559,117 +834,63 @@ EmberAfStatus emAfReadOrWriteAttribute(EmberAfAttributeSearchRecord * attRecord,
 {
     assertChipStackLockedByCurrentThread();
 
-    uint16_t attributeOffsetIndex = 0;
-
-    for (uint16_t ep = 0; ep < emberAfEndpointCount(); ep++)
+    AttributeLocation location;
+    EmberAfStatus status = findAttributeLocationCached(attRecord, location);
+    if (status != EMBER_ZCL_STATUS_SUCCESS)
     {
-        // Is this a dynamic endpoint?
-        bool isDynamicEndpoint = (ep >= emberAfFixedEndpointCount());
-
-        if (emAfEndpoints[ep].endpoint == attRecord->endpoint)
-        {
-            const EmberAfEndpointType * endpointType = emAfEndpoints[ep].endpointType;
-            uint8_t clusterIndex;
-            if (!emberAfEndpointIndexIsEnabled(ep))
-            {
-                continue;
-            }
-            for (clusterIndex = 0; clusterIndex < endpointType->clusterCount; clusterIndex++)
-            {
-                const EmberAfCluster * cluster = &(endpointType->cluster[clusterIndex]);
-                if (emAfMatchCluster(cluster, attRecord))
-                { // Got the cluster
-                    uint16_t attrIndex;
-                    for (attrIndex = 0; attrIndex < cluster->attributeCount; attrIndex++)
-                    {
-                        const EmberAfAttributeMetadata * am = &(cluster->attributes[attrIndex]);
-                        if (emAfMatchAttribute(cluster, am, attRecord))
-                        { // Got the attribute
-                            // If passed metadata location is not null, populate
-                            if (metadata != nullptr)
-                            {
-                                *metadata = am;
-                            }
-
-                            {
-                                uint8_t * attributeLocation =
-                                    (am->mask & ATTRIBUTE_MASK_SINGLETON ? singletonAttributeLocation(am)
-                                                                         : attributeData + attributeOffsetIndex);
-                                uint8_t *src, *dst;
-                                if (write)
-                                {
-                                    src = buffer;
-                                    dst = attributeLocation;
-                                    if (!emberAfAttributeWriteAccessCallback(attRecord->endpoint, attRecord->clusterId,
-                                                                             am->attributeId))
-                                    {
-                                        return EMBER_ZCL_STATUS_UNSUPPORTED_ACCESS;
-                                    }
-                                }
-                                else
-                                {
-                                    if (buffer == nullptr)
-                                    {
-                                        return EMBER_ZCL_STATUS_SUCCESS;
-                                    }
-
-                                    src = attributeLocation;
-                                    dst = buffer;
-                                    if (!emberAfAttributeReadAccessCallback(attRecord->endpoint, attRecord->clusterId,
-                                                                            am->attributeId))
-                                    {
-                                        return EMBER_ZCL_STATUS_UNSUPPORTED_ACCESS;
-                                    }
-                                }
-
-                                // Is the attribute externally stored?
-                                if (am->mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE)
-                                {
-                                    return (write ? emberAfExternalAttributeWriteCallback(attRecord->endpoint, attRecord->clusterId,
-                                                                                          am, buffer)
-                                                  : emberAfExternalAttributeReadCallback(attRecord->endpoint, attRecord->clusterId,
-                                                                                         am, buffer, emberAfAttributeSize(am)));
-                                }
-
-                                // Internal storage is only supported for fixed endpoints
-                                if (!isDynamicEndpoint)
-                                {
-                                    return typeSensitiveMemCopy(attRecord->clusterId, dst, src, am, write, readLength);
-                                }
-
-                                return EMBER_ZCL_STATUS_FAILURE;
-                            }
-                        }
-                        else
-                        { // Not the attribute we are looking for
-                            // Increase the index if attribute is not externally stored
-                            if (!(am->mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE) && !(am->mask & ATTRIBUTE_MASK_SINGLETON))
-                            {
-                                attributeOffsetIndex = static_cast<uint16_t>(attributeOffsetIndex + emberAfAttributeSize(am));
-                            }
-                        }
-                    }
+        return status;
+    }
 
-                    // Attribute is not in the cluster.
-                    return EMBER_ZCL_STATUS_UNSUPPORTED_ATTRIBUTE;
-                }
+    // Is this a dynamic endpoint?
+    bool isDynamicEndpoint              = (location.endpointIndex >= emberAfFixedEndpointCount());
+    const EmberAfAttributeMetadata * am = location.metadata;
 
-                // Not the cluster we are looking for
-                attributeOffsetIndex = static_cast<uint16_t>(attributeOffsetIndex + cluster->clusterSize);
-            }
+    // If passed metadata location is not null, populate
+    if (metadata != nullptr)
+    {
+        *metadata = am;
+    }
 
-            // Cluster is not in the endpoint.
-            return EMBER_ZCL_STATUS_UNSUPPORTED_CLUSTER;
+    uint8_t *src, *dst;
+    if (write)
+    {
+        src = buffer;
+        dst = location.data;
+        if (!emberAfAttributeWriteAccessCallback(attRecord->endpoint, attRecord->clusterId, am->attributeId))
+        {
+            return EMBER_ZCL_STATUS_UNSUPPORTED_ACCESS;
+        }
+    }
+    else
+    {
+        if (buffer == nullptr)
+        {
+            return EMBER_ZCL_STATUS_SUCCESS;
         }
 
-        // Not the endpoint we are looking for
-        // Dynamic endpoints are external and don't factor into storage size
-        if (!isDynamicEndpoint)
+        src = location.data;
+        dst = buffer;
+        if (!emberAfAttributeReadAccessCallback(attRecord->endpoint, attRecord->clusterId, am->attributeId))
         {
-            attributeOffsetIndex = static_cast<uint16_t>(attributeOffsetIndex + emAfEndpoints[ep].endpointType->endpointSize);
+            return EMBER_ZCL_STATUS_UNSUPPORTED_ACCESS;
         }
     }
-    return EMBER_ZCL_STATUS_UNSUPPORTED_ENDPOINT; // Sorry, endpoint was not found.
+
+    // Is the attribute externally stored?
+    if (am->mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE)
+    {
+        return (write ? emberAfExternalAttributeWriteCallback(attRecord->endpoint, attRecord->clusterId, am, buffer)
+                      : emberAfExternalAttributeReadCallback(attRecord->endpoint, attRecord->clusterId, am, buffer,
+                                                             emberAfAttributeSize(am)));
+    }
+
+    // Internal storage is only supported for fixed endpoints
+    if (!isDynamicEndpoint)
+    {
+        return typeSensitiveMemCopy(attRecord->clusterId, dst, src, am, write, readLength);
+    }
+
+    return EMBER_ZCL_STATUS_FAILURE;
 }
 
 const EmberAfEndpointType * emberAfFindEndpointType(chip::EndpointId endpointId)
@@ -714,7 +935,12 @@ const EmberAfCluster * emberAfFindClusterInType(const EmberAfEndpointType * endp
 
 uint8_t emberAfClusterIndex(EndpointId endpoint, ClusterId clusterId, EmberAfClusterMask mask)
 {
-    for (uint16_t ep = 0; ep < emberAfEndpointCount(); ep++)
+    if (endpoint == kInvalidEndpointId)
+    {
+        return 0xFF;
+    }
+
+    for (uint16_t ep = gEndpointIndexTable.Find(endpoint); ep < emberAfEndpointCount(); ep++)
     {
         // Check the endpoint id first, because that way we avoid examining the
         // endpoint type for endpoints that are not actually defined.
@@ -727,6 +953,10 @@ uint8_t emberAfClusterIndex(EndpointId endpoint, ClusterId clusterId, EmberAfClu
                 return index;
             }
         }
+        if (!gEndpointIndexTable.HasDuplicates())
+        {
+            break;
+        }
     }
     return 0xFF;
 }
@@ -824,14 +1054,19 @@ static uint16_t findIndexFromEndpoint(EndpointId endpoint, bool ignoreDisabledEn
         return kEmberInvalidEndpointIndex;
     }
 
-    uint16_t epi;
-    for (epi = 0; epi < emberAfEndpointCount(); epi++)
+    uint16_t epi = gEndpointIndexTable.Find(endpoint);
+    for (; epi < emberAfEndpointCount(); epi++)
     {
         if (emAfEndpoints[epi].endpoint == endpoint &&
             (!ignoreDisabledEndpoints || emAfEndpoints[epi].bitmask & EMBER_AF_ENDPOINT_ENABLED))
         {
             return epi;
         }
+        if (!gEndpointIndexTable.HasDuplicates())
+        {
+            // The lowest index defining the endpoint is the only one.
+            break;
+        }
     }
     return kEmberInvalidEndpointIndex;
 }
@@ -922,6 +1157,8 @@ bool emberAfEndpointEnableDisable(EndpointId endpoint, bool enable)
 
     if (currentlyEnabled != enable)
     {
+        gMetadataStructureGeneration++;
+
         if (enable)
         {
             initializeEndpoint(&(emAfEndpoints[index]));
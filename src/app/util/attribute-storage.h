@@ -232,6 +232,10 @@ EmberAfStatus emberAfSetDynamicEndpoint(uint16_t index, chip::EndpointId id, con
 chip::EndpointId emberAfClearDynamicEndpoint(uint16_t index);
 uint16_t emberAfGetDynamicIndexFromEndpoint(chip::EndpointId id);
 
+// Returns a counter that changes whenever endpoints are added, removed, enabled or disabled.  Anything derived from the
+// endpoint / cluster / attribute structure exposed by this file can be cached as long as this value stays the same.
+uint32_t emberAfMetadataStructureGeneration();
+
 // Get the number of attributes of the specific cluster under the endpoint.
 // Returns 0 if the cluster does not exist.
 uint16_t emberAfGetServerAttributeCount(chip::EndpointId endpoint, chip::ClusterId cluster);
@@ -43,6 +43,13 @@
 #define EMBER_BINDING_TABLE_SIZE 10
 #endif // EMBER_BINDING_TABLE_SIZE
 
+// Number of entries of the cache of attribute locations used by attribute-storage.cpp to
+// avoid walking the endpoint, cluster and attribute metadata on every access.  Set to 0 to
+// disable the cache.
+#ifndef EMBER_AF_ATTRIBUTE_LOCATION_CACHE_SIZE
+#define EMBER_AF_ATTRIBUTE_LOCATION_CACHE_SIZE 32
+#endif // EMBER_AF_ATTRIBUTE_LOCATION_CACHE_SIZE
+
 /**
  * @brief CHIP uses millisecond ticks
  */
@@ -34,6 +34,15 @@ namespace Test {
 CHIP_ERROR ReadSingleMockClusterData(FabricIndex aAccessingFabricIndex, const app::ConcreteAttributePath & aPath,
                                      app::AttributeReportIBs::Builder & aAttributeReports,
                                      app::AttributeValueEncoder::AttributeEncodeState * apEncoderState);
+/**
+ * Only expose the first aEndpointCount mock endpoints, as if the following ones had been removed.
+ */
+void SetMockEndpointCount(uint16_t aEndpointCount);
+/**
+ * Append aEndpointCount bridged endpoints, with ids 1 to aEndpointCount, to the mock endpoints.  They have the clusters
+ * and attributes of kMockEndpoint3.
+ */
+void SetMockBridgedEndpointCount(uint16_t aEndpointCount);
 void BumpVersion();
 DataVersion GetVersion();
 } // namespace Test
@@ -20,6 +20,7 @@
  *    @file
  *     This file contains the mock implementation for the generated attribute-storage.cpp
  *     - It contains three endpoints, 0xFFFE, 0xFFFD, 0xFFFC
+ *     - Bridged endpoints 1 to N, with the clusters of 0xFFFC, can be appended with SetMockBridgedEndpointCount
  *     - It contains four clusters: 0xFFF1'0001 to 0xFFF1'0004
  *     - All cluster has two global attribute (0x0000'FFFC, 0x0000'FFFD)
  *     - Some clusters has some cluster-specific attributes, with 0xFFF1 prefix.
@@ -86,6 +87,14 @@ EventId events[] = {
     MockEventId(2),
 };
 
+// Endpoints past endpointCount are considered removed.
+uint16_t endpointCount       = ArraySize(endpoints);
+uint32_t structureGeneration = 0;
+
+// The bridged endpoints follow the mock endpoints and all share the layout of the last one.
+constexpr uint16_t kMaxBridgedEndpointCount = 1024;
+uint16_t bridgedEndpointCount               = 0;
+
 uint16_t mockClusterRevision = 1;
 uint32_t mockFeatureMap      = 0x1234;
 bool mockAttribute1          = true;
@@ -128,22 +137,34 @@ EmberAfEndpointType endpointStructs[] = {
     MOCK_ENDPOINT_DECL(2),
 };
 
+EndpointId EndpointFromIndex(uint16_t index)
+{
+    return (index < endpointCount) ? endpoints[index] : static_cast<EndpointId>(index - endpointCount + 1);
+}
+
+// Index of the mock endpoint whose clusters and attributes the endpoint at index has.
+uint16_t LayoutIndex(uint16_t index)
+{
+    return (index < endpointCount) ? index : static_cast<uint16_t>(ArraySize(endpoints) - 1);
+}
+
 } // namespace
 
 uint16_t emberAfEndpointCount()
 {
-    return ArraySize(endpoints);
+    return static_cast<uint16_t>(endpointCount + bridgedEndpointCount);
 }
 
 uint16_t emberAfIndexFromEndpoint(chip::EndpointId endpoint)
 {
-    static_assert(ArraySize(endpoints) < UINT16_MAX, "Need to be able to return endpoint index as a 16-bit value.");
+    static_assert(ArraySize(endpoints) + kMaxBridgedEndpointCount < UINT16_MAX,
+                  "Need to be able to return endpoint index as a 16-bit value.");
 
-    for (size_t i = 0; i < ArraySize(endpoints); i++)
+    for (uint16_t i = 0; i < emberAfEndpointCount(); i++)
     {
-        if (endpoints[i] == endpoint)
+        if (EndpointFromIndex(i) == endpoint)
         {
-            return static_cast<uint16_t>(i);
+            return i;
         }
     }
     return UINT16_MAX;
@@ -151,14 +172,8 @@ uint16_t emberAfIndexFromEndpoint(chip::EndpointId endpoint)
 
 uint8_t emberAfGetClusterCountForEndpoint(chip::EndpointId endpoint)
 {
-    for (size_t i = 0; i < ArraySize(endpoints); i++)
-    {
-        if (endpoints[i] == endpoint)
-        {
-            return clusterCount[i];
-        }
-    }
-    return 0;
+    uint16_t endpointIndex = emberAfIndexFromEndpoint(endpoint);
+    return (endpointIndex == UINT16_MAX) ? 0 : clusterCount[LayoutIndex(endpointIndex)];
 }
 
 uint8_t emberAfClusterCount(chip::EndpointId endpoint, bool server)
@@ -172,9 +187,9 @@ uint16_t emberAfGetServerAttributeCount(chip::EndpointId endpoint, chip::Cluster
     uint8_t clusterCountOnEndpoint = emberAfClusterCount(endpoint, true);
     for (uint8_t i = 0; i < clusterCountOnEndpoint; i++)
     {
-        if (clusters[i + clusterIndex[endpointIndex]] == cluster)
+        if (clusters[i + clusterIndex[LayoutIndex(endpointIndex)]] == cluster)
         {
-            return attributeCount[i + clusterIndex[endpointIndex]];
+            return attributeCount[i + clusterIndex[LayoutIndex(endpointIndex)]];
         }
     }
     return 0;
@@ -187,9 +202,9 @@ uint16_t emberAfGetServerAttributeIndexByAttributeId(chip::EndpointId endpoint,
     uint8_t clusterCountOnEndpoint = emberAfClusterCount(endpoint, true);
     for (uint8_t i = 0; i < clusterCountOnEndpoint; i++)
     {
-        if (clusters[i + clusterIndex[endpointIndex]] == cluster)
+        if (clusters[i + clusterIndex[LayoutIndex(endpointIndex)]] == cluster)
         {
-            uint16_t clusterAttributeOffset = attributeIndex[i + clusterIndex[endpointIndex]];
+            uint16_t clusterAttributeOffset = attributeIndex[i + clusterIndex[LayoutIndex(endpointIndex)]];
             for (uint16_t j = 0; j < emberAfGetServerAttributeCount(endpoint, cluster); j++)
             {
                 if (attributes[clusterAttributeOffset + j] == attributeId)
@@ -210,8 +225,8 @@ bool emberAfContainsAttribute(chip::EndpointId endpoint, chip::ClusterId cluster
 
 chip::EndpointId emberAfEndpointFromIndex(uint16_t index)
 {
-    VerifyOrDie(index < ArraySize(endpoints));
-    return endpoints[index];
+    VerifyOrDie(index < emberAfEndpointCount());
+    return EndpointFromIndex(index);
 }
 
 chip::Optional<chip::ClusterId> emberAfGetNthClusterId(chip::EndpointId endpoint, uint8_t n, bool server)
@@ -220,7 +235,7 @@ chip::Optional<chip::ClusterId> emberAfGetNthClusterId(chip::EndpointId endpoint
     {
         return chip::Optional<chip::ClusterId>::Missing();
     }
-    return chip::Optional<chip::ClusterId>(clusters[clusterIndex[emberAfIndexFromEndpoint(endpoint)] + n]);
+    return chip::Optional<chip::ClusterId>(clusters[clusterIndex[LayoutIndex(emberAfIndexFromEndpoint(endpoint))] + n]);
 }
 
 // Returns number of clusters put into the passed cluster list
@@ -248,9 +263,9 @@ chip::Optional<chip::AttributeId> emberAfGetServerAttributeIdByIndex(chip::Endpo
     uint8_t clusterCountOnEndpoint = emberAfClusterCount(endpoint, true);
     for (uint8_t i = 0; i < clusterCountOnEndpoint; i++)
     {
-        if (clusters[i + clusterIndex[endpointIndex]] == cluster)
+        if (clusters[i + clusterIndex[LayoutIndex(endpointIndex)]] == cluster)
         {
-            uint16_t clusterAttributeOffset = attributeIndex[i + clusterIndex[endpointIndex]];
+            uint16_t clusterAttributeOffset = attributeIndex[i + clusterIndex[LayoutIndex(endpointIndex)]];
             if (index < emberAfGetServerAttributeCount(endpoint, cluster))
             {
                 return Optional<AttributeId>(attributes[clusterAttributeOffset + index]);
@@ -267,7 +282,7 @@ uint8_t emberAfClusterIndex(chip::EndpointId endpoint, chip::ClusterId cluster,
     uint8_t clusterCountOnEndpoint = emberAfClusterCount(endpoint, true);
     for (uint8_t i = 0; i < clusterCountOnEndpoint; i++)
     {
-        if (clusters[i + clusterIndex[endpointIndex]] == cluster)
+        if (clusters[i + clusterIndex[LayoutIndex(endpointIndex)]] == cluster)
         {
             return i;
         }
@@ -277,7 +292,12 @@ uint8_t emberAfClusterIndex(chip::EndpointId endpoint, chip::ClusterId cluster,
 
 bool emberAfEndpointIndexIsEnabled(uint16_t index)
 {
-    return index < ArraySize(endpoints);
+    return index < emberAfEndpointCount();
+}
+
+uint32_t emberAfMetadataStructureGeneration()
+{
+    return structureGeneration;
 }
 
 // This duplication of basic utilities is really unfortunate, but we can't link
@@ -328,7 +348,7 @@ const EmberAfEndpointType * emberAfFindEndpointType(EndpointId endpointId)
     {
         return nullptr;
     }
-    return &endpointStructs[ep];
+    return &endpointStructs[LayoutIndex(ep)];
 }
 
 const EmberAfCluster * emberAfFindServerCluster(EndpointId endpoint, ClusterId clusterId)
@@ -388,6 +408,20 @@ void EnabledEndpointsWithServerCluster::EnsureMatchingEndpoint()
 } // namespace app
 namespace Test {
 
+void SetMockEndpointCount(uint16_t aEndpointCount)
+{
+    VerifyOrDie(aEndpointCount <= ArraySize(endpoints));
+    endpointCount = aEndpointCount;
+    structureGeneration++;
+}
+
+void SetMockBridgedEndpointCount(uint16_t aEndpointCount)
+{
+    VerifyOrDie(aEndpointCount <= kMaxBridgedEndpointCount);
+    bridgedEndpointCount = aEndpointCount;
+    structureGeneration++;
+}
+
 void BumpVersion()
 {
     dataVersion++;
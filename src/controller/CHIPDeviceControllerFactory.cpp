@@ -36,7 +36,7 @@
 
 #include <app/server/Dnssd.h>
 #include <protocols/secure_channel/CASEServer.h>
-#include <protocols/secure_channel/SimpleSessionResumptionStorage.h>
+#include <protocols/secure_channel/CachedSessionResumptionStorage.h>
 
 using namespace chip::Inet;
 using namespace chip::System;
@@ -191,8 +191,8 @@ CHIP_ERROR DeviceControllerFactory::InitSystemState(FactoryInitParams params)
         tempFabricTable         = stateParams.fabricTable;
     }
 
-    auto sessionResumptionStorage = chip::Platform::MakeUnique<SimpleSessionResumptionStorage>();
-    ReturnErrorOnFailure(sessionResumptionStorage->Init(params.fabricIndependentStorage));
+    auto sessionResumptionStorage = chip::Platform::MakeUnique<CachedSessionResumptionStorage>();
+    ReturnErrorOnFailure(sessionResumptionStorage->Init(params.fabricIndependentStorage, stateParams.systemLayer));
     stateParams.sessionResumptionStorage = std::move(sessionResumptionStorage);
 
     auto delegate = chip::Platform::MakeUnique<ControllerFabricDelegate>();
@@ -416,6 +416,12 @@ void DeviceControllerSystemState::Shutdown()
         mCASESessionManager = nullptr;
     }
 
+    // Write out the session resumption records still pending while the system layer and the storage are up.
+    if (mSessionResumptionStorage)
+    {
+        mSessionResumptionStorage->Shutdown();
+    }
+
     // mCASEClientPool and mSessionSetupPool must be deallocated
     // after mCASESessionManager, which uses them.
 
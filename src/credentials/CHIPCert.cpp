@@ -469,11 +469,24 @@ CHIP_ERROR ChipCertificateSet::ValidateCert(const ChipCertificateData * cert, Va
         ExitNow(err = CHIP_ERROR_CA_CERT_NOT_FOUND);
     }
 
+    // A CA certificate issued by the trust anchor may already have been verified by an earlier validation, in which
+    // case its signature doesn't need to be checked again.
+    if (depth > 0 && caCert->mCertFlags.Has(CertFlags::kIsTrustAnchor) && context.mVerifiedCertificateCache != nullptr &&
+        context.mVerifiedCertificateCache->Lookup(*cert, *caCert))
+    {
+        ExitNow(err = CHIP_NO_ERROR);
+    }
+
     // Verify signature of the current certificate against public key of the CA certificate. If signature verification
     // succeeds, the current certificate is valid.
     err = VerifySignature(cert, caCert);
     SuccessOrExit(err);
 
+    if (depth > 0 && caCert->mCertFlags.Has(CertFlags::kIsTrustAnchor) && context.mVerifiedCertificateCache != nullptr)
+    {
+        context.mVerifiedCertificateCache->Add(*cert, *caCert);
+    }
+
 exit:
     return err;
 }
@@ -564,9 +577,10 @@ bool ChipCertificateData::IsEqual(const ChipCertificateData & other) const
 
 void ValidationContext::Reset()
 {
-    mEffectiveTime  = EffectiveTime{};
-    mTrustAnchor    = nullptr;
-    mValidityPolicy = nullptr;
+    mEffectiveTime            = EffectiveTime{};
+    mTrustAnchor              = nullptr;
+    mValidityPolicy           = nullptr;
+    mVerifiedCertificateCache = nullptr;
     mRequiredKeyUsages.ClearAll();
     mRequiredKeyPurposes.ClearAll();
     mRequiredCertType = kCertType_NotSpecified;
@@ -32,6 +32,7 @@
 
 #include "CHIPCert.h"
 #include "CertificateValidityPolicy.h"
+#include "VerifiedCertificateCache.h"
 #include <lib/support/Variant.h>
 
 namespace chip {
@@ -74,6 +75,8 @@ struct ValidationContext
 
     CertificateValidityPolicy * mValidityPolicy =
         nullptr; /**< Optional application policy to apply for certificate validity period evaluation. */
+    VerifiedCertificateCache * mVerifiedCertificateCache =
+        nullptr; /**< Optional cache of CA certificates already verified against a trust anchor. */
 
     void Reset();
 
@@ -927,6 +927,9 @@ CHIP_ERROR FabricTable::Delete(FabricIndex fabricIndex)
         fabricInfo = GetMutableFabricByIndex(fabricIndex);
     }
 
+    // Persist the removal of all the data of the fabric, including what delegates remove, at once.
+    PersistentStorageBatch storageBatch(mStorage);
+
     bool fabricIsInitialized = fabricInfo != nullptr && fabricInfo->IsInitialized();
     CHIP_ERROR metadataErr   = DeleteMetadataFromStorage(fabricIndex); // Delete from storage regardless
 
@@ -1128,6 +1131,7 @@ void FabricTable::Shutdown()
         // direct lookups fail.
         fabricInfo.Reset();
     }
+    mVerifiedCertificateCache.Clear();
 
     mStorage = nullptr;
 }
@@ -1858,6 +1862,11 @@ CHIP_ERROR FabricTable::CommitPendingFabricData()
     }
 
     // ==== Start of actual commit transaction after pre-flight checks ====
+
+    // Storage backends that support batching persist all the writes of the commit at once. The commit marker is still
+    // needed for the ones that do not.
+    PersistentStorageBatch storageBatch(mStorage);
+
     CHIP_ERROR stickyError  = StoreCommitMarker(CommitMarker{ fabricIndexBeingCommitted, isAdding });
     bool failedCommitMarker = (stickyError != CHIP_NO_ERROR);
     if (failedCommitMarker)
@@ -1923,6 +1932,14 @@ CHIP_ERROR FabricTable::CommitPendingFabricData()
                 mFabricIndexWithPendingState = kUndefinedFabricIndex;
                 mPendingFabric.Reset();
 
+                // Persist the partial transaction, as a reboot at this point would leave it without batching.
+                CHIP_ERROR batchErr = storageBatch.Commit();
+                if (batchErr != CHIP_NO_ERROR)
+                {
+                    ChipLogError(FabricProvisioning, "Failed to persist partial fabric commit: %" CHIP_ERROR_FORMAT,
+                                 batchErr.Format());
+                }
+
                 ChipLogError(FabricProvisioning, "Aborting commit in middle of transaction for testing.");
                 return CHIP_ERROR_INTERNAL;
             }
@@ -1963,6 +1980,13 @@ CHIP_ERROR FabricTable::CommitPendingFabricData()
             }
         }
         stickyError = (stickyError != CHIP_NO_ERROR) ? stickyError : fabricIndexErr;
+
+        CHIP_ERROR batchErr = storageBatch.Commit();
+        if (batchErr != CHIP_NO_ERROR)
+        {
+            ChipLogError(FabricProvisioning, "Failed to persist fabric commit: %" CHIP_ERROR_FORMAT, batchErr.Format());
+        }
+        stickyError = (stickyError != CHIP_NO_ERROR) ? stickyError : batchErr;
     }
 
     // Commit must have same side-effect as reverting all pending data
@@ -29,6 +29,7 @@
 #include <credentials/CertificateValidityPolicy.h>
 #include <credentials/LastKnownGoodTime.h>
 #include <credentials/OperationalCertificateStore.h>
+#include <credentials/VerifiedCertificateCache.h>
 #include <crypto/CHIPCryptoPAL.h>
 #include <crypto/OperationalKeystore.h>
 #include <lib/core/CHIPPersistentStorageDelegate.h>
@@ -931,6 +932,15 @@ public:
                                         Credentials::ValidationContext & context, CompressedFabricId & outCompressedFabricId,
                                         FabricId & outFabricId, NodeId & outNodeId, Crypto::P256PublicKey & outNocPubkey,
                                         Crypto::P256PublicKey * outRootPublicKey = nullptr);
+
+    /**
+     * @brief Cache of intermediate certificates already verified against a trusted root, meant to be set as the
+     *        mVerifiedCertificateCache of the ValidationContext used to verify peer credentials (e.g. by CASE).
+     *
+     * GetStats() on the cache reports its hit rate.
+     */
+    Credentials::VerifiedCertificateCache & GetVerifiedCertificateCache() { return mVerifiedCertificateCache; }
+
     /**
      * @brief Enables FabricInfo instances to collide and reference the same logical fabric (i.e Root Public Key + FabricId).
      *
@@ -1148,6 +1158,8 @@ private:
 
     LastKnownGoodTime mLastKnownGoodTime;
 
+    Credentials::VerifiedCertificateCache mVerifiedCertificateCache;
+
     // We may not have an mNextAvailableFabricIndex if our table is as large as
     // it can go and is full.
     Optional<FabricIndex> mNextAvailableFabricIndex;
@@ -335,6 +335,9 @@ CHIP_ERROR PersistentStorageOpCertStore::CommitOpCertsForFabric(FabricIndex fabr
 
     // TODO: Handle transaction marking to revert partial certs at next boot if we get interrupted by reboot.
 
+    // Storage backends that support batching persist the whole chain at once.
+    PersistentStorageBatch storageBatch(mStorage);
+
     // Start committing NOC first so we don't have dangling roots if one was added.
     ByteSpan pendingNocSpan{ mPendingNoc.Get(), mPendingNoc.AllocatedSize() };
     CHIP_ERROR nocErr = SaveCertToStorage(mStorage, mPendingFabricIndex, CertChainElement::kNoc, pendingNocSpan);
@@ -377,6 +380,8 @@ CHIP_ERROR PersistentStorageOpCertStore::CommitOpCertsForFabric(FabricIndex fabr
         return stickyErr;
     }
 
+    ReturnErrorOnFailure(storageBatch.Commit());
+
     // If we got here, we succeeded and can reset the pending certs: next `GetCertificate` will use the stored certs
     RevertPendingOpCerts();
     return CHIP_NO_ERROR;
@@ -411,6 +416,7 @@ CHIP_ERROR PersistentStorageOpCertStore::RemoveOpCertsForFabric(FabricIndex fabr
     RevertPendingOpCerts();
 
     // Remove all persisted certs for the given fabric, blindly
+    PersistentStorageBatch storageBatch(mStorage);
     CHIP_ERROR nocErr  = DeleteCertFromStorage(mStorage, fabricIndex, CertChainElement::kNoc);
     CHIP_ERROR icacErr = DeleteCertFromStorage(mStorage, fabricIndex, CertChainElement::kIcac);
     CHIP_ERROR rcacErr = DeleteCertFromStorage(mStorage, fabricIndex, CertChainElement::kRcac);
@@ -425,7 +431,8 @@ CHIP_ERROR PersistentStorageOpCertStore::RemoveOpCertsForFabric(FabricIndex fabr
     stickyErr            = (stickyErr != CHIP_NO_ERROR) ? stickyErr : icacErr;
     stickyErr            = (stickyErr != CHIP_NO_ERROR) ? stickyErr : rcacErr;
 
-    return stickyErr;
+    CHIP_ERROR batchErr = storageBatch.Commit();
+    return (stickyErr != CHIP_NO_ERROR) ? stickyErr : batchErr;
 }
 
 CHIP_ERROR PersistentStorageOpCertStore::GetPendingCertificate(FabricIndex fabricIndex, CertChainElement element,
@@ -0,0 +1,152 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <credentials/VerifiedCertificateCache.h>
+
+#include <credentials/CHIPCert.h>
+#include <lib/support/CodeUtils.h>
+
+#include <mutex>
+#include <string.h>
+
+namespace chip {
+namespace Credentials {
+
+static_assert(CHIP_CONFIG_VERIFIED_CERT_CACHE_SIZE > 0, "The verified certificate cache needs at least one entry");
+
+VerifiedCertificateCache::VerifiedCertificateCache()
+{
+    System::Mutex::Init(mLock);
+    for (auto & entry : mEntries)
+    {
+        entry.mInUse = false;
+    }
+}
+
+CHIP_ERROR VerifiedCertificateCache::ComputeKey(const ChipCertificateData & cert, const ChipCertificateData & caCert,
+                                                uint8_t (&outKey)[Crypto::kSHA256_Hash_Length])
+{
+    VerifyOrReturnError(cert.mCertFlags.Has(CertFlags::kTBSHashPresent), CHIP_ERROR_INVALID_ARGUMENT);
+
+    Crypto::Hash_SHA256_stream hash;
+    ReturnErrorOnFailure(hash.Begin());
+    ReturnErrorOnFailure(hash.AddData(ByteSpan(cert.mTBSHash)));
+    ReturnErrorOnFailure(hash.AddData(ByteSpan(cert.mSignature)));
+    ReturnErrorOnFailure(hash.AddData(ByteSpan(caCert.mPublicKey)));
+
+    MutableByteSpan keySpan(outKey);
+    return hash.Finish(keySpan);
+}
+
+VerifiedCertificateCache::Entry * VerifiedCertificateCache::Find(const uint8_t (&key)[Crypto::kSHA256_Hash_Length])
+{
+    for (auto & entry : mEntries)
+    {
+        if (entry.mInUse && memcmp(entry.mKey, key, sizeof(key)) == 0)
+        {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+bool VerifiedCertificateCache::Lookup(const ChipCertificateData & cert, const ChipCertificateData & caCert)
+{
+    uint8_t key[Crypto::kSHA256_Hash_Length];
+    if (ComputeKey(cert, caCert, key) != CHIP_NO_ERROR)
+    {
+        return false;
+    }
+
+    std::lock_guard<System::Mutex> lock(mLock);
+
+    Entry * entry = Find(key);
+    if (entry == nullptr)
+    {
+        mStats.mMisses++;
+        return false;
+    }
+
+    entry->mLastUsed = ++mUseCounter;
+    mStats.mHits++;
+    return true;
+}
+
+void VerifiedCertificateCache::Add(const ChipCertificateData & cert, const ChipCertificateData & caCert)
+{
+    uint8_t key[Crypto::kSHA256_Hash_Length];
+    if (ComputeKey(cert, caCert, key) != CHIP_NO_ERROR)
+    {
+        return;
+    }
+
+    std::lock_guard<System::Mutex> lock(mLock);
+
+    // Another validation may have added the same certificate while the signature was being verified.
+    Entry * entry = Find(key);
+    if (entry == nullptr)
+    {
+        entry = &mEntries[0];
+        for (auto & candidate : mEntries)
+        {
+            if (!candidate.mInUse)
+            {
+                entry = &candidate;
+                break;
+            }
+            if (candidate.mLastUsed < entry->mLastUsed)
+            {
+                entry = &candidate;
+            }
+        }
+
+        if (entry->mInUse)
+        {
+            mStats.mEvictions++;
+        }
+
+        memcpy(entry->mKey, key, sizeof(key));
+        entry->mInUse = true;
+    }
+
+    entry->mLastUsed = ++mUseCounter;
+}
+
+void VerifiedCertificateCache::Clear()
+{
+    std::lock_guard<System::Mutex> lock(mLock);
+
+    for (auto & entry : mEntries)
+    {
+        entry.mInUse = false;
+    }
+}
+
+VerifiedCertificateCache::Stats VerifiedCertificateCache::GetStats()
+{
+    std::lock_guard<System::Mutex> lock(mLock);
+    return mStats;
+}
+
+void VerifiedCertificateCache::ResetStats()
+{
+    std::lock_guard<System::Mutex> lock(mLock);
+    mStats = Stats();
+}
+
+} // namespace Credentials
+} // namespace chip
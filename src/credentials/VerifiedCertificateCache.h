@@ -0,0 +1,105 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @brief Defines a bounded cache of CA certificate signatures that were already verified against a trusted root.
+ */
+
+#pragma once
+
+#include <crypto/CHIPCryptoPAL.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/CHIPError.h>
+#include <system/SystemMutex.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace Credentials {
+
+struct ChipCertificateData;
+
+/**
+ * Remembers which intermediate certificates were found to be signed by a trust anchor, so that validating
+ * another chain through the same ICAC (e.g. every CASE session with the nodes of one fabric) does not repeat
+ * the ECDSA verification of the ICAC against the RCAC.
+ *
+ * An entry is keyed by a digest of the TBS hash and signature of the certificate together with the public key
+ * of the trust anchor that signed it, so a hit only stands for "this exact signature was valid under this exact
+ * root key". Whether the root itself is trusted is still decided by the caller on every validation.
+ *
+ * Least recently used entries are evicted when the cache is full. Lookups and insertions are serialized, since
+ * certificate validation may run on background threads.
+ */
+class VerifiedCertificateCache
+{
+public:
+    struct Stats
+    {
+        uint32_t mHits      = 0;
+        uint32_t mMisses    = 0;
+        uint32_t mEvictions = 0;
+    };
+
+    VerifiedCertificateCache();
+
+    VerifiedCertificateCache(const VerifiedCertificateCache &)             = delete;
+    VerifiedCertificateCache & operator=(const VerifiedCertificateCache &) = delete;
+
+    /**
+     * Check whether the signature of `cert` was already verified against the public key of `caCert`.
+     *
+     * @return true on a cache hit, in which case the signature does not need to be verified again.
+     */
+    bool Lookup(const ChipCertificateData & cert, const ChipCertificateData & caCert);
+
+    /**
+     * Record that the signature of `cert` was verified against the public key of `caCert`, evicting the least
+     * recently used entry if the cache is full.
+     */
+    void Add(const ChipCertificateData & cert, const ChipCertificateData & caCert);
+
+    /**
+     * Drop all entries. Statistics are kept.
+     */
+    void Clear();
+
+    Stats GetStats();
+    void ResetStats();
+
+private:
+    struct Entry
+    {
+        uint8_t mKey[Crypto::kSHA256_Hash_Length];
+        uint32_t mLastUsed;
+        bool mInUse;
+    };
+
+    static CHIP_ERROR ComputeKey(const ChipCertificateData & cert, const ChipCertificateData & caCert,
+                                 uint8_t (&outKey)[Crypto::kSHA256_Hash_Length]);
+
+    Entry * Find(const uint8_t (&key)[Crypto::kSHA256_Hash_Length]);
+
+    Entry mEntries[CHIP_CONFIG_VERIFIED_CERT_CACHE_SIZE];
+    uint32_t mUseCounter = 0;
+    Stats mStats;
+    System::Mutex mLock;
+};
+
+} // namespace Credentials
+} // namespace chip
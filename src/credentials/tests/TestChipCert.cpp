@@ -25,6 +25,7 @@
  */
 
 #include <credentials/CHIPCert.h>
+#include <credentials/VerifiedCertificateCache.h>
 #include <credentials/examples/LastKnownGoodTimeCertificateValidityPolicyExample.h>
 #include <credentials/examples/StrictCertificateValidityPolicyExample.h>
 #include <crypto/CHIPCryptoPAL.h>
@@ -1076,6 +1077,77 @@ static void TestChipCert_CertValidityPolicyInjection(nlTestSuite * inSuite, void
     certSet.Release();
 }
 
+static void TestChipCert_VerifiedCertificateCache(nlTestSuite * inSuite, void * inContext)
+{
+    CHIP_ERROR err;
+    ChipCertificateSet certSet;
+    ValidationContext validContext;
+    VerifiedCertificateCache cache;
+
+    err = certSet.Init(kStandardCertsCount);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = LoadTestCertSet01(certSet);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    validContext.Reset();
+    validContext.mRequiredKeyUsages.Set(KeyUsageFlags::kDigitalSignature);
+    validContext.mRequiredKeyPurposes.Set(KeyPurposeFlags::kServerAuth);
+    validContext.mVerifiedCertificateCache = &cache;
+
+    // First validation verifies the ICAC signature and remembers it. The NOC is not issued by the root and is never cached.
+    err = certSet.ValidateCert(certSet.GetLastCert(), validContext);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    VerifiedCertificateCache::Stats stats = cache.GetStats();
+    NL_TEST_ASSERT(inSuite, stats.mHits == 0 && stats.mMisses == 1 && stats.mEvictions == 0);
+
+    // Validating again through the same ICAC hits the cache.
+    err = certSet.ValidateCert(certSet.GetLastCert(), validContext);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    stats = cache.GetStats();
+    NL_TEST_ASSERT(inSuite, stats.mHits == 1 && stats.mMisses == 1 && stats.mEvictions == 0);
+
+    const ChipCertificateData * rcac = &certSet.GetCertSet()[0];
+    const ChipCertificateData * icac = &certSet.GetCertSet()[1];
+    NL_TEST_ASSERT(inSuite, cache.Lookup(*icac, *rcac));
+
+    // An entry only stands for the signature under that root key.
+    NL_TEST_ASSERT(inSuite, !cache.Lookup(*icac, *icac));
+
+    // Fill the cache with other certificates; the least recently used one is evicted.
+    ChipCertificateData fakeCerts[CHIP_CONFIG_VERIFIED_CERT_CACHE_SIZE];
+    for (size_t i = 0; i < CHIP_CONFIG_VERIFIED_CERT_CACHE_SIZE; i++)
+    {
+        fakeCerts[i] = *icac;
+        fakeCerts[i].mTBSHash[0] ^= static_cast<uint8_t>(i + 1);
+    }
+    NL_TEST_ASSERT(inSuite, cache.Lookup(*icac, *rcac));
+    for (size_t i = 0; i < CHIP_CONFIG_VERIFIED_CERT_CACHE_SIZE - 1; i++)
+    {
+        cache.Add(fakeCerts[i], *rcac);
+    }
+    stats = cache.GetStats();
+    NL_TEST_ASSERT(inSuite, stats.mEvictions == 0);
+
+    cache.Add(fakeCerts[CHIP_CONFIG_VERIFIED_CERT_CACHE_SIZE - 1], *rcac);
+    stats = cache.GetStats();
+    NL_TEST_ASSERT(inSuite, stats.mEvictions == 1);
+    NL_TEST_ASSERT(inSuite, !cache.Lookup(*icac, *rcac));
+    NL_TEST_ASSERT(inSuite, cache.Lookup(fakeCerts[CHIP_CONFIG_VERIFIED_CERT_CACHE_SIZE - 1], *rcac));
+
+    // Once evicted, the next validation verifies the signature again.
+    cache.ResetStats();
+    err = certSet.ValidateCert(certSet.GetLastCert(), validContext);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    stats = cache.GetStats();
+    NL_TEST_ASSERT(inSuite, stats.mHits == 0 && stats.mMisses == 1 && stats.mEvictions == 1);
+
+    cache.Clear();
+    NL_TEST_ASSERT(inSuite, !cache.Lookup(*icac, *rcac));
+
+    certSet.Release();
+}
+
 static void TestChipCert_CertUsage(nlTestSuite * inSuite, void * inContext)
 {
     CHIP_ERROR err;
@@ -2148,6 +2220,7 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Test CHIP Certificate Validation time", TestChipCert_CertValidTime),
     NL_TEST_DEF("Test CHIP Root Certificate Validation", TestChipCert_ValidateChipRCAC),
     NL_TEST_DEF("Test CHIP Certificate Validity Policy injection", TestChipCert_CertValidityPolicyInjection),
+    NL_TEST_DEF("Test CHIP Verified Certificate Cache", TestChipCert_VerifiedCertificateCache),
     NL_TEST_DEF("Test CHIP Certificate Usage", TestChipCert_CertUsage),
     NL_TEST_DEF("Test CHIP Certificate Type", TestChipCert_CertType),
     NL_TEST_DEF("Test CHIP Certificate ID", TestChipCert_CertId),
@@ -704,6 +704,77 @@ CHIP_ERROR AES_CTR_crypt(const uint8_t * input, size_t input_length, const Aes12
     return AES_CCM_encrypt(input, input_length, nullptr, 0, key, nonce, nonce_length, output, tag, kTagLen);
 }
 
+#if !(CHIP_CRYPTO_OPENSSL || CHIP_CRYPTO_BORINGSSL)
+
+// Backends without a cipher context that can be kept across messages go through the one-shot functions.
+
+CHIP_ERROR Aes128CcmCipher::Init(const Aes128KeyHandle & key)
+{
+    VerifyOrReturnError(mKey == nullptr, CHIP_ERROR_INCORRECT_STATE);
+    mKey = &key;
+    return CHIP_NO_ERROR;
+}
+
+void Aes128CcmCipher::Release()
+{
+    mKey = nullptr;
+}
+
+CHIP_ERROR Aes128CcmCipher::Encrypt(const uint8_t * plaintext, size_t plaintext_length, const uint8_t * aad, size_t aad_length,
+                                    const uint8_t * nonce, size_t nonce_length, uint8_t * ciphertext, uint8_t * tag,
+                                    size_t tag_length) const
+{
+    VerifyOrReturnError(mKey != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    return AES_CCM_encrypt(plaintext, plaintext_length, aad, aad_length, *mKey, nonce, nonce_length, ciphertext, tag, tag_length);
+}
+
+CHIP_ERROR Aes128CcmCipher::Decrypt(const uint8_t * ciphertext, size_t ciphertext_length, const uint8_t * aad, size_t aad_length,
+                                    const uint8_t * tag, size_t tag_length, const uint8_t * nonce, size_t nonce_length,
+                                    uint8_t * plaintext) const
+{
+    VerifyOrReturnError(mKey != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    return AES_CCM_decrypt(ciphertext, ciphertext_length, aad, aad_length, tag, tag_length, *mKey, nonce, nonce_length,
+                           plaintext);
+}
+
+#endif // !(CHIP_CRYPTO_OPENSSL || CHIP_CRYPTO_BORINGSSL)
+
+CHIP_ERROR Aes128CcmCipher::EncryptMessages(Message * messages, size_t count) const
+{
+    VerifyOrReturnError(messages != nullptr || count == 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    CHIP_ERROR firstError = CHIP_NO_ERROR;
+    for (size_t i = 0; i < count; i++)
+    {
+        Message & message = messages[i];
+        message.mResult   = Encrypt(message.mInput, message.mInputLength, message.mAad, message.mAadLength, message.mNonce,
+                                    message.mNonceLength, message.mOutput, message.mTag, message.mTagLength);
+        if (firstError == CHIP_NO_ERROR)
+        {
+            firstError = message.mResult;
+        }
+    }
+    return firstError;
+}
+
+CHIP_ERROR Aes128CcmCipher::DecryptMessages(Message * messages, size_t count) const
+{
+    VerifyOrReturnError(messages != nullptr || count == 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    CHIP_ERROR firstError = CHIP_NO_ERROR;
+    for (size_t i = 0; i < count; i++)
+    {
+        Message & message = messages[i];
+        message.mResult   = Decrypt(message.mInput, message.mInputLength, message.mAad, message.mAadLength, message.mTag,
+                                    message.mTagLength, message.mNonce, message.mNonceLength, message.mOutput);
+        if (firstError == CHIP_NO_ERROR)
+        {
+            firstError = message.mResult;
+        }
+    }
+    return firstError;
+}
+
 CHIP_ERROR GenerateCompressedFabricId(const Crypto::P256PublicKey & root_public_key, uint64_t fabric_id,
                                       MutableByteSpan & out_compressed_fabric_id)
 {
@@ -749,6 +749,100 @@ CHIP_ERROR AES_CCM_decrypt(const uint8_t * ciphertext, size_t ciphertext_length,
 CHIP_ERROR AES_CTR_crypt(const uint8_t * input, size_t input_length, const Aes128KeyHandle & key, const uint8_t * nonce,
                          size_t nonce_length, uint8_t * output);
 
+/**
+ * @brief AES-CCM cipher bound to one key, for encrypting and decrypting many messages with it
+ *
+ * Performs the same operations as AES_CCM_encrypt() and AES_CCM_decrypt(), but lets the backend set up its cipher
+ * context and expand the key once per direction, the first time the cipher encrypts or decrypts, instead of for every
+ * message.  Backends that cannot keep such a context, and messages whose nonce or tag length differs from
+ * kAES_CCM128_Nonce_Length and kAES_CCM128_Tag_Length, go through the one-shot functions instead.
+ *
+ * The key handle passed to Init() must outlive the cipher, or the cipher must be released first.
+ */
+class Aes128CcmCipher
+{
+public:
+    /**
+     * @brief One message of a batch, with the arguments of AES_CCM_encrypt() or AES_CCM_decrypt().
+     *
+     * The tag is written when encrypting and read when decrypting.  mResult receives the outcome for this message.
+     */
+    struct Message
+    {
+        const uint8_t * mInput = nullptr;
+        size_t mInputLength    = 0;
+        const uint8_t * mAad   = nullptr;
+        size_t mAadLength      = 0;
+        const uint8_t * mNonce = nullptr;
+        size_t mNonceLength    = 0;
+        uint8_t * mOutput      = nullptr;
+        uint8_t * mTag         = nullptr;
+        size_t mTagLength      = 0;
+        CHIP_ERROR mResult     = CHIP_NO_ERROR;
+    };
+
+    Aes128CcmCipher() = default;
+    ~Aes128CcmCipher() { Release(); }
+
+    Aes128CcmCipher(const Aes128CcmCipher &) = delete;
+    Aes128CcmCipher(Aes128CcmCipher &&)      = delete;
+    void operator=(const Aes128CcmCipher &) = delete;
+    void operator=(Aes128CcmCipher &&) = delete;
+
+    /**
+     * @brief Bind the cipher to a key.
+     *
+     * @return CHIP_ERROR_INCORRECT_STATE if the cipher is already bound, CHIP_NO_ERROR otherwise.
+     */
+    CHIP_ERROR Init(const Aes128KeyHandle & key);
+
+    /**
+     * @brief Free the backend contexts and unbind the cipher from its key.  Does nothing if it is not bound.
+     */
+    void Release();
+
+    bool IsInitialized() const { return mKey != nullptr; }
+
+    /**
+     * @brief Same as AES_CCM_encrypt() with the key of the cipher.
+     */
+    CHIP_ERROR Encrypt(const uint8_t * plaintext, size_t plaintext_length, const uint8_t * aad, size_t aad_length,
+                       const uint8_t * nonce, size_t nonce_length, uint8_t * ciphertext, uint8_t * tag, size_t tag_length) const;
+
+    /**
+     * @brief Same as AES_CCM_decrypt() with the key of the cipher.
+     */
+    CHIP_ERROR Decrypt(const uint8_t * ciphertext, size_t ciphertext_length, const uint8_t * aad, size_t aad_length,
+                       const uint8_t * tag, size_t tag_length, const uint8_t * nonce, size_t nonce_length,
+                       uint8_t * plaintext) const;
+
+    /**
+     * @brief Encrypt a burst of messages, reusing the same backend context for all of them.
+     *
+     * Every message is processed, whether or not the others succeed, and its outcome is stored in its mResult.
+     *
+     * @return The first error of the batch, CHIP_NO_ERROR if every message was encrypted.
+     */
+    CHIP_ERROR EncryptMessages(Message * messages, size_t count) const;
+
+    /**
+     * @brief Decrypt a burst of messages, reusing the same backend context for all of them.
+     *
+     * Every message is processed, so that one message failing authentication does not prevent the others from being
+     * decrypted, and its outcome is stored in its mResult.
+     *
+     * @return The first error of the batch, CHIP_NO_ERROR if every message was decrypted.
+     */
+    CHIP_ERROR DecryptMessages(Message * messages, size_t count) const;
+
+private:
+    const Aes128KeyHandle * mKey = nullptr;
+
+    // Cipher contexts of the backend, if it keeps any, set up the first time the cipher is used in each direction.
+    mutable void * mEncryptContext = nullptr;
+    mutable void * mDecryptContext = nullptr;
+};
+
 /**
  * @brief Generate a PKCS#10 CSR, usable for Matter, from a P256Keypair.
  *
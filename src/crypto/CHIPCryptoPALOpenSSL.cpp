@@ -411,6 +411,210 @@ exit:
     return error;
 }
 
+namespace {
+
+#if CHIP_CRYPTO_BORINGSSL
+using AesCcmContext = EVP_AEAD_CTX;
+#else
+using AesCcmContext = EVP_CIPHER_CTX;
+#endif // CHIP_CRYPTO_BORINGSSL
+
+// Sets up a context that keeps the expanded key for the messages of one direction.  The nonce and tag lengths are part
+// of the CCM parameters set up along with the key, so the context is only used for the lengths of Matter messages.
+AesCcmContext * NewAesCcmContext(const Aes128KeyHandle & key, bool encrypt)
+{
+#if CHIP_CRYPTO_BORINGSSL
+    // The AEAD context serves both directions; each direction still gets its own.
+    (void) encrypt;
+    return EVP_AEAD_CTX_new(EVP_aead_aes_128_ccm_matter(), key.As<Aes128KeyByteArray>(), sizeof(Aes128KeyByteArray),
+                            kAES_CCM128_Tag_Length);
+#else
+    EVP_CIPHER_CTX * context = EVP_CIPHER_CTX_new();
+    VerifyOrReturnValue(context != nullptr, nullptr);
+
+    static_assert(kAES_CCM128_Key_Length == sizeof(Aes128KeyByteArray), "Unexpected key length");
+    const int enc = encrypt ? 1 : 0;
+    int result    = EVP_CipherInit_ex(context, EVP_aes_128_ccm(), nullptr, nullptr, nullptr, enc);
+    if (result == 1)
+    {
+        result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_IVLEN, static_cast<int>(kAES_CCM128_Nonce_Length), nullptr);
+    }
+    if (result == 1)
+    {
+        result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_TAG, static_cast<int>(kAES_CCM128_Tag_Length), nullptr);
+    }
+    if (result == 1)
+    {
+        result = EVP_CipherInit_ex(context, nullptr, nullptr, key.As<Aes128KeyByteArray>(), nullptr, enc);
+    }
+    if (result != 1)
+    {
+        EVP_CIPHER_CTX_free(context);
+        return nullptr;
+    }
+    return context;
+#endif // CHIP_CRYPTO_BORINGSSL
+}
+
+void FreeAesCcmContext(void * context)
+{
+    if (context != nullptr)
+    {
+#if CHIP_CRYPTO_BORINGSSL
+        EVP_AEAD_CTX_free(static_cast<EVP_AEAD_CTX *>(context));
+#else
+        EVP_CIPHER_CTX_free(static_cast<EVP_CIPHER_CTX *>(context));
+#endif // CHIP_CRYPTO_BORINGSSL
+    }
+}
+
+} // namespace
+
+CHIP_ERROR Aes128CcmCipher::Init(const Aes128KeyHandle & key)
+{
+    VerifyOrReturnError(mKey == nullptr, CHIP_ERROR_INCORRECT_STATE);
+    mKey = &key;
+    return CHIP_NO_ERROR;
+}
+
+void Aes128CcmCipher::Release()
+{
+    FreeAesCcmContext(mEncryptContext);
+    FreeAesCcmContext(mDecryptContext);
+    mEncryptContext = nullptr;
+    mDecryptContext = nullptr;
+    mKey            = nullptr;
+}
+
+CHIP_ERROR Aes128CcmCipher::Encrypt(const uint8_t * plaintext, size_t plaintext_length, const uint8_t * aad, size_t aad_length,
+                                    const uint8_t * nonce, size_t nonce_length, uint8_t * ciphertext, uint8_t * tag,
+                                    size_t tag_length) const
+{
+    VerifyOrReturnError(mKey != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    // Leave the lengths the context was not set up for, and the corner cases of empty or missing buffers, to the one-shot
+    // function.
+    if (nonce_length != kAES_CCM128_Nonce_Length || tag_length != kAES_CCM128_Tag_Length || plaintext_length == 0 ||
+        plaintext == nullptr || ciphertext == nullptr || nonce == nullptr || tag == nullptr)
+    {
+        return AES_CCM_encrypt(plaintext, plaintext_length, aad, aad_length, *mKey, nonce, nonce_length, ciphertext, tag,
+                               tag_length);
+    }
+
+    if (mEncryptContext == nullptr)
+    {
+        mEncryptContext = NewAesCcmContext(*mKey, true);
+        VerifyOrReturnError(mEncryptContext != nullptr, CHIP_ERROR_NO_MEMORY);
+    }
+    auto * context = static_cast<AesCcmContext *>(mEncryptContext);
+
+#if CHIP_CRYPTO_BORINGSSL
+    size_t written_tag_len = 0;
+
+    int result = EVP_AEAD_CTX_seal_scatter(context, ciphertext, tag, &written_tag_len, tag_length, nonce, nonce_length, plaintext,
+                                           plaintext_length, nullptr, 0, aad, aad_length);
+    VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+    VerifyOrReturnError(written_tag_len == tag_length, CHIP_ERROR_INTERNAL);
+#else
+    int bytesWritten = 0;
+
+    VerifyOrReturnError(CanCastTo<int>(plaintext_length), CHIP_ERROR_INVALID_ARGUMENT);
+
+    // Pass in nonce, keeping the key schedule
+    int result = EVP_EncryptInit_ex(context, nullptr, nullptr, nullptr, Uint8::to_const_uchar(nonce));
+    VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+
+    // Pass in plain text length
+    result = EVP_EncryptUpdate(context, nullptr, &bytesWritten, nullptr, static_cast<int>(plaintext_length));
+    VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+
+    // Pass in AAD
+    if (aad_length > 0 && aad != nullptr)
+    {
+        VerifyOrReturnError(CanCastTo<int>(aad_length), CHIP_ERROR_INVALID_ARGUMENT);
+        result = EVP_EncryptUpdate(context, nullptr, &bytesWritten, Uint8::to_const_uchar(aad), static_cast<int>(aad_length));
+        VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+    }
+
+    // Encrypt
+    result = EVP_EncryptUpdate(context, Uint8::to_uchar(ciphertext), &bytesWritten, Uint8::to_const_uchar(plaintext),
+                               static_cast<int>(plaintext_length));
+    VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+    VerifyOrReturnError(bytesWritten >= 0 && bytesWritten <= static_cast<int>(plaintext_length), CHIP_ERROR_INTERNAL);
+
+    // Finalize encryption
+    result = EVP_EncryptFinal_ex(context, ciphertext + bytesWritten, &bytesWritten);
+    VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+
+    // Get tag
+    result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_GET_TAG, static_cast<int>(tag_length), Uint8::to_uchar(tag));
+    VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+#endif // CHIP_CRYPTO_BORINGSSL
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR Aes128CcmCipher::Decrypt(const uint8_t * ciphertext, size_t ciphertext_length, const uint8_t * aad, size_t aad_length,
+                                    const uint8_t * tag, size_t tag_length, const uint8_t * nonce, size_t nonce_length,
+                                    uint8_t * plaintext) const
+{
+    VerifyOrReturnError(mKey != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    // Leave the lengths the context was not set up for, and the corner cases of empty or missing buffers, to the one-shot
+    // function.
+    if (nonce_length != kAES_CCM128_Nonce_Length || tag_length != kAES_CCM128_Tag_Length || ciphertext_length == 0 ||
+        ciphertext == nullptr || plaintext == nullptr || nonce == nullptr || tag == nullptr)
+    {
+        return AES_CCM_decrypt(ciphertext, ciphertext_length, aad, aad_length, tag, tag_length, *mKey, nonce, nonce_length,
+                               plaintext);
+    }
+
+    if (mDecryptContext == nullptr)
+    {
+        mDecryptContext = NewAesCcmContext(*mKey, false);
+        VerifyOrReturnError(mDecryptContext != nullptr, CHIP_ERROR_NO_MEMORY);
+    }
+    auto * context = static_cast<AesCcmContext *>(mDecryptContext);
+
+#if CHIP_CRYPTO_BORINGSSL
+    int result = EVP_AEAD_CTX_open_gather(context, plaintext, nonce, nonce_length, ciphertext, ciphertext_length, tag, tag_length,
+                                          aad, aad_length);
+    VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+#else
+    int bytesOutput = 0;
+
+    VerifyOrReturnError(CanCastTo<int>(ciphertext_length), CHIP_ERROR_INVALID_ARGUMENT);
+
+    // Pass in nonce, keeping the key schedule
+    int result = EVP_DecryptInit_ex(context, nullptr, nullptr, nullptr, Uint8::to_const_uchar(nonce));
+    VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+
+    // Pass in expected tag
+    result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_TAG, static_cast<int>(tag_length),
+                                 const_cast<void *>(static_cast<const void *>(tag)));
+    VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+
+    // Pass in cipher text length
+    result = EVP_DecryptUpdate(context, nullptr, &bytesOutput, nullptr, static_cast<int>(ciphertext_length));
+    VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+
+    // Pass in aad
+    if (aad_length > 0 && aad != nullptr)
+    {
+        VerifyOrReturnError(CanCastTo<int>(aad_length), CHIP_ERROR_INVALID_ARGUMENT);
+        result = EVP_DecryptUpdate(context, nullptr, &bytesOutput, Uint8::to_const_uchar(aad), static_cast<int>(aad_length));
+        VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+    }
+
+    // Pass in ciphertext. We wont get anything if validation fails.
+    result = EVP_DecryptUpdate(context, Uint8::to_uchar(plaintext), &bytesOutput, Uint8::to_const_uchar(ciphertext),
+                               static_cast<int>(ciphertext_length));
+    VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+#endif // CHIP_CRYPTO_BORINGSSL
+
+    return CHIP_NO_ERROR;
+}
+
 CHIP_ERROR Hash_SHA256(const uint8_t * data, const size_t data_length, uint8_t * out_buffer)
 {
     // zero data length hash is supported.
@@ -0,0 +1,210 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Measures AES-CCM-128 with the parameters of Matter messages, for the crypto backend the tree is built with: the
+ *      one-shot AES_CCM_encrypt() and AES_CCM_decrypt(), which set up the cipher for every message, against an
+ *      Aes128CcmCipher bound to the key once, used one message at a time and in bursts.
+ *
+ */
+
+#include <crypto/CHIPCryptoPAL.h>
+#include <crypto/CryptoBuildConfig.h>
+#include <crypto/DefaultSessionKeystore.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+
+using namespace chip;
+using namespace chip::Crypto;
+
+namespace {
+
+constexpr size_t kPayloadSizes[] = { 16, 64, 256, 1024 };
+constexpr size_t kMaxPayloadSize = 1024;
+constexpr size_t kBurstSize      = 16;
+constexpr unsigned kIterations   = 20000;
+
+// Same as the header of an unicast message with a destination node ID, which is the authenticated data of the message.
+constexpr size_t kAadLength = 16;
+
+using BenchmarkClock = std::chrono::steady_clock;
+
+const char * BackendName()
+{
+#if CHIP_CRYPTO_BORINGSSL
+    return "boringssl";
+#elif CHIP_CRYPTO_OPENSSL
+    return "openssl";
+#elif CHIP_CRYPTO_MBEDTLS
+    return "mbedtls";
+#elif CHIP_CRYPTO_PSA
+    return "psa";
+#else
+    return "platform";
+#endif
+}
+
+double NanosecondsPerOperation(BenchmarkClock::time_point start, size_t operations)
+{
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(BenchmarkClock::now() - start).count()) /
+        static_cast<double>(operations);
+}
+
+struct Buffers
+{
+    uint8_t mPlaintext[kBurstSize][kMaxPayloadSize];
+    uint8_t mCiphertext[kBurstSize][kMaxPayloadSize];
+    uint8_t mNonce[kBurstSize][kAES_CCM128_Nonce_Length];
+    uint8_t mTag[kBurstSize][kAES_CCM128_Tag_Length];
+    uint8_t mAad[kAadLength];
+};
+
+Buffers gBuffers;
+
+// Every message gets its own nonce, the way the message counter makes them unique.
+void SetNonce(Buffers & buffers, size_t slot, unsigned counter)
+{
+    memset(buffers.mNonce[slot], 0, kAES_CCM128_Nonce_Length);
+    memcpy(buffers.mNonce[slot], &counter, sizeof(counter));
+}
+
+void RunScenario(const Aes128KeyHandle & key, Buffers & buffers, size_t payloadSize)
+{
+    Aes128CcmCipher cipher;
+    VerifyOrDie(cipher.Init(key) == CHIP_NO_ERROR);
+
+    BenchmarkClock::time_point start = BenchmarkClock::now();
+    for (unsigned i = 0; i < kIterations; i++)
+    {
+        SetNonce(buffers, 0, i);
+        VerifyOrDie(AES_CCM_encrypt(buffers.mPlaintext[0], payloadSize, buffers.mAad, kAadLength, key, buffers.mNonce[0],
+                                    kAES_CCM128_Nonce_Length, buffers.mCiphertext[0], buffers.mTag[0],
+                                    kAES_CCM128_Tag_Length) == CHIP_NO_ERROR);
+    }
+    double oneShotEncryptNs = NanosecondsPerOperation(start, kIterations);
+
+    start = BenchmarkClock::now();
+    for (unsigned i = 0; i < kIterations; i++)
+    {
+        VerifyOrDie(AES_CCM_decrypt(buffers.mCiphertext[0], payloadSize, buffers.mAad, kAadLength, buffers.mTag[0],
+                                    kAES_CCM128_Tag_Length, key, buffers.mNonce[0], kAES_CCM128_Nonce_Length,
+                                    buffers.mPlaintext[0]) == CHIP_NO_ERROR);
+    }
+    double oneShotDecryptNs = NanosecondsPerOperation(start, kIterations);
+
+    start = BenchmarkClock::now();
+    for (unsigned i = 0; i < kIterations; i++)
+    {
+        SetNonce(buffers, 0, i);
+        VerifyOrDie(cipher.Encrypt(buffers.mPlaintext[0], payloadSize, buffers.mAad, kAadLength, buffers.mNonce[0],
+                                   kAES_CCM128_Nonce_Length, buffers.mCiphertext[0], buffers.mTag[0],
+                                   kAES_CCM128_Tag_Length) == CHIP_NO_ERROR);
+    }
+    double cipherEncryptNs = NanosecondsPerOperation(start, kIterations);
+
+    start = BenchmarkClock::now();
+    for (unsigned i = 0; i < kIterations; i++)
+    {
+        VerifyOrDie(cipher.Decrypt(buffers.mCiphertext[0], payloadSize, buffers.mAad, kAadLength, buffers.mTag[0],
+                                   kAES_CCM128_Tag_Length, buffers.mNonce[0], kAES_CCM128_Nonce_Length,
+                                   buffers.mPlaintext[0]) == CHIP_NO_ERROR);
+    }
+    double cipherDecryptNs = NanosecondsPerOperation(start, kIterations);
+
+    Aes128CcmCipher::Message encryptBurst[kBurstSize];
+    Aes128CcmCipher::Message decryptBurst[kBurstSize];
+    for (size_t slot = 0; slot < kBurstSize; slot++)
+    {
+        encryptBurst[slot] = { buffers.mPlaintext[slot],
+                               payloadSize,
+                               buffers.mAad,
+                               kAadLength,
+                               buffers.mNonce[slot],
+                               kAES_CCM128_Nonce_Length,
+                               buffers.mCiphertext[slot],
+                               buffers.mTag[slot],
+                               kAES_CCM128_Tag_Length,
+                               CHIP_NO_ERROR };
+        decryptBurst[slot] = { buffers.mCiphertext[slot],
+                               payloadSize,
+                               buffers.mAad,
+                               kAadLength,
+                               buffers.mNonce[slot],
+                               kAES_CCM128_Nonce_Length,
+                               buffers.mPlaintext[slot],
+                               buffers.mTag[slot],
+                               kAES_CCM128_Tag_Length,
+                               CHIP_NO_ERROR };
+    }
+
+    constexpr unsigned kBursts = kIterations / kBurstSize;
+
+    start = BenchmarkClock::now();
+    for (unsigned i = 0; i < kBursts; i++)
+    {
+        for (size_t slot = 0; slot < kBurstSize; slot++)
+        {
+            SetNonce(buffers, slot, static_cast<unsigned>(i * kBurstSize + slot));
+        }
+        VerifyOrDie(cipher.EncryptMessages(encryptBurst, kBurstSize) == CHIP_NO_ERROR);
+    }
+    double burstEncryptNs = NanosecondsPerOperation(start, kBursts * kBurstSize);
+
+    start = BenchmarkClock::now();
+    for (unsigned i = 0; i < kBursts; i++)
+    {
+        VerifyOrDie(cipher.DecryptMessages(decryptBurst, kBurstSize) == CHIP_NO_ERROR);
+    }
+    double burstDecryptNs = NanosecondsPerOperation(start, kBursts * kBurstSize);
+
+    printf("backend=%s payload=%-5u one-shot encrypt=%8.1f decrypt=%8.1f  cipher encrypt=%8.1f decrypt=%8.1f  "
+           "burst of %u encrypt=%8.1f decrypt=%8.1f ns/message\n",
+           BackendName(), static_cast<unsigned>(payloadSize), oneShotEncryptNs, oneShotDecryptNs, cipherEncryptNs,
+           cipherDecryptNs, static_cast<unsigned>(kBurstSize), burstEncryptNs, burstDecryptNs);
+}
+
+} // namespace
+
+int main()
+{
+    VerifyOrDie(Platform::MemoryInit() == CHIP_NO_ERROR);
+
+    Aes128KeyByteArray keyMaterial;
+    memset(keyMaterial, 0x42, sizeof(keyMaterial));
+
+    DefaultSessionKeystore keystore;
+    Aes128KeyHandle key;
+    VerifyOrDie(keystore.CreateKey(keyMaterial, key) == CHIP_NO_ERROR);
+
+    memset(gBuffers.mPlaintext, 0x5a, sizeof(gBuffers.mPlaintext));
+    memset(gBuffers.mAad, 0xa5, sizeof(gBuffers.mAad));
+
+    for (size_t payloadSize : kPayloadSizes)
+    {
+        RunScenario(key, gBuffers, payloadSize);
+    }
+
+    keystore.DestroyKey(key);
+    Platform::MemoryShutdown();
+    return 0;
+}
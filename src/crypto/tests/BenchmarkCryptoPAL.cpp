@@ -0,0 +1,419 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Measures the crypto PAL primitives that PASE, CASE and secure sessions are made of, for the crypto backend the
+ *      tree is built with (the chip_crypto GN argument); build once per backend to compare them.  Every primitive is
+ *      run for a fixed time at each of its sizes, and the results are written to stdout as JSON:
+ *
+ *        {
+ *          "backend": "openssl",
+ *          "results": [
+ *            { "primitive": "aes_ccm_128_encrypt", "size": 64, "operations": 812345, "ops_per_sec": 2707816.7,
+ *              "ns_per_op": 369.3, "allocations_per_op": 0.00 },
+ *            ...
+ *          ]
+ *        }
+ *
+ *      The size is in bytes of input, except for pbkdf2_sha256 where it is the iteration count, and for the
+ *      primitives without a size (0).  Allocations are those made by the backend library, which can only be counted
+ *      with OpenSSL and with mbedTLS built with MBEDTLS_PLATFORM_MEMORY; allocations_per_op is null otherwise.
+ *
+ */
+
+#include <crypto/CHIPCryptoPAL.h>
+#include <crypto/CryptoBuildConfig.h>
+#include <crypto/DefaultSessionKeystore.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+
+#include <chrono>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if CHIP_CRYPTO_OPENSSL
+#include <openssl/crypto.h>
+#endif
+
+#if CHIP_CRYPTO_MBEDTLS
+#include <mbedtls/platform.h>
+#endif
+
+using namespace chip;
+using namespace chip::Crypto;
+
+namespace {
+
+constexpr size_t kAesCcmSizes[]        = { 64, 128, 256, 512, 1024 };
+constexpr size_t kHashSizes[]          = { 64, 256, 1024, 4096 };
+constexpr size_t kHkdfOutputSizes[]    = { 16, 32, 48 };
+constexpr uint32_t kPbkdf2Iterations[] = { kSpake2p_Min_PBKDF_Iterations, 10000, kSpake2p_Max_PBKDF_Iterations };
+constexpr size_t kSignedMessageSizes[] = { 64, 1024 };
+constexpr size_t kMaxInputSize         = 4096;
+constexpr size_t kAadLength            = 16;
+constexpr size_t kSetupPinLength       = 4;
+constexpr double kNanosecondsPerSecond = 1e9;
+
+using BenchmarkClock = std::chrono::steady_clock;
+
+// Each primitive runs in batches until this much time was spent in it.  The batches grow until one lasts long enough
+// for the clock not to matter.
+constexpr BenchmarkClock::duration kMinDuration = std::chrono::milliseconds(250);
+constexpr BenchmarkClock::duration kMinBatch    = std::chrono::milliseconds(1);
+
+bool gCountingAllocations = false;
+uint64_t gAllocations     = 0;
+
+#if CHIP_CRYPTO_OPENSSL
+
+void * CountingMalloc(size_t size, const char * file, int line)
+{
+    gAllocations++;
+    return malloc(size);
+}
+
+void * CountingRealloc(void * ptr, size_t size, const char * file, int line)
+{
+    gAllocations++;
+    return realloc(ptr, size);
+}
+
+void CountingFree(void * ptr, const char * file, int line)
+{
+    free(ptr);
+}
+
+#elif CHIP_CRYPTO_MBEDTLS && defined(MBEDTLS_PLATFORM_MEMORY) &&                                                             \
+    !(defined(MBEDTLS_PLATFORM_CALLOC_MACRO) && defined(MBEDTLS_PLATFORM_FREE_MACRO))
+
+void * CountingCalloc(size_t count, size_t size)
+{
+    gAllocations++;
+    return calloc(count, size);
+}
+
+void CountingFree(void * ptr)
+{
+    free(ptr);
+}
+
+#endif
+
+// Has to run before the backend allocates anything, since the memory it already holds would be freed by the wrong
+// function otherwise.
+void StartCountingAllocations()
+{
+#if CHIP_CRYPTO_OPENSSL
+    gCountingAllocations = CRYPTO_set_mem_functions(CountingMalloc, CountingRealloc, CountingFree) == 1;
+#elif CHIP_CRYPTO_MBEDTLS && defined(MBEDTLS_PLATFORM_MEMORY) &&                                                             \
+    !(defined(MBEDTLS_PLATFORM_CALLOC_MACRO) && defined(MBEDTLS_PLATFORM_FREE_MACRO))
+    gCountingAllocations = mbedtls_platform_set_calloc_free(CountingCalloc, CountingFree) == 0;
+#endif
+}
+
+const char * BackendName()
+{
+#if CHIP_CRYPTO_BORINGSSL
+    return "boringssl";
+#elif CHIP_CRYPTO_OPENSSL
+    return "openssl";
+#elif CHIP_CRYPTO_MBEDTLS
+    return "mbedtls";
+#elif CHIP_CRYPTO_PSA
+    return "psa";
+#else
+    return "platform";
+#endif
+}
+
+// Accumulates the time and the backend allocations of the operations run between Start() and Stop().
+class Stopwatch
+{
+public:
+    void Start()
+    {
+        mAllocationsAtStart = gAllocations;
+        mStart              = BenchmarkClock::now();
+    }
+
+    // Returns how long the operations since Start() took.
+    BenchmarkClock::duration Stop(uint64_t operations)
+    {
+        BenchmarkClock::duration elapsed = BenchmarkClock::now() - mStart;
+        mElapsed += elapsed;
+        mAllocations += gAllocations - mAllocationsAtStart;
+        mOperations += operations;
+        return elapsed;
+    }
+
+    bool Done() const { return mElapsed >= kMinDuration; }
+
+    BenchmarkClock::duration Elapsed() const { return mElapsed; }
+    uint64_t Allocations() const { return mAllocations; }
+    uint64_t Operations() const { return mOperations; }
+
+private:
+    BenchmarkClock::time_point mStart;
+    BenchmarkClock::duration mElapsed{};
+    uint64_t mAllocationsAtStart = 0;
+    uint64_t mAllocations        = 0;
+    uint64_t mOperations         = 0;
+};
+
+bool gFirstResult = true;
+
+void Report(const char * primitive, size_t size, const Stopwatch & stopwatch)
+{
+    const double operations = static_cast<double>(stopwatch.Operations());
+    const double nanoseconds =
+        static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(stopwatch.Elapsed()).count());
+    const double nsPerOp = nanoseconds / operations;
+
+    printf("%s\n    { \"primitive\": \"%s\", \"size\": %u, \"operations\": %llu, \"ops_per_sec\": %.1f, \"ns_per_op\": %.1f, "
+           "\"allocations_per_op\": ",
+           gFirstResult ? "" : ",", primitive, static_cast<unsigned>(size),
+           static_cast<unsigned long long>(stopwatch.Operations()), kNanosecondsPerSecond / nsPerOp, nsPerOp);
+    if (gCountingAllocations)
+    {
+        printf("%.2f }", static_cast<double>(stopwatch.Allocations()) / operations);
+    }
+    else
+    {
+        printf("null }");
+    }
+    gFirstResult = false;
+}
+
+template <typename Operation>
+void Measure(const char * primitive, size_t size, Operation && operation)
+{
+    Stopwatch stopwatch;
+    uint64_t batch = 1;
+    while (!stopwatch.Done())
+    {
+        stopwatch.Start();
+        for (uint64_t i = 0; i < batch; i++)
+        {
+            operation();
+        }
+        if (stopwatch.Stop(batch) < kMinBatch)
+        {
+            batch *= 2;
+        }
+    }
+    Report(primitive, size, stopwatch);
+}
+
+uint8_t gInput[kMaxInputSize];
+uint8_t gOutput[kMaxInputSize];
+
+void MeasureAesCcm()
+{
+    Aes128KeyByteArray keyMaterial;
+    memset(keyMaterial, 0x42, sizeof(keyMaterial));
+
+    DefaultSessionKeystore keystore;
+    Aes128KeyHandle key;
+    VerifyOrDie(keystore.CreateKey(keyMaterial, key) == CHIP_NO_ERROR);
+
+    Aes128CcmCipher cipher;
+    VerifyOrDie(cipher.Init(key) == CHIP_NO_ERROR);
+
+    uint8_t aad[kAadLength]                 = {};
+    uint8_t nonce[kAES_CCM128_Nonce_Length] = {};
+    uint8_t tag[kAES_CCM128_Tag_Length];
+
+    for (size_t size : kAesCcmSizes)
+    {
+        Measure("aes_ccm_128_encrypt", size, [&] {
+            VerifyOrDie(AES_CCM_encrypt(gInput, size, aad, sizeof(aad), key, nonce, sizeof(nonce), gOutput, tag, sizeof(tag)) ==
+                        CHIP_NO_ERROR);
+        });
+        Measure("aes_ccm_128_decrypt", size, [&] {
+            VerifyOrDie(AES_CCM_decrypt(gOutput, size, aad, sizeof(aad), tag, sizeof(tag), key, nonce, sizeof(nonce), gInput) ==
+                        CHIP_NO_ERROR);
+        });
+        Measure("aes_ccm_128_session_encrypt", size, [&] {
+            VerifyOrDie(cipher.Encrypt(gInput, size, aad, sizeof(aad), nonce, sizeof(nonce), gOutput, tag, sizeof(tag)) ==
+                        CHIP_NO_ERROR);
+        });
+        Measure("aes_ccm_128_session_decrypt", size, [&] {
+            VerifyOrDie(cipher.Decrypt(gOutput, size, aad, sizeof(aad), tag, sizeof(tag), nonce, sizeof(nonce), gInput) ==
+                        CHIP_NO_ERROR);
+        });
+    }
+
+    cipher.Release();
+    keystore.DestroyKey(key);
+}
+
+void MeasureHashes()
+{
+    for (size_t size : kHashSizes)
+    {
+        Measure("sha256_stream", size, [&] {
+            Hash_SHA256_stream hash;
+            uint8_t digest[kSHA256_Hash_Length];
+            MutableByteSpan digestSpan(digest);
+            VerifyOrDie(hash.Begin() == CHIP_NO_ERROR);
+            VerifyOrDie(hash.AddData(ByteSpan(gInput, size)) == CHIP_NO_ERROR);
+            VerifyOrDie(hash.Finish(digestSpan) == CHIP_NO_ERROR);
+        });
+    }
+
+    // Same inputs as the derivation of session keys from a shared secret.
+    const uint8_t secret[kMax_ECDH_Secret_Length] = { 0x01 };
+    const uint8_t salt[kSHA256_Hash_Length]        = { 0x02 };
+    const uint8_t info[]                           = { 'S', 'e', 's', 's', 'i', 'o', 'n', 'K', 'e', 'y', 's' };
+    for (size_t size : kHkdfOutputSizes)
+    {
+        Measure("hkdf_sha256", size, [&] {
+            HKDF_sha hkdf;
+            VerifyOrDie(hkdf.HKDF_SHA256(secret, sizeof(secret), salt, sizeof(salt), info, sizeof(info), gOutput, size) ==
+                        CHIP_NO_ERROR);
+        });
+    }
+
+    const uint8_t setupPin[kSetupPinLength]                 = { 0x15, 0xcd, 0x5b, 0x07 };
+    const uint8_t pbkdfSalt[kSpake2p_Max_PBKDF_Salt_Length] = { 0x03 };
+    for (uint32_t iterations : kPbkdf2Iterations)
+    {
+        Measure("pbkdf2_sha256", iterations, [&] {
+            PBKDF2_sha256 pbkdf;
+            VerifyOrDie(pbkdf.pbkdf2_sha256(setupPin, sizeof(setupPin), pbkdfSalt, sizeof(pbkdfSalt), iterations,
+                                            kSpake2p_WS_Length * 2, gOutput) == CHIP_NO_ERROR);
+        });
+    }
+}
+
+void MeasureP256()
+{
+    Measure("p256_keypair_generate", 0, [] {
+        P256Keypair keypair;
+        VerifyOrDie(keypair.Initialize(ECPKeyTarget::ECDH) == CHIP_NO_ERROR);
+    });
+
+    P256Keypair keypair;
+    VerifyOrDie(keypair.Initialize(ECPKeyTarget::ECDSA) == CHIP_NO_ERROR);
+
+    for (size_t size : kSignedMessageSizes)
+    {
+        P256ECDSASignature signature;
+        Measure("ecdsa_p256_sign", size, [&] { VerifyOrDie(keypair.ECDSA_sign_msg(gInput, size, signature) == CHIP_NO_ERROR); });
+        Measure("ecdsa_p256_verify", size, [&] {
+            VerifyOrDie(keypair.Pubkey().ECDSA_validate_msg_signature(gInput, size, signature) == CHIP_NO_ERROR);
+        });
+    }
+
+    P256Keypair peer;
+    VerifyOrDie(peer.Initialize(ECPKeyTarget::ECDH) == CHIP_NO_ERROR);
+    Measure("ecdh_p256", 0, [&] {
+        P256ECDHDerivedSecret secret;
+        VerifyOrDie(keypair.ECDH_derive_secret(peer.Pubkey(), secret) == CHIP_NO_ERROR);
+    });
+}
+
+// Runs whole SPAKE2+ exchanges the way PASE does, timing each step of both parties together as well as the exchange.
+void MeasureSpake2p()
+{
+    uint8_t context[kSHA256_Hash_Length] = { 0x04 };
+    uint8_t w0[kP256_FE_Length];
+    uint8_t w1[kP256_FE_Length];
+    memset(w0, 0x11, sizeof(w0));
+    memset(w1, 0x22, sizeof(w1));
+
+    uint8_t L[kP256_Point_Length];
+    size_t LLength = sizeof(L);
+    {
+        Spake2p_P256_SHA256_HKDF_HMAC verifier;
+        VerifyOrDie(verifier.Init(context, sizeof(context)) == CHIP_NO_ERROR);
+        VerifyOrDie(verifier.ComputeL(L, &LLength, w1, sizeof(w1)) == CHIP_NO_ERROR);
+    }
+
+    Stopwatch begin;
+    Stopwatch roundOne;
+    Stopwatch roundTwo;
+    Stopwatch keyConfirm;
+    Stopwatch exchange;
+    while (!exchange.Done())
+    {
+        Spake2p_P256_SHA256_HKDF_HMAC prover;
+        Spake2p_P256_SHA256_HKDF_HMAC verifier;
+        uint8_t X[kP256_Point_Length];
+        size_t XLength = sizeof(X);
+        uint8_t Y[kP256_Point_Length];
+        size_t YLength = sizeof(Y);
+        uint8_t proverConfirmation[kMAX_Hash_Length];
+        size_t proverConfirmationLength = sizeof(proverConfirmation);
+        uint8_t verifierConfirmation[kMAX_Hash_Length];
+        size_t verifierConfirmationLength = sizeof(verifierConfirmation);
+
+        exchange.Start();
+        begin.Start();
+        VerifyOrDie(prover.Init(context, sizeof(context)) == CHIP_NO_ERROR);
+        VerifyOrDie(prover.BeginProver(nullptr, 0, nullptr, 0, w0, sizeof(w0), w1, sizeof(w1)) == CHIP_NO_ERROR);
+        VerifyOrDie(verifier.Init(context, sizeof(context)) == CHIP_NO_ERROR);
+        VerifyOrDie(verifier.BeginVerifier(nullptr, 0, nullptr, 0, w0, sizeof(w0), L, LLength) == CHIP_NO_ERROR);
+        begin.Stop(1);
+
+        roundOne.Start();
+        VerifyOrDie(prover.ComputeRoundOne(nullptr, 0, X, &XLength) == CHIP_NO_ERROR);
+        VerifyOrDie(verifier.ComputeRoundOne(X, XLength, Y, &YLength) == CHIP_NO_ERROR);
+        roundOne.Stop(1);
+
+        roundTwo.Start();
+        VerifyOrDie(verifier.ComputeRoundTwo(X, XLength, verifierConfirmation, &verifierConfirmationLength) == CHIP_NO_ERROR);
+        VerifyOrDie(prover.ComputeRoundTwo(Y, YLength, proverConfirmation, &proverConfirmationLength) == CHIP_NO_ERROR);
+        roundTwo.Stop(1);
+
+        keyConfirm.Start();
+        VerifyOrDie(prover.KeyConfirm(verifierConfirmation, verifierConfirmationLength) == CHIP_NO_ERROR);
+        VerifyOrDie(verifier.KeyConfirm(proverConfirmation, proverConfirmationLength) == CHIP_NO_ERROR);
+        keyConfirm.Stop(1);
+        exchange.Stop(1);
+    }
+
+    Report("spake2p_p256_begin", 0, begin);
+    Report("spake2p_p256_round_one", 0, roundOne);
+    Report("spake2p_p256_round_two", 0, roundTwo);
+    Report("spake2p_p256_key_confirm", 0, keyConfirm);
+    Report("spake2p_p256_exchange", 0, exchange);
+}
+
+} // namespace
+
+int main()
+{
+    StartCountingAllocations();
+    VerifyOrDie(Platform::MemoryInit() == CHIP_NO_ERROR);
+
+    memset(gInput, 0x5a, sizeof(gInput));
+
+    printf("{\n  \"backend\": \"%s\",\n  \"results\": [", BackendName());
+    MeasureAesCcm();
+    MeasureHashes();
+    MeasureP256();
+    MeasureSpake2p();
+    printf("\n  ]\n}\n");
+
+    Platform::MemoryShutdown();
+    return 0;
+}
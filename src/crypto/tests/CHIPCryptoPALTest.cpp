@@ -328,6 +328,150 @@ static void TestAES_CCM_128DecryptTestVectors(nlTestSuite * inSuite, void * inCo
     NL_TEST_ASSERT(inSuite, numOfTestsRan > 0);
 }
 
+static void TestAES_CCM_128CipherTestVectors(nlTestSuite * inSuite, void * inContext)
+{
+    HeapChecker heapChecker(inSuite);
+    int numOfTestVectors = ArraySize(ccm_128_test_vectors);
+    int numOfTestsRan    = 0;
+    for (int vectorIndex = 0; vectorIndex < numOfTestVectors; vectorIndex++)
+    {
+        const ccm_128_test_vector * vector = ccm_128_test_vectors[vectorIndex];
+        if (vector->pt_len > 0)
+        {
+            numOfTestsRan++;
+            chip::Platform::ScopedMemoryBuffer<uint8_t> out_ct;
+            out_ct.Alloc(vector->ct_len);
+            NL_TEST_ASSERT(inSuite, out_ct);
+            chip::Platform::ScopedMemoryBuffer<uint8_t> out_tag;
+            out_tag.Alloc(vector->tag_len);
+            NL_TEST_ASSERT(inSuite, out_tag);
+            chip::Platform::ScopedMemoryBuffer<uint8_t> out_pt;
+            out_pt.Alloc(vector->pt_len);
+            NL_TEST_ASSERT(inSuite, out_pt);
+
+            TestAesKey key(inSuite, vector->key, vector->key_len);
+            Aes128CcmCipher cipher;
+            NL_TEST_ASSERT(inSuite, cipher.Init(key.key) == CHIP_NO_ERROR);
+
+            // Run every operation twice, and decrypt both before and after encrypting, to check that the cipher can be
+            // reused in either direction.
+            for (int pass = 0; pass < 2; pass++)
+            {
+                CHIP_ERROR err = cipher.Decrypt(vector->ct, vector->ct_len, vector->aad, vector->aad_len, vector->tag,
+                                                vector->tag_len, vector->nonce, vector->nonce_len, out_pt.Get());
+                NL_TEST_ASSERT(inSuite, err == vector->result);
+                if (vector->result == CHIP_NO_ERROR)
+                {
+                    NL_TEST_ASSERT(inSuite, memcmp(vector->pt, out_pt.Get(), vector->pt_len) == 0);
+                }
+
+                err = cipher.Encrypt(vector->pt, vector->pt_len, vector->aad, vector->aad_len, vector->nonce, vector->nonce_len,
+                                     out_ct.Get(), out_tag.Get(), vector->tag_len);
+                NL_TEST_ASSERT(inSuite, err == vector->result);
+                if (vector->result == CHIP_NO_ERROR)
+                {
+                    NL_TEST_ASSERT(inSuite, memcmp(out_ct.Get(), vector->ct, vector->ct_len) == 0);
+                    NL_TEST_ASSERT(inSuite, memcmp(out_tag.Get(), vector->tag, vector->tag_len) == 0);
+                }
+            }
+
+            // A message failing authentication does not affect the next one.
+            if (vector->result == CHIP_NO_ERROR)
+            {
+                memcpy(out_tag.Get(), vector->tag, vector->tag_len);
+                out_tag[0] ^= 0x01;
+                CHIP_ERROR err = cipher.Decrypt(vector->ct, vector->ct_len, vector->aad, vector->aad_len, out_tag.Get(),
+                                                vector->tag_len, vector->nonce, vector->nonce_len, out_pt.Get());
+                NL_TEST_ASSERT(inSuite, err != CHIP_NO_ERROR);
+
+                err = cipher.Decrypt(vector->ct, vector->ct_len, vector->aad, vector->aad_len, vector->tag, vector->tag_len,
+                                     vector->nonce, vector->nonce_len, out_pt.Get());
+                NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+                NL_TEST_ASSERT(inSuite, memcmp(vector->pt, out_pt.Get(), vector->pt_len) == 0);
+            }
+
+            cipher.Release();
+            NL_TEST_ASSERT(inSuite, !cipher.IsInitialized());
+        }
+    }
+    NL_TEST_ASSERT(inSuite, numOfTestsRan > 0);
+}
+
+static void TestAES_CCM_128CipherBatch(nlTestSuite * inSuite, void * inContext)
+{
+    HeapChecker heapChecker(inSuite);
+
+    constexpr size_t kNumMessages                = 4;
+    constexpr size_t kMessageSizes[kNumMessages] = { 1, 16, 33, 200 };
+    const uint8_t aad[]                          = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07 };
+
+    uint8_t keyBytes[KEY_LENGTH];
+    memset(keyBytes, 0x42, sizeof(keyBytes));
+
+    uint8_t plaintexts[kNumMessages][200];
+    uint8_t ciphertexts[kNumMessages][200];
+    uint8_t decrypted[kNumMessages][200];
+    uint8_t nonces[kNumMessages][NONCE_LENGTH];
+    uint8_t tags[kNumMessages][kAES_CCM128_Tag_Length];
+
+    TestAesKey key(inSuite, keyBytes, sizeof(keyBytes));
+    Aes128CcmCipher cipher;
+    NL_TEST_ASSERT(inSuite, cipher.Init(key.key) == CHIP_NO_ERROR);
+
+    Aes128CcmCipher::Message messages[kNumMessages];
+    for (size_t i = 0; i < kNumMessages; i++)
+    {
+        memset(plaintexts[i], static_cast<int>(i + 1), kMessageSizes[i]);
+        memset(nonces[i], 0, NONCE_LENGTH);
+        nonces[i][0] = static_cast<uint8_t>(i);
+
+        messages[i].mInput       = plaintexts[i];
+        messages[i].mInputLength = kMessageSizes[i];
+        messages[i].mAad         = aad;
+        messages[i].mAadLength   = sizeof(aad);
+        messages[i].mNonce       = nonces[i];
+        messages[i].mNonceLength = NONCE_LENGTH;
+        messages[i].mOutput      = ciphertexts[i];
+        messages[i].mTag         = tags[i];
+        messages[i].mTagLength   = kAES_CCM128_Tag_Length;
+    }
+    NL_TEST_ASSERT(inSuite, cipher.EncryptMessages(messages, kNumMessages) == CHIP_NO_ERROR);
+
+    // Every message of the batch matches the one-shot function.
+    for (size_t i = 0; i < kNumMessages; i++)
+    {
+        uint8_t ciphertext[200];
+        uint8_t tag[kAES_CCM128_Tag_Length];
+        NL_TEST_ASSERT(inSuite, messages[i].mResult == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite,
+                       AES_CCM_encrypt(plaintexts[i], kMessageSizes[i], aad, sizeof(aad), key.key, nonces[i], NONCE_LENGTH,
+                                       ciphertext, tag, sizeof(tag)) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, memcmp(ciphertext, ciphertexts[i], kMessageSizes[i]) == 0);
+        NL_TEST_ASSERT(inSuite, memcmp(tag, tags[i], sizeof(tag)) == 0);
+    }
+
+    // A message failing authentication is reported without preventing the others from being decrypted.
+    tags[1][0] ^= 0x01;
+    for (size_t i = 0; i < kNumMessages; i++)
+    {
+        messages[i].mInput  = ciphertexts[i];
+        messages[i].mOutput = decrypted[i];
+    }
+    NL_TEST_ASSERT(inSuite, cipher.DecryptMessages(messages, kNumMessages) != CHIP_NO_ERROR);
+    for (size_t i = 0; i < kNumMessages; i++)
+    {
+        if (i == 1)
+        {
+            NL_TEST_ASSERT(inSuite, messages[i].mResult != CHIP_NO_ERROR);
+        }
+        else
+        {
+            NL_TEST_ASSERT(inSuite, messages[i].mResult == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(inSuite, memcmp(decrypted[i], plaintexts[i], kMessageSizes[i]) == 0);
+        }
+    }
+}
+
 static void TestAES_CCM_128EncryptInvalidNonceLen(nlTestSuite * inSuite, void * inContext)
 {
     HeapChecker heapChecker(inSuite);
@@ -2764,6 +2908,8 @@ static const nlTest sTests[] = {
 
     NL_TEST_DEF("Test encrypting AES-CCM-128 test vectors", TestAES_CCM_128EncryptTestVectors),
     NL_TEST_DEF("Test decrypting AES-CCM-128 test vectors", TestAES_CCM_128DecryptTestVectors),
+    NL_TEST_DEF("Test AES-CCM-128 test vectors with a reused cipher", TestAES_CCM_128CipherTestVectors),
+    NL_TEST_DEF("Test AES-CCM-128 batches with a reused cipher", TestAES_CCM_128CipherBatch),
     NL_TEST_DEF("Test encrypting AES-CCM-128 using invalid nonce", TestAES_CCM_128EncryptInvalidNonceLen),
     NL_TEST_DEF("Test encrypting AES-CCM-128 using invalid tag", TestAES_CCM_128EncryptInvalidTagLen),
     NL_TEST_DEF("Test decrypting AES-CCM-128 invalid nonce", TestAES_CCM_128DecryptInvalidNonceLen),
@@ -136,6 +136,18 @@
 #define CHIP_DEVICE_CONFIG_BG_MAX_EVENT_QUEUE_SIZE 1
 #endif
 
+/**
+ * CHIP_DEVICE_CONFIG_BG_THREAD_POOL_SIZE
+ *
+ * The number of threads serving the chip background event queue, on platforms that run background events on a
+ * pool of threads (POSIX).  Work scheduled with ScheduleBackgroundWork() may then run concurrently, for instance
+ * the certificate validation and signature work of several CASE sessions, so
+ * CHIP_DEVICE_CONFIG_BG_MAX_EVENT_QUEUE_SIZE should be at least as large as the pool.
+ */
+#ifndef CHIP_DEVICE_CONFIG_BG_THREAD_POOL_SIZE
+#define CHIP_DEVICE_CONFIG_BG_THREAD_POOL_SIZE 2
+#endif
+
 /**
  * CHIP_DEVICE_CONFIG_ICD_SLOW_POLL_INTERVAL
  *
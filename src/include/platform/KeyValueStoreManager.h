@@ -170,6 +170,23 @@ public:
      */
     CHIP_ERROR Delete(const char * key);
 
+    /**
+     * @brief
+     * Starts, commits or aborts a batch of Put and Delete calls, see
+     * PersistentStorageDelegate::BeginBatch() for the semantics.
+     *
+     * Platforms that do not override _BeginBatch, _CommitBatch and _AbortBatch
+     * write every entry through, as outside of a batch.
+     */
+    CHIP_ERROR BeginBatch();
+    CHIP_ERROR CommitBatch();
+    void AbortBatch();
+
+    // Default implementations of the batch interface, for platforms without batching support.
+    CHIP_ERROR _BeginBatch() { return CHIP_NO_ERROR; }
+    CHIP_ERROR _CommitBatch() { return CHIP_NO_ERROR; }
+    void _AbortBatch() {}
+
 private:
     using ImplClass = ::chip::DeviceLayer::PersistedStorage::KeyValueStoreManagerImpl;
 
@@ -233,6 +250,21 @@ inline CHIP_ERROR KeyValueStoreManager::Delete(const char * key)
     return static_cast<ImplClass *>(this)->_Delete(key);
 }
 
+inline CHIP_ERROR KeyValueStoreManager::BeginBatch()
+{
+    return static_cast<ImplClass *>(this)->_BeginBatch();
+}
+
+inline CHIP_ERROR KeyValueStoreManager::CommitBatch()
+{
+    return static_cast<ImplClass *>(this)->_CommitBatch();
+}
+
+inline void KeyValueStoreManager::AbortBatch()
+{
+    static_cast<ImplClass *>(this)->_AbortBatch();
+}
+
 } // namespace PersistedStorage
 } // namespace DeviceLayer
 } // namespace chip
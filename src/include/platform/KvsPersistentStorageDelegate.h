@@ -103,8 +103,70 @@ public:
         return mKvsManager->Delete(key);
     }
 
+    // The nesting of batches is tracked per delegate: only its outermost batch starts and ends a batch of the KVS
+    // manager.  The KVS manager keeps a single batch for all the delegates sharing it, so the batches of different
+    // delegates must nest rather than interleave, which is checked when they end.
+    CHIP_ERROR BeginBatch() override
+    {
+        VerifyOrReturnError(mKvsManager != nullptr, CHIP_ERROR_INCORRECT_STATE);
+        if (mBatchDepth == 0)
+        {
+            ReturnErrorOnFailure(mKvsManager->BeginBatch());
+            mOuterBatchOwner      = InnermostBatchOwner();
+            InnermostBatchOwner() = this;
+        }
+        mBatchDepth++;
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR CommitBatch() override
+    {
+        VerifyOrReturnError(mKvsManager != nullptr && mBatchDepth > 0, CHIP_ERROR_INCORRECT_STATE);
+        VerifyOrReturnError(--mBatchDepth == 0, CHIP_NO_ERROR);
+        EndOutermostBatch();
+        if (mBatchAborted)
+        {
+            mBatchAborted = false;
+            mKvsManager->AbortBatch();
+            return CHIP_ERROR_TRANSACTION_CANCELED;
+        }
+        return mKvsManager->CommitBatch();
+    }
+
+    void AbortBatch() override
+    {
+        VerifyOrReturn(mKvsManager != nullptr && mBatchDepth > 0);
+
+        // Aborting a nested batch discards the outermost one, when it ends.
+        mBatchAborted = true;
+        if (--mBatchDepth == 0)
+        {
+            EndOutermostBatch();
+            mBatchAborted = false;
+            mKvsManager->AbortBatch();
+        }
+    }
+
 protected:
+    // Delegate whose outermost batch began last and has not ended yet.
+    static KvsPersistentStorageDelegate *& InnermostBatchOwner()
+    {
+        static KvsPersistentStorageDelegate * sOwner = nullptr;
+        return sOwner;
+    }
+
+    void EndOutermostBatch()
+    {
+        // Ending the batch of the KVS manager on behalf of another delegate would commit or discard its writes.
+        VerifyOrDie(InnermostBatchOwner() == this);
+        InnermostBatchOwner() = mOuterBatchOwner;
+        mOuterBatchOwner      = nullptr;
+    }
+
     DeviceLayer::PersistedStorage::KeyValueStoreManager * mKvsManager = nullptr;
+    KvsPersistentStorageDelegate * mOuterBatchOwner                   = nullptr;
+    unsigned mBatchDepth                                              = 0;
+    bool mBatchAborted                                                = false;
 };
 
 } // namespace chip
@@ -93,6 +93,11 @@ protected:
     CHIP_ERROR _StartChipTimer(System::Clock::Timeout duration);
     void _Shutdown();
 
+    CHIP_ERROR _PostBackgroundEvent(const ChipDeviceEvent * event);
+    void _RunBackgroundEventLoop();
+    CHIP_ERROR _StartBackgroundEventLoopTask();
+    CHIP_ERROR _StopBackgroundEventLoopTask();
+
 #if CHIP_STACK_LOCK_TRACKING_ENABLED
     bool _IsChipStackLockedByCurrentThread() const;
 #endif
@@ -111,6 +116,20 @@ private:
     DeviceSafeQueue mChipEventQueue;
     std::atomic<bool> mShouldRunEventLoop{ true };
     static void * EventLoopTaskMain(void * arg);
+
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+    // Background events are served by a pool of worker threads, all waiting on the same queue. The queue, the
+    // pool and mShouldRunBackgroundEventLoop are protected by mBackgroundEventQueueLock.
+    std::queue<ChipDeviceEvent> mBackgroundEventQueue;
+    pthread_mutex_t mBackgroundEventQueueLock = PTHREAD_MUTEX_INITIALIZER;
+    pthread_cond_t mBackgroundEventQueueCond  = PTHREAD_COND_INITIALIZER;
+    pthread_t mBackgroundTasks[CHIP_DEVICE_CONFIG_BG_THREAD_POOL_SIZE];
+    size_t mBackgroundTaskCount        = 0;
+    bool mShouldRunBackgroundEventLoop = false;
+
+    void ProcessBackgroundEvents();
+    static void * BackgroundEventLoopTaskMain(void * arg);
+#endif
 #endif
     void ProcessDeviceEvents();
 };
@@ -70,6 +70,12 @@ CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_InitChipStack()
 
     ret = pthread_mutex_init(&mStateLock, nullptr);
     VerifyOrReturnError(ret == 0, CHIP_ERROR_POSIX(ret));
+
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+    // POSIX applications have never had to start the background event loop themselves, so start the pool along
+    // with the stack rather than leave background work queued with nobody to run it.
+    ReturnErrorOnFailure(Impl()->StartBackgroundEventLoopTask());
+#endif
 #endif
 
     return CHIP_NO_ERROR;
@@ -254,8 +260,152 @@ void * GenericPlatformManagerImpl_POSIX<ImplClass>::EventLoopTaskMain(void * arg
     return nullptr;
 }
 
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+template <class ImplClass>
+void GenericPlatformManagerImpl_POSIX<ImplClass>::ProcessBackgroundEvents()
+{
+    pthread_mutex_lock(&mBackgroundEventQueueLock);
+    while (true)
+    {
+        while (mShouldRunBackgroundEventLoop && mBackgroundEventQueue.empty())
+        {
+            pthread_cond_wait(&mBackgroundEventQueueCond, &mBackgroundEventQueueLock);
+        }
+        if (!mShouldRunBackgroundEventLoop)
+        {
+            break;
+        }
+
+        const ChipDeviceEvent event = mBackgroundEventQueue.front();
+        mBackgroundEventQueue.pop();
+
+        // Background work must not touch the stack, and runs without holding any lock so that the other
+        // threads of the pool can pick up the next events meanwhile.
+        pthread_mutex_unlock(&mBackgroundEventQueueLock);
+        Impl()->DispatchEvent(&event);
+        pthread_mutex_lock(&mBackgroundEventQueueLock);
+    }
+    pthread_mutex_unlock(&mBackgroundEventQueueLock);
+}
+
+template <class ImplClass>
+void * GenericPlatformManagerImpl_POSIX<ImplClass>::BackgroundEventLoopTaskMain(void * arg)
+{
+    ChipLogDetail(DeviceLayer, "CHIP background task running");
+    static_cast<GenericPlatformManagerImpl_POSIX<ImplClass> *>(arg)->ProcessBackgroundEvents();
+    return nullptr;
+}
+#endif // CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+
 #endif // !CHIP_SYSTEM_CONFIG_USE_LIBEV
 
+template <class ImplClass>
+CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_PostBackgroundEvent(const ChipDeviceEvent * event)
+{
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING && !CHIP_SYSTEM_CONFIG_USE_LIBEV
+    if (!(event->Type == DeviceEventType::kCallWorkFunct || event->Type == DeviceEventType::kNoOp))
+    {
+        return CHIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    pthread_mutex_lock(&mBackgroundEventQueueLock);
+    if (mBackgroundEventQueue.size() < CHIP_DEVICE_CONFIG_BG_MAX_EVENT_QUEUE_SIZE)
+    {
+        mBackgroundEventQueue.push(*event);
+        pthread_cond_signal(&mBackgroundEventQueueCond);
+    }
+    else
+    {
+        ChipLogError(DeviceLayer, "Failed to post event to CHIP background event queue");
+        err = CHIP_ERROR_NO_MEMORY;
+    }
+    pthread_mutex_unlock(&mBackgroundEventQueueLock);
+    return err;
+#else
+    // Use foreground event loop for background events
+    return _PostEvent(event);
+#endif
+}
+
+template <class ImplClass>
+void GenericPlatformManagerImpl_POSIX<ImplClass>::_RunBackgroundEventLoop()
+{
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING && !CHIP_SYSTEM_CONFIG_USE_LIBEV
+    // The calling thread joins the pool until StopBackgroundEventLoopTask() is called.
+    pthread_mutex_lock(&mBackgroundEventQueueLock);
+    mShouldRunBackgroundEventLoop = true;
+    pthread_mutex_unlock(&mBackgroundEventQueueLock);
+
+    ProcessBackgroundEvents();
+#else
+    // Use foreground event loop for background events
+#endif
+}
+
+template <class ImplClass>
+CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_StartBackgroundEventLoopTask()
+{
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING && !CHIP_SYSTEM_CONFIG_USE_LIBEV
+    int err = 0;
+
+    pthread_mutex_lock(&mBackgroundEventQueueLock);
+    mShouldRunBackgroundEventLoop = true;
+    while (mBackgroundTaskCount < CHIP_DEVICE_CONFIG_BG_THREAD_POOL_SIZE)
+    {
+        err = pthread_create(&mBackgroundTasks[mBackgroundTaskCount], nullptr, BackgroundEventLoopTaskMain, this);
+        if (err != 0)
+        {
+            break;
+        }
+        mBackgroundTaskCount++;
+    }
+    pthread_mutex_unlock(&mBackgroundEventQueueLock);
+
+    return CHIP_ERROR_POSIX(err);
+#else
+    // Use foreground event loop for background events
+    return CHIP_NO_ERROR;
+#endif
+}
+
+template <class ImplClass>
+CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_StopBackgroundEventLoopTask()
+{
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING && !CHIP_SYSTEM_CONFIG_USE_LIBEV
+    pthread_mutex_lock(&mBackgroundEventQueueLock);
+    mShouldRunBackgroundEventLoop = false;
+    pthread_cond_broadcast(&mBackgroundEventQueueCond);
+
+    pthread_t tasks[CHIP_DEVICE_CONFIG_BG_THREAD_POOL_SIZE];
+    size_t taskCount = mBackgroundTaskCount;
+    for (size_t i = 0; i < taskCount; i++)
+    {
+        tasks[i] = mBackgroundTasks[i];
+    }
+    mBackgroundTaskCount = 0;
+    pthread_mutex_unlock(&mBackgroundEventQueueLock);
+
+    // Work still running finishes before the pool is gone; work still queued is dropped with the queue when the
+    // stack shuts down.
+    int err = 0;
+    for (size_t i = 0; i < taskCount; i++)
+    {
+        if (pthread_equal(pthread_self(), tasks[i]))
+        {
+            pthread_detach(tasks[i]);
+            continue;
+        }
+        int joinErr = pthread_join(tasks[i], nullptr);
+        err         = (err == 0) ? joinErr : err;
+    }
+    return CHIP_ERROR_POSIX(err);
+#else
+    // Use foreground event loop for background events
+    return CHIP_NO_ERROR;
+#endif
+}
+
 template <class ImplClass>
 CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_StartEventLoopTask()
 {
@@ -391,6 +541,13 @@ void GenericPlatformManagerImpl_POSIX<ImplClass>::_Shutdown()
     VerifyOrDie(mState.load(std::memory_order_relaxed) == State::kStopped);
 
 #if !CHIP_SYSTEM_CONFIG_USE_LIBEV
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+    Impl()->StopBackgroundEventLoopTask();
+    pthread_mutex_lock(&mBackgroundEventQueueLock);
+    mBackgroundEventQueue = {};
+    pthread_mutex_unlock(&mBackgroundEventQueueLock);
+#endif
+
     pthread_mutex_destroy(&mStateLock);
     pthread_cond_destroy(&mEventQueueStoppedCond);
 #endif
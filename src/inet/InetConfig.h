@@ -272,4 +272,38 @@
 #endif
 #endif // INET_CONFIG_UDP_SOCKET_PKTINFO
 
+/**
+ *  @def INET_CONFIG_UDP_SOCKET_MMSG
+ *
+ *  @brief
+ *    Use sendmmsg() and recvmmsg() to send and receive several UDP packets
+ *    with a single system call.
+ *
+ *  @details
+ *    When this flag is set, the socket-based implementation of UDP endpoints
+ *    passes the messages given to UDPEndPoint::SendMsgs() to the kernel
+ *    together, and drains a readable socket with recvmmsg() into packet
+ *    buffers allocated for that call.
+ */
+#ifndef INET_CONFIG_UDP_SOCKET_MMSG
+#define INET_CONFIG_UDP_SOCKET_MMSG 0
+#endif // INET_CONFIG_UDP_SOCKET_MMSG
+
+/**
+ *  @def INET_CONFIG_UDP_SOCKET_MMSG_MAX_MESSAGES
+ *
+ *  @brief
+ *    The maximum number of UDP packets sent or received by a single
+ *    sendmmsg() or recvmmsg() call, when INET_CONFIG_UDP_SOCKET_MMSG is set.
+ *
+ *  @details
+ *    Reading a socket allocates this many receive buffers, and frees the
+ *    ones left without a message once the call returns.  It must be
+ *    smaller than the number of full-size packet buffers of pool-based
+ *    builds.
+ */
+#ifndef INET_CONFIG_UDP_SOCKET_MMSG_MAX_MESSAGES
+#define INET_CONFIG_UDP_SOCKET_MMSG_MAX_MESSAGES 8
+#endif // INET_CONFIG_UDP_SOCKET_MMSG_MAX_MESSAGES
+
 // clang-format on
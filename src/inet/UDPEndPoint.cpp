@@ -121,6 +121,33 @@ CHIP_ERROR UDPEndPoint::SendMsg(const IPPacketInfo * pktInfo, System::PacketBuff
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR UDPEndPoint::SendMsgs(const IPPacketInfo * pktInfos, System::PacketBufferHandle * msgs, size_t count)
+{
+    INET_FAULT_INJECT(FaultInjection::kFault_Send, return INET_ERROR_UNKNOWN_INTERFACE;);
+    INET_FAULT_INJECT(FaultInjection::kFault_SendNonCritical, return CHIP_ERROR_NO_MEMORY;);
+
+    ReturnErrorOnFailure(SendMsgsImpl(pktInfos, msgs, count));
+
+    CHIP_SYSTEM_FAULT_INJECT_ASYNC_EVENT();
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR UDPEndPoint::SendMsgsImpl(const IPPacketInfo * pktInfos, System::PacketBufferHandle * msgs, size_t count)
+{
+    CHIP_ERROR result = CHIP_NO_ERROR;
+    for (size_t i = 0; i < count; i++)
+    {
+        CHIP_ERROR err = SendMsgImpl(&pktInfos[i], std::move(msgs[i]));
+        msgs[i]        = nullptr;
+        if (result == CHIP_NO_ERROR)
+        {
+            result = err;
+        }
+    }
+    return result;
+}
+
 void UDPEndPoint::Close()
 {
     if (mState != State::kClosed)
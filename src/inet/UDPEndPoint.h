@@ -227,6 +227,23 @@ public:
      */
     CHIP_ERROR SendMsg(const IPPacketInfo * pktInfo, chip::System::PacketBufferHandle && msg);
 
+    /**
+     * Send several UDP messages.
+     *
+     *  Send each message in \c msgs to the destination given in the element of \c pktInfos with the same index, as
+     *  \c SendMsg does.  Where the platform allows it, the messages are passed to the network stack together.
+     *
+     *  Every message is attempted, even when an earlier one fails, and every buffer in \c msgs is released.
+     *
+     * @param[in]   pktInfos    Source and destination information for each UDP message.
+     * @param[in]   msgs        Packet buffers containing the UDP messages.
+     * @param[in]   count       Number of UDP messages.
+     *
+     * @retval  CHIP_NO_ERROR   Success: all the messages are queued for transmit.
+     * @retval  other           The error of the first message that could not be sent, as returned by \c SendMsg.
+     */
+    CHIP_ERROR SendMsgs(const IPPacketInfo * pktInfos, chip::System::PacketBufferHandle * msgs, size_t count);
+
     /**
      * Close the endpoint.
      *
@@ -295,6 +312,7 @@ protected:
     virtual CHIP_ERROR BindInterfaceImpl(IPAddressType addressType, InterfaceId interfaceId)                                  = 0;
     virtual CHIP_ERROR ListenImpl()                                                                                           = 0;
     virtual CHIP_ERROR SendMsgImpl(const IPPacketInfo * pktInfo, chip::System::PacketBufferHandle && msg)                     = 0;
+    virtual CHIP_ERROR SendMsgsImpl(const IPPacketInfo * pktInfos, chip::System::PacketBufferHandle * msgs, size_t count);
     virtual void CloseImpl()                                                                                                  = 0;
 };
 
@@ -278,7 +278,17 @@ CHIP_ERROR UDPEndPointImplSockets::ListenImpl()
     return layer->RequestCallbackOnPendingRead(mWatch);
 }
 
-CHIP_ERROR UDPEndPointImplSockets::SendMsgImpl(const IPPacketInfo * aPktInfo, System::PacketBufferHandle && msg)
+struct UDPEndPointImplSockets::SendMsgStorage
+{
+    struct iovec msgIOV;
+    SockAddr peerSockAddr;
+#if defined(IP_PKTINFO) || defined(IPV6_PKTINFO)
+    uint8_t controlData[256];
+#endif // defined(IP_PKTINFO) || defined(IPV6_PKTINFO)
+};
+
+CHIP_ERROR UDPEndPointImplSockets::PrepareSendMsg(const IPPacketInfo * aPktInfo, const System::PacketBufferHandle & msg,
+                                                  SendMsgStorage & storage, struct msghdr & msgHeader)
 {
     // Ensure packet buffer is not null
     VerifyOrReturnError(!msg.IsNull(), CHIP_ERROR_INVALID_ARGUMENT);
@@ -293,22 +303,21 @@ CHIP_ERROR UDPEndPointImplSockets::SendMsgImpl(const IPPacketInfo * aPktInfo, Sy
     // For now the entire message must fit within a single buffer.
     VerifyOrReturnError(!msg->HasChainedBuffer(), CHIP_ERROR_MESSAGE_TOO_LONG);
 
-    struct iovec msgIOV;
-    msgIOV.iov_base = msg->Start();
-    msgIOV.iov_len  = msg->DataLength();
+    struct iovec & msgIOV = storage.msgIOV;
+    msgIOV.iov_base       = msg->Start();
+    msgIOV.iov_len        = msg->DataLength();
 
 #if defined(IP_PKTINFO) || defined(IPV6_PKTINFO)
-    uint8_t controlData[256];
-    memset(controlData, 0, sizeof(controlData));
+    uint8_t * controlData = storage.controlData;
+    memset(controlData, 0, sizeof(storage.controlData));
 #endif // defined(IP_PKTINFO) || defined(IPV6_PKTINFO)
 
-    struct msghdr msgHeader;
     memset(&msgHeader, 0, sizeof(msgHeader));
     msgHeader.msg_iov    = &msgIOV;
     msgHeader.msg_iovlen = 1;
 
     // Construct a sockaddr_in/sockaddr_in6 structure containing the destination information.
-    SockAddr peerSockAddr;
+    SockAddr & peerSockAddr = storage.peerSockAddr;
     memset(&peerSockAddr, 0, sizeof(peerSockAddr));
     msgHeader.msg_name = &peerSockAddr;
     if (mAddrType == IPAddressType::kIPv6)
@@ -352,7 +361,7 @@ CHIP_ERROR UDPEndPointImplSockets::SendMsgImpl(const IPPacketInfo * aPktInfo, Sy
     {
 #if defined(IP_PKTINFO) || defined(IPV6_PKTINFO)
         msgHeader.msg_control    = controlData;
-        msgHeader.msg_controllen = sizeof(controlData);
+        msgHeader.msg_controllen = sizeof(storage.controlData);
 
         struct cmsghdr * controlHdr      = CMSG_FIRSTHDR(&msgHeader);
         InterfaceId::PlatformType intfId = intf.GetPlatformInterface();
@@ -410,6 +419,15 @@ CHIP_ERROR UDPEndPointImplSockets::SendMsgImpl(const IPPacketInfo * aPktInfo, Sy
     }
 #endif // INET_CONFIG_UDP_SOCKET_PKTINFO
 
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR UDPEndPointImplSockets::SendMsgImpl(const IPPacketInfo * aPktInfo, System::PacketBufferHandle && msg)
+{
+    SendMsgStorage storage;
+    struct msghdr msgHeader;
+    ReturnErrorOnFailure(PrepareSendMsg(aPktInfo, msg, storage, msgHeader));
+
     // Send IP packet.
     const ssize_t lenSent = sendmsg(mSocket, &msgHeader, 0);
     if (lenSent == -1)
@@ -423,6 +441,66 @@ CHIP_ERROR UDPEndPointImplSockets::SendMsgImpl(const IPPacketInfo * aPktInfo, Sy
     return CHIP_NO_ERROR;
 }
 
+#if INET_CONFIG_UDP_SOCKET_MMSG
+CHIP_ERROR UDPEndPointImplSockets::SendMsgsImpl(const IPPacketInfo * aPktInfos, System::PacketBufferHandle * msgs, size_t count)
+{
+    constexpr size_t kMaxBatchSize = INET_CONFIG_UDP_SOCKET_MMSG_MAX_MESSAGES;
+
+    SendMsgStorage storage[kMaxBatchSize];
+    struct mmsghdr msgHeaders[kMaxBatchSize];
+    System::PacketBufferHandle * batchMsgs[kMaxBatchSize];
+    CHIP_ERROR result = CHIP_NO_ERROR;
+
+    size_t next = 0;
+    while (next < count)
+    {
+        // Messages that cannot be sent are dropped, the others are gathered into the batch.
+        size_t batchSize = 0;
+        for (; next < count && batchSize < kMaxBatchSize; next++)
+        {
+            CHIP_ERROR err = PrepareSendMsg(&aPktInfos[next], msgs[next], storage[batchSize], msgHeaders[batchSize].msg_hdr);
+            if (err != CHIP_NO_ERROR)
+            {
+                result     = (result == CHIP_NO_ERROR) ? err : result;
+                msgs[next] = nullptr;
+                continue;
+            }
+            msgHeaders[batchSize].msg_len = 0;
+            batchMsgs[batchSize]          = &msgs[next];
+            batchSize++;
+        }
+
+        // sendmmsg() stops at the first message that fails, which is dropped before sending the rest.
+        size_t sent = 0;
+        while (sent < batchSize)
+        {
+            const int numSent = sendmmsg(mSocket, &msgHeaders[sent], static_cast<unsigned int>(batchSize - sent), 0);
+            if (numSent < 0)
+            {
+                result = (result == CHIP_NO_ERROR) ? CHIP_ERROR_POSIX(errno) : result;
+                sent++;
+                continue;
+            }
+            for (size_t i = sent; i < sent + static_cast<size_t>(numSent); i++)
+            {
+                if (msgHeaders[i].msg_len != (*batchMsgs[i])->DataLength())
+                {
+                    result = (result == CHIP_NO_ERROR) ? CHIP_ERROR_OUTBOUND_MESSAGE_TOO_BIG : result;
+                }
+            }
+            sent += static_cast<size_t>(numSent);
+        }
+
+        for (size_t i = 0; i < batchSize; i++)
+        {
+            *batchMsgs[i] = nullptr;
+        }
+    }
+
+    return result;
+}
+#endif // INET_CONFIG_UDP_SOCKET_MMSG
+
 void UDPEndPointImplSockets::CloseImpl()
 {
     if (mSocket != kInvalidSocketFd)
@@ -568,113 +646,103 @@ void UDPEndPointImplSockets::HandlePendingIO(System::SocketEvents events)
         return;
     }
 
-    CHIP_ERROR lStatus = CHIP_NO_ERROR;
-    IPPacketInfo lPacketInfo;
-    System::PacketBufferHandle lBuffer;
-
-    lPacketInfo.Clear();
-    lPacketInfo.DestPort  = mBoundPort;
-    lPacketInfo.Interface = mBoundIntfId;
-
-    lBuffer = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSizeWithoutReserve, 0);
+#if INET_CONFIG_UDP_SOCKET_MMSG
+    ReceiveMsgs();
+#else  // !INET_CONFIG_UDP_SOCKET_MMSG
+    ReceiveMsg();
+#endif // !INET_CONFIG_UDP_SOCKET_MMSG
+}
 
-    if (!lBuffer.IsNull())
-    {
-        struct iovec msgIOV;
-        SockAddr lPeerSockAddr;
-        uint8_t controlData[256];
-        struct msghdr msgHeader;
+struct UDPEndPointImplSockets::ReceiveMsgStorage
+{
+    struct iovec msgIOV;
+    SockAddr peerSockAddr;
+    uint8_t controlData[256];
+};
 
-        msgIOV.iov_base = lBuffer->Start();
-        msgIOV.iov_len  = lBuffer->AvailableDataLength();
+void UDPEndPointImplSockets::PrepareReceiveMsg(System::PacketBufferHandle & buffer, ReceiveMsgStorage & storage,
+                                               struct msghdr & msgHeader)
+{
+    storage.msgIOV.iov_base = buffer->Start();
+    storage.msgIOV.iov_len  = buffer->AvailableDataLength();
 
-        memset(&lPeerSockAddr, 0, sizeof(lPeerSockAddr));
+    memset(&storage.peerSockAddr, 0, sizeof(storage.peerSockAddr));
 
-        memset(&msgHeader, 0, sizeof(msgHeader));
+    memset(&msgHeader, 0, sizeof(msgHeader));
 
-        msgHeader.msg_name       = &lPeerSockAddr;
-        msgHeader.msg_namelen    = sizeof(lPeerSockAddr);
-        msgHeader.msg_iov        = &msgIOV;
-        msgHeader.msg_iovlen     = 1;
-        msgHeader.msg_control    = controlData;
-        msgHeader.msg_controllen = sizeof(controlData);
+    msgHeader.msg_name       = &storage.peerSockAddr;
+    msgHeader.msg_namelen    = sizeof(storage.peerSockAddr);
+    msgHeader.msg_iov        = &storage.msgIOV;
+    msgHeader.msg_iovlen     = 1;
+    msgHeader.msg_control    = storage.controlData;
+    msgHeader.msg_controllen = sizeof(storage.controlData);
+}
 
-        ssize_t rcvLen = recvmsg(mSocket, &msgHeader, MSG_DONTWAIT);
+CHIP_ERROR UDPEndPointImplSockets::GetReceivedPacketInfo(struct msghdr & msgHeader, IPPacketInfo & lPacketInfo)
+{
+    const SockAddr & lPeerSockAddr = *static_cast<const SockAddr *>(msgHeader.msg_name);
 
-        if (rcvLen < 0)
-        {
-            lStatus = CHIP_ERROR_POSIX(errno);
-        }
-        else if (rcvLen > lBuffer->AvailableDataLength())
-        {
-            lStatus = CHIP_ERROR_INBOUND_MESSAGE_TOO_BIG;
-        }
-        else
-        {
-            lBuffer->SetDataLength(static_cast<uint16_t>(rcvLen));
+    lPacketInfo.Clear();
+    lPacketInfo.DestPort  = mBoundPort;
+    lPacketInfo.Interface = mBoundIntfId;
 
-            if (lPeerSockAddr.any.sa_family == AF_INET6)
-            {
-                lPacketInfo.SrcAddress = IPAddress(lPeerSockAddr.in6.sin6_addr);
-                lPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in6.sin6_port);
-            }
+    if (lPeerSockAddr.any.sa_family == AF_INET6)
+    {
+        lPacketInfo.SrcAddress = IPAddress(lPeerSockAddr.in6.sin6_addr);
+        lPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in6.sin6_port);
+    }
 #if INET_CONFIG_ENABLE_IPV4
-            else if (lPeerSockAddr.any.sa_family == AF_INET)
-            {
-                lPacketInfo.SrcAddress = IPAddress(lPeerSockAddr.in.sin_addr);
-                lPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in.sin_port);
-            }
+    else if (lPeerSockAddr.any.sa_family == AF_INET)
+    {
+        lPacketInfo.SrcAddress = IPAddress(lPeerSockAddr.in.sin_addr);
+        lPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in.sin_port);
+    }
 #endif // INET_CONFIG_ENABLE_IPV4
-            else
-            {
-                lStatus = CHIP_ERROR_INCORRECT_STATE;
-            }
-        }
+    else
+    {
+        return CHIP_ERROR_INCORRECT_STATE;
+    }
 
-        if (lStatus == CHIP_NO_ERROR)
-        {
-            for (struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&msgHeader); controlHdr != nullptr;
-                 controlHdr                  = CMSG_NXTHDR(&msgHeader, controlHdr))
-            {
+    for (struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&msgHeader); controlHdr != nullptr;
+         controlHdr                  = CMSG_NXTHDR(&msgHeader, controlHdr))
+    {
 #if INET_CONFIG_ENABLE_IPV4
 #ifdef IP_PKTINFO
-                if (controlHdr->cmsg_level == IPPROTO_IP && controlHdr->cmsg_type == IP_PKTINFO)
-                {
-                    auto * inPktInfo = reinterpret_cast<struct in_pktinfo *> CMSG_DATA(controlHdr);
-                    if (!CanCastTo<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex))
-                    {
-                        lStatus = CHIP_ERROR_INCORRECT_STATE;
-                        break;
-                    }
-                    lPacketInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex));
-                    lPacketInfo.DestAddress = IPAddress(inPktInfo->ipi_addr);
-                    continue;
-                }
+        if (controlHdr->cmsg_level == IPPROTO_IP && controlHdr->cmsg_type == IP_PKTINFO)
+        {
+            auto * inPktInfo = reinterpret_cast<struct in_pktinfo *> CMSG_DATA(controlHdr);
+            if (!CanCastTo<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex))
+            {
+                return CHIP_ERROR_INCORRECT_STATE;
+            }
+            lPacketInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex));
+            lPacketInfo.DestAddress = IPAddress(inPktInfo->ipi_addr);
+            continue;
+        }
 #endif // defined(IP_PKTINFO)
 #endif // INET_CONFIG_ENABLE_IPV4
 
 #ifdef IPV6_PKTINFO
-                if (controlHdr->cmsg_level == IPPROTO_IPV6 && controlHdr->cmsg_type == IPV6_PKTINFO)
-                {
-                    auto * in6PktInfo = reinterpret_cast<struct in6_pktinfo *> CMSG_DATA(controlHdr);
-                    if (!CanCastTo<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex))
-                    {
-                        lStatus = CHIP_ERROR_INCORRECT_STATE;
-                        break;
-                    }
-                    lPacketInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex));
-                    lPacketInfo.DestAddress = IPAddress(in6PktInfo->ipi6_addr);
-                    continue;
-                }
-#endif // defined(IPV6_PKTINFO)
+        if (controlHdr->cmsg_level == IPPROTO_IPV6 && controlHdr->cmsg_type == IPV6_PKTINFO)
+        {
+            auto * in6PktInfo = reinterpret_cast<struct in6_pktinfo *> CMSG_DATA(controlHdr);
+            if (!CanCastTo<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex))
+            {
+                return CHIP_ERROR_INCORRECT_STATE;
             }
+            lPacketInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex));
+            lPacketInfo.DestAddress = IPAddress(in6PktInfo->ipi6_addr);
+            continue;
         }
-    }
-    else
-    {
-        lStatus = CHIP_ERROR_NO_MEMORY;
+#endif // defined(IPV6_PKTINFO)
     }
 
+    return CHIP_NO_ERROR;
+}
+
+void UDPEndPointImplSockets::HandleReceivedMsg(CHIP_ERROR lStatus, System::PacketBufferHandle && lBuffer,
+                                               const IPPacketInfo & lPacketInfo)
+{
     if (lStatus == CHIP_NO_ERROR)
     {
         lBuffer.RightSize();
@@ -689,6 +757,127 @@ void UDPEndPointImplSockets::HandlePendingIO(System::SocketEvents events)
     }
 }
 
+#if INET_CONFIG_UDP_SOCKET_MMSG
+
+#if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_SIZE_CLASSES
+static_assert(INET_CONFIG_UDP_SOCKET_MMSG_MAX_MESSAGES < CHIP_SYSTEM_CONFIG_PACKETBUFFER_LARGE_POOL_SIZE,
+              "A recvmmsg() batch must leave full-size packet buffers for the messages it hands over");
+#elif CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL
+static_assert(INET_CONFIG_UDP_SOCKET_MMSG_MAX_MESSAGES < CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE,
+              "A recvmmsg() batch must leave packet buffers for the messages it hands over");
+#endif
+
+void UDPEndPointImplSockets::ReceiveMsgs()
+{
+    constexpr size_t kMaxBatchSize = INET_CONFIG_UDP_SOCKET_MMSG_MAX_MESSAGES;
+
+    ReceiveMsgStorage storage[kMaxBatchSize];
+    struct mmsghdr msgHeaders[kMaxBatchSize];
+    IPPacketInfo lPacketInfo;
+
+    // The buffers are only held for this read, so that a listening endpoint does not keep packet buffers allocated.
+    System::PacketBufferHandle buffers[kMaxBatchSize];
+    size_t batchSize = 0;
+    for (; batchSize < kMaxBatchSize; batchSize++)
+    {
+        buffers[batchSize] = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSizeWithoutReserve, 0);
+        if (buffers[batchSize].IsNull())
+        {
+            break;
+        }
+        PrepareReceiveMsg(buffers[batchSize], storage[batchSize], msgHeaders[batchSize].msg_hdr);
+        msgHeaders[batchSize].msg_len = 0;
+    }
+
+    if (batchSize == 0)
+    {
+        lPacketInfo.Clear();
+        HandleReceivedMsg(CHIP_ERROR_NO_MEMORY, System::PacketBufferHandle(), lPacketInfo);
+        return;
+    }
+
+    const int numReceived = recvmmsg(mSocket, msgHeaders, static_cast<unsigned int>(batchSize), MSG_DONTWAIT, nullptr);
+    if (numReceived < 0)
+    {
+        lPacketInfo.Clear();
+        HandleReceivedMsg(CHIP_ERROR_POSIX(errno), System::PacketBufferHandle(), lPacketInfo);
+        return;
+    }
+
+    // Give back the buffers no message was received into before the handlers allocate their own.
+    for (size_t i = static_cast<size_t>(numReceived); i < batchSize; i++)
+    {
+        buffers[i] = nullptr;
+    }
+
+    // A message handler may close or free the endpoint.  Keep it alive until all the messages are handled, and drop the
+    // remaining messages once it is no longer listening.
+    Retain();
+    for (int i = 0; i < numReceived && mState == State::kListening; i++)
+    {
+        System::PacketBufferHandle & lBuffer = buffers[i];
+        CHIP_ERROR lStatus                   = CHIP_NO_ERROR;
+
+        if (msgHeaders[i].msg_len > lBuffer->AvailableDataLength())
+        {
+            lStatus = CHIP_ERROR_INBOUND_MESSAGE_TOO_BIG;
+        }
+        else
+        {
+            lBuffer->SetDataLength(static_cast<uint16_t>(msgHeaders[i].msg_len));
+            lStatus = GetReceivedPacketInfo(msgHeaders[i].msg_hdr, lPacketInfo);
+        }
+
+        HandleReceivedMsg(lStatus, std::move(lBuffer), lPacketInfo);
+    }
+    Release();
+}
+
+#else // !INET_CONFIG_UDP_SOCKET_MMSG
+
+void UDPEndPointImplSockets::ReceiveMsg()
+{
+    CHIP_ERROR lStatus = CHIP_NO_ERROR;
+    IPPacketInfo lPacketInfo;
+    System::PacketBufferHandle lBuffer;
+
+    lPacketInfo.Clear();
+
+    lBuffer = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSizeWithoutReserve, 0);
+
+    if (!lBuffer.IsNull())
+    {
+        ReceiveMsgStorage storage;
+        struct msghdr msgHeader;
+
+        PrepareReceiveMsg(lBuffer, storage, msgHeader);
+
+        ssize_t rcvLen = recvmsg(mSocket, &msgHeader, MSG_DONTWAIT);
+
+        if (rcvLen < 0)
+        {
+            lStatus = CHIP_ERROR_POSIX(errno);
+        }
+        else if (rcvLen > lBuffer->AvailableDataLength())
+        {
+            lStatus = CHIP_ERROR_INBOUND_MESSAGE_TOO_BIG;
+        }
+        else
+        {
+            lBuffer->SetDataLength(static_cast<uint16_t>(rcvLen));
+            lStatus = GetReceivedPacketInfo(msgHeader, lPacketInfo);
+        }
+    }
+    else
+    {
+        lStatus = CHIP_ERROR_NO_MEMORY;
+    }
+
+    HandleReceivedMsg(lStatus, std::move(lBuffer), lPacketInfo);
+}
+
+#endif // !INET_CONFIG_UDP_SOCKET_MMSG
+
 #if IP_MULTICAST_LOOP || IPV6_MULTICAST_LOOP
 static CHIP_ERROR SocketsSetMulticastLoopback(int aSocket, bool aLoopback, int aProtocol, int aOption)
 {
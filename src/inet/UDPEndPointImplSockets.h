@@ -52,11 +52,28 @@ private:
     CHIP_ERROR BindInterfaceImpl(IPAddressType addressType, InterfaceId interfaceId) override;
     CHIP_ERROR ListenImpl() override;
     CHIP_ERROR SendMsgImpl(const IPPacketInfo * pktInfo, chip::System::PacketBufferHandle && msg) override;
+#if INET_CONFIG_UDP_SOCKET_MMSG
+    CHIP_ERROR SendMsgsImpl(const IPPacketInfo * pktInfos, chip::System::PacketBufferHandle * msgs, size_t count) override;
+#endif // INET_CONFIG_UDP_SOCKET_MMSG
     void CloseImpl() override;
 
+    // Storage the header of a message being sent or received points to.
+    struct SendMsgStorage;
+    struct ReceiveMsgStorage;
+
     CHIP_ERROR GetSocket(IPAddressType addressType);
+    CHIP_ERROR PrepareSendMsg(const IPPacketInfo * pktInfo, const System::PacketBufferHandle & msg, SendMsgStorage & storage,
+                              struct msghdr & msgHeader);
     void HandlePendingIO(System::SocketEvents events);
     static void HandlePendingIO(System::SocketEvents events, intptr_t data);
+#if INET_CONFIG_UDP_SOCKET_MMSG
+    void ReceiveMsgs();
+#else
+    void ReceiveMsg();
+#endif // INET_CONFIG_UDP_SOCKET_MMSG
+    void PrepareReceiveMsg(System::PacketBufferHandle & buffer, ReceiveMsgStorage & storage, struct msghdr & msgHeader);
+    CHIP_ERROR GetReceivedPacketInfo(struct msghdr & msgHeader, IPPacketInfo & pktInfo);
+    void HandleReceivedMsg(CHIP_ERROR status, System::PacketBufferHandle && buffer, const IPPacketInfo & pktInfo);
 
     InterfaceId mBoundIntfId;
     uint16_t mBoundPort;
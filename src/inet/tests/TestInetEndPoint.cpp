@@ -239,6 +239,106 @@ static void TestInetInterface(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, !addrIterator.HasBroadcastAddress());
 }
 
+struct BatchReceiveState
+{
+    size_t mCount     = 0;
+    int mLastSequence = -1;
+    bool mInOrder     = true;
+};
+
+static void HandleBatchMessageReceived(UDPEndPoint * endPoint, PacketBufferHandle && msg, const IPPacketInfo * pktInfo)
+{
+    BatchReceiveState * state = static_cast<BatchReceiveState *>(endPoint->mAppState);
+    int sequence              = msg->DataLength() == 1 ? msg->Start()[0] : -1;
+
+    state->mInOrder      = state->mInOrder && sequence > state->mLastSequence;
+    state->mLastSequence = sequence;
+    state->mCount++;
+}
+
+static void CheckUDPSendMsgs(nlTestSuite * inSuite, UDPEndPoint * testUDPEP, BatchReceiveState & state)
+{
+    constexpr size_t kMessageCount = 2 * INET_CONFIG_UDP_SOCKET_MMSG_MAX_MESSAGES + 3;
+
+    IPAddress loopback;
+    IPPacketInfo pktInfos[kMessageCount];
+    PacketBufferHandle msgs[kMessageCount];
+
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, IPAddress::FromString("::1", loopback));
+
+    // Let the system pick the port, so that the test does not depend on a fixed port being free.
+    CHIP_ERROR err = testUDPEP->Bind(IPAddressType::kIPv6, loopback, 0);
+    if (err == CHIP_ERROR_POSIX(EAFNOSUPPORT) || err == CHIP_ERROR_POSIX(EADDRNOTAVAIL))
+    {
+        printf("IPv6 loopback is not available, skipping the test\n");
+        return;
+    }
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = testUDPEP->Listen(HandleBatchMessageReceived, nullptr /*OnReceiveError*/, &state);
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    const uint16_t port = testUDPEP->GetBoundPort();
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, port != 0);
+
+    for (size_t i = 0; i < kMessageCount; i++)
+    {
+        pktInfos[i].Clear();
+        pktInfos[i].DestAddress = loopback;
+        pktInfos[i].DestPort    = port;
+
+        msgs[i] = PacketBufferHandle::New(1);
+        NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, !msgs[i].IsNull());
+        msgs[i]->Start()[0] = static_cast<uint8_t>(i);
+        msgs[i]->SetDataLength(1);
+    }
+
+    // A message that cannot be sent is reported without keeping the others from being sent.
+    msgs[kMessageCount / 2] = nullptr;
+
+    err = testUDPEP->SendMsgs(pktInfos, msgs, kMessageCount);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_INVALID_ARGUMENT);
+    for (size_t i = 0; i < kMessageCount; i++)
+    {
+        NL_TEST_ASSERT(inSuite, msgs[i].IsNull());
+    }
+
+    for (int i = 0; i < 100 && state.mCount < kMessageCount - 1; i++)
+    {
+        ServiceEvents(10);
+    }
+    NL_TEST_ASSERT(inSuite, state.mCount == kMessageCount - 1);
+    NL_TEST_ASSERT(inSuite, state.mInOrder);
+
+#if INET_CONFIG_UDP_SOCKET_MMSG && (CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_SIZE_CLASSES || CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL)
+    // The listening endpoint holds no receive buffers between reads, so every full-size buffer of the pool is free.
+#if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_SIZE_CLASSES
+    constexpr size_t kFullSizeBufferCount = CHIP_SYSTEM_CONFIG_PACKETBUFFER_LARGE_POOL_SIZE;
+#else
+    constexpr size_t kFullSizeBufferCount = CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE;
+#endif
+    PacketBufferHandle fullSizeBuffers[kFullSizeBufferCount];
+    for (PacketBufferHandle & buffer : fullSizeBuffers)
+    {
+        buffer = PacketBufferHandle::New(PacketBuffer::kMaxSizeWithoutReserve, 0);
+        NL_TEST_ASSERT(inSuite, !buffer.IsNull());
+    }
+#endif // INET_CONFIG_UDP_SOCKET_MMSG
+}
+
+// Send more messages than fit in a single batch from an endpoint to itself over the loopback interface.
+static void TestInetUDPSendMsgs(nlTestSuite * inSuite, void * inContext)
+{
+    BatchReceiveState state;
+    UDPEndPoint * testUDPEP = nullptr;
+
+    CHIP_ERROR err = gUDP.NewEndPoint(&testUDPEP);
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    // The endpoint is freed whether or not the checks pass.
+    CheckUDPSendMsgs(inSuite, testUDPEP, state);
+    testUDPEP->Free();
+}
+
 static void TestInetEndPointInternal(nlTestSuite * inSuite, void * inContext)
 {
     CHIP_ERROR err;
@@ -451,6 +551,7 @@ static void TestInetEndPointLimit(nlTestSuite * inSuite, void * inContext)
 static const nlTest sTests[] = { NL_TEST_DEF("InetEndPoint::PreTest", TestInetPre),
                                  NL_TEST_DEF("InetEndPoint::TestInetError", TestInetError),
                                  NL_TEST_DEF("InetEndPoint::TestInetInterface", TestInetInterface),
+                                 NL_TEST_DEF("InetEndPoint::TestInetUDPSendMsgs", TestInetUDPSendMsgs),
                                  NL_TEST_DEF("InetEndPoint::TestInetEndPoint", TestInetEndPointInternal),
 #if !CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
                                  NL_TEST_DEF("InetEndPoint::TestEndPointLimit", TestInetEndPointLimit),
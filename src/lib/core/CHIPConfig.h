@@ -667,6 +667,19 @@
 #define CHIP_CONFIG_UNAUTHENTICATED_CONNECTION_POOL_SIZE 4
 #endif // CHIP_CONFIG_UNAUTHENTICATED_CONNECTION_POOL_SIZE
 
+/**
+ * @def CHIP_CONFIG_SEND_BATCH_SIZE
+ *
+ * @brief Define the number of messages to UDP peers a SessionManager::SendBatch
+ * holds before they are passed to the transport.
+ *
+ * A value of 1 disables batching: messages are passed to the transport as they
+ * are sent, and the SessionManager does not reserve storage for a batch.
+ */
+#ifndef CHIP_CONFIG_SEND_BATCH_SIZE
+#define CHIP_CONFIG_SEND_BATCH_SIZE 1
+#endif // CHIP_CONFIG_SEND_BATCH_SIZE
+
 /**
  * @def CHIP_CONFIG_SECURE_SESSION_REFCOUNT_LOGGING
  *
@@ -690,6 +703,19 @@
 #define CHIP_CONFIG_MAX_FABRICS 16
 #endif // CHIP_CONFIG_MAX_FABRICS
 
+/**
+ * @def CHIP_CONFIG_CASE_SERVER_MAX_CONCURRENT_HANDSHAKES
+ *
+ * @brief Defines the number of CASE handshakes, each from a different initiator,
+ * that CASEServer can respond to at the same time.  A Sigma1 that arrives while
+ * all of them are in progress is dropped.
+ *
+ * Each of them holds a CASESession and reserves a slot of the secure session pool.
+ */
+#ifndef CHIP_CONFIG_CASE_SERVER_MAX_CONCURRENT_HANDSHAKES
+#define CHIP_CONFIG_CASE_SERVER_MAX_CONCURRENT_HANDSHAKES 1
+#endif // CHIP_CONFIG_CASE_SERVER_MAX_CONCURRENT_HANDSHAKES
+
 /**
  * @def CHIP_CONFIG_SECURE_SESSION_POOL_SIZE
  *
@@ -699,7 +725,7 @@
  *
  * This is sized by default to cover the sum of the following:
  *  - At least 3 CASE sessions / fabric (Spec Ref: 4.13.2.8)
- *  - 1 reserved slot for CASEServer as a responder.
+ *  - 1 reserved slot for each CASEServer responder (CHIP_CONFIG_CASE_SERVER_MAX_CONCURRENT_HANDSHAKES).
  *  - 1 reserved slot for PASE.
  *
  *  NOTE: On heap-based platforms, there is no pre-allocation of the pool.
@@ -709,7 +735,7 @@
  *
  */
 #ifndef CHIP_CONFIG_SECURE_SESSION_POOL_SIZE
-#define CHIP_CONFIG_SECURE_SESSION_POOL_SIZE (CHIP_CONFIG_MAX_FABRICS * 3 + 2)
+#define CHIP_CONFIG_SECURE_SESSION_POOL_SIZE (CHIP_CONFIG_MAX_FABRICS * 3 + CHIP_CONFIG_CASE_SERVER_MAX_CONCURRENT_HANDSHAKES + 1)
 #endif // CHIP_CONFIG_SECURE_SESSION_POOL_SIZE
 
 /**
@@ -874,6 +900,17 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_IM_SERVER_MAX_NUM_DIRTY_SET 8
 #endif
 
+/**
+ * @def CHIP_IM_FLATTENED_ATTRIBUTE_TREE
+ *
+ * @brief Enables expanding wildcard attribute paths from a heap allocated copy of the endpoint / cluster / attribute ids of the
+ *        data model, see app/FlattenedAttributeTree.h.  This trades memory proportional to the number of attributes for
+ *        fewer attribute storage lookups on every wildcard read, subscription report and priming report.
+ */
+#ifndef CHIP_IM_FLATTENED_ATTRIBUTE_TREE
+#define CHIP_IM_FLATTENED_ATTRIBUTE_TREE CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+#endif
+
 /**
  * @def CHIP_IM_MAX_NUM_WRITE_HANDLER
  *
@@ -1155,6 +1192,40 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_CASE_SESSION_RESUME_CACHE_SIZE (3 * CHIP_CONFIG_MAX_FABRICS)
 #endif
 
+/**
+ * @def CHIP_CONFIG_CASE_SESSION_RESUME_MEMORY_CACHE_SIZE
+ *
+ * @brief
+ *   Number of CASE session resumption records that CachedSessionResumptionStorage keeps
+ *   in memory in front of the persistent storage.
+ */
+#ifndef CHIP_CONFIG_CASE_SESSION_RESUME_MEMORY_CACHE_SIZE
+#define CHIP_CONFIG_CASE_SESSION_RESUME_MEMORY_CACHE_SIZE CHIP_CONFIG_CASE_SESSION_RESUME_CACHE_SIZE
+#endif
+
+/**
+ * @def CHIP_CONFIG_CASE_SESSION_RESUME_WRITE_BEHIND_DELAY_MS
+ *
+ * @brief
+ *   Time, in milliseconds, that CachedSessionResumptionStorage waits after a session resumption
+ *   record is saved before writing it to the persistent storage. Records saved again within
+ *   that time are written once.
+ */
+#ifndef CHIP_CONFIG_CASE_SESSION_RESUME_WRITE_BEHIND_DELAY_MS
+#define CHIP_CONFIG_CASE_SESSION_RESUME_WRITE_BEHIND_DELAY_MS 1000
+#endif
+
+/**
+ * @def CHIP_CONFIG_VERIFIED_CERT_CACHE_SIZE
+ *
+ * @brief
+ *   Number of intermediate certificates whose signature by a trusted root is remembered, so that
+ *   CASE sessions with peers sharing an ICAC don't verify the ICAC signature again.
+ */
+#ifndef CHIP_CONFIG_VERIFIED_CERT_CACHE_SIZE
+#define CHIP_CONFIG_VERIFIED_CERT_CACHE_SIZE 8
+#endif
+
 /**
  * @def CHIP_CONFIG_EVENT_LOGGING_BYTE_THRESHOLD
  *
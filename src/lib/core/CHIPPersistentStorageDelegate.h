@@ -19,6 +19,7 @@
 #pragma once
 
 #include <lib/core/CHIPError.h>
+#include <lib/support/CodeUtils.h>
 #include <lib/support/DLLUtil.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -110,6 +111,87 @@ public:
         CHIP_ERROR err = SyncGetKeyValue(key, nullptr, size);
         return (err == CHIP_ERROR_BUFFER_TOO_SMALL) || (err == CHIP_NO_ERROR);
     }
+
+    /**
+     * @brief
+     *   Starts a batch of writes.
+     *
+     *   The SyncSetKeyValue and SyncDeleteKeyValue calls made until the matching CommitBatch() or AbortBatch() are
+     *   visible to SyncGetKeyValue right away, but a backend that supports batching may defer making them durable
+     *   until CommitBatch(), and then persist all of them atomically, with a single flush.
+     *
+     *   Batches nest, and their depth is tracked by each delegate: only the end of the delegate's outermost batch
+     *   commits.  They are meant to group the writes of a single operation running on the CHIP thread, not to isolate
+     *   concurrent writers: delegates sharing a backend may share its batch, in which case their batches must nest,
+     *   and aborting the inner one discards the writes of the outer one as well.
+     *
+     *   The default implementation does nothing, every write is then durable on its own as before.
+     *
+     * @return CHIP_NO_ERROR on success, or another CHIP_ERROR value from implementation on failure, in which case
+     *         no batch was started and CommitBatch()/AbortBatch() must not be called.
+     */
+    virtual CHIP_ERROR BeginBatch() { return CHIP_NO_ERROR; }
+
+    /**
+     * @brief
+     *   Ends the batch started by the matching BeginBatch(), making its writes durable if it is the outermost one.
+     *
+     * @return CHIP_NO_ERROR on success, CHIP_ERROR_TRANSACTION_CANCELED if a nested batch was aborted, in which case
+     *         the whole batch was discarded, or another CHIP_ERROR value from implementation on failure.
+     */
+    virtual CHIP_ERROR CommitBatch() { return CHIP_NO_ERROR; }
+
+    /**
+     * @brief
+     *   Ends the batch started by the matching BeginBatch(), discarding the writes of the outermost batch.
+     *
+     *   Only a backend that supports batching can discard writes: with the default implementation, they were already
+     *   made durable when issued.  Callers must therefore not rely on AbortBatch() to undo their writes.
+     */
+    virtual void AbortBatch() {}
+};
+
+/**
+ * Scoped batch of writes to a PersistentStorageDelegate, see PersistentStorageDelegate::BeginBatch().
+ *
+ * The batch is committed when the object goes out of scope, unless Commit() or Abort() was called before.  This keeps
+ * the outcome of a partially failed sequence of writes the same as without batching, while issuing a single flush.
+ */
+class PersistentStorageBatch
+{
+public:
+    explicit PersistentStorageBatch(PersistentStorageDelegate * storage) : mStorage(storage)
+    {
+        if (mStorage != nullptr && mStorage->BeginBatch() != CHIP_NO_ERROR)
+        {
+            // Fall back to unbatched writes.
+            mStorage = nullptr;
+        }
+    }
+
+    ~PersistentStorageBatch() { LogErrorOnFailure(Commit()); }
+
+    PersistentStorageBatch(const PersistentStorageBatch &) = delete;
+    PersistentStorageBatch & operator=(const PersistentStorageBatch &) = delete;
+
+    CHIP_ERROR Commit()
+    {
+        PersistentStorageDelegate * storage = mStorage;
+        mStorage                            = nullptr;
+        return (storage != nullptr) ? storage->CommitBatch() : CHIP_NO_ERROR;
+    }
+
+    void Abort()
+    {
+        if (mStorage != nullptr)
+        {
+            mStorage->AbortBatch();
+            mStorage = nullptr;
+        }
+    }
+
+private:
+    PersistentStorageDelegate * mStorage;
 };
 
 } // namespace chip
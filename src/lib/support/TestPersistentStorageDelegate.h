@@ -126,6 +126,53 @@ public:
         return err;
     }
 
+    CHIP_ERROR BeginBatch() override
+    {
+        if (mBatchDepth == 0)
+        {
+            mBatchSnapshot = mStorage;
+        }
+        mBatchDepth++;
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR CommitBatch() override
+    {
+        VerifyOrReturnError(mBatchDepth > 0, CHIP_ERROR_INCORRECT_STATE);
+        VerifyOrReturnError(--mBatchDepth == 0, CHIP_NO_ERROR);
+        if (mBatchAborted)
+        {
+            RollbackBatch();
+            return CHIP_ERROR_TRANSACTION_CANCELED;
+        }
+
+        mBatchSnapshot.clear();
+        mCommittedBatchCount++;
+        return CHIP_NO_ERROR;
+    }
+
+    void AbortBatch() override
+    {
+        VerifyOrReturn(mBatchDepth > 0);
+
+        // Aborting a nested batch discards the outermost one, when it ends.
+        mBatchAborted = true;
+        if (--mBatchDepth == 0)
+        {
+            RollbackBatch();
+        }
+    }
+
+    /**
+     * @return the nesting depth of the current batch, 0 outside of a batch
+     */
+    virtual unsigned GetBatchDepth() { return mBatchDepth; }
+
+    /**
+     * @return the number of outermost batches committed so far
+     */
+    virtual size_t GetCommittedBatchCount() { return mCommittedBatchCount; }
+
     /**
      * @brief Adds a "poison key": a key that, if read/written, implies some bad
      *        behavior occurred.
@@ -271,9 +318,22 @@ protected:
         return CHIP_NO_ERROR;
     }
 
+    void RollbackBatch()
+    {
+        mStorage = std::move(mBatchSnapshot);
+        mBatchSnapshot.clear();
+        mBatchAborted = false;
+    }
+
     std::map<std::string, std::vector<uint8_t>> mStorage;
     std::set<std::string> mPoisonKeys;
     LoggingLevel mLoggingLevel = LoggingLevel::kDisabled;
+
+    // Contents of the storage when the outermost batch began, restored if it is aborted.
+    std::map<std::string, std::vector<uint8_t>> mBatchSnapshot;
+    unsigned mBatchDepth        = 0;
+    bool mBatchAborted          = false;
+    size_t mCommittedBatchCount = 0;
 };
 
 } // namespace chip
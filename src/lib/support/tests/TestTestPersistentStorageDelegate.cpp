@@ -341,8 +341,135 @@ void TestClearStorage(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, size == sizeof(buf));
 }
 
+bool HasValue(TestPersistentStorageDelegate & storage, const char * key, const char * value)
+{
+    char buf[16];
+    uint16_t size = sizeof(buf);
+    return storage.SyncGetKeyValue(key, buf, size) == CHIP_NO_ERROR && size == strlen(value) && memcmp(buf, value, size) == 0;
+}
+
+CHIP_ERROR SetValue(TestPersistentStorageDelegate & storage, const char * key, const char * value)
+{
+    return storage.SyncSetKeyValue(key, value, static_cast<uint16_t>(strlen(value)));
+}
+
+void TestNestedBatches(nlTestSuite * inSuite, void * inContext)
+{
+    TestPersistentStorageDelegate storage;
+
+    {
+        PersistentStorageBatch outer(&storage);
+        NL_TEST_ASSERT(inSuite, SetValue(storage, "key1", "one") == CHIP_NO_ERROR);
+
+        {
+            PersistentStorageBatch inner(&storage);
+            NL_TEST_ASSERT(inSuite, storage.GetBatchDepth() == 2);
+            NL_TEST_ASSERT(inSuite, SetValue(storage, "key2", "two") == CHIP_NO_ERROR);
+        }
+
+        // Ending the inner batch does not commit, but its writes are visible.
+        NL_TEST_ASSERT(inSuite, storage.GetBatchDepth() == 1);
+        NL_TEST_ASSERT(inSuite, storage.GetCommittedBatchCount() == 0);
+        NL_TEST_ASSERT(inSuite, HasValue(storage, "key1", "one"));
+        NL_TEST_ASSERT(inSuite, HasValue(storage, "key2", "two"));
+
+        // Only the end of the outermost batch commits, and only once.
+        NL_TEST_ASSERT(inSuite, outer.Commit() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.GetBatchDepth() == 0);
+        NL_TEST_ASSERT(inSuite, storage.GetCommittedBatchCount() == 1);
+        NL_TEST_ASSERT(inSuite, outer.Commit() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.GetCommittedBatchCount() == 1);
+    }
+    NL_TEST_ASSERT(inSuite, storage.GetCommittedBatchCount() == 1);
+
+    // Going out of scope commits.
+    {
+        PersistentStorageBatch batch(&storage);
+        NL_TEST_ASSERT(inSuite, storage.SyncDeleteKeyValue("key1") == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, storage.GetBatchDepth() == 0);
+    NL_TEST_ASSERT(inSuite, storage.GetCommittedBatchCount() == 2);
+    NL_TEST_ASSERT(inSuite, !storage.HasKey("key1"));
+
+    // The depth is tracked per delegate.
+    TestPersistentStorageDelegate otherStorage;
+    {
+        PersistentStorageBatch batch(&storage);
+        NL_TEST_ASSERT(inSuite, otherStorage.CommitBatch() == CHIP_ERROR_INCORRECT_STATE);
+        PersistentStorageBatch otherBatch(&otherStorage);
+        NL_TEST_ASSERT(inSuite, otherBatch.Commit() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, otherStorage.GetCommittedBatchCount() == 1);
+        NL_TEST_ASSERT(inSuite, storage.GetBatchDepth() == 1);
+    }
+    NL_TEST_ASSERT(inSuite, storage.GetCommittedBatchCount() == 3);
+    NL_TEST_ASSERT(inSuite, storage.CommitBatch() == CHIP_ERROR_INCORRECT_STATE);
+}
+
+class UnbatchedStorageDelegate : public TestPersistentStorageDelegate
+{
+public:
+    CHIP_ERROR BeginBatch() override { return CHIP_ERROR_NOT_IMPLEMENTED; }
+};
+
+void TestBatchErrorMidway(nlTestSuite * inSuite, void * inContext)
+{
+    TestPersistentStorageDelegate storage;
+    storage.AddPoisonKey("poison");
+
+    // A batch that is not aborted keeps the writes made before the error, as without batching.
+    {
+        PersistentStorageBatch batch(&storage);
+        NL_TEST_ASSERT(inSuite, SetValue(storage, "key1", "one") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, SetValue(storage, "poison", "bad") == CHIP_ERROR_PERSISTED_STORAGE_FAILED);
+    }
+    NL_TEST_ASSERT(inSuite, storage.GetCommittedBatchCount() == 1);
+    NL_TEST_ASSERT(inSuite, HasValue(storage, "key1", "one"));
+
+    // Aborting discards them.
+    {
+        PersistentStorageBatch batch(&storage);
+        NL_TEST_ASSERT(inSuite, SetValue(storage, "key1", "changed") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, SetValue(storage, "key2", "two") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, SetValue(storage, "poison", "bad") == CHIP_ERROR_PERSISTED_STORAGE_FAILED);
+        batch.Abort();
+        NL_TEST_ASSERT(inSuite, batch.Commit() == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, storage.GetBatchDepth() == 0);
+    NL_TEST_ASSERT(inSuite, storage.GetCommittedBatchCount() == 1);
+    NL_TEST_ASSERT(inSuite, HasValue(storage, "key1", "one"));
+    NL_TEST_ASSERT(inSuite, !storage.HasKey("key2"));
+
+    // Aborting a nested batch discards the outermost one.
+    {
+        PersistentStorageBatch outer(&storage);
+        NL_TEST_ASSERT(inSuite, storage.SyncDeleteKeyValue("key1") == CHIP_NO_ERROR);
+        {
+            PersistentStorageBatch inner(&storage);
+            NL_TEST_ASSERT(inSuite, SetValue(storage, "key3", "three") == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(inSuite, storage.SyncDeleteKeyValue("poison") == CHIP_ERROR_PERSISTED_STORAGE_FAILED);
+            inner.Abort();
+        }
+        NL_TEST_ASSERT(inSuite, outer.Commit() == CHIP_ERROR_TRANSACTION_CANCELED);
+    }
+    NL_TEST_ASSERT(inSuite, storage.GetCommittedBatchCount() == 1);
+    NL_TEST_ASSERT(inSuite, HasValue(storage, "key1", "one"));
+    NL_TEST_ASSERT(inSuite, !storage.HasKey("key3"));
+
+    // A delegate that fails to start a batch writes through, and is not asked to commit.
+    UnbatchedStorageDelegate unbatched;
+    {
+        PersistentStorageBatch batch(&unbatched);
+        NL_TEST_ASSERT(inSuite, SetValue(unbatched, "key1", "one") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, batch.Commit() == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, unbatched.GetCommittedBatchCount() == 0);
+    NL_TEST_ASSERT(inSuite, HasValue(unbatched, "key1", "one"));
+}
+
 const nlTest sTests[] = { NL_TEST_DEF("Test basic API", TestBasicApi),
                           NL_TEST_DEF("Test ClearStorage method of TestPersistentStorageDelegate", TestClearStorage),
+                          NL_TEST_DEF("Test nested batches", TestNestedBatches),
+                          NL_TEST_DEF("Test error in the middle of a batch", TestBatchErrorMidway),
                           NL_TEST_SENTINEL() };
 
 } // namespace
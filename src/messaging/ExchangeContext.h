@@ -248,6 +248,10 @@ private:
     ExchangeSessionHolder mSession; // The connection state
     uint16_t mExchangeId;           // Assigned exchange ID.
 
+    // Bucket of the ExchangeManager exchange index this exchange is in, and the next exchange in that bucket.
+    size_t mIndexBucket            = 0;
+    ExchangeContext * mNextInIndex = nullptr;
+
     /**
      *  Track whether we are now expecting a response to a message sent via this exchange (because that
      *  message had the kExpectResponse flag set in its sendFlags).
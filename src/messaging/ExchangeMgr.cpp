@@ -59,7 +59,7 @@ namespace Messaging {
  *    prior to use.
  *
  */
-ExchangeManager::ExchangeManager() : mReliableMessageMgr(mContextPool)
+ExchangeManager::ExchangeManager()
 {
     mState = State::kState_NotInitialized;
 }
@@ -115,7 +115,45 @@ ExchangeContext * ExchangeManager::NewContext(const SessionHandle & session, Exc
         ChipLogError(ExchangeManager, "NewContext failed: session inactive");
         return nullptr;
     }
-    return mContextPool.CreateObject(this, mNextExchangeId++, session, isInitiator, delegate);
+    return AllocateContext(mNextExchangeId++, session, isInitiator, delegate);
+}
+
+ExchangeContext * ExchangeManager::AllocateContext(uint16_t exchangeId, const SessionHandle & session, bool isInitiator,
+                                                   ExchangeDelegate * delegate, bool isEphemeralExchange)
+{
+    ExchangeContext * ec = mContextPool.CreateObject(this, exchangeId, session, isInitiator, delegate, isEphemeralExchange);
+    if (ec != nullptr)
+    {
+        ec->mIndexBucket         = IndexBucket(session.operator->(), exchangeId, isInitiator);
+        ec->mNextInIndex         = mIndex[ec->mIndexBucket];
+        mIndex[ec->mIndexBucket] = ec;
+    }
+    return ec;
+}
+
+void ExchangeManager::RemoveFromIndex(ExchangeContext & ec)
+{
+    for (ExchangeContext ** link = &mIndex[ec.mIndexBucket]; *link != nullptr; link = &(*link)->mNextInIndex)
+    {
+        if (*link == &ec)
+        {
+            *link           = ec.mNextInIndex;
+            ec.mNextInIndex = nullptr;
+            return;
+        }
+    }
+}
+
+ExchangeContext * ExchangeManager::FindContext(const SessionHandle & session, const PacketHeader & packetHeader,
+                                               const PayloadHeader & payloadHeader)
+{
+    // The exchange of a message sent by an initiator is a responder, and conversely.
+    ExchangeContext * ec = mIndex[IndexBucket(session.operator->(), payloadHeader.GetExchangeID(), !payloadHeader.IsInitiator())];
+    while (ec != nullptr && !ec->MatchExchange(session, packetHeader, payloadHeader))
+    {
+        ec = ec->mNextInIndex;
+    }
+    return ec;
 }
 
 CHIP_ERROR ExchangeManager::RegisterUnsolicitedMessageHandlerForProtocol(Protocols::Id protocolId,
@@ -238,23 +276,14 @@ void ExchangeManager::OnMessageReceived(const PacketHeader & packetHeader, const
     if (!packetHeader.IsGroupSession())
     {
         // Search for an existing exchange that the message applies to. If a match is found...
-        bool found = false;
-        mContextPool.ForEachActiveObject([&](auto * ec) {
-            if (ec->MatchExchange(session, packetHeader, payloadHeader))
-            {
-                ChipLogDetail(ExchangeManager, "Found matching exchange: " ChipLogFormatExchange ", Delegate: %p",
-                              ChipLogValueExchange(ec), ec->GetDelegate());
-
-                // Matched ExchangeContext; send to message handler.
-                ec->HandleMessage(packetHeader.GetMessageCounter(), payloadHeader, msgFlags, std::move(msgBuf));
-                found = true;
-                return Loop::Break;
-            }
-            return Loop::Continue;
-        });
-
-        if (found)
+        ExchangeContext * ec = FindContext(session, packetHeader, payloadHeader);
+        if (ec != nullptr)
         {
+            ChipLogDetail(ExchangeManager, "Found matching exchange: " ChipLogFormatExchange ", Delegate: %p",
+                          ChipLogValueExchange(ec), ec->GetDelegate());
+
+            // Matched ExchangeContext; send to message handler.
+            ec->HandleMessage(packetHeader.GetMessageCounter(), payloadHeader, msgFlags, std::move(msgBuf));
             return;
         }
     }
@@ -321,7 +350,7 @@ void ExchangeManager::OnMessageReceived(const PacketHeader & packetHeader, const
             return;
         }
 
-        ExchangeContext * ec = mContextPool.CreateObject(this, payloadHeader.GetExchangeID(), session, false, delegate);
+        ExchangeContext * ec = AllocateContext(payloadHeader.GetExchangeID(), session, false, delegate);
 
         if (ec == nullptr)
         {
@@ -371,8 +400,8 @@ void ExchangeManager::SendStandaloneAckIfNeeded(const PacketHeader & packetHeade
     // If rcvd msg is from initiator then this exchange is created as not Initiator.
     // If rcvd msg is not from initiator then this exchange is created as Initiator.
     // Create a EphemeralExchange to generate a StandaloneAck
-    ExchangeContext * ec = mContextPool.CreateObject(this, payloadHeader.GetExchangeID(), session, !payloadHeader.IsInitiator(),
-                                                     nullptr, true /* IsEphemeralExchange */);
+    ExchangeContext * ec = AllocateContext(payloadHeader.GetExchangeID(), session, !payloadHeader.IsInitiator(), nullptr,
+                                           true /* IsEphemeralExchange */);
 
     if (ec == nullptr)
     {
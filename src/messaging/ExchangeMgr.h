@@ -42,6 +42,19 @@ class ExchangeDelegate;
 
 static constexpr int16_t kAnyMessageType = -1;
 
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+// A heap backed pool is not bounded by CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS, and controllers keep hundreds of exchanges open.
+constexpr size_t kMinExchangeIndexBucketCount = 256;
+#else
+constexpr size_t kMinExchangeIndexBucketCount = 1;
+#endif
+
+// Smallest power of two that is at least the exchange context pool size.
+constexpr size_t ExchangeIndexBucketCount(size_t count = kMinExchangeIndexBucketCount)
+{
+    return count >= CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS ? count : ExchangeIndexBucketCount(count * 2);
+}
+
 /**
  *  @brief
  *    This class is used to manage ExchangeContexts with other CHIP nodes.
@@ -100,7 +113,11 @@ public:
      */
     ExchangeContext * NewContext(const SessionHandle & session, ExchangeDelegate * delegate, bool isInitiator = true);
 
-    void ReleaseContext(ExchangeContext * ec) { mContextPool.ReleaseObject(ec); }
+    void ReleaseContext(ExchangeContext * ec)
+    {
+        RemoveFromIndex(*ec);
+        mContextPool.ReleaseObject(ec);
+    }
 
     /**
      *  Register an unsolicited message handler for a given protocol identifier. This handler would be
@@ -230,11 +247,36 @@ private:
 
     ObjectPool<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> mContextPool;
 
+    // Exchanges hashed by session, exchange ID and initiator flag, chained through the exchanges themselves, so that
+    // received messages find their exchange without visiting the others.
+    static constexpr size_t kIndexBucketCount   = ExchangeIndexBucketCount();
+    ExchangeContext * mIndex[kIndexBucketCount] = {};
+
     SessionManager * mSessionManager;
     ReliableMessageMgr mReliableMessageMgr;
 
     UnsolicitedMessageHandlerSlot UMHandlerPool[CHIP_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS];
 
+    static size_t IndexBucket(const Transport::Session * session, uint16_t exchangeId, bool isInitiator)
+    {
+        uint64_t key  = (static_cast<uint64_t>(exchangeId) << 1) | (isInitiator ? 1 : 0);
+        uint64_t hash = (reinterpret_cast<uintptr_t>(session) ^ key) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(hash >> 32) & (kIndexBucketCount - 1);
+    }
+
+    /**
+     * Allocate an exchange out of the pool and add it to the index.
+     */
+    ExchangeContext * AllocateContext(uint16_t exchangeId, const SessionHandle & session, bool isInitiator,
+                                      ExchangeDelegate * delegate, bool isEphemeralExchange = false);
+    void RemoveFromIndex(ExchangeContext & ec);
+
+    /**
+     * Find the exchange a received unicast message belongs to, if any.
+     */
+    ExchangeContext * FindContext(const SessionHandle & session, const PacketHeader & packetHeader,
+                                  const PayloadHeader & payloadHeader);
+
     CHIP_ERROR RegisterUMH(Protocols::Id protocolId, int16_t msgType, UnsolicitedMessageHandler * handler);
     CHIP_ERROR UnregisterUMH(Protocols::Id protocolId, int16_t msgType);
 
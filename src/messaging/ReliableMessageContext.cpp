@@ -193,6 +193,22 @@ CHIP_ERROR ReliableMessageContext::SendStandaloneAckMessage()
     return err;
 }
 
+void ReliableMessageContext::SetAckPending(bool inAckPending)
+{
+    VerifyOrReturn(inAckPending != IsAckPending());
+    mFlags.Set(Flags::kFlagAckPending, inAckPending);
+
+    // Keep the ReliableMessageMgr list of exchanges it may have to send a standalone ack for up to date.
+    if (inAckPending)
+    {
+        GetReliableMessageMgr()->AddToPendingAcks(*this);
+    }
+    else
+    {
+        GetReliableMessageMgr()->RemoveFromPendingAcks(*this);
+    }
+}
+
 void ReliableMessageContext::SetPendingPeerAckMessageCounter(uint32_t aPeerAckMessageCounter)
 {
     mPendingPeerAckMessageCounter = aPeerAckMessageCounter;
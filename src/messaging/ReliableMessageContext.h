@@ -204,6 +204,10 @@ private:
 
     System::Clock::Timestamp mNextAckTime; // Next time for triggering Solo Ack
     uint32_t mPendingPeerAckMessageCounter;
+
+    // Neighbours in the list of exchanges with a pending ack of the ReliableMessageMgr.
+    ReliableMessageContext * mPrevPendingAck = nullptr;
+    ReliableMessageContext * mNextPendingAck = nullptr;
 };
 
 inline bool ReliableMessageContext::AutoRequestAck() const
@@ -236,11 +240,6 @@ inline void ReliableMessageContext::SetAutoRequestAck(bool autoReqAck)
     mFlags.Set(Flags::kFlagAutoRequestAck, autoReqAck);
 }
 
-inline void ReliableMessageContext::SetAckPending(bool inAckPending)
-{
-    mFlags.Set(Flags::kFlagAckPending, inAckPending);
-}
-
 inline void ReliableMessageContext::SetMessageNotAcked(bool messageNotAcked)
 {
     mFlags.Set(Flags::kFlagMessageNotAcked, messageNotAcked);
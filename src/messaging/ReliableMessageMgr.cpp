@@ -47,7 +47,7 @@ namespace chip {
 namespace Messaging {
 
 ReliableMessageMgr::RetransTableEntry::RetransTableEntry(ReliableMessageContext * rc) :
-    ec(*rc->GetExchangeContext()), nextRetransTime(0), sendCount(0)
+    ec(*rc->GetExchangeContext()), nextRetransTime(0), sendCount(0), queueIndex(0), nextInAckIndex(nullptr)
 {
     ec->SetMessageNotAcked(true);
 }
@@ -57,9 +57,7 @@ ReliableMessageMgr::RetransTableEntry::~RetransTableEntry()
     ec->SetMessageNotAcked(false);
 }
 
-ReliableMessageMgr::ReliableMessageMgr(ObjectPool<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> & contextPool) :
-    mContextPool(contextPool), mSystemLayer(nullptr)
-{}
+ReliableMessageMgr::ReliableMessageMgr() : mSystemLayer(nullptr) {}
 
 ReliableMessageMgr::~ReliableMessageMgr() {}
 
@@ -74,10 +72,16 @@ void ReliableMessageMgr::Shutdown()
 
     // Clear the retransmit table
     mRetransTable.ForEachActiveObject([&](auto * entry) {
-        mRetransTable.ReleaseObject(entry);
+        ReleaseRetransTableEntry(*entry);
         return Loop::Continue;
     });
 
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    Platform::MemoryFree(mRetransQueue);
+    mRetransQueue         = nullptr;
+    mRetransQueueCapacity = 0;
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+
     mSystemLayer = nullptr;
 }
 
@@ -104,23 +108,37 @@ void ReliableMessageMgr::ExecuteActions()
     ChipLogDetail(ExchangeManager, "ReliableMessageMgr::ExecuteActions at %" PRIu64 "ms", now.count());
 #endif
 
-    ExecuteForAllContext([&](ReliableMessageContext * rc) {
-        if (rc->IsAckPending())
+    // Sending an ack can close exchanges or flush their acks, which takes them off their list, so move the exchanges
+    // whose ack is due to a list of their own first, then send their acks one at a time.
+    for (ReliableMessageContext * rc = mPendingAcks; rc != nullptr;)
+    {
+        ReliableMessageContext * next = rc->mNextPendingAck;
+        if (rc->mNextAckTime <= now)
         {
-            if (rc->mNextAckTime <= now)
-            {
+            RemoveFromPendingAcks(*rc);
+            PushToAckList(mDueAcks, *rc);
+        }
+        rc = next;
+    }
+
+    while (mDueAcks != nullptr)
+    {
+        ReliableMessageContext * rc = mDueAcks;
+
+        // Sending the ack takes the exchange off the pending acks, unless it fails.
+        RemoveFromPendingAcks(*rc);
+        PushToAckList(mPendingAcks, *rc);
 #if defined(RMP_TICKLESS_DEBUG)
-                ChipLogDetail(ExchangeManager, "ReliableMessageMgr::ExecuteActions sending ACK %p", rc);
+        ChipLogDetail(ExchangeManager, "ReliableMessageMgr::ExecuteActions sending ACK %p", rc);
 #endif
-                rc->SendStandaloneAckMessage();
-            }
-        }
-    });
+        rc->SendStandaloneAckMessage();
+    }
 
-    // Retransmit / cancel anything in the retrans table whose retrans timeout has expired
-    mRetransTable.ForEachActiveObject([&](auto * entry) {
-        if (entry->nextRetransTime > now)
-            return Loop::Continue;
+    // Retransmit / cancel anything in the retrans table whose retrans timeout has expired.  A retransmitted entry moves
+    // to a later time, so each expired entry is visited once.
+    while (mRetransQueueSize > 0 && mRetransQueue[0]->nextRetransTime <= now)
+    {
+        RetransTableEntry * entry = mRetransQueue[0];
 
         VerifyOrDie(!entry->retainedBuf.IsNull());
 
@@ -153,8 +171,8 @@ void ReliableMessageMgr::ExecuteActions()
             }
 
             // Do not StartTimer, we will schedule the timer at the end of the timer handler.
-            mRetransTable.ReleaseObject(entry);
-            return Loop::Continue;
+            ReleaseRetransTableEntry(*entry);
+            continue;
         }
 
         entry->sendCount++;
@@ -166,11 +184,9 @@ void ReliableMessageMgr::ExecuteActions()
         // Choose active/idle timeout from PeerActiveMode of session per 4.11.2.1. Retransmissions.
         System::Clock::Timestamp baseTimeout = entry->ec->GetSessionHandle()->GetMRPBaseTimeout();
         System::Clock::Timestamp backoff     = ReliableMessageMgr::GetBackoff(baseTimeout, entry->sendCount);
-        entry->nextRetransTime               = System::SystemClock().GetMonotonicTimestamp() + backoff;
+        SetNextRetransTime(*entry, System::SystemClock().GetMonotonicTimestamp() + backoff);
         SendFromRetransTable(entry);
-
-        return Loop::Continue;
-    });
+    }
 
     TicklessDebugDumpRetransTable("ReliableMessageMgr::ExecuteActions Dumping mRetransTable entries after processing");
 }
@@ -196,13 +212,22 @@ CHIP_ERROR ReliableMessageMgr::AddToRetransTable(ReliableMessageContext * rc, Re
 {
     VerifyOrDie(!rc->IsMessageNotAcked());
 
-    *rEntry = mRetransTable.CreateObject(rc);
+    CHIP_ERROR err = ReserveRetransQueue();
+    *rEntry        = (err == CHIP_NO_ERROR) ? mRetransTable.CreateObject(rc) : nullptr;
     if (*rEntry == nullptr)
     {
         ChipLogError(ExchangeManager, "mRetransTable Already Full");
         return CHIP_ERROR_RETRANS_TABLE_FULL;
     }
 
+    // The entry is due immediately until StartRetransmision schedules it.
+    PlaceInRetransQueue(**rEntry, mRetransQueueSize++);
+    SiftUp((*rEntry)->queueIndex);
+
+    size_t bucket             = AckIndexBucket(rc);
+    (*rEntry)->nextInAckIndex = mAckIndex[bucket];
+    mAckIndex[bucket]         = *rEntry;
+
     return CHIP_NO_ERROR;
 }
 
@@ -277,30 +302,26 @@ void ReliableMessageMgr::StartRetransmision(RetransTableEntry * entry)
     // Choose active/idle timeout from PeerActiveMode of session per 4.11.2.1. Retransmissions.
     System::Clock::Timestamp baseTimeout = entry->ec->GetSessionHandle()->GetMRPBaseTimeout();
     System::Clock::Timestamp backoff     = ReliableMessageMgr::GetBackoff(baseTimeout, entry->sendCount);
-    entry->nextRetransTime               = System::SystemClock().GetMonotonicTimestamp() + backoff;
+    SetNextRetransTime(*entry, System::SystemClock().GetMonotonicTimestamp() + backoff);
     StartTimer();
 }
 
 bool ReliableMessageMgr::CheckAndRemRetransTable(ReliableMessageContext * rc, uint32_t ackMessageCounter)
 {
-    bool removed = false;
-    mRetransTable.ForEachActiveObject([&](auto * entry) {
-        if (entry->ec->GetReliableMessageContext() == rc && entry->retainedBuf.GetMessageCounter() == ackMessageCounter)
-        {
-            // Clear the entry from the retransmision table.
-            ClearRetransTable(*entry);
-
-            ChipLogDetail(ExchangeManager,
-                          "Rxd Ack; Removing MessageCounter:" ChipLogFormatMessageCounter
-                          " from Retrans Table on exchange " ChipLogFormatExchange,
-                          ackMessageCounter, ChipLogValueExchange(rc->GetExchangeContext()));
-            removed = true;
-            return Loop::Break;
-        }
-        return Loop::Continue;
-    });
+    RetransTableEntry * entry = FindRetransTableEntry(rc);
+    if (entry == nullptr || entry->retainedBuf.GetMessageCounter() != ackMessageCounter)
+    {
+        return false;
+    }
+
+    // Clear the entry from the retransmision table.
+    ClearRetransTable(*entry);
 
-    return removed;
+    ChipLogDetail(ExchangeManager,
+                  "Rxd Ack; Removing MessageCounter:" ChipLogFormatMessageCounter
+                  " from Retrans Table on exchange " ChipLogFormatExchange,
+                  ackMessageCounter, ChipLogValueExchange(rc->GetExchangeContext()));
+    return true;
 }
 
 CHIP_ERROR ReliableMessageMgr::SendFromRetransTable(RetransTableEntry * entry)
@@ -356,43 +377,181 @@ CHIP_ERROR ReliableMessageMgr::SendFromRetransTable(RetransTableEntry * entry)
 
 void ReliableMessageMgr::ClearRetransTable(ReliableMessageContext * rc)
 {
-    mRetransTable.ForEachActiveObject([&](auto * entry) {
-        if (entry->ec->GetReliableMessageContext() == rc)
-        {
-            ClearRetransTable(*entry);
-            return Loop::Break;
-        }
-        return Loop::Continue;
-    });
+    RetransTableEntry * entry = FindRetransTableEntry(rc);
+    if (entry != nullptr)
+    {
+        ClearRetransTable(*entry);
+    }
 }
 
 void ReliableMessageMgr::ClearRetransTable(RetransTableEntry & entry)
 {
-    mRetransTable.ReleaseObject(&entry);
+    ReleaseRetransTableEntry(entry);
     // Expire any virtual ticks that have expired so all wakeup sources reflect the current time
     StartTimer();
 }
 
+void ReliableMessageMgr::ReleaseRetransTableEntry(RetransTableEntry & entry)
+{
+    // Move the last entry of the queue into the hole, then restore the heap order around it.
+    mRetransQueueSize--;
+    if (entry.queueIndex != mRetransQueueSize)
+    {
+        RetransTableEntry * last = mRetransQueue[mRetransQueueSize];
+        PlaceInRetransQueue(*last, entry.queueIndex);
+        SiftUp(last->queueIndex);
+        SiftDown(last->queueIndex);
+    }
+
+    RetransTableEntry ** link = &mAckIndex[AckIndexBucket(entry.ec->GetReliableMessageContext())];
+    while (*link != &entry)
+    {
+        link = &(*link)->nextInAckIndex;
+    }
+    *link = entry.nextInAckIndex;
+
+    mRetransTable.ReleaseObject(&entry);
+}
+
+ReliableMessageMgr::RetransTableEntry * ReliableMessageMgr::FindRetransTableEntry(const ReliableMessageContext * rc)
+{
+    RetransTableEntry * entry = mAckIndex[AckIndexBucket(rc)];
+    while (entry != nullptr && entry->ec->GetReliableMessageContext() != rc)
+    {
+        entry = entry->nextInAckIndex;
+    }
+    return entry;
+}
+
+CHIP_ERROR ReliableMessageMgr::ReserveRetransQueue()
+{
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    if (mRetransQueueSize == mRetransQueueCapacity)
+    {
+        size_t capacity = (mRetransQueueCapacity == 0) ? CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE : mRetransQueueCapacity * 2;
+        void * queue    = Platform::MemoryRealloc(mRetransQueue, capacity * sizeof(*mRetransQueue));
+        VerifyOrReturnError(queue != nullptr, CHIP_ERROR_NO_MEMORY);
+        mRetransQueue         = static_cast<RetransTableEntry **>(queue);
+        mRetransQueueCapacity = capacity;
+    }
+#else
+    VerifyOrReturnError(mRetransQueueSize < ArraySize(mRetransQueue), CHIP_ERROR_RETRANS_TABLE_FULL);
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    return CHIP_NO_ERROR;
+}
+
+void ReliableMessageMgr::SetNextRetransTime(RetransTableEntry & entry, System::Clock::Timestamp nextRetransTime)
+{
+    bool later            = nextRetransTime > entry.nextRetransTime;
+    entry.nextRetransTime = nextRetransTime;
+    if (later)
+    {
+        SiftDown(entry.queueIndex);
+    }
+    else
+    {
+        SiftUp(entry.queueIndex);
+    }
+}
+
+void ReliableMessageMgr::PlaceInRetransQueue(RetransTableEntry & entry, size_t index)
+{
+    mRetransQueue[index] = &entry;
+    entry.queueIndex     = index;
+}
+
+void ReliableMessageMgr::SiftUp(size_t index)
+{
+    RetransTableEntry * entry = mRetransQueue[index];
+    while (index > 0)
+    {
+        size_t parent = (index - 1) / 2;
+        if (mRetransQueue[parent]->nextRetransTime <= entry->nextRetransTime)
+        {
+            break;
+        }
+        PlaceInRetransQueue(*mRetransQueue[parent], index);
+        index = parent;
+    }
+    PlaceInRetransQueue(*entry, index);
+}
+
+void ReliableMessageMgr::SiftDown(size_t index)
+{
+    RetransTableEntry * entry = mRetransQueue[index];
+    for (size_t child = 2 * index + 1; child < mRetransQueueSize; child = 2 * index + 1)
+    {
+        if (child + 1 < mRetransQueueSize && mRetransQueue[child + 1]->nextRetransTime < mRetransQueue[child]->nextRetransTime)
+        {
+            child++;
+        }
+        if (entry->nextRetransTime <= mRetransQueue[child]->nextRetransTime)
+        {
+            break;
+        }
+        PlaceInRetransQueue(*mRetransQueue[child], index);
+        index = child;
+    }
+    PlaceInRetransQueue(*entry, index);
+}
+
+void ReliableMessageMgr::AddToPendingAcks(ReliableMessageContext & rc)
+{
+    PushToAckList(mPendingAcks, rc);
+}
+
+void ReliableMessageMgr::RemoveFromPendingAcks(ReliableMessageContext & rc)
+{
+    if (rc.mPrevPendingAck != nullptr)
+    {
+        rc.mPrevPendingAck->mNextPendingAck = rc.mNextPendingAck;
+    }
+    else if (mPendingAcks == &rc)
+    {
+        mPendingAcks = rc.mNextPendingAck;
+    }
+    else
+    {
+        // ExecuteActions() is sending the acks that are due.
+        mDueAcks = rc.mNextPendingAck;
+    }
+    if (rc.mNextPendingAck != nullptr)
+    {
+        rc.mNextPendingAck->mPrevPendingAck = rc.mPrevPendingAck;
+    }
+    rc.mPrevPendingAck = nullptr;
+    rc.mNextPendingAck = nullptr;
+}
+
+void ReliableMessageMgr::PushToAckList(ReliableMessageContext *& list, ReliableMessageContext & rc)
+{
+    rc.mPrevPendingAck = nullptr;
+    rc.mNextPendingAck = list;
+    if (list != nullptr)
+    {
+        list->mPrevPendingAck = &rc;
+    }
+    list = &rc;
+}
+
 void ReliableMessageMgr::StartTimer()
 {
     // When do we need to next wake up to send an ACK?
     System::Clock::Timestamp nextWakeTime = System::Clock::Timestamp::max();
 
-    ExecuteForAllContext([&](ReliableMessageContext * rc) {
-        if (rc->IsAckPending() && rc->mNextAckTime < nextWakeTime)
+    for (ReliableMessageContext * rc = mPendingAcks; rc != nullptr; rc = rc->mNextPendingAck)
+    {
+        if (rc->mNextAckTime < nextWakeTime)
         {
             nextWakeTime = rc->mNextAckTime;
         }
-    });
+    }
 
     // When do we need to next wake up for ReliableMessageProtocol retransmit?
-    mRetransTable.ForEachActiveObject([&](auto * entry) {
-        if (entry->nextRetransTime < nextWakeTime)
-        {
-            nextWakeTime = entry->nextRetransTime;
-        }
-        return Loop::Continue;
-    });
+    if (mRetransQueueSize > 0 && mRetransQueue[0]->nextRetransTime < nextWakeTime)
+    {
+        nextWakeTime = mRetransQueue[0]->nextRetransTime;
+    }
 
     StopTimer();
 
@@ -465,6 +624,17 @@ int ReliableMessageMgr::TestGetCountRetransTable()
     });
     return count;
 }
+
+bool ReliableMessageMgr::TestIsRetransQueueOrdered()
+{
+    for (size_t index = 0; index < mRetransQueueSize; index++)
+    {
+        VerifyOrReturnValue(mRetransQueue[index]->queueIndex == index, false);
+        VerifyOrReturnValue(index == 0 || mRetransQueue[(index - 1) / 2]->nextRetransTime <= mRetransQueue[index]->nextRetransTime,
+                            false);
+    }
+    return static_cast<size_t>(TestGetCountRetransTable()) == mRetransQueueSize;
+}
 #endif // CHIP_CONFIG_TEST
 
 } // namespace Messaging
@@ -42,6 +42,19 @@ namespace Messaging {
 enum class SendMessageFlags : uint16_t;
 class ReliableMessageContext;
 
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+// A heap backed retransmission table is not bounded by CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE.
+constexpr size_t kMinRetransIndexBucketCount = 256;
+#else
+constexpr size_t kMinRetransIndexBucketCount = 1;
+#endif
+
+// Smallest power of two that is at least the retransmission table size.
+constexpr size_t RetransIndexBucketCount(size_t count = kMinRetransIndexBucketCount)
+{
+    return count >= CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE ? count : RetransIndexBucketCount(count * 2);
+}
+
 class ReliableMessageMgr
 {
 public:
@@ -65,16 +78,22 @@ public:
         System::Clock::Timestamp nextRetransTime; /**< A counter representing the next retransmission time for the message. */
         uint8_t sendCount;                        /**< The number of times we have tried to send this entry,
                                                        including both successfully and failure send. */
+
+    private:
+        friend class ReliableMessageMgr;
+
+        size_t queueIndex;                  /**< Position of the entry in the retransmission queue. */
+        RetransTableEntry * nextInAckIndex; /**< The next entry in the same bucket of the ack index. */
     };
 
-    ReliableMessageMgr(ObjectPool<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> & contextPool);
+    ReliableMessageMgr();
     ~ReliableMessageMgr();
 
     void Init(chip::System::Layer * systemLayer);
     void Shutdown();
 
     /**
-     * Iterate through active exchange contexts and retrans table entries.  If an
+     * Send the standalone acks and the retransmissions that are due.  If an
      * action needs to be triggered by ReliableMessageProtocol time facilities,
      * execute that action.
      */
@@ -124,8 +143,7 @@ public:
     void StartRetransmision(RetransTableEntry * entry);
 
     /**
-     *  Iterate through active exchange contexts and retrans table entries. Clear the entry matching
-     *  the specified ExchangeContext and the message ID from the retransmision table.
+     *  Clear the entry matching the specified ExchangeContext and the message ID from the retransmision table.
      *
      *  @param[in]    rc                 A pointer to the ExchangeContext object.
      *  @param[in]    ackMessageCounter  The acknowledged message counter of the received packet.
@@ -160,10 +178,9 @@ public:
     void ClearRetransTable(RetransTableEntry & rEntry);
 
     /**
-     * Iterate through active exchange contexts and retrans table entries.
      * Determine how many ReliableMessageProtocol ticks we need to sleep before we
-     * need to physically wake the CPU to perform an action.  Set a timer to go off
-     * when we next need to wake the system.
+     * need to physically wake the CPU to send a pending ack or retransmit a message.
+     * Set a timer to go off when we next need to wake the system.
      *
      */
     void StartTimer();
@@ -195,6 +212,14 @@ public:
     // Functions for testing
     int TestGetCountRetransTable();
 
+    // Reschedule an entry of the retransmission table, and inspect the retransmission queue.
+    void TestSetNextRetransTime(RetransTableEntry & entry, System::Clock::Timestamp nextRetransTime)
+    {
+        SetNextRetransTime(entry, nextRetransTime);
+    }
+    RetransTableEntry * TestGetNextRetransTableEntry() { return (mRetransQueueSize > 0) ? mRetransQueue[0] : nullptr; }
+    bool TestIsRetransQueueOrdered();
+
     // Enumerate the retransmission table.  Clearing an entry while enumerating
     // that entry is allowed.  F must take a RetransTableEntry as an argument
     // and return Loop::Continue or Loop::Break.
@@ -206,24 +231,54 @@ public:
 #endif // CHIP_CONFIG_TEST
 
 private:
-    ObjectPool<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> & mContextPool;
+    friend class ReliableMessageContext;
+
     chip::System::Layer * mSystemLayer;
 
-    /* Placeholder function to run a function for all exchanges */
-    template <typename Function>
-    void ExecuteForAllContext(Function function)
+    void TicklessDebugDumpRetransTable(const char * log);
+
+    // Exchanges with a pending ack, which are usually few, are linked through the contexts themselves.
+    void AddToPendingAcks(ReliableMessageContext & rc);
+    void RemoveFromPendingAcks(ReliableMessageContext & rc);
+    static void PushToAckList(ReliableMessageContext *& list, ReliableMessageContext & rc);
+
+    // The retransmission queue is a binary min-heap of the entries ordered by nextRetransTime.
+    CHIP_ERROR ReserveRetransQueue();
+    void SetNextRetransTime(RetransTableEntry & entry, System::Clock::Timestamp nextRetransTime);
+    void SiftUp(size_t index);
+    void SiftDown(size_t index);
+    void PlaceInRetransQueue(RetransTableEntry & entry, size_t index);
+
+    // An exchange has at most one message in the table, so acks find their entry by exchange.
+    static constexpr size_t kAckIndexBucketCount = RetransIndexBucketCount();
+    static size_t AckIndexBucket(const ReliableMessageContext * rc)
     {
-        mContextPool.ForEachActiveObject([&](auto * ec) {
-            function(ec->GetReliableMessageContext());
-            return Loop::Continue;
-        });
+        uint64_t hash = reinterpret_cast<uintptr_t>(rc) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(hash >> 32) & (kAckIndexBucketCount - 1);
     }
+    RetransTableEntry * FindRetransTableEntry(const ReliableMessageContext * rc);
 
-    void TicklessDebugDumpRetransTable(const char * log);
+    /**
+     *  Remove an entry from the retransmission queue and the ack index, and release it, without rescheduling the timer.
+     */
+    void ReleaseRetransTableEntry(RetransTableEntry & entry);
 
     // ReliableMessageProtocol Global tables for timer context
     ObjectPool<RetransTableEntry, CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE> mRetransTable;
 
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    RetransTableEntry ** mRetransQueue = nullptr;
+    size_t mRetransQueueCapacity       = 0;
+#else
+    RetransTableEntry * mRetransQueue[CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE];
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    size_t mRetransQueueSize = 0;
+
+    RetransTableEntry * mAckIndex[kAckIndexBucketCount] = {};
+    ReliableMessageContext * mPendingAcks               = nullptr;
+    // Exchanges whose ack ExecuteActions() is about to send, off mPendingAcks meanwhile.
+    ReliableMessageContext * mDueAcks = nullptr;
+
     SessionUpdateDelegate * mSessionUpdateDelegate = nullptr;
 };
 
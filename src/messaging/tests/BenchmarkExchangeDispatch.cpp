@@ -0,0 +1,130 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Measures how long the ExchangeManager takes to dispatch a received message to its exchange while many exchanges
+ *      are open on the same session.  Messages are delivered as duplicates, so that the exchanges handle them without
+ *      closing or replying and only the dispatch itself is measured.
+ *
+ */
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <messaging/ExchangeContext.h>
+#include <messaging/ExchangeDelegate.h>
+#include <messaging/ExchangeMgr.h>
+#include <messaging/tests/MessagingContext.h>
+#include <protocols/echo/Echo.h>
+#include <transport/SessionMessageDelegate.h>
+
+#include <chrono>
+#include <stdarg.h>
+#include <stdio.h>
+#include <vector>
+
+using namespace chip;
+using namespace chip::Messaging;
+
+namespace {
+
+constexpr size_t kExchangeCounts[] = { 10, 100, 1000 };
+constexpr unsigned kIterations     = 100000;
+
+using BenchmarkClock = std::chrono::steady_clock;
+
+class IdleExchangeDelegate : public ExchangeDelegate
+{
+public:
+    CHIP_ERROR OnMessageReceived(ExchangeContext * ec, const PayloadHeader & payloadHeader,
+                                 System::PacketBufferHandle && buffer) override
+    {
+        return CHIP_NO_ERROR;
+    }
+
+    void OnResponseTimeout(ExchangeContext * ec) override {}
+};
+
+// Dispatch logs every message; keep it from writing to the console while measuring.
+void DiscardLog(const char * module, uint8_t category, const char * msg, va_list args) {}
+
+void RunScenario(Test::LoopbackMessagingContext & ctx, size_t exchangeCount)
+{
+    IdleExchangeDelegate delegate;
+    SessionHandle session = ctx.GetSessionCharlieToDavid();
+
+    std::vector<ExchangeContext *> exchanges(exchangeCount);
+    for (ExchangeContext *& ec : exchanges)
+    {
+        ec = ctx.GetExchangeManager().NewContext(session, &delegate);
+        VerifyOrDie(ec != nullptr);
+    }
+
+    PacketHeader packetHeader;
+    packetHeader.SetSessionId(Test::MessagingContext::kCharlieKeyId);
+
+    SessionMessageDelegate & dispatcher = ctx.GetExchangeManager();
+    BenchmarkClock::time_point start    = BenchmarkClock::now();
+    for (unsigned i = 0; i < kIterations; i++)
+    {
+        // The responses of the peer to the exchanges we initiated, in an order that does not follow the pool.
+        const ExchangeContext * ec = exchanges[(i * 7919u) % exchangeCount];
+
+        PayloadHeader payloadHeader;
+        payloadHeader.SetMessageType(Protocols::Echo::MsgType::EchoResponse);
+        payloadHeader.SetExchangeID(ec->GetExchangeId());
+        payloadHeader.SetInitiator(false);
+        packetHeader.SetMessageCounter(i);
+
+        System::PacketBufferHandle buffer = MessagePacketBuffer::New(0);
+        VerifyOrDie(!buffer.IsNull());
+        dispatcher.OnMessageReceived(packetHeader, payloadHeader, session, SessionMessageDelegate::DuplicateMessage::Yes,
+                                     std::move(buffer));
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(BenchmarkClock::now() - start);
+
+    printf("exchanges=%-5u dispatch=%8.1f ns/message\n", static_cast<unsigned>(exchangeCount),
+           static_cast<double>(elapsed.count()) / kIterations);
+
+    for (ExchangeContext * ec : exchanges)
+    {
+        ec->Close();
+    }
+    VerifyOrDie(ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+}
+
+} // namespace
+
+int main()
+{
+    // Only a PASE session is needed, which does not involve the Alice and Bob fabrics.
+    Test::LoopbackMessagingContext ctx;
+    ctx.ConfigInitializeNodes(false);
+    VerifyOrDie(ctx.Init() == CHIP_NO_ERROR);
+    VerifyOrDie(ctx.CreatePASESessionCharlieToDavid() == CHIP_NO_ERROR);
+
+    Logging::SetLogRedirectCallback(DiscardLog);
+    for (size_t exchangeCount : kExchangeCounts)
+    {
+        RunScenario(ctx, exchangeCount);
+    }
+    Logging::SetLogRedirectCallback(nullptr);
+
+    ctx.Shutdown();
+    return 0;
+}
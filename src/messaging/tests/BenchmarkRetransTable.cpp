@@ -0,0 +1,187 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Measures the ReliableMessageMgr while many messages wait for an acknowledgment: the cost of a timer tick, which
+ *      retransmits the messages that are due and reschedules the timer, and the cost of removing a message from the
+ *      retransmission table when its ack is received.  The messages are sent on a loopback transport that drops them,
+ *      and time is driven by a mock clock.
+ *
+ */
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <messaging/ExchangeContext.h>
+#include <messaging/ExchangeDelegate.h>
+#include <messaging/ExchangeMgr.h>
+#include <messaging/ReliableMessageMgr.h>
+#include <messaging/tests/MessagingContext.h>
+#include <protocols/echo/Echo.h>
+#include <system/SystemClock.h>
+
+#include <chrono>
+#include <stdarg.h>
+#include <stdio.h>
+#include <vector>
+
+using namespace chip;
+using namespace chip::Messaging;
+using namespace chip::System::Clock::Literals;
+
+namespace {
+
+constexpr size_t kMessageCounts[] = { 10, 100, 1000 };
+
+// Ticks of the retransmission timer before the first retransmission is due, when the timer only fires for pending acks,
+// then ticks spaced so that every message is retransmitted without running out of retries.
+constexpr unsigned kIdleTicks                            = 100;
+constexpr System::Clock::Milliseconds64 kIdleTickTime    = 1_ms64;
+constexpr unsigned kRetransTicks                         = 100;
+constexpr System::Clock::Milliseconds64 kRetransTickTime = 10_ms64;
+
+using BenchmarkClock = std::chrono::steady_clock;
+
+class IdleExchangeDelegate : public ExchangeDelegate
+{
+public:
+    CHIP_ERROR OnMessageReceived(ExchangeContext * ec, const PayloadHeader & payloadHeader,
+                                 System::PacketBufferHandle && buffer) override
+    {
+        return CHIP_NO_ERROR;
+    }
+
+    void OnResponseTimeout(ExchangeContext * ec) override {}
+};
+
+struct OutstandingMessage
+{
+    ReliableMessageContext * mContext;
+    uint32_t mMessageCounter;
+};
+
+// Every retransmission is logged; keep it from writing to the console while measuring.
+void DiscardLog(const char * module, uint8_t category, const char * msg, va_list args) {}
+
+double NanosecondsPerOperation(BenchmarkClock::time_point start, size_t operations)
+{
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(BenchmarkClock::now() - start).count()) /
+        static_cast<double>(operations);
+}
+
+void RunScenario(Test::LoopbackMessagingContext & ctx, System::Clock::Internal::MockClock & clock, const SessionHandle & session,
+                 size_t messageCount)
+{
+    IdleExchangeDelegate delegate;
+    ReliableMessageMgr * rm = ctx.GetExchangeManager().GetReliableMessageMgr();
+
+    std::vector<ExchangeContext *> exchanges(messageCount);
+    for (ExchangeContext *& ec : exchanges)
+    {
+        ec = ctx.GetExchangeManager().NewContext(session, &delegate);
+        VerifyOrDie(ec != nullptr);
+        VerifyOrDie(ec->SendMessage(Protocols::Echo::MsgType::EchoRequest, MessagePacketBuffer::New(0),
+                                    SendFlags(SendMessageFlags::kExpectResponse)) == CHIP_NO_ERROR);
+    }
+    VerifyOrDie(rm->TestGetCountRetransTable() == static_cast<int>(messageCount));
+
+    // Run the retransmission timer handler the way the system layer does when the timer fires.
+    uint32_t sent                    = ctx.GetLoopback().mDroppedMessageCount;
+    BenchmarkClock::time_point start = BenchmarkClock::now();
+    for (unsigned i = 0; i < kIdleTicks; i++)
+    {
+        clock.AdvanceMonotonic(kIdleTickTime);
+        rm->ExecuteActions();
+        rm->StartTimer();
+    }
+    double idleTickNs = NanosecondsPerOperation(start, kIdleTicks);
+    VerifyOrDie(ctx.GetLoopback().mDroppedMessageCount == sent);
+
+    start = BenchmarkClock::now();
+    for (unsigned i = 0; i < kRetransTicks; i++)
+    {
+        clock.AdvanceMonotonic(kRetransTickTime);
+        rm->ExecuteActions();
+        rm->StartTimer();
+    }
+    uint32_t retransmitted = ctx.GetLoopback().mDroppedMessageCount - sent;
+    VerifyOrDie(retransmitted >= messageCount && rm->TestGetCountRetransTable() == static_cast<int>(messageCount));
+    double retransmitNs = NanosecondsPerOperation(start, retransmitted);
+
+    // Acknowledge every message, in an order that does not follow the table.
+    std::vector<OutstandingMessage> outstanding;
+    rm->EnumerateRetransTable([&](auto * entry) {
+        outstanding.push_back({ entry->ec->GetReliableMessageContext(), entry->retainedBuf.GetMessageCounter() });
+        return Loop::Continue;
+    });
+
+    start = BenchmarkClock::now();
+    for (size_t i = 0; i < messageCount; i++)
+    {
+        const OutstandingMessage & message = outstanding[(i * 7919u) % messageCount];
+        VerifyOrDie(rm->CheckAndRemRetransTable(message.mContext, message.mMessageCounter));
+    }
+    double ackNs = NanosecondsPerOperation(start, messageCount);
+    VerifyOrDie(rm->TestGetCountRetransTable() == 0);
+
+    printf("messages=%-5u idle=%8.1f ns/tick  retransmit=%8.1f ns/message  ack=%8.1f ns/message\n",
+           static_cast<unsigned>(messageCount), idleTickNs, retransmitNs, ackNs);
+
+    for (ExchangeContext * ec : exchanges)
+    {
+        ec->Close();
+    }
+    VerifyOrDie(ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+}
+
+} // namespace
+
+int main()
+{
+    // Only a PASE session is needed, which does not involve the Alice and Bob fabrics.  MRP is only used with UDP peers.
+    Test::LoopbackMessagingContext ctx;
+    ctx.ConfigInitializeNodes(false);
+    VerifyOrDie(ctx.Init() == CHIP_NO_ERROR);
+
+    SessionHolder session;
+    VerifyOrDie(ctx.GetSecureSessionManager().InjectPaseSessionWithTestKey(
+                    session, Test::MessagingContext::kCharlieKeyId, 0xdeadbeef, Test::MessagingContext::kDavidKeyId,
+                    kUndefinedFabricIndex, Transport::PeerAddress::UDP(Test::MessagingContext::GetAddress(), CHIP_PORT),
+                    CryptoContext::SessionRole::kInitiator) == CHIP_NO_ERROR);
+
+    System::Clock::ClockBase & realClock = System::SystemClock();
+    System::Clock::Internal::MockClock clock;
+    clock.SetMonotonic(System::Clock::Milliseconds64(realClock.GetMonotonicMilliseconds64()));
+    System::Clock::Internal::SetSystemClockForTesting(&clock);
+
+    // Messages never reach the peer, so they stay in the retransmission table until they are acknowledged below.
+    ctx.GetLoopback().mNumMessagesToDrop = UINT32_MAX;
+
+    Logging::SetLogRedirectCallback(DiscardLog);
+    for (size_t messageCount : kMessageCounts)
+    {
+        RunScenario(ctx, clock, session.Get().Value(), messageCount);
+    }
+    Logging::SetLogRedirectCallback(nullptr);
+
+    ctx.GetLoopback().mNumMessagesToDrop = 0;
+    System::Clock::Internal::SetSystemClockForTesting(&realClock);
+    session.Release();
+    ctx.Shutdown();
+    return 0;
+}
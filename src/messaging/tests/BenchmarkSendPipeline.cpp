@@ -0,0 +1,174 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Measures the SessionManager send path for a secure session: encrypting a message and encoding its headers in
+ *      its buffer (PrepareMessage), handing it to the transport (SendPreparedMessage), and sending it again the way
+ *      retransmissions do.  Besides the time, it counts how often the payload had to be moved within its buffer to make
+ *      room for the headers, and how often the transport was handed a copy of the buffer rather than the buffer itself.
+ *      The messages are sent on a loopback transport that drops them.
+ *
+ */
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <messaging/tests/MessagingContext.h>
+#include <protocols/echo/Echo.h>
+#include <transport/SessionManager.h>
+
+#include <chrono>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+using namespace chip;
+
+namespace {
+
+constexpr size_t kPayloadSizes[] = { 0, 64, 256, 1024 };
+constexpr unsigned kIterations   = 10000;
+constexpr unsigned kRetransmits  = 3;
+
+using BenchmarkClock = std::chrono::steady_clock;
+
+struct PipelineCounters
+{
+    unsigned mPayloadMoves = 0;
+    unsigned mCopies       = 0;
+};
+
+// Every send is logged; keep it from writing to the console while measuring.
+void DiscardLog(const char * module, uint8_t category, const char * msg, va_list args) {}
+
+double NanosecondsPerOperation(BenchmarkClock::duration elapsed, size_t operations)
+{
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) /
+        static_cast<double>(operations);
+}
+
+// A reserved message leaves the default header reserve in front of the payload.  An unreserved one has the same room for
+// the headers, but after the payload instead of in front of it, as when a buffer is allocated without a reserve.
+System::PacketBufferHandle NewMessage(size_t payloadSize, bool reserved)
+{
+    constexpr size_t kHeaderRoom = CHIP_SYSTEM_CONFIG_HEADER_RESERVE_SIZE;
+
+    System::PacketBufferHandle buffer;
+    if (reserved)
+    {
+        buffer = MessagePacketBuffer::New(payloadSize);
+    }
+    else
+    {
+        buffer = System::PacketBufferHandle::New(payloadSize + MessagePacketBuffer::kMaxFooterSize + kHeaderRoom, 0);
+    }
+    VerifyOrDie(!buffer.IsNull());
+    memset(buffer->Start(), 0x5a, payloadSize);
+    buffer->SetDataLength(static_cast<uint16_t>(payloadSize));
+    return buffer;
+}
+
+void RunScenario(Test::LoopbackMessagingContext & ctx, const SessionHandle & session, size_t payloadSize, bool reserved)
+{
+    SessionManager & sessionManager = ctx.GetSecureSessionManager();
+    auto & loopback                 = ctx.GetLoopback();
+    PipelineCounters counters;
+    BenchmarkClock::duration sendTime{};
+    BenchmarkClock::duration retransmitTime{};
+
+    for (unsigned i = 0; i < kIterations; i++)
+    {
+        System::PacketBufferHandle message = NewMessage(payloadSize, reserved);
+        const uint8_t * payloadEnd         = message->Start() + message->DataLength();
+
+        PayloadHeader payloadHeader;
+        payloadHeader.SetMessageType(Protocols::Echo::MsgType::EchoRequest);
+        payloadHeader.SetExchangeID(static_cast<uint16_t>(i));
+        payloadHeader.SetInitiator(true);
+
+        EncryptedPacketBufferHandle prepared;
+        BenchmarkClock::time_point start = BenchmarkClock::now();
+        VerifyOrDie(sessionManager.PrepareMessage(session, payloadHeader, std::move(message), prepared) == CHIP_NO_ERROR);
+        VerifyOrDie(sessionManager.SendPreparedMessage(session, prepared) == CHIP_NO_ERROR);
+        sendTime += BenchmarkClock::now() - start;
+
+        // The payload is encrypted where it lies unless it had to be moved to make room for the headers, and the MIC follows
+        // it.
+        const uint8_t * preparedStart = prepared.CastToWritable()->Start();
+        const uint8_t * preparedEnd   = preparedStart + prepared.CastToWritable()->DataLength();
+        if (preparedEnd != payloadEnd + MessagePacketBuffer::kMaxFooterSize)
+        {
+            counters.mPayloadMoves++;
+        }
+        if (loopback.mLastSentMessageStart != preparedStart)
+        {
+            counters.mCopies++;
+        }
+
+        start = BenchmarkClock::now();
+        for (unsigned r = 0; r < kRetransmits; r++)
+        {
+            VerifyOrDie(sessionManager.SendPreparedMessage(session, prepared) == CHIP_NO_ERROR);
+        }
+        retransmitTime += BenchmarkClock::now() - start;
+        if (loopback.mLastSentMessageStart != preparedStart)
+        {
+            counters.mCopies++;
+        }
+    }
+
+    printf("payload=%-5u reserve=%-3s send=%8.1f ns/message  retransmit=%8.1f ns/message  payload moves=%.2f/message  "
+           "copies=%.2f/message\n",
+           static_cast<unsigned>(payloadSize), reserved ? "yes" : "no", NanosecondsPerOperation(sendTime, kIterations),
+           NanosecondsPerOperation(retransmitTime, kIterations * kRetransmits),
+           static_cast<double>(counters.mPayloadMoves) / kIterations, static_cast<double>(counters.mCopies) / kIterations);
+}
+
+} // namespace
+
+int main()
+{
+    // Only a PASE session is needed, which does not involve the Alice and Bob fabrics.
+    Test::LoopbackMessagingContext ctx;
+    ctx.ConfigInitializeNodes(false);
+    VerifyOrDie(ctx.Init() == CHIP_NO_ERROR);
+
+    SessionHolder session;
+    VerifyOrDie(ctx.GetSecureSessionManager().InjectPaseSessionWithTestKey(
+                    session, Test::MessagingContext::kCharlieKeyId, 0xdeadbeef, Test::MessagingContext::kDavidKeyId,
+                    kUndefinedFabricIndex, Transport::PeerAddress::UDP(Test::MessagingContext::GetAddress(), CHIP_PORT),
+                    CryptoContext::SessionRole::kInitiator) == CHIP_NO_ERROR);
+
+    // Messages never reach the peer; only the way down to the transport is measured.
+    ctx.GetLoopback().mNumMessagesToDrop = UINT32_MAX;
+
+    Logging::SetLogRedirectCallback(DiscardLog);
+    for (bool reserved : { true, false })
+    {
+        for (size_t payloadSize : kPayloadSizes)
+        {
+            RunScenario(ctx, session.Get().Value(), payloadSize, reserved);
+        }
+    }
+    Logging::SetLogRedirectCallback(nullptr);
+
+    ctx.GetLoopback().mNumMessagesToDrop = 0;
+    session.Release();
+    ctx.Shutdown();
+    return 0;
+}
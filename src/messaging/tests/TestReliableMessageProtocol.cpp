@@ -1685,6 +1685,202 @@ void CheckGetBackoff(nlTestSuite * inSuite, void * inContext)
     }
 }
 
+/**
+ * Sends kCount messages that are all dropped, so each one keeps an entry in the retransmission table, and checks that the
+ * retransmission queue stays ordered by retransmission time as entries are rescheduled and removed.
+ */
+void CheckRetransQueueOrder(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    constexpr size_t kCount = 8;
+
+    ReliableMessageMgr * rm = ctx.GetExchangeManager().GetReliableMessageMgr();
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 0);
+
+    // Keep the timer from retransmitting anything while entries are moved around.
+    System::Clock::ClockBase & realClock = System::SystemClock();
+    System::Clock::Internal::MockClock clock;
+    clock.SetMonotonic(realClock.GetMonotonicTimestamp());
+    System::Clock::Internal::SetSystemClockForTesting(&clock);
+
+    auto & loopback             = ctx.GetLoopback();
+    loopback.mNumMessagesToDrop = UINT32_MAX;
+
+    MockAppDelegate mockSender(ctx);
+    ExchangeContext * exchanges[kCount];
+    for (ExchangeContext *& exchange : exchanges)
+    {
+        exchange = ctx.NewExchangeToAlice(&mockSender);
+        NL_TEST_ASSERT(inSuite, exchange != nullptr);
+
+        chip::System::PacketBufferHandle buffer = chip::MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD));
+        NL_TEST_ASSERT(inSuite, !buffer.IsNull());
+        CHIP_ERROR err =
+            exchange->SendMessage(Echo::MsgType::EchoRequest, std::move(buffer), SendFlags(SendMessageFlags::kExpectResponse));
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == static_cast<int>(kCount));
+
+    ReliableMessageMgr::RetransTableEntry * entries[kCount] = {};
+    rm->EnumerateRetransTable([&](ReliableMessageMgr::RetransTableEntry * entry) {
+        for (size_t i = 0; i < kCount; i++)
+        {
+            if (entry->ec->GetReliableMessageContext() == exchanges[i]->GetReliableMessageContext())
+            {
+                entries[i] = entry;
+            }
+        }
+        return Loop::Continue;
+    });
+
+    // Schedule the entries out of order.
+    const System::Clock::Timestamp base = clock.GetMonotonicTimestamp() + 1000_ms64;
+    for (size_t i = 0; i < kCount; i++)
+    {
+        NL_TEST_ASSERT(inSuite, entries[i] != nullptr);
+        rm->TestSetNextRetransTime(*entries[i], base + System::Clock::Milliseconds64(((i * 5) % kCount) * 10));
+        NL_TEST_ASSERT(inSuite, rm->TestIsRetransQueueOrdered());
+    }
+    NL_TEST_ASSERT(inSuite, rm->TestGetNextRetransTableEntry() == entries[0]);
+
+    // Move the first entry last, and the last one first.
+    rm->TestSetNextRetransTime(*entries[0], base + 1000_ms64);
+    NL_TEST_ASSERT(inSuite, rm->TestIsRetransQueueOrdered());
+    NL_TEST_ASSERT(inSuite, rm->TestGetNextRetransTableEntry() != entries[0]);
+    rm->TestSetNextRetransTime(*entries[kCount - 1], base - 10_ms64);
+    NL_TEST_ASSERT(inSuite, rm->TestIsRetransQueueOrdered());
+    NL_TEST_ASSERT(inSuite, rm->TestGetNextRetransTableEntry() == entries[kCount - 1]);
+
+    // Remove entries from the middle of the queue.
+    rm->ClearRetransTable(*entries[3]);
+    NL_TEST_ASSERT(inSuite, rm->TestIsRetransQueueOrdered());
+    rm->ClearRetransTable(exchanges[5]->GetReliableMessageContext());
+    NL_TEST_ASSERT(inSuite, rm->TestIsRetransQueueOrdered());
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == static_cast<int>(kCount - 2));
+
+    // The remaining entries come out in retransmission time order.
+    System::Clock::Timestamp previous = System::Clock::kZero;
+    size_t remaining                  = kCount - 2;
+    while (ReliableMessageMgr::RetransTableEntry * entry = rm->TestGetNextRetransTableEntry())
+    {
+        NL_TEST_ASSERT(inSuite, entry->nextRetransTime >= previous);
+        previous = entry->nextRetransTime;
+        rm->ClearRetransTable(*entry);
+        NL_TEST_ASSERT(inSuite, rm->TestIsRetransQueueOrdered());
+        NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == static_cast<int>(--remaining));
+    }
+    NL_TEST_ASSERT(inSuite, remaining == 0);
+    NL_TEST_ASSERT(inSuite, previous == base + 1000_ms64);
+
+    for (ExchangeContext * exchange : exchanges)
+    {
+        exchange->Close();
+    }
+
+    loopback.mNumMessagesToDrop   = 0;
+    loopback.mDroppedMessageCount = 0;
+    System::Clock::Internal::SetSystemClockForTesting(&realClock);
+}
+
+class FlushAcksOnDrop : public Test::LoopbackTransportDelegate
+{
+public:
+    void OnMessageDropped() override
+    {
+        for (ExchangeContext * exchange : mExchanges)
+        {
+            (void) exchange->GetReliableMessageContext()->TakePendingPeerAckMessageCounter();
+        }
+    }
+
+    ExchangeContext * mExchanges[2] = {};
+};
+
+/**
+ * Checks that sending the standalone acks that are due copes with the sending of one ack flushing another one.
+ */
+void CheckPendingAckFlushedWhileSendingAcks(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    ReliableMessageMgr * rm = ctx.GetExchangeManager().GetReliableMessageMgr();
+
+    System::Clock::ClockBase & realClock = System::SystemClock();
+    System::Clock::Internal::MockClock clock;
+    clock.SetMonotonic(realClock.GetMonotonicTimestamp());
+    System::Clock::Internal::SetSystemClockForTesting(&clock);
+
+    MockAppDelegate requestReceiver(ctx);
+    MockAppDelegate responseReceiver(ctx);
+    requestReceiver.mRetainExchange  = true;
+    responseReceiver.mRetainExchange = true;
+
+    CHIP_ERROR err =
+        ctx.GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(Echo::MsgType::EchoRequest, &requestReceiver);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = ctx.GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(Echo::MsgType::EchoResponse, &responseReceiver);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    // Two exchanges each receive a message, and have to send a standalone ack for it.
+    MockAppDelegate mockSender(ctx);
+    ExchangeContext * exchanges[] = { ctx.NewExchangeToAlice(&mockSender), ctx.NewExchangeToAlice(&mockSender) };
+    const Echo::MsgType messageTypes[] = { Echo::MsgType::EchoRequest, Echo::MsgType::EchoResponse };
+    for (size_t i = 0; i < ArraySize(exchanges); i++)
+    {
+        NL_TEST_ASSERT(inSuite, exchanges[i] != nullptr);
+        chip::System::PacketBufferHandle buffer = chip::MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD));
+        NL_TEST_ASSERT(inSuite, !buffer.IsNull());
+        err = exchanges[i]->SendMessage(messageTypes[i], std::move(buffer), SendFlags(SendMessageFlags::kExpectResponse));
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    }
+    ctx.DrainAndServiceIO();
+
+    NL_TEST_ASSERT(inSuite, requestReceiver.mExchange != nullptr && responseReceiver.mExchange != nullptr);
+    NL_TEST_ASSERT(inSuite, requestReceiver.mExchange->GetReliableMessageContext()->IsAckPending());
+    NL_TEST_ASSERT(inSuite, responseReceiver.mExchange->GetReliableMessageContext()->IsAckPending());
+
+    // Dropping the first ack flushes the other one, which must then not be sent.
+    FlushAcksOnDrop flushAcks;
+    flushAcks.mExchanges[0] = requestReceiver.mExchange;
+    flushAcks.mExchanges[1] = responseReceiver.mExchange;
+
+    auto & loopback               = ctx.GetLoopback();
+    loopback.mSentMessageCount    = 0;
+    loopback.mDroppedMessageCount = 0;
+    loopback.mNumMessagesToDrop   = 1;
+    loopback.SetLoopbackTransportDelegate(&flushAcks);
+
+    clock.AdvanceMonotonic(CHIP_CONFIG_RMP_DEFAULT_ACK_TIMEOUT);
+    rm->ExecuteActions();
+
+    NL_TEST_ASSERT(inSuite, loopback.mSentMessageCount == 1);
+    NL_TEST_ASSERT(inSuite, loopback.mDroppedMessageCount == 1);
+    NL_TEST_ASSERT(inSuite, !requestReceiver.mExchange->GetReliableMessageContext()->IsAckPending());
+    NL_TEST_ASSERT(inSuite, !responseReceiver.mExchange->GetReliableMessageContext()->IsAckPending());
+
+    loopback.SetLoopbackTransportDelegate(nullptr);
+    loopback.Reset();
+
+    // The messages were never acknowledged.
+    for (ExchangeContext * exchange : exchanges)
+    {
+        rm->ClearRetransTable(exchange->GetReliableMessageContext());
+        exchange->Close();
+    }
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 0);
+
+    requestReceiver.CloseExchangeIfNeeded();
+    responseReceiver.CloseExchangeIfNeeded();
+    err = ctx.GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Echo::MsgType::EchoRequest);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = ctx.GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Echo::MsgType::EchoResponse);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    System::Clock::Internal::SetSystemClockForTesting(&realClock);
+    ctx.DrainAndServiceIO();
+}
+
 int InitializeTestCase(void * inContext)
 {
     TestContext & ctx = *static_cast<TestContext *>(inContext);
@@ -1734,6 +1930,8 @@ const nlTest sTests[] = {
     NL_TEST_DEF("Test that an application-level response-to-response after a lost standalone ack to the initial message works",
                 CheckLostStandaloneAck),
     NL_TEST_DEF("Test MRP backoff algorithm", CheckGetBackoff),
+    NL_TEST_DEF("Test that the retransmission queue stays ordered", CheckRetransQueueOrder),
+    NL_TEST_DEF("Test flushing a pending ack while sending the acks that are due", CheckPendingAckFlushedWhileSendingAcks),
     NL_TEST_SENTINEL(),
 };
 
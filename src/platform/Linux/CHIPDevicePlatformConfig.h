@@ -68,6 +68,24 @@
 #define CHIP_DEVICE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS 1
 #endif // CHIP_DEVICE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
 
+// Builds that set CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING to 1 run background work, such as the CASE certificate
+// validation and signatures, on a pool of CHIP_DEVICE_CONFIG_BG_THREAD_POOL_SIZE threads.  The queue of that work is sized
+// for a burst of handshakes.
+#ifndef CHIP_DEVICE_CONFIG_BG_MAX_EVENT_QUEUE_SIZE
+#define CHIP_DEVICE_CONFIG_BG_MAX_EVENT_QUEUE_SIZE 16
+#endif // CHIP_DEVICE_CONFIG_BG_MAX_EVENT_QUEUE_SIZE
+
+/**
+ * CHIP_DEVICE_CONFIG_KVS_WRITE_COALESCING_WINDOW_MS
+ *
+ * When non-zero, KVS writes are acknowledged once applied in memory and written to the KVS log at most this many milliseconds
+ * later, with all the writes to a key in that window collapsed into one.  Writes made in the window are lost if the process
+ * dies before they are flushed.  When zero, every KVS write reaches the KVS log before returning.
+ */
+#ifndef CHIP_DEVICE_CONFIG_KVS_WRITE_COALESCING_WINDOW_MS
+#define CHIP_DEVICE_CONFIG_KVS_WRITE_COALESCING_WINDOW_MS 0
+#endif // CHIP_DEVICE_CONFIG_KVS_WRITE_COALESCING_WINDOW_MS
+
 #define CHIP_DEVICE_CONFIG_ENABLE_WIFI_TELEMETRY 0
 #define CHIP_DEVICE_CONFIG_ENABLE_THREAD_TELEMETRY 0
 #define CHIP_DEVICE_CONFIG_ENABLE_THREAD_TELEMETRY_FULL 0
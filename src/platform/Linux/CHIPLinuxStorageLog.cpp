@@ -0,0 +1,599 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *          Implements the append-only log backed key value store of the Linux KVS.
+ *
+ *          Log format, all integers little endian:
+ *
+ *              magic      8 bytes, see kMagic
+ *              records    any number of:
+ *                  op         1 byte, kOpPut, kOpDelete or kOpBatch
+ *                  key length 2 bytes, 0 for kOpBatch
+ *                  value len  4 bytes, 0 for kOpDelete
+ *                  key        key length bytes
+ *                  value      value len bytes, the kOpPut and kOpDelete records of the batch for kOpBatch
+ *                  checksum   4 bytes, FNV-1a of all the previous fields of the record
+ *
+ *          Loading stops at the first truncated or corrupted record, which is how a write interrupted by a crash shows up.
+ *          A flush of several keys is written as a single kOpBatch record, so that it is either fully applied or not at all.
+ *
+ */
+
+#include <platform/Linux/CHIPLinuxStorageLog.h>
+
+#include <algorithm>
+#include <errno.h>
+#include <fcntl.h>
+#include <fstream>
+#include <iterator>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <lib/core/CHIPEncoding.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <platform/Linux/CHIPLinuxStorageIni.h>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+namespace {
+
+constexpr uint8_t kOpPut    = 1;
+constexpr uint8_t kOpDelete = 2;
+constexpr uint8_t kOpBatch  = 3;
+
+constexpr size_t kRecordHeaderSize   = 1 + 2 + 4;
+constexpr size_t kRecordChecksumSize = 4;
+
+uint32_t Checksum(const uint8_t * data, size_t length)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++)
+    {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+CHIP_ERROR WriteAll(int fd, const uint8_t * data, size_t length)
+{
+    while (length > 0)
+    {
+        ssize_t written = write(fd, data, length);
+        if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (written <= 0)
+        {
+            ChipLogError(DeviceLayer, "KVS log write failed: %s (%d)", strerror(errno), errno);
+            return CHIP_ERROR_WRITE_FAILED;
+        }
+        data += written;
+        length -= static_cast<size_t>(written);
+    }
+    return CHIP_NO_ERROR;
+}
+
+// Returns the size of the record at the start of data, or 0 if it is truncated or corrupted.
+size_t ParseRecord(const uint8_t * data, size_t length)
+{
+    VerifyOrReturnValue(length >= kRecordHeaderSize + kRecordChecksumSize, 0);
+
+    uint8_t op           = data[0];
+    uint16_t keyLength   = Encoding::LittleEndian::Get16(data + 1);
+    uint32_t valueLength = Encoding::LittleEndian::Get32(data + 3);
+    size_t payloadLength = kRecordHeaderSize + keyLength + valueLength;
+
+    VerifyOrReturnValue(length - kRecordChecksumSize >= payloadLength, 0);
+    VerifyOrReturnValue(op == kOpPut || op == kOpDelete || op == kOpBatch, 0);
+    VerifyOrReturnValue(Checksum(data, payloadLength) == Encoding::LittleEndian::Get32(data + payloadLength), 0);
+    return payloadLength + kRecordChecksumSize;
+}
+
+} // namespace
+
+constexpr uint8_t ChipLinuxStorageLog::kMagic[];
+
+ChipLinuxStorageLog::~ChipLinuxStorageLog()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    if (mFd != -1)
+    {
+        LogErrorOnFailure(FlushLocked());
+    }
+    CloseLog();
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Init(const char * path, bool coalesce)
+{
+    VerifyOrReturnError(path != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::lock_guard<std::mutex> lock(mLock);
+
+    ChipLogDetail(DeviceLayer, "ChipLinuxStorageLog::Init: Using KVS file: %s", path);
+    if (mFd != -1)
+    {
+        ChipLogError(DeviceLayer, "ChipLinuxStorageLog::Init: Attempt to re-initialize with KVS file: %s", path);
+        return CHIP_NO_ERROR;
+    }
+
+    mPath.assign(path);
+    mCoalesce = coalesce;
+    mValues.clear();
+    mPendingKeys.clear();
+
+    std::vector<uint8_t> contents;
+    std::ifstream ifs(mPath, std::ifstream::in | std::ifstream::binary);
+    if (ifs.is_open())
+    {
+        contents.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+        ifs.close();
+    }
+
+    if (contents.empty())
+    {
+        // Create the log.
+        return CompactLocked();
+    }
+
+    if (contents.size() < sizeof(kMagic) || memcmp(contents.data(), kMagic, sizeof(kMagic)) != 0)
+    {
+        return MigrateIni();
+    }
+
+    ReturnErrorOnFailure(Load(contents));
+    return OpenLog();
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Load(const std::vector<uint8_t> & contents)
+{
+    const uint8_t * data = contents.data();
+    size_t offset        = sizeof(kMagic);
+
+    while (offset < contents.size())
+    {
+        size_t recordLength = ParseRecord(data + offset, contents.size() - offset);
+        if (recordLength == 0 || !ApplyRecord(data + offset))
+        {
+            break;
+        }
+        offset += recordLength;
+    }
+
+    if (offset != contents.size())
+    {
+        ChipLogError(DeviceLayer, "KVS log %s has %u bytes of incomplete records, dropping them", mPath.c_str(),
+                     static_cast<unsigned>(contents.size() - offset));
+        if (truncate(mPath.c_str(), static_cast<off_t>(offset)) != 0)
+        {
+            ChipLogError(DeviceLayer, "failed to truncate (%s), %s (%d)", mPath.c_str(), strerror(errno), errno);
+            return CHIP_ERROR_WRITE_FAILED;
+        }
+    }
+
+    mLogSize  = offset;
+    mLiveSize = sizeof(kMagic);
+    for (const auto & entry : mValues)
+    {
+        mLiveSize += RecordSize(entry.first, entry.second.size());
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+bool ChipLinuxStorageLog::ApplyRecord(const uint8_t * record)
+{
+    uint8_t op            = record[0];
+    uint16_t keyLength    = Encoding::LittleEndian::Get16(record + 1);
+    uint32_t valueLength  = Encoding::LittleEndian::Get32(record + 3);
+    const uint8_t * value = record + kRecordHeaderSize + keyLength;
+
+    if (op == kOpBatch)
+    {
+        // Check the whole batch before applying any of it.
+        size_t length = 0;
+        for (size_t offset = 0; offset < valueLength; offset += length)
+        {
+            length = ParseRecord(value + offset, valueLength - offset);
+            VerifyOrReturnValue(length != 0 && value[offset] != kOpBatch, false);
+        }
+        for (size_t offset = 0; offset < valueLength; offset += ParseRecord(value + offset, valueLength - offset))
+        {
+            ApplyRecord(value + offset);
+        }
+        return true;
+    }
+
+    std::string key(reinterpret_cast<const char *>(record + kRecordHeaderSize), keyLength);
+    if (op == kOpPut)
+    {
+        mValues[key].assign(value, value + valueLength);
+    }
+    else
+    {
+        mValues.erase(key);
+    }
+    return true;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::MigrateIni()
+{
+    ChipLinuxStorageIni ini;
+    std::vector<std::string> keys;
+
+    ReturnErrorOnFailure(ini.Init());
+    ReturnErrorOnFailure(ini.AddConfig(mPath));
+
+    CHIP_ERROR err = ini.GetKeys(keys);
+    VerifyOrReturnError(err == CHIP_NO_ERROR || err == CHIP_ERROR_KEY_NOT_FOUND, err);
+
+    for (const auto & key : keys)
+    {
+        // Every value of the KVS was stored as a base64 encoded blob.
+        size_t valueLength = 0;
+        err                = ini.GetBinaryBlobValue(key.c_str(), nullptr, 0, valueLength);
+        VerifyOrReturnError(err == CHIP_NO_ERROR || err == CHIP_ERROR_BUFFER_TOO_SMALL, err);
+
+        std::vector<uint8_t> & value = mValues[key];
+        value.resize(valueLength);
+        ReturnErrorOnFailure(ini.GetBinaryBlobValue(key.c_str(), value.data(), value.size(), valueLength));
+        value.resize(valueLength);
+    }
+
+    ChipLogProgress(DeviceLayer, "Migrating %u keys of %s from the INI format", static_cast<unsigned>(mValues.size()),
+                    mPath.c_str());
+
+    // Compaction writes the whole store to a new file and atomically renames it over the INI file.
+    return CompactLocked();
+}
+
+CHIP_ERROR ChipLinuxStorageLog::OpenLog()
+{
+    CloseLog();
+
+    mFd = open(mPath.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC);
+    if (mFd == -1)
+    {
+        ChipLogError(DeviceLayer, "failed to open KVS log (%s), %s (%d)", mPath.c_str(), strerror(errno), errno);
+        return CHIP_ERROR_OPEN_FAILED;
+    }
+    return CHIP_NO_ERROR;
+}
+
+void ChipLinuxStorageLog::CloseLog()
+{
+    if (mFd != -1)
+    {
+        close(mFd);
+        mFd = -1;
+    }
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Get(const char * key, void * value, size_t value_size, size_t * read_bytes_size, size_t offset)
+{
+    VerifyOrReturnError(key != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(value != nullptr || value_size == 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::lock_guard<std::mutex> lock(mLock);
+
+    auto it = mValues.find(key);
+    VerifyOrReturnError(it != mValues.end(), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+
+    const std::vector<uint8_t> & stored = it->second;
+    VerifyOrReturnError(offset <= stored.size(), CHIP_ERROR_INVALID_ARGUMENT);
+
+    size_t total_size_to_read = stored.size() - offset;
+    size_t copy_size          = std::min(value_size, total_size_to_read);
+    if (read_bytes_size != nullptr)
+    {
+        *read_bytes_size = copy_size;
+    }
+    if (copy_size > 0)
+    {
+        memcpy(value, stored.data() + offset, copy_size);
+    }
+
+    return (value_size < total_size_to_read) ? CHIP_ERROR_BUFFER_TOO_SMALL : CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Put(const char * key, const void * value, size_t value_size)
+{
+    VerifyOrReturnError(key != nullptr && strlen(key) <= UINT16_MAX, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(value != nullptr || value_size == 0, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(value_size <= UINT32_MAX - UINT16_MAX - kRecordHeaderSize, CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::lock_guard<std::mutex> lock(mLock);
+    VerifyOrReturnError(mFd != -1, CHIP_ERROR_INCORRECT_STATE);
+
+    std::string keyString(key);
+    if (mBatchDepth > 0)
+    {
+        SaveUndoLocked(keyString);
+    }
+
+    auto it = mValues.find(keyString);
+    if (it != mValues.end())
+    {
+        mLiveSize -= RecordSize(keyString, it->second.size());
+    }
+    else
+    {
+        it = mValues.emplace(keyString, std::vector<uint8_t>()).first;
+    }
+
+    const uint8_t * bytes = static_cast<const uint8_t *>(value);
+    it->second.assign(bytes, bytes + value_size);
+    mLiveSize += RecordSize(keyString, value_size);
+    mPendingKeys.insert(keyString);
+
+    return (mCoalesce || mBatchDepth > 0) ? CHIP_NO_ERROR : FlushLocked();
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Delete(const char * key)
+{
+    VerifyOrReturnError(key != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::lock_guard<std::mutex> lock(mLock);
+    VerifyOrReturnError(mFd != -1, CHIP_ERROR_INCORRECT_STATE);
+
+    auto it = mValues.find(key);
+    VerifyOrReturnError(it != mValues.end(), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+
+    if (mBatchDepth > 0)
+    {
+        SaveUndoLocked(it->first);
+    }
+
+    mLiveSize -= RecordSize(it->first, it->second.size());
+    mPendingKeys.insert(it->first);
+    mValues.erase(it);
+
+    return (mCoalesce || mBatchDepth > 0) ? CHIP_NO_ERROR : FlushLocked();
+}
+
+CHIP_ERROR ChipLinuxStorageLog::BeginBatch()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    VerifyOrReturnError(mFd != -1, CHIP_ERROR_INCORRECT_STATE);
+
+    mBatchDepth++;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::CommitBatch()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    VerifyOrReturnError(mBatchDepth > 0, CHIP_ERROR_INCORRECT_STATE);
+
+    VerifyOrReturnError(--mBatchDepth == 0, CHIP_NO_ERROR);
+    if (mBatchAborted)
+    {
+        RollbackLocked();
+        return CHIP_ERROR_TRANSACTION_CANCELED;
+    }
+
+    mBatchUndo.clear();
+    return mCoalesce ? CHIP_NO_ERROR : FlushLocked();
+}
+
+void ChipLinuxStorageLog::AbortBatch()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    VerifyOrReturn(mBatchDepth > 0);
+
+    // Aborting a nested batch discards the outermost one, when it ends.
+    mBatchAborted = true;
+    if (--mBatchDepth == 0)
+    {
+        RollbackLocked();
+    }
+}
+
+void ChipLinuxStorageLog::SaveUndoLocked(const std::string & key)
+{
+    VerifyOrReturn(mBatchUndo.find(key) == mBatchUndo.end());
+
+    UndoEntry & undo = mBatchUndo[key];
+    auto it          = mValues.find(key);
+    undo.present     = (it != mValues.end());
+    undo.pending     = (mPendingKeys.count(key) != 0);
+    if (undo.present)
+    {
+        undo.value = it->second;
+    }
+}
+
+void ChipLinuxStorageLog::RollbackLocked()
+{
+    for (auto & entry : mBatchUndo)
+    {
+        const std::string & key = entry.first;
+        UndoEntry & undo        = entry.second;
+
+        auto it = mValues.find(key);
+        if (it != mValues.end())
+        {
+            mLiveSize -= RecordSize(key, it->second.size());
+            mValues.erase(it);
+        }
+        if (undo.present)
+        {
+            mLiveSize += RecordSize(key, undo.value.size());
+            mValues.emplace(key, std::move(undo.value));
+        }
+        if (!undo.pending)
+        {
+            mPendingKeys.erase(key);
+        }
+    }
+
+    mBatchUndo.clear();
+    mBatchAborted = false;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Flush()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    VerifyOrReturnError(mFd != -1, CHIP_ERROR_INCORRECT_STATE);
+    return FlushLocked();
+}
+
+bool ChipLinuxStorageLog::HasPendingWrites()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    return !mPendingKeys.empty();
+}
+
+CHIP_ERROR ChipLinuxStorageLog::FlushLocked()
+{
+    // The writes of a batch are only written once it is committed.
+    VerifyOrReturnError(mBatchDepth == 0, CHIP_NO_ERROR);
+
+    if (!mPendingKeys.empty())
+    {
+        std::vector<uint8_t> records;
+        for (const auto & key : mPendingKeys)
+        {
+            auto it = mValues.find(key);
+            if (it != mValues.end())
+            {
+                EncodeRecord(records, kOpPut, key, it->second.data(), it->second.size());
+            }
+            else
+            {
+                EncodeRecord(records, kOpDelete, key, nullptr, 0);
+            }
+        }
+
+        if (mPendingKeys.size() > 1)
+        {
+            std::vector<uint8_t> batch;
+            EncodeRecord(batch, kOpBatch, std::string(), records.data(), records.size());
+            records.swap(batch);
+        }
+
+        // Keep the keys pending on failure, so that the next flush writes them again.
+        ReturnErrorOnFailure(AppendLocked(records));
+        mPendingKeys.clear();
+    }
+
+    if (mLogSize > kMinCompactionSize && mLogSize / 2 > mLiveSize)
+    {
+        return CompactLocked();
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::AppendLocked(const std::vector<uint8_t> & records)
+{
+    CHIP_ERROR err = WriteAll(mFd, records.data(), records.size());
+    if (err != CHIP_NO_ERROR)
+    {
+        // Drop any partially written record, so that later records are not hidden behind it when loading.
+        if (ftruncate(mFd, static_cast<off_t>(mLogSize)) != 0)
+        {
+            ChipLogError(DeviceLayer, "failed to truncate (%s), %s (%d)", mPath.c_str(), strerror(errno), errno);
+        }
+        return err;
+    }
+
+    mLogSize += records.size();
+    return CHIP_NO_ERROR;
+}
+
+// Same approach as ChipLinuxStorageIni::CommitConfig: write the store to a temporary file and rename it over the log.
+CHIP_ERROR ChipLinuxStorageLog::CompactLocked()
+{
+    std::vector<uint8_t> contents(kMagic, kMagic + sizeof(kMagic));
+    contents.reserve(mLiveSize);
+    for (const auto & entry : mValues)
+    {
+        EncodeRecord(contents, kOpPut, entry.first, entry.second.data(), entry.second.size());
+    }
+
+    std::string tmpPath = mPath + "-XXXXXX";
+    int fd              = mkstemp(&tmpPath[0]);
+    if (fd == -1)
+    {
+        ChipLogError(DeviceLayer, "failed to open file (%s) for writing", tmpPath.c_str());
+        return CHIP_ERROR_OPEN_FAILED;
+    }
+
+    CHIP_ERROR err = WriteAll(fd, contents.data(), contents.size());
+    if (err == CHIP_NO_ERROR && fsync(fd) != 0)
+    {
+        err = CHIP_ERROR_WRITE_FAILED;
+    }
+    close(fd);
+
+    if (err == CHIP_NO_ERROR && rename(tmpPath.c_str(), mPath.c_str()) != 0)
+    {
+        ChipLogError(DeviceLayer, "failed to rename (%s), %s (%d)", tmpPath.c_str(), strerror(errno), errno);
+        err = CHIP_ERROR_WRITE_FAILED;
+    }
+    if (err != CHIP_NO_ERROR)
+    {
+        unlink(tmpPath.c_str());
+        return err;
+    }
+
+    ChipLogProgress(DeviceLayer, "compacted KVS log (%s) from %u to %u bytes", mPath.c_str(), static_cast<unsigned>(mLogSize),
+                    static_cast<unsigned>(contents.size()));
+
+    mLogSize  = contents.size();
+    mLiveSize = contents.size();
+    mPendingKeys.clear();
+
+    // The log file has been replaced, append to the new one.
+    return OpenLog();
+}
+
+size_t ChipLinuxStorageLog::RecordSize(const std::string & key, size_t valueSize)
+{
+    return kRecordHeaderSize + key.size() + valueSize + kRecordChecksumSize;
+}
+
+void ChipLinuxStorageLog::EncodeRecord(std::vector<uint8_t> & out, uint8_t op, const std::string & key, const uint8_t * value,
+                                       size_t valueSize)
+{
+    size_t start = out.size();
+    out.resize(start + RecordSize(key, valueSize));
+
+    uint8_t * record = out.data() + start;
+    record[0]        = op;
+    Encoding::LittleEndian::Put16(record + 1, static_cast<uint16_t>(key.size()));
+    Encoding::LittleEndian::Put32(record + 3, static_cast<uint32_t>(valueSize));
+    memcpy(record + kRecordHeaderSize, key.data(), key.size());
+    if (valueSize > 0)
+    {
+        memcpy(record + kRecordHeaderSize + key.size(), value, valueSize);
+    }
+
+    size_t payloadLength = kRecordHeaderSize + key.size() + valueSize;
+    Encoding::LittleEndian::Put32(record + payloadLength, Checksum(record, payloadLength));
+}
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
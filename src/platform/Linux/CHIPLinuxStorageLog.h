@@ -0,0 +1,147 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *         Provides an append-only log backed key value store for the Linux KVS.
+ *
+ *         The whole store is kept in memory.  Every change is appended to the log file as a self-checking record, so a write
+ *         costs I/O proportional to the size of the value instead of the size of the store.  The log is compacted, by
+ *         rewriting the live records to a temporary file and renaming it over the log, once it holds mostly stale records.
+ *
+ *         Writes can be grouped in batches, which are written as a single record when committed and can be aborted.
+ *
+ *         On Init, a file in the legacy INI format written by ChipLinuxStorage is migrated in place.
+ *
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+
+#include <map>
+#include <mutex>
+#include <set>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+class ChipLinuxStorageLog
+{
+public:
+    ChipLinuxStorageLog() = default;
+    ~ChipLinuxStorageLog();
+
+    ChipLinuxStorageLog(const ChipLinuxStorageLog &) = delete;
+    ChipLinuxStorageLog & operator=(const ChipLinuxStorageLog &) = delete;
+
+    /**
+     * Load the store from the given file, creating it if needed and migrating it if it is in the legacy INI format.
+     *
+     * @param coalesce  When true, Put and Delete only update the in-memory store and the changes are written on the next
+     *                  call to Flush().  Several writes to the same key in between result in a single record.
+     */
+    CHIP_ERROR Init(const char * path, bool coalesce = false);
+
+    /**
+     * Same semantics as KeyValueStoreManager::Get, except that value may only be null when value_size is 0.
+     */
+    CHIP_ERROR Get(const char * key, void * value, size_t value_size, size_t * read_bytes_size, size_t offset);
+    CHIP_ERROR Put(const char * key, const void * value, size_t value_size);
+    CHIP_ERROR Delete(const char * key);
+
+    /**
+     * Batch the following Put and Delete calls, see PersistentStorageDelegate::BeginBatch().  Their changes are visible to
+     * Get right away but are only written, atomically, once the outermost batch is committed and flushed.  Aborting
+     * restores the values the keys had when the outermost batch began.
+     *
+     * The log keeps a single batch and undo journal for all of its callers: a batch begun while another is open joins
+     * it, so batches must nest rather than interleave, and aborting any of them discards the whole outermost batch.
+     * KvsPersistentStorageDelegate checks that the batches of its instances nest.
+     */
+    CHIP_ERROR BeginBatch();
+    CHIP_ERROR CommitBatch();
+    void AbortBatch();
+
+    /**
+     * Write the changes made since the last flush, and compact the log if it has grown too much.
+     */
+    CHIP_ERROR Flush();
+
+    /**
+     * Returns whether some changes have not been written yet.  Only ever true when coalescing.
+     */
+    bool HasPendingWrites();
+
+    /**
+     * Size of the log file, and size the log would have once compacted.
+     */
+    size_t LogSize() const { return mLogSize; }
+    size_t LiveSize() const { return mLiveSize; }
+
+private:
+    // Log files start with this magic, which cannot start a legacy INI file.
+    static constexpr uint8_t kMagic[] = { 0x00, 'C', 'K', 'V', 'L', 'O', 'G', 0x01 };
+
+    // Compaction is only considered once the log is larger than this.
+    static constexpr size_t kMinCompactionSize = 16 * 1024;
+
+    // Value of a key before the current batch changed it.
+    struct UndoEntry
+    {
+        bool present;
+        bool pending;
+        std::vector<uint8_t> value;
+    };
+
+    CHIP_ERROR Load(const std::vector<uint8_t> & contents);
+    bool ApplyRecord(const uint8_t * record);
+    CHIP_ERROR MigrateIni();
+    CHIP_ERROR OpenLog();
+    CHIP_ERROR AppendLocked(const std::vector<uint8_t> & records);
+    CHIP_ERROR CompactLocked();
+    CHIP_ERROR FlushLocked();
+    void CloseLog();
+    void SaveUndoLocked(const std::string & key);
+    void RollbackLocked();
+
+    static size_t RecordSize(const std::string & key, size_t valueSize);
+    static void EncodeRecord(std::vector<uint8_t> & out, uint8_t op, const std::string & key, const uint8_t * value,
+                             size_t valueSize);
+
+    std::mutex mLock;
+    std::map<std::string, std::vector<uint8_t>> mValues;
+    std::set<std::string> mPendingKeys;
+    std::map<std::string, UndoEntry> mBatchUndo;
+    std::string mPath;
+    int mFd          = -1;
+    size_t mLogSize  = 0;
+    size_t mLiveSize = 0;
+    unsigned mBatchDepth = 0;
+    bool mCoalesce       = false;
+    bool mBatchAborted   = false;
+};
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
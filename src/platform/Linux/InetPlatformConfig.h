@@ -46,3 +46,8 @@
 
 // On linux platform, we have sys/socket.h, so HAVE_SO_BINDTODEVICE should be set to 1
 #define HAVE_SO_BINDTODEVICE 1
+
+// Linux has sendmmsg() and recvmmsg().
+#ifndef INET_CONFIG_UDP_SOCKET_MMSG
+#define INET_CONFIG_UDP_SOCKET_MMSG 1
+#endif // INET_CONFIG_UDP_SOCKET_MMSG
@@ -23,12 +23,9 @@
 
 #include <platform/KeyValueStoreManager.h>
 
-#include <algorithm>
-#include <string.h>
-
 #include <lib/support/CodeUtils.h>
 #include <lib/support/logging/CHIPLogging.h>
-#include <platform/Linux/CHIPLinuxStorage.h>
+#include <platform/CHIPDeviceLayer.h>
 
 namespace chip {
 namespace DeviceLayer {
@@ -39,75 +36,77 @@ KeyValueStoreManagerImpl KeyValueStoreManagerImpl::sInstance;
 CHIP_ERROR KeyValueStoreManagerImpl::_Get(const char * key, void * value, size_t value_size, size_t * read_bytes_size,
                                           size_t offset_bytes)
 {
-    size_t read_size;
-
-    // Copy data into value buffer
     VerifyOrReturnError(value != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
 
-    // On linux read first without a buffer which returns the size, and then
-    // use a local buffer to read the entire object, which allows partial and
-    // offset reads.
-    CHIP_ERROR err = mStorage.ReadValueBin(key, nullptr, 0, read_size);
-    if (err == CHIP_ERROR_KEY_NOT_FOUND)
-    {
-        return CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND;
-    }
-    if ((err != CHIP_NO_ERROR) && (err != CHIP_ERROR_BUFFER_TOO_SMALL))
-    {
-        return err;
-    }
-    if (offset_bytes > read_size)
-    {
-        return CHIP_ERROR_INVALID_ARGUMENT;
-    }
-
-    Platform::ScopedMemoryBuffer<uint8_t> buf;
-    VerifyOrReturnError(buf.Alloc(read_size), CHIP_ERROR_NO_MEMORY);
-    ReturnErrorOnFailure(mStorage.ReadValueBin(key, buf.Get(), read_size, read_size));
-
-    size_t total_size_to_read = read_size - offset_bytes;
-    size_t copy_size          = std::min(value_size, total_size_to_read);
-    if (read_bytes_size != nullptr)
-    {
-        *read_bytes_size = copy_size;
-    }
-    ::memcpy(value, buf.Get() + offset_bytes, copy_size);
-
-    return (value_size < total_size_to_read) ? CHIP_ERROR_BUFFER_TOO_SMALL : CHIP_NO_ERROR;
+    return mStorage.Get(key, value, value_size, read_bytes_size, offset_bytes);
 }
 
 CHIP_ERROR KeyValueStoreManagerImpl::_Put(const char * key, const void * value, size_t value_size)
 {
-    CHIP_ERROR err = CHIP_NO_ERROR;
+    ReturnErrorOnFailure(mStorage.Put(key, value, value_size));
+    ScheduleFlush();
+    return CHIP_NO_ERROR;
+}
 
-    err = mStorage.WriteValueBin(key, reinterpret_cast<const uint8_t *>(value), value_size);
-    SuccessOrExit(err);
+CHIP_ERROR KeyValueStoreManagerImpl::_Delete(const char * key)
+{
+    ReturnErrorOnFailure(mStorage.Delete(key));
+    ScheduleFlush();
+    return CHIP_NO_ERROR;
+}
 
-    // Commit the value to the persistent store.
-    err = mStorage.Commit();
-    SuccessOrExit(err);
+CHIP_ERROR KeyValueStoreManagerImpl::_CommitBatch()
+{
+    ReturnErrorOnFailure(mStorage.CommitBatch());
+    // A flush that ran during the batch skipped its writes.
+    ScheduleFlush();
+    return CHIP_NO_ERROR;
+}
 
-exit:
-    return err;
+CHIP_ERROR KeyValueStoreManagerImpl::Flush()
+{
+    VerifyOrReturnError(mStorage.HasPendingWrites(), CHIP_NO_ERROR);
+    return mStorage.Flush();
 }
 
-CHIP_ERROR KeyValueStoreManagerImpl::_Delete(const char * key)
+void KeyValueStoreManagerImpl::ScheduleFlush()
 {
-    CHIP_ERROR err = CHIP_NO_ERROR;
-    err            = mStorage.ClearValue(key);
+#if CHIP_DEVICE_CONFIG_KVS_WRITE_COALESCING_WINDOW_MS > 0
+    VerifyOrReturn(!mFlushScheduled.exchange(true));
 
-    if (err == CHIP_ERROR_KEY_NOT_FOUND)
+    // The KVS can be used from any thread, so hop to the CHIP thread to arm the timer.
+    if (PlatformMgr().ScheduleWork(StartFlushTimer, reinterpret_cast<intptr_t>(this)) != CHIP_NO_ERROR)
     {
-        ExitNow(err = CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+        // No event loop to flush from, write through instead.
+        mFlushScheduled = false;
+        LogErrorOnFailure(Flush());
     }
-    SuccessOrExit(err);
+#endif // CHIP_DEVICE_CONFIG_KVS_WRITE_COALESCING_WINDOW_MS > 0
+}
 
-    // Commit the value to the persistent store.
-    err = mStorage.Commit();
-    SuccessOrExit(err);
+void KeyValueStoreManagerImpl::StartFlushTimer(intptr_t context)
+{
+    auto * self    = reinterpret_cast<KeyValueStoreManagerImpl *>(context);
+    CHIP_ERROR err = DeviceLayer::SystemLayer().StartTimer(
+        System::Clock::Milliseconds32(CHIP_DEVICE_CONFIG_KVS_WRITE_COALESCING_WINDOW_MS), OnFlushTimer, self);
+    if (err != CHIP_NO_ERROR)
+    {
+        OnFlushTimer(nullptr, self);
+    }
+}
+
+void KeyValueStoreManagerImpl::OnFlushTimer(System::Layer * layer, void * context)
+{
+    auto * self = static_cast<KeyValueStoreManagerImpl *>(context);
 
-exit:
-    return err;
+    // Clear the flag first: a write racing with the flush either is part of it or schedules the next one.
+    self->mFlushScheduled = false;
+
+    CHIP_ERROR err = self->Flush();
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DeviceLayer, "Failed to flush the KVS: %" CHIP_ERROR_FORMAT, err.Format());
+    }
 }
 
 } // namespace PersistedStorage
@@ -23,7 +23,11 @@
 
 #pragma once
 
-#include <platform/Linux/CHIPLinuxStorage.h>
+#include <platform/CHIPDeviceConfig.h>
+#include <platform/Linux/CHIPLinuxStorageLog.h>
+#include <system/SystemLayer.h>
+
+#include <atomic>
 
 namespace chip {
 namespace DeviceLayer {
@@ -35,15 +39,35 @@ public:
     /**
      * @brief
      * Initalize the KVS, must be called before using.
+     *
+     * A file written by the former INI based implementation is converted to the KVS log format.
      */
-    CHIP_ERROR Init(const char * file) { return mStorage.Init(file); }
+    CHIP_ERROR Init(const char * file)
+    {
+        return mStorage.Init(file, CHIP_DEVICE_CONFIG_KVS_WRITE_COALESCING_WINDOW_MS > 0 /* coalesce */);
+    }
 
     CHIP_ERROR _Get(const char * key, void * value, size_t value_size, size_t * read_bytes_size = nullptr, size_t offset = 0);
     CHIP_ERROR _Delete(const char * key);
     CHIP_ERROR _Put(const char * key, const void * value, size_t value_size);
 
+    CHIP_ERROR _BeginBatch() { return mStorage.BeginBatch(); }
+    CHIP_ERROR _CommitBatch();
+    void _AbortBatch() { mStorage.AbortBatch(); }
+
+    /**
+     * @brief
+     * Write the changes still held by the write coalescing window, see CHIP_DEVICE_CONFIG_KVS_WRITE_COALESCING_WINDOW_MS.
+     */
+    CHIP_ERROR Flush();
+
 private:
-    DeviceLayer::Internal::ChipLinuxStorage mStorage;
+    void ScheduleFlush();
+    static void StartFlushTimer(intptr_t context);
+    static void OnFlushTimer(System::Layer * layer, void * context);
+
+    DeviceLayer::Internal::ChipLinuxStorageLog mStorage;
+    std::atomic<bool> mFlushScheduled{ false };
 
     // ===== Members for internal use by the following friends.
     friend KeyValueStoreManager & KeyValueStoreMgr();
@@ -0,0 +1,343 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the append-only log backing the Linux KVS.
+ *
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <unistd.h>
+
+#include <lib/support/CHIPMem.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <platform/Linux/CHIPLinuxStorage.h>
+#include <platform/Linux/CHIPLinuxStorageLog.h>
+
+#include <nlunit-test.h>
+
+using namespace chip;
+using namespace chip::DeviceLayer::Internal;
+
+namespace {
+
+class TemporaryFile
+{
+public:
+    TemporaryFile()
+    {
+        char path[] = "/tmp/chip_kvs_log_test-XXXXXX";
+        int fd      = mkstemp(path);
+        if (fd != -1)
+        {
+            close(fd);
+        }
+        mPath = path;
+    }
+    ~TemporaryFile() { unlink(mPath.c_str()); }
+
+    const char * Path() const { return mPath.c_str(); }
+
+private:
+    std::string mPath;
+};
+
+bool HasValue(ChipLinuxStorageLog & storage, const char * key, const char * expected)
+{
+    char value[64];
+    size_t readSize = 0;
+    return storage.Get(key, value, sizeof(value), &readSize, 0) == CHIP_NO_ERROR && readSize == strlen(expected) &&
+        memcmp(value, expected, readSize) == 0;
+}
+
+bool IsMissing(ChipLinuxStorageLog & storage, const char * key)
+{
+    char value[64];
+    return storage.Get(key, value, sizeof(value), nullptr, 0) == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND;
+}
+
+void TestPersistence(nlTestSuite * inSuite, void * inContext)
+{
+    TemporaryFile file;
+
+    {
+        ChipLinuxStorageLog storage;
+        NL_TEST_ASSERT(inSuite, storage.Init(file.Path()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Put("a", "first", 5) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Put("b", "second", 6) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Put("a", "third", 5) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Put("empty", nullptr, 0) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Delete("b") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Delete("b") == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+
+        // Partial and offset reads.
+        char value[2];
+        size_t readSize = 0;
+        NL_TEST_ASSERT(inSuite, storage.Get("a", value, sizeof(value), &readSize, 1) == CHIP_ERROR_BUFFER_TOO_SMALL);
+        NL_TEST_ASSERT(inSuite, readSize == 2 && memcmp(value, "hi", 2) == 0);
+        NL_TEST_ASSERT(inSuite, storage.Get("a", value, sizeof(value), &readSize, 6) == CHIP_ERROR_INVALID_ARGUMENT);
+    }
+
+    ChipLinuxStorageLog storage;
+    NL_TEST_ASSERT(inSuite, storage.Init(file.Path()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, HasValue(storage, "a", "third"));
+    NL_TEST_ASSERT(inSuite, HasValue(storage, "empty", ""));
+    NL_TEST_ASSERT(inSuite, IsMissing(storage, "b"));
+    NL_TEST_ASSERT(inSuite, storage.LiveSize() < storage.LogSize());
+}
+
+void TestTornWrite(nlTestSuite * inSuite, void * inContext)
+{
+    TemporaryFile file;
+    size_t logSize = 0;
+
+    {
+        ChipLinuxStorageLog storage;
+        NL_TEST_ASSERT(inSuite, storage.Init(file.Path()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Put("a", "first", 5) == CHIP_NO_ERROR);
+        logSize = storage.LogSize();
+    }
+
+    // Simulate a record cut short by a crash.
+    {
+        std::ofstream ofs(file.Path(), std::ofstream::out | std::ofstream::app | std::ofstream::binary);
+        const char partialRecord[] = { 1, 1, 0, 5, 0, 0, 0, 'b', 's' };
+        ofs.write(partialRecord, sizeof(partialRecord));
+    }
+
+    {
+        ChipLinuxStorageLog storage;
+        NL_TEST_ASSERT(inSuite, storage.Init(file.Path()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.LogSize() == logSize);
+        NL_TEST_ASSERT(inSuite, HasValue(storage, "a", "first"));
+        NL_TEST_ASSERT(inSuite, IsMissing(storage, "b"));
+
+        // Records written after the recovery are not hidden behind the dropped bytes.
+        NL_TEST_ASSERT(inSuite, storage.Put("c", "third", 5) == CHIP_NO_ERROR);
+    }
+
+    ChipLinuxStorageLog storage;
+    NL_TEST_ASSERT(inSuite, storage.Init(file.Path()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, HasValue(storage, "c", "third"));
+}
+
+void TestCoalescing(nlTestSuite * inSuite, void * inContext)
+{
+    TemporaryFile file;
+    ChipLinuxStorageLog storage;
+
+    NL_TEST_ASSERT(inSuite, storage.Init(file.Path(), true /* coalesce */) == CHIP_NO_ERROR);
+    size_t initialSize = storage.LogSize();
+
+    char counter[8];
+    for (int i = 0; i < 100; i++)
+    {
+        snprintf(counter, sizeof(counter), "%05d", i);
+        NL_TEST_ASSERT(inSuite, storage.Put("counter", counter, 5) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, storage.Put("deleted", "x", 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.Delete("deleted") == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, storage.HasPendingWrites());
+    NL_TEST_ASSERT(inSuite, storage.LogSize() == initialSize);
+    NL_TEST_ASSERT(inSuite, HasValue(storage, "counter", "00099"));
+
+    // One record for the counter, one for the deletion, both in a batch record.
+    NL_TEST_ASSERT(inSuite, storage.Flush() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, !storage.HasPendingWrites());
+    NL_TEST_ASSERT(inSuite, storage.LogSize() == initialSize + (7 + 4) + (7 + 7 + 5 + 4) + (7 + 7 + 4));
+
+    ChipLinuxStorageLog reloaded;
+    NL_TEST_ASSERT(inSuite, reloaded.Init(file.Path()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, HasValue(reloaded, "counter", "00099"));
+    NL_TEST_ASSERT(inSuite, IsMissing(reloaded, "deleted"));
+}
+
+void TestBatch(nlTestSuite * inSuite, void * inContext)
+{
+    TemporaryFile file;
+    size_t logSize = 0;
+
+    {
+        ChipLinuxStorageLog storage;
+        NL_TEST_ASSERT(inSuite, storage.Init(file.Path()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Put("a", "first", 5) == CHIP_NO_ERROR);
+        logSize = storage.LogSize();
+
+        NL_TEST_ASSERT(inSuite, storage.BeginBatch() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Put("b", "second", 6) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Delete("a") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.BeginBatch() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Put("c", "third", 5) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.CommitBatch() == CHIP_NO_ERROR);
+
+        // Visible, but not written until the outermost batch is committed.
+        NL_TEST_ASSERT(inSuite, HasValue(storage, "c", "third"));
+        NL_TEST_ASSERT(inSuite, IsMissing(storage, "a"));
+        NL_TEST_ASSERT(inSuite, storage.LogSize() == logSize);
+
+        NL_TEST_ASSERT(inSuite, storage.CommitBatch() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, !storage.HasPendingWrites());
+        NL_TEST_ASSERT(inSuite, storage.LogSize() == logSize + (7 + 4) + (7 + 1 + 6 + 4) + (7 + 1 + 4) + (7 + 1 + 5 + 4));
+        NL_TEST_ASSERT(inSuite, storage.CommitBatch() == CHIP_ERROR_INCORRECT_STATE);
+        logSize = storage.LogSize();
+
+        // Aborting restores the previous values.
+        NL_TEST_ASSERT(inSuite, storage.BeginBatch() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Put("b", "changed", 7) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Put("d", "fourth", 6) == CHIP_NO_ERROR);
+        storage.AbortBatch();
+        NL_TEST_ASSERT(inSuite, HasValue(storage, "b", "second"));
+        NL_TEST_ASSERT(inSuite, IsMissing(storage, "d"));
+        NL_TEST_ASSERT(inSuite, !storage.HasPendingWrites());
+
+        // Aborting a nested batch discards the outermost one.
+        NL_TEST_ASSERT(inSuite, storage.BeginBatch() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Delete("c") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.BeginBatch() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Put("e", "fifth", 5) == CHIP_NO_ERROR);
+        storage.AbortBatch();
+        NL_TEST_ASSERT(inSuite, storage.CommitBatch() == CHIP_ERROR_TRANSACTION_CANCELED);
+        NL_TEST_ASSERT(inSuite, HasValue(storage, "c", "third"));
+        NL_TEST_ASSERT(inSuite, IsMissing(storage, "e"));
+        NL_TEST_ASSERT(inSuite, storage.LogSize() == logSize);
+
+        // A batch cut short by a crash is dropped as a whole.
+        NL_TEST_ASSERT(inSuite, storage.BeginBatch() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Put("f", "sixth", 5) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Put("g", "seventh", 7) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.CommitBatch() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, truncate(file.Path(), static_cast<off_t>(storage.LogSize() - 1)) == 0);
+    }
+
+    ChipLinuxStorageLog storage;
+    NL_TEST_ASSERT(inSuite, storage.Init(file.Path()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.LogSize() == logSize);
+    NL_TEST_ASSERT(inSuite, IsMissing(storage, "a"));
+    NL_TEST_ASSERT(inSuite, HasValue(storage, "b", "second"));
+    NL_TEST_ASSERT(inSuite, HasValue(storage, "c", "third"));
+    NL_TEST_ASSERT(inSuite, IsMissing(storage, "f"));
+    NL_TEST_ASSERT(inSuite, IsMissing(storage, "g"));
+}
+
+void TestCompaction(nlTestSuite * inSuite, void * inContext)
+{
+    TemporaryFile file;
+    ChipLinuxStorageLog storage;
+
+    NL_TEST_ASSERT(inSuite, storage.Init(file.Path()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.Put("keep", "kept", 4) == CHIP_NO_ERROR);
+
+    uint8_t value[512];
+    size_t maxLogSize = 0;
+    for (int i = 0; i < 1000; i++)
+    {
+        memset(value, i & 0xFF, sizeof(value));
+        NL_TEST_ASSERT(inSuite, storage.Put("overwritten", value, sizeof(value)) == CHIP_NO_ERROR);
+        maxLogSize = std::max(maxLogSize, storage.LogSize());
+    }
+
+    // The log is rewritten once it is mostly stale, instead of growing without bounds.
+    NL_TEST_ASSERT(inSuite, maxLogSize < 64 * 1024);
+
+    ChipLinuxStorageLog reloaded;
+    NL_TEST_ASSERT(inSuite, reloaded.Init(file.Path()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, HasValue(reloaded, "keep", "kept"));
+
+    uint8_t readValue[sizeof(value)];
+    size_t readSize = 0;
+    NL_TEST_ASSERT(inSuite, reloaded.Get("overwritten", readValue, sizeof(readValue), &readSize, 0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readSize == sizeof(value) && memcmp(readValue, value, sizeof(value)) == 0);
+}
+
+void TestIniMigration(nlTestSuite * inSuite, void * inContext)
+{
+    TemporaryFile file;
+    unlink(file.Path());
+
+    // Write the file the way the INI based KVS did.
+    {
+        ChipLinuxStorage ini;
+        const uint8_t binary[] = { 0x00, 0xFF, 0x10, 0x20 };
+        NL_TEST_ASSERT(inSuite, ini.Init(file.Path()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, ini.WriteValueBin("f/1/k", binary, sizeof(binary)) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, ini.WriteValueBin("key with = and \\", reinterpret_cast<const uint8_t *>("text"), 4) ==
+                           CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, ini.WriteValueBin("empty", nullptr, 0) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, ini.Commit() == CHIP_NO_ERROR);
+    }
+
+    {
+        ChipLinuxStorageLog storage;
+        NL_TEST_ASSERT(inSuite, storage.Init(file.Path()) == CHIP_NO_ERROR);
+
+        uint8_t value[8];
+        size_t readSize = 0;
+        NL_TEST_ASSERT(inSuite, storage.Get("f/1/k", value, sizeof(value), &readSize, 0) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, readSize == 4 && value[0] == 0x00 && value[1] == 0xFF && value[3] == 0x20);
+        NL_TEST_ASSERT(inSuite, HasValue(storage, "key with = and \\", "text"));
+        NL_TEST_ASSERT(inSuite, HasValue(storage, "empty", ""));
+    }
+
+    // The file has been converted: loading it again does not go through the migration.
+    ChipLinuxStorageLog storage;
+    NL_TEST_ASSERT(inSuite, storage.Init(file.Path()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.LogSize() == storage.LiveSize());
+    NL_TEST_ASSERT(inSuite, HasValue(storage, "key with = and \\", "text"));
+}
+
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("Test Persistence", TestPersistence),
+    NL_TEST_DEF("Test TornWrite", TestTornWrite),
+    NL_TEST_DEF("Test Coalescing", TestCoalescing),
+    NL_TEST_DEF("Test Batch", TestBatch),
+    NL_TEST_DEF("Test Compaction", TestCompaction),
+    NL_TEST_DEF("Test IniMigration", TestIniMigration),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int TestSetup(void * inContext)
+{
+    return chip::Platform::MemoryInit() == CHIP_NO_ERROR ? SUCCESS : FAILURE;
+}
+
+int TestTeardown(void * inContext)
+{
+    chip::Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+} // namespace
+
+int TestChipLinuxStorageLog()
+{
+    nlTestSuite theSuite = { "ChipLinuxStorageLog tests", &sTests[0], TestSetup, TestTeardown };
+
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestChipLinuxStorageLog)
@@ -29,6 +29,7 @@
 
 #include <platform/CHIPDeviceLayer.h>
 #include <platform/KeyValueStoreManager.h>
+#include <platform/KvsPersistentStorageDelegate.h>
 
 using namespace chip;
 using namespace chip::DeviceLayer;
@@ -260,6 +261,59 @@ static void TestKeyValueStoreMgr_NonExistentDelete(nlTestSuite * inSuite, void *
     NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
 }
 
+static void TestKeyValueStoreMgr_DelegateBatches(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr const char * kTestKey1 = "batch_key1";
+    constexpr const char * kTestKey2 = "batch_key2";
+    constexpr uint32_t kTestValue    = 5;
+
+    KvsPersistentStorageDelegate storage1;
+    KvsPersistentStorageDelegate storage2;
+    NL_TEST_ASSERT(inSuite, storage1.Init(&KeyValueStoreMgr()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage2.Init(&KeyValueStoreMgr()) == CHIP_NO_ERROR);
+
+    // Each delegate tracks the nesting of its own batches, even when they share the key value store.
+    NL_TEST_ASSERT(inSuite, storage1.BeginBatch() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage1.SyncSetKeyValue(kTestKey1, &kTestValue, sizeof(kTestValue)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage2.CommitBatch() == CHIP_ERROR_INCORRECT_STATE);
+
+    NL_TEST_ASSERT(inSuite, storage2.BeginBatch() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage2.BeginBatch() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage2.SyncSetKeyValue(kTestKey2, &kTestValue, sizeof(kTestValue)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage2.CommitBatch() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage2.CommitBatch() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage2.CommitBatch() == CHIP_ERROR_INCORRECT_STATE);
+
+    NL_TEST_ASSERT(inSuite, storage1.CommitBatch() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage1.CommitBatch() == CHIP_ERROR_INCORRECT_STATE);
+
+    uint32_t readValue = 0;
+    uint16_t readSize  = sizeof(readValue);
+    NL_TEST_ASSERT(inSuite, storage2.SyncGetKeyValue(kTestKey1, &readValue, readSize) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readValue == kTestValue);
+    readValue = 0;
+    NL_TEST_ASSERT(inSuite, storage1.SyncGetKeyValue(kTestKey2, &readValue, readSize) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readValue == kTestValue);
+
+    NL_TEST_ASSERT(inSuite, KeyValueStoreMgr().Delete(kTestKey1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, KeyValueStoreMgr().Delete(kTestKey2) == CHIP_NO_ERROR);
+
+#if CHIP_DEVICE_LAYER_TARGET_LINUX
+    // The delegates share the batch of the key value store, so aborting the inner batch discards the outer one too.
+    NL_TEST_ASSERT(inSuite, storage1.BeginBatch() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage1.SyncSetKeyValue(kTestKey1, &kTestValue, sizeof(kTestValue)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage2.BeginBatch() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage2.SyncSetKeyValue(kTestKey2, &kTestValue, sizeof(kTestValue)) == CHIP_NO_ERROR);
+    storage2.AbortBatch();
+    NL_TEST_ASSERT(inSuite, storage1.CommitBatch() == CHIP_ERROR_TRANSACTION_CANCELED);
+
+    NL_TEST_ASSERT(inSuite,
+                   storage1.SyncGetKeyValue(kTestKey1, &readValue, readSize) == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+    NL_TEST_ASSERT(inSuite,
+                   storage1.SyncGetKeyValue(kTestKey2, &readValue, readSize) == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+#endif
+}
+
 #if !defined(__ZEPHYR__) && !defined(__MBED__)
 static void TestKeyValueStoreMgr_MultiRead(nlTestSuite * inSuite, void * inContext)
 {
@@ -319,6 +373,7 @@ static const nlTest sTests[] = { NL_TEST_DEF("Test KeyValueStoreMgr_EmptyString"
                                  NL_TEST_DEF("Test KeyValueStoreMgr_TooSmallBufferRead", TestKeyValueStoreMgr_TooSmallBufferRead),
                                  NL_TEST_DEF("Test KeyValueStoreMgr_AllCharactersKey", TestKeyValueStoreMgr_AllCharactersKey),
                                  NL_TEST_DEF("Test KeyValueStoreMgr_NonExistentDelete", TestKeyValueStoreMgr_NonExistentDelete),
+                                 NL_TEST_DEF("Test KeyValueStoreMgr_DelegateBatches", TestKeyValueStoreMgr_DelegateBatches),
 #if !defined(__ZEPHYR__) && !defined(__MBED__)
                                  // Zephyr and Mbed platforms do not support partial or offset reads yet.
                                  NL_TEST_DEF("Test KeyValueStoreMgr_MultiRead", TestKeyValueStoreMgr_MultiRead),
@@ -45,20 +45,37 @@ CHIP_ERROR CASEServer::ListenForSessionEstablishment(Messaging::ExchangeManager
     mExchangeManager           = exchangeManager;
     mGroupDataProvider         = responderGroupDataProvider;
 
-    // Set up the group state provider that persists across all handshakes.
-    GetSession().SetGroupDataProvider(mGroupDataProvider);
+    for (auto & responder : mResponders)
+    {
+        responder.mServer = this;
+
+        // Set up the group state provider that persists across all handshakes.
+        responder.mSession.SetGroupDataProvider(mGroupDataProvider);
 
-    PrepareForSessionEstablishment();
+        PrepareForSessionEstablishment(responder);
+    }
 
     return CHIP_NO_ERROR;
 }
 
-CHIP_ERROR CASEServer::InitCASEHandshake(Messaging::ExchangeContext * ec)
+CASEServer::Responder * CASEServer::FindIdleResponder()
+{
+    for (auto & responder : mResponders)
+    {
+        if (responder.mSession.GetState() == CASESession::State::kInitialized)
+        {
+            return &responder;
+        }
+    }
+    return nullptr;
+}
+
+CHIP_ERROR CASEServer::InitCASEHandshake(Responder & responder, Messaging::ExchangeContext * ec)
 {
     ReturnErrorCodeIf(ec == nullptr, CHIP_ERROR_INVALID_ARGUMENT);
 
     // Hand over the exchange context to the CASE session.
-    ec->SetDelegate(&GetSession());
+    ec->SetDelegate(&responder.mSession);
 
     return CHIP_NO_ERROR;
 }
@@ -73,17 +90,27 @@ CHIP_ERROR CASEServer::OnUnsolicitedMessageReceived(const PayloadHeader & payloa
 CHIP_ERROR CASEServer::OnMessageReceived(Messaging::ExchangeContext * ec, const PayloadHeader & payloadHeader,
                                          System::PacketBufferHandle && payload)
 {
-    if (GetSession().GetState() != CASESession::State::kInitialized)
+    Responder * responder = FindIdleResponder();
+    if (responder == nullptr)
     {
-        // We are in the middle of CASE handshake
+        // Every responder is in the middle of a CASE handshake
 
-        // Invoke watchdog to fix any stuck handshakes
-        bool watchdogFired = GetSession().InvokeBackgroundWorkWatchdog();
-        if (!watchdogFired)
+        // Invoke watchdogs to fix any stuck handshakes; a handshake that was stuck ends and frees its responder.
+        bool watchdogFired = false;
+        for (auto & busyResponder : mResponders)
         {
-            // Handshake wasn't stuck, let it continue its work
+            if (busyResponder.mSession.InvokeBackgroundWorkWatchdog())
+            {
+                watchdogFired = true;
+            }
+        }
+
+        responder = watchdogFired ? FindIdleResponder() : nullptr;
+        if (responder == nullptr)
+        {
+            // Handshakes weren't stuck, let them continue their work
             // TODO: Send Busy response, #27473
-            ChipLogError(Inet, "CASE session is in establishing state, returning without responding");
+            ChipLogError(Inet, "CASE sessions are all in establishing state, returning without responding");
             return CHIP_NO_ERROR;
         }
     }
@@ -96,13 +123,10 @@ CHIP_ERROR CASEServer::OnMessageReceived(Messaging::ExchangeContext * ec, const
 
     ChipLogProgress(Inet, "CASE Server received Sigma1 message %s EC %p", ". Starting handshake.", ec);
 
-    CHIP_ERROR err = InitCASEHandshake(ec);
+    CHIP_ERROR err = InitCASEHandshake(*responder, ec);
     SuccessOrExit(err);
 
-    // TODO - Enable multiple concurrent CASE session establishment
-    // https://github.com/project-chip/connectedhomeip/issues/8342
-
-    err = GetSession().OnMessageReceived(ec, payloadHeader, std::move(payload));
+    err = responder->mSession.OnMessageReceived(ec, payloadHeader, std::move(payload));
     SuccessOrExit(err);
 
 exit:
@@ -111,14 +135,14 @@ exit:
     return err;
 }
 
-void CASEServer::PrepareForSessionEstablishment(const ScopedNodeId & previouslyEstablishedPeer)
+void CASEServer::PrepareForSessionEstablishment(Responder & responder, const ScopedNodeId & previouslyEstablishedPeer)
 {
     // Let's re-register for CASE Sigma1 message, so that the next CASE session setup request can be processed.
     // https://github.com/project-chip/connectedhomeip/issues/8342
     ChipLogProgress(Inet, "CASE Server enabling CASE session setups");
     mExchangeManager->RegisterUnsolicitedMessageHandlerForType(Protocols::SecureChannel::MsgType::CASE_Sigma1, this);
 
-    GetSession().Clear();
+    responder.mSession.Clear();
 
     //
     // This releases our reference to a previously pinned session. If that was a successfully established session and is now
@@ -129,7 +153,7 @@ void CASEServer::PrepareForSessionEstablishment(const ScopedNodeId & previouslyE
     // de-allocated since no one else is holding onto this session. This will mean that when we get to allocating a session below,
     // we'll at least have one free session available in the session table, and won't need to evict an arbitrary session.
     //
-    mPinnedSecureSession.ClearValue();
+    responder.mPinnedSecureSession.ClearValue();
 
     //
     // Indicate to the underlying CASE session to prepare for session establishment requests coming its way. This will
@@ -147,9 +171,9 @@ void CASEServer::PrepareForSessionEstablishment(const ScopedNodeId & previouslyE
     // TODO(#17568): Once session eviction is actually in place, this call should NEVER fail and if so, is a logic bug.
     // Dying here on failure is even more appropriate then.
     //
-    VerifyOrDie(GetSession().PrepareForSessionEstablishment(*mSessionManager, mFabrics, mSessionResumptionStorage,
-                                                            mCertificateValidityPolicy, this, previouslyEstablishedPeer,
-                                                            GetLocalMRPConfig()) == CHIP_NO_ERROR);
+    VerifyOrDie(responder.mSession.PrepareForSessionEstablishment(*mSessionManager, mFabrics, mSessionResumptionStorage,
+                                                                  mCertificateValidityPolicy, &responder, previouslyEstablishedPeer,
+                                                                  GetLocalMRPConfig()) == CHIP_NO_ERROR);
 
     //
     // PairingSession::mSecureSessionHolder is a weak-reference. If MarkForEviction is called on this session, the session is
@@ -161,26 +185,26 @@ void CASEServer::PrepareForSessionEstablishment(const ScopedNodeId & previouslyE
     //
     // Let's create a SessionHandle strong-reference to it to keep it resident.
     //
-    mPinnedSecureSession = GetSession().CopySecureSession();
+    responder.mPinnedSecureSession = responder.mSession.CopySecureSession();
 
     //
     // If we've gotten this far, it means we have successfully allocated a SecureSession to back our next attempt. If we haven't,
     // there is a bug somewhere and we should raise attention to it by dying.
     //
-    VerifyOrDie(mPinnedSecureSession.HasValue());
+    VerifyOrDie(responder.mPinnedSecureSession.HasValue());
 }
 
-void CASEServer::OnSessionEstablishmentError(CHIP_ERROR err)
+void CASEServer::Responder::OnSessionEstablishmentError(CHIP_ERROR err)
 {
     ChipLogError(Inet, "CASE Session establishment failed: %" CHIP_ERROR_FORMAT, err.Format());
 
-    PrepareForSessionEstablishment();
+    mServer->PrepareForSessionEstablishment(*this);
 }
 
-void CASEServer::OnSessionEstablished(const SessionHandle & session)
+void CASEServer::Responder::OnSessionEstablished(const SessionHandle & session)
 {
     ChipLogProgress(Inet, "CASE Session established to peer: " ChipLogFormatScopedNodeId,
                     ChipLogValueScopedNodeId(session->GetPeer()));
-    PrepareForSessionEstablishment(session->GetPeer());
+    mServer->PrepareForSessionEstablishment(*this, session->GetPeer());
 }
 } // namespace chip
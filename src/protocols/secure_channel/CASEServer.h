@@ -25,18 +25,16 @@
 
 namespace chip {
 
-class CASEServer : public SessionEstablishmentDelegate,
-                   public Messaging::UnsolicitedMessageHandler,
-                   public Messaging::ExchangeDelegate
+class CASEServer : public Messaging::UnsolicitedMessageHandler, public Messaging::ExchangeDelegate
 {
 public:
     CASEServer() {}
     ~CASEServer() override { Shutdown(); }
 
     /*
-     * This method will shutdown this object, releasing the strong reference to the pinned SecureSession object.
-     * It will also unregister the unsolicited handler and clear out the session object (which will release the weak
-     * reference through the underlying SessionHolder).
+     * This method will shutdown this object, releasing the strong references to the pinned SecureSession objects.
+     * It will also unregister the unsolicited handler and clear out the session objects (which will release the weak
+     * references through the underlying SessionHolders).
      *
      */
     void Shutdown()
@@ -47,8 +45,11 @@ public:
             mExchangeManager = nullptr;
         }
 
-        GetSession().Clear();
-        mPinnedSecureSession.ClearValue();
+        for (auto & responder : mResponders)
+        {
+            responder.mSession.Clear();
+            responder.mPinnedSecureSession.ClearValue();
+        }
     }
 
     CHIP_ERROR ListenForSessionEstablishment(Messaging::ExchangeManager * exchangeManager, SessionManager * sessionManager,
@@ -56,10 +57,6 @@ public:
                                              Credentials::CertificateValidityPolicy * policy,
                                              Credentials::GroupDataProvider * responderGroupDataProvider);
 
-    //////////// SessionEstablishmentDelegate Implementation ///////////////
-    void OnSessionEstablishmentError(CHIP_ERROR error) override;
-    void OnSessionEstablished(const SessionHandle & session) override;
-
     //// UnsolicitedMessageHandler Implementation ////
     CHIP_ERROR OnUnsolicitedMessageReceived(const PayloadHeader & payloadHeader, ExchangeDelegate *& newDelegate) override;
 
@@ -67,46 +64,66 @@ public:
     CHIP_ERROR OnMessageReceived(Messaging::ExchangeContext * ec, const PayloadHeader & payloadHeader,
                                  System::PacketBufferHandle && payload) override;
     void OnResponseTimeout(Messaging::ExchangeContext * ec) override {}
-    Messaging::ExchangeMessageDispatch & GetMessageDispatch() override { return GetSession().GetMessageDispatch(); }
-
-    CASESession & GetSession() { return mPairingSession; }
+    Messaging::ExchangeMessageDispatch & GetMessageDispatch() override { return mResponders[0].mSession.GetMessageDispatch(); }
 
 private:
+    /*
+     * A CASESession waiting for, or in the middle of, a handshake started by a Sigma1. Each responder is its own
+     * SessionEstablishmentDelegate, so that the end of a handshake only prepares the responder that ran it.
+     *
+     */
+    class Responder : public SessionEstablishmentDelegate
+    {
+    public:
+        //////////// SessionEstablishmentDelegate Implementation ///////////////
+        void OnSessionEstablishmentError(CHIP_ERROR error) override;
+        void OnSessionEstablished(const SessionHandle & session) override;
+
+        CASEServer * mServer = nullptr;
+        CASESession mSession;
+
+        //
+        // When we're in the process of establishing a session, this is used
+        // to maintain an additional, strong reference to the underlying SecureSession.
+        // This is because the existing reference in PairingSession is a weak one
+        // (i.e a SessionHolder) and can lose its reference if the session is evicted
+        // for any reason.
+        //
+        // This initially points to a session that is not yet active. Upon activation, it
+        // transfers ownership of the session to the SecureSessionManager and this reference
+        // is released before simultaneously acquiring ownership of a new SecureSession.
+        //
+        Optional<SessionHandle> mPinnedSecureSession;
+    };
+
     Messaging::ExchangeManager * mExchangeManager                       = nullptr;
     SessionResumptionStorage * mSessionResumptionStorage                = nullptr;
     Credentials::CertificateValidityPolicy * mCertificateValidityPolicy = nullptr;
 
-    //
-    // When we're in the process of establishing a session, this is used
-    // to maintain an additional, strong reference to the underlying SecureSession.
-    // This is because the existing reference in PairingSession is a weak one
-    // (i.e a SessionHolder) and can lose its reference if the session is evicted
-    // for any reason.
-    //
-    // This initially points to a session that is not yet active. Upon activation, it
-    // transfers ownership of the session to the SecureSessionManager and this reference
-    // is released before simultaneously acquiring ownership of a new SecureSession.
-    //
-    Optional<SessionHandle> mPinnedSecureSession;
-
-    CASESession mPairingSession;
+    // Handshakes from different initiators each get their own responder, see CHIP_CONFIG_CASE_SERVER_MAX_CONCURRENT_HANDSHAKES.
+    Responder mResponders[CHIP_CONFIG_CASE_SERVER_MAX_CONCURRENT_HANDSHAKES];
     SessionManager * mSessionManager = nullptr;
 
     FabricTable * mFabrics                              = nullptr;
     Credentials::GroupDataProvider * mGroupDataProvider = nullptr;
 
-    CHIP_ERROR InitCASEHandshake(Messaging::ExchangeContext * ec);
+    /*
+     * Returns a responder that is waiting for a Sigma1, or nullptr if all of them are in the middle of a handshake.
+     */
+    Responder * FindIdleResponder();
+
+    CHIP_ERROR InitCASEHandshake(Responder & responder, Messaging::ExchangeContext * ec);
 
     /*
      * This will clean up any state from a previous session establishment
-     * attempt (if any) and setup the machinery to listen for and handle
+     * attempt (if any) of the responder and setup the machinery to listen for and handle
      * any session handshakes there-after.
      *
      * If a session had previously been established successfully, previouslyEstablishedPeer
      * should be set to the scoped node-id of the peer associated with that session.
      *
      */
-    void PrepareForSessionEstablishment(const ScopedNodeId & previouslyEstablishedPeer = ScopedNodeId());
+    void PrepareForSessionEstablishment(Responder & responder, const ScopedNodeId & previouslyEstablishedPeer = ScopedNodeId());
 };
 
 } // namespace chip
@@ -0,0 +1,319 @@
+/*
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <protocols/secure_channel/CachedSessionResumptionStorage.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <algorithm>
+
+namespace chip {
+
+CHIP_ERROR CachedSessionResumptionStorage::Init(PersistentStorageDelegate * storage, System::Layer * systemLayer)
+{
+    ReturnErrorOnFailure(SimpleSessionResumptionStorage::Init(storage));
+    mSystemLayer = systemLayer;
+    return CHIP_NO_ERROR;
+}
+
+void CachedSessionResumptionStorage::Shutdown()
+{
+    if (mFlushScheduled)
+    {
+        mSystemLayer->CancelTimer(FlushTimerHandler, this);
+        mFlushScheduled = false;
+    }
+
+    CHIP_ERROR err = Flush();
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(SecureChannel, "Unable to write out session resumption records on shutdown: %" CHIP_ERROR_FORMAT,
+                     err.Format());
+    }
+
+    for (auto & entry : mEntries)
+    {
+        ReleaseEntry(entry);
+    }
+    mSystemLayer = nullptr;
+}
+
+CHIP_ERROR CachedSessionResumptionStorage::Flush()
+{
+    CHIP_ERROR stickyErr = CHIP_NO_ERROR;
+    for (auto & entry : mEntries)
+    {
+        if (entry.mInUse && entry.mDirty)
+        {
+            CHIP_ERROR err = WriteEntry(entry);
+            stickyErr      = stickyErr == CHIP_NO_ERROR ? err : stickyErr;
+        }
+    }
+    return stickyErr;
+}
+
+CHIP_ERROR CachedSessionResumptionStorage::FindByScopedNodeId(const ScopedNodeId & node, ResumptionIdStorage & resumptionId,
+                                                              Crypto::P256ECDHDerivedSecret & sharedSecret, CATValues & peerCATs)
+{
+    Entry * entry = FindEntry(node);
+    if (entry != nullptr)
+    {
+        resumptionId = entry->mResumptionId;
+        sharedSecret = entry->mSharedSecret;
+        peerCATs     = entry->mPeerCATs;
+        Touch(*entry);
+        mStats.mCacheHits++;
+        mStats.mResumptionHits++;
+        return CHIP_NO_ERROR;
+    }
+
+    mStats.mStorageReads++;
+    CHIP_ERROR err = LoadState(node, resumptionId, sharedSecret, peerCATs);
+    if (err != CHIP_NO_ERROR)
+    {
+        mStats.mResumptionMisses++;
+        return err;
+    }
+    mStats.mResumptionHits++;
+
+    entry = AllocateEntry();
+    if (entry != nullptr)
+    {
+        entry->mNode         = node;
+        entry->mResumptionId = resumptionId;
+        entry->mSharedSecret = sharedSecret;
+        entry->mPeerCATs     = peerCATs;
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CachedSessionResumptionStorage::FindByResumptionId(ConstResumptionIdView resumptionId, ScopedNodeId & node,
+                                                              Crypto::P256ECDHDerivedSecret & sharedSecret, CATValues & peerCATs)
+{
+    Entry * entry = FindEntry(resumptionId);
+    if (entry != nullptr)
+    {
+        node         = entry->mNode;
+        sharedSecret = entry->mSharedSecret;
+        peerCATs     = entry->mPeerCATs;
+        Touch(*entry);
+        mStats.mCacheHits++;
+        mStats.mResumptionHits++;
+        return CHIP_NO_ERROR;
+    }
+
+    mStats.mStorageReads++;
+    ScopedNodeId storedNode;
+    ResumptionIdStorage storedResumptionId;
+    CHIP_ERROR err = FindNodeByResumptionId(resumptionId, storedNode);
+    // A node with a cached record has a newer resumption ID than the one in storage, which may not be written out yet.
+    if (err == CHIP_NO_ERROR && FindEntry(storedNode) != nullptr)
+    {
+        err = CHIP_ERROR_KEY_NOT_FOUND;
+    }
+    if (err == CHIP_NO_ERROR)
+    {
+        err = LoadState(storedNode, storedResumptionId, sharedSecret, peerCATs);
+    }
+    if (err == CHIP_NO_ERROR &&
+        !std::equal(storedResumptionId.begin(), storedResumptionId.end(), resumptionId.begin(), resumptionId.end()))
+    {
+        err = CHIP_ERROR_KEY_NOT_FOUND;
+    }
+    if (err != CHIP_NO_ERROR)
+    {
+        mStats.mResumptionMisses++;
+        return err;
+    }
+    mStats.mResumptionHits++;
+    node = storedNode;
+
+    entry = AllocateEntry();
+    if (entry != nullptr)
+    {
+        entry->mNode         = storedNode;
+        entry->mResumptionId = storedResumptionId;
+        entry->mSharedSecret = sharedSecret;
+        entry->mPeerCATs     = peerCATs;
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CachedSessionResumptionStorage::Save(const ScopedNodeId & node, ConstResumptionIdView resumptionId,
+                                                const Crypto::P256ECDHDerivedSecret & sharedSecret, const CATValues & peerCATs)
+{
+    Entry * entry = FindEntry(node);
+    if (entry != nullptr)
+    {
+        if (entry->mDirty)
+        {
+            mStats.mCoalescedSaves++;
+        }
+    }
+    else
+    {
+        entry = AllocateEntry();
+        if (entry == nullptr)
+        {
+            // The least recently used record could not be written out to make room; don't hold this one back.
+            return DefaultSessionResumptionStorage::Save(node, resumptionId, sharedSecret, peerCATs);
+        }
+        entry->mNode = node;
+    }
+
+    std::copy(resumptionId.begin(), resumptionId.end(), entry->mResumptionId.begin());
+    entry->mSharedSecret = sharedSecret;
+    entry->mPeerCATs     = peerCATs;
+    entry->mDirty        = true;
+    Touch(*entry);
+
+    if (mSystemLayer == nullptr)
+    {
+        return WriteEntry(*entry);
+    }
+
+    ScheduleFlush();
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CachedSessionResumptionStorage::Delete(const ScopedNodeId & node)
+{
+    // Drop the cached record too, even if it was never written out, so it can neither be resumed nor written back later.
+    Entry * entry = FindEntry(node);
+    if (entry != nullptr)
+    {
+        ReleaseEntry(*entry);
+    }
+    return DefaultSessionResumptionStorage::Delete(node);
+}
+
+CHIP_ERROR CachedSessionResumptionStorage::DeleteAll(FabricIndex fabricIndex)
+{
+    for (auto & entry : mEntries)
+    {
+        if (entry.mInUse && entry.mNode.GetFabricIndex() == fabricIndex)
+        {
+            ReleaseEntry(entry);
+        }
+    }
+    return DefaultSessionResumptionStorage::DeleteAll(fabricIndex);
+}
+
+CachedSessionResumptionStorage::Entry * CachedSessionResumptionStorage::FindEntry(const ScopedNodeId & node)
+{
+    for (auto & entry : mEntries)
+    {
+        if (entry.mInUse && entry.mNode == node)
+        {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+CachedSessionResumptionStorage::Entry * CachedSessionResumptionStorage::FindEntry(ConstResumptionIdView resumptionId)
+{
+    for (auto & entry : mEntries)
+    {
+        if (entry.mInUse && std::equal(entry.mResumptionId.begin(), entry.mResumptionId.end(), resumptionId.begin()))
+        {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+CachedSessionResumptionStorage::Entry * CachedSessionResumptionStorage::AllocateEntry()
+{
+    Entry * victim = &mEntries[0];
+    for (auto & entry : mEntries)
+    {
+        if (!entry.mInUse)
+        {
+            victim = &entry;
+            break;
+        }
+        if (entry.mLastUsed < victim->mLastUsed)
+        {
+            victim = &entry;
+        }
+    }
+
+    if (victim->mInUse && victim->mDirty)
+    {
+        CHIP_ERROR err = WriteEntry(*victim);
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(SecureChannel,
+                         "Unable to write out session resumption record for node " ChipLogFormatX64 ": %" CHIP_ERROR_FORMAT,
+                         ChipLogValueX64(victim->mNode.GetNodeId()), err.Format());
+            return nullptr;
+        }
+    }
+
+    ReleaseEntry(*victim);
+    victim->mInUse = true;
+    Touch(*victim);
+    return victim;
+}
+
+void CachedSessionResumptionStorage::ReleaseEntry(Entry & entry)
+{
+    entry.mInUse = false;
+    entry.mDirty = false;
+    Crypto::ClearSecretData(entry.mSharedSecret.Bytes(), entry.mSharedSecret.Capacity());
+}
+
+CHIP_ERROR CachedSessionResumptionStorage::WriteEntry(Entry & entry)
+{
+    ReturnErrorOnFailure(DefaultSessionResumptionStorage::Save(entry.mNode, ConstResumptionIdView(entry.mResumptionId.data()),
+                                                               entry.mSharedSecret, entry.mPeerCATs));
+    entry.mDirty = false;
+    mStats.mStorageWrites++;
+    return CHIP_NO_ERROR;
+}
+
+void CachedSessionResumptionStorage::ScheduleFlush()
+{
+    VerifyOrReturn(!mFlushScheduled);
+
+    CHIP_ERROR err =
+        mSystemLayer->StartTimer(System::Clock::Milliseconds32(CHIP_CONFIG_CASE_SESSION_RESUME_WRITE_BEHIND_DELAY_MS),
+                                 FlushTimerHandler, this);
+    if (err != CHIP_NO_ERROR)
+    {
+        // Without a timer, fall back to writing through.
+        FlushTimerHandler(mSystemLayer, this);
+        return;
+    }
+    mFlushScheduled = true;
+}
+
+void CachedSessionResumptionStorage::FlushTimerHandler(System::Layer * systemLayer, void * appState)
+{
+    auto * self           = static_cast<CachedSessionResumptionStorage *>(appState);
+    self->mFlushScheduled = false;
+
+    CHIP_ERROR err = self->Flush();
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(SecureChannel, "Unable to write out session resumption records: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+}
+
+} // namespace chip
@@ -0,0 +1,105 @@
+/*
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <protocols/secure_channel/SimpleSessionResumptionStorage.h>
+#include <system/SystemClock.h>
+#include <system/SystemLayer.h>
+
+namespace chip {
+
+/**
+ * @brief A SimpleSessionResumptionStorage with an in-memory copy of the most recently used resumption records in front
+ *   of the persistent storage.
+ *
+ *   Lookups by ScopedNodeId and by ResumptionId are served from memory when the record is cached, and only fall back
+ *   to reading the persistent storage on a miss. Saves update memory and, when a System::Layer is given to Init, are
+ *   written to the persistent storage after CHIP_CONFIG_CASE_SESSION_RESUME_WRITE_BEHIND_DELAY_MS, so that a peer
+ *   resuming several times within that window costs a single write. Without a System::Layer, saves are written
+ *   through immediately.
+ *
+ *   Records still waiting to be written are lost on power loss, in which case the peer falls back to a full CASE
+ *   handshake. Call Shutdown() before the persistent storage goes away so pending records are written out.
+ */
+class CachedSessionResumptionStorage : public SimpleSessionResumptionStorage
+{
+public:
+    struct Stats
+    {
+        uint32_t mResumptionHits   = 0; /**< Lookups that found a record, so the session could be resumed. */
+        uint32_t mResumptionMisses = 0; /**< Lookups that found no record, so a full CASE handshake is needed. */
+        uint32_t mCacheHits        = 0; /**< Lookups served from memory. */
+        uint32_t mStorageReads     = 0; /**< Lookups that had to read the persistent storage. */
+        uint32_t mStorageWrites    = 0; /**< Records written to the persistent storage. */
+        uint32_t mCoalescedSaves   = 0; /**< Saves that replaced a record before it was written. */
+    };
+
+    CHIP_ERROR Init(PersistentStorageDelegate * storage, System::Layer * systemLayer = nullptr);
+
+    /**
+     * Write out the pending records and forget all cached ones.
+     */
+    void Shutdown();
+
+    /**
+     * Write all the records saved since the last flush to the persistent storage.
+     */
+    CHIP_ERROR Flush();
+
+    CHIP_ERROR FindByScopedNodeId(const ScopedNodeId & node, ResumptionIdStorage & resumptionId,
+                                  Crypto::P256ECDHDerivedSecret & sharedSecret, CATValues & peerCATs) override;
+    CHIP_ERROR FindByResumptionId(ConstResumptionIdView resumptionId, ScopedNodeId & node,
+                                  Crypto::P256ECDHDerivedSecret & sharedSecret, CATValues & peerCATs) override;
+    CHIP_ERROR Save(const ScopedNodeId & node, ConstResumptionIdView resumptionId,
+                    const Crypto::P256ECDHDerivedSecret & sharedSecret, const CATValues & peerCATs) override;
+    CHIP_ERROR Delete(const ScopedNodeId & node) override;
+    CHIP_ERROR DeleteAll(FabricIndex fabricIndex) override;
+
+    const Stats & GetStats() const { return mStats; }
+    void ResetStats() { mStats = Stats(); }
+
+private:
+    struct Entry
+    {
+        ScopedNodeId mNode;
+        ResumptionIdStorage mResumptionId;
+        Crypto::P256ECDHDerivedSecret mSharedSecret;
+        CATValues mPeerCATs;
+        uint32_t mLastUsed = 0;
+        bool mInUse        = false;
+        bool mDirty        = false;
+    };
+
+    Entry * FindEntry(const ScopedNodeId & node);
+    Entry * FindEntry(ConstResumptionIdView resumptionId);
+    Entry * AllocateEntry();
+    void ReleaseEntry(Entry & entry);
+    void Touch(Entry & entry) { entry.mLastUsed = ++mUseCounter; }
+
+    CHIP_ERROR WriteEntry(Entry & entry);
+    void ScheduleFlush();
+    static void FlushTimerHandler(System::Layer * systemLayer, void * appState);
+
+    Entry mEntries[CHIP_CONFIG_CASE_SESSION_RESUME_MEMORY_CACHE_SIZE];
+    System::Layer * mSystemLayer = nullptr;
+    uint32_t mUseCounter         = 0;
+    bool mFlushScheduled         = false;
+    Stats mStats;
+};
+
+} // namespace chip
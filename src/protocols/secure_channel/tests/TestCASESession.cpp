@@ -44,6 +44,17 @@
 
 #include "credentials/tests/CHIPCert_test_vectors.h"
 
+// Linux builds that enable background event processing serve that work from a pool of threads, see
+// GenericPlatformManagerImpl_POSIX.
+#define CASE_TEST_BACKGROUND_WORK_POOL (CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING && CHIP_DEVICE_LAYER_TARGET_LINUX)
+
+#if CASE_TEST_BACKGROUND_WORK_POOL
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif // CASE_TEST_BACKGROUND_WORK_POOL
+
 using namespace chip;
 using namespace Credentials;
 using namespace TestCerts;
@@ -58,6 +69,43 @@ using TestContext = Test::LoopbackMessagingContext;
 namespace chip {
 namespace {
 
+#if CASE_TEST_BACKGROUND_WORK_POOL
+// Waits for the background work scheduled so far by occupying every thread of the pool at once.  The pool takes work in
+// order, so no earlier work is still running then, and the after work callbacks of that work are queued on the Matter thread.
+void DrainBackgroundWork()
+{
+    static struct
+    {
+        std::mutex lock;
+        std::condition_variable cond;
+        size_t arrived;
+        size_t left;
+    } sBarrier;
+
+    sBarrier.arrived = 0;
+    sBarrier.left    = 0;
+
+    for (size_t i = 0; i < CHIP_DEVICE_CONFIG_BG_THREAD_POOL_SIZE; i++)
+    {
+        // The queue may still be full of work that the pool has not taken yet.
+        while (chip::DeviceLayer::PlatformMgr().ScheduleBackgroundWork([](intptr_t) -> void {
+            std::unique_lock<std::mutex> lock(sBarrier.lock);
+            sBarrier.arrived++;
+            sBarrier.cond.notify_all();
+            sBarrier.cond.wait(lock, [] { return sBarrier.arrived == CHIP_DEVICE_CONFIG_BG_THREAD_POOL_SIZE; });
+            sBarrier.left++;
+            sBarrier.cond.notify_all();
+        }) != CHIP_NO_ERROR)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(sBarrier.lock);
+    sBarrier.cond.wait(lock, [] { return sBarrier.left == CHIP_DEVICE_CONFIG_BG_THREAD_POOL_SIZE; });
+}
+#endif // CASE_TEST_BACKGROUND_WORK_POOL
+
 void ServiceEvents(TestContext & ctx)
 {
     // Takes a few rounds of this because handling IO messages may schedule work,
@@ -66,6 +114,11 @@ void ServiceEvents(TestContext & ctx)
     {
         ctx.DrainAndServiceIO();
 
+#if CASE_TEST_BACKGROUND_WORK_POOL
+        // Let the background work finish, so that its after work callbacks run below.
+        DrainBackgroundWork();
+#endif // CASE_TEST_BACKGROUND_WORK_POOL
+
         chip::DeviceLayer::PlatformMgr().ScheduleWork(
             [](intptr_t) -> void { chip::DeviceLayer::PlatformMgr().StopEventLoopTask(); }, (intptr_t) nullptr);
         chip::DeviceLayer::PlatformMgr().RunEventLoop();
@@ -171,6 +224,14 @@ public:
     {
         VerifyOrReturnError(mKeypair != nullptr, CHIP_ERROR_INCORRECT_STATE);
         VerifyOrReturnError(fabricIndex == mSingleFabricIndex, CHIP_ERROR_INVALID_FABRIC_INDEX);
+#if CASE_TEST_BACKGROUND_WORK_POOL
+        std::unique_lock<std::mutex> lock(mHoldLock);
+        mHeldSignatureCount++;
+        mHoldCond.notify_all();
+        mHoldCond.wait(lock, [this] { return !mHoldSignatures; });
+        mHeldSignatureCount--;
+        // The signatures are still made one at a time: the DRBG of the crypto backend may not be thread-safe.
+#endif // CASE_TEST_BACKGROUND_WORK_POOL
         return mKeypair->ECDSA_sign_msg(message.data(), message.size(), outSignature);
     }
 
@@ -178,9 +239,44 @@ public:
 
     void ReleaseEphemeralKeypair(Crypto::P256Keypair * keypair) override { Platform::Delete<Crypto::P256Keypair>(keypair); }
 
+#if CASE_TEST_BACKGROUND_WORK_POOL
+    bool SupportsSignWithOpKeypairInBackground() const override { return mSignInBackground; }
+
+    void SetSignInBackground(bool signInBackground) { mSignInBackground = signInBackground; }
+
+    // While signatures are held, SignWithOpKeypair waits for ReleaseSignatures(), so the work signing them stays pending.
+    void HoldSignatures()
+    {
+        std::lock_guard<std::mutex> lock(mHoldLock);
+        mHoldSignatures = true;
+    }
+
+    void ReleaseSignatures()
+    {
+        std::lock_guard<std::mutex> lock(mHoldLock);
+        mHoldSignatures = false;
+        mHoldCond.notify_all();
+    }
+
+    // Returns whether `count` signatures are held at the same time within a few seconds.
+    bool WaitForHeldSignatures(size_t count)
+    {
+        std::unique_lock<std::mutex> lock(mHoldLock);
+        return mHoldCond.wait_for(lock, std::chrono::seconds(5), [this, count] { return mHeldSignatureCount >= count; });
+    }
+#endif // CASE_TEST_BACKGROUND_WORK_POOL
+
 protected:
     Platform::UniquePtr<P256Keypair> mKeypair;
     FabricIndex mSingleFabricIndex = kUndefinedFabricIndex;
+
+#if CASE_TEST_BACKGROUND_WORK_POOL
+    bool mSignInBackground = false;
+    mutable std::mutex mHoldLock;
+    mutable std::condition_variable mHoldCond;
+    mutable size_t mHeldSignatureCount = 0;
+    bool mHoldSignatures               = false;
+#endif // CASE_TEST_BACKGROUND_WORK_POOL
 };
 
 #if CHIP_CONFIG_SLOW_CRYPTO
@@ -308,6 +404,9 @@ public:
     static void SecurePairingStartTest(nlTestSuite * inSuite, void * inContext);
     static void SecurePairingHandshakeTest(nlTestSuite * inSuite, void * inContext);
     static void SecurePairingHandshakeServerTest(nlTestSuite * inSuite, void * inContext);
+#if CHIP_CONFIG_CASE_SERVER_MAX_CONCURRENT_HANDSHAKES >= 2
+    static void ConcurrentServerHandshakesTest(nlTestSuite * inSuite, void * inContext);
+#endif // CHIP_CONFIG_CASE_SERVER_MAX_CONCURRENT_HANDSHAKES >= 2
     static void Sigma1ParsingTest(nlTestSuite * inSuite, void * inContext);
     static void DestinationIdTest(nlTestSuite * inSuite, void * inContext);
     static void SessionResumptionStorage(nlTestSuite * inSuite, void * inContext);
@@ -315,6 +414,9 @@ public:
     static void SimulateUpdateNOCInvalidatePendingEstablishment(nlTestSuite * inSuite, void * inContext);
 #endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
     static void Sigma1BadDestinationIdTest(nlTestSuite * inSuite, void * inContext);
+#if CASE_TEST_BACKGROUND_WORK_POOL && CHIP_DEVICE_CONFIG_BG_THREAD_POOL_SIZE >= 2
+    static void ConcurrentHandshakesTest(nlTestSuite * inSuite, void * inContext);
+#endif // CASE_TEST_BACKGROUND_WORK_POOL && CHIP_DEVICE_CONFIG_BG_THREAD_POOL_SIZE >= 2
 };
 
 void TestCASESession::SecurePairingWaitTest(nlTestSuite * inSuite, void * inContext)
@@ -530,6 +632,49 @@ void TestCASESession::SecurePairingHandshakeServerTest(nlTestSuite * inSuite, vo
     chip::Platform::Delete(pairingCommissioner1);
 }
 
+#if CHIP_CONFIG_CASE_SERVER_MAX_CONCURRENT_HANDSHAKES >= 2
+void TestCASESession::ConcurrentServerHandshakesTest(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    constexpr size_t kHandshakeCount = CHIP_CONFIG_CASE_SERVER_MAX_CONCURRENT_HANDSHAKES;
+
+    TestCASESecurePairingDelegate delegateCommissioner[kHandshakeCount];
+    CASESession pairingCommissioner[kHandshakeCount];
+
+    auto & loopback            = ctx.GetLoopback();
+    loopback.mSentMessageCount = 0;
+
+    NL_TEST_ASSERT(inSuite,
+                   gPairingServer.ListenForSessionEstablishment(&ctx.GetExchangeManager(), &ctx.GetSecureSessionManager(),
+                                                                &gDeviceFabrics, nullptr, nullptr,
+                                                                &gDeviceGroupDataProvider) == CHIP_NO_ERROR);
+
+    // Every Sigma1 is sent before any of them is delivered, so the server gets each of them while the handshakes of the
+    // others are in progress.
+    for (size_t i = 0; i < kHandshakeCount; i++)
+    {
+        pairingCommissioner[i].SetGroupDataProvider(&gCommissionerGroupDataProvider);
+        ExchangeContext * contextCommissioner = ctx.NewUnauthenticatedExchangeToBob(&pairingCommissioner[i]);
+        NL_TEST_ASSERT(inSuite,
+                       pairingCommissioner[i].EstablishSession(
+                           ctx.GetSecureSessionManager(), &gCommissionerFabrics, ScopedNodeId{ Node01_01, gCommissionerFabricIndex },
+                           contextCommissioner, nullptr, nullptr, &delegateCommissioner[i],
+                           Optional<ReliableMessageProtocolConfig>::Missing()) == CHIP_NO_ERROR);
+    }
+    ServiceEvents(ctx);
+
+    // No Sigma1 was dropped, and none had to be retransmitted.
+    NL_TEST_ASSERT(inSuite, loopback.mSentMessageCount == kHandshakeCount * sTestCaseMessageCount);
+    for (size_t i = 0; i < kHandshakeCount; i++)
+    {
+        NL_TEST_ASSERT(inSuite, delegateCommissioner[i].mNumPairingComplete == 1);
+        NL_TEST_ASSERT(inSuite, delegateCommissioner[i].mNumPairingErrors == 0);
+        NL_TEST_ASSERT(inSuite, delegateCommissioner[i].GetSessionHolder());
+    }
+}
+#endif // CHIP_CONFIG_CASE_SERVER_MAX_CONCURRENT_HANDSHAKES >= 2
+
 struct Sigma1Params
 {
     // Purposefully not using constants like kSigmaParamRandomNumberSize that
@@ -1093,6 +1238,91 @@ void TestCASESession::Sigma1BadDestinationIdTest(nlTestSuite * inSuite, void * i
     caseSession.Clear();
 }
 
+#if CASE_TEST_BACKGROUND_WORK_POOL && CHIP_DEVICE_CONFIG_BG_THREAD_POOL_SIZE >= 2
+void TestCASESession::ConcurrentHandshakesTest(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+    TemporarySessionManager sessionManager(inSuite, ctx);
+
+    // The first two handshakes run concurrently, the last one is abandoned while its background work is pending.
+    constexpr size_t kConcurrentHandshakeCount = 2;
+    constexpr size_t kHandshakeCount           = kConcurrentHandshakeCount + 1;
+
+    TestCASESecurePairingDelegate delegateCommissioner[kHandshakeCount];
+    TestCASESecurePairingDelegate delegateAccessory[kHandshakeCount];
+    CASESession pairingCommissioner[kHandshakeCount];
+    CASESession pairingAccessory[kHandshakeCount];
+
+    // Starts a handshake and delivers its Sigma1, so that the accessory signs Sigma2 in the background.
+    auto startHandshake = [&](size_t i) {
+        NL_TEST_ASSERT(inSuite,
+                       ctx.GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(
+                           Protocols::SecureChannel::MsgType::CASE_Sigma1, &pairingAccessory[i]) == CHIP_NO_ERROR);
+
+        pairingAccessory[i].SetGroupDataProvider(&gDeviceGroupDataProvider);
+        NL_TEST_ASSERT(inSuite,
+                       pairingAccessory[i].PrepareForSessionEstablishment(
+                           sessionManager, &gDeviceFabrics, nullptr, nullptr, &delegateAccessory[i], ScopedNodeId(),
+                           Optional<ReliableMessageProtocolConfig>::Missing()) == CHIP_NO_ERROR);
+
+        pairingCommissioner[i].SetGroupDataProvider(&gCommissionerGroupDataProvider);
+        ExchangeContext * contextCommissioner = ctx.NewUnauthenticatedExchangeToBob(&pairingCommissioner[i]);
+        NL_TEST_ASSERT(inSuite,
+                       pairingCommissioner[i].EstablishSession(
+                           sessionManager, &gCommissionerFabrics, ScopedNodeId{ Node01_01, gCommissionerFabricIndex },
+                           contextCommissioner, nullptr, nullptr, &delegateCommissioner[i],
+                           Optional<ReliableMessageProtocolConfig>::Missing()) == CHIP_NO_ERROR);
+        ctx.DrainAndServiceIO();
+
+        ctx.GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Protocols::SecureChannel::MsgType::CASE_Sigma1);
+        NL_TEST_ASSERT(inSuite, pairingAccessory[i].mState == CASESession::State::kSendSigma2Pending);
+    };
+
+    gDeviceOperationalKeystore.SetSignInBackground(true);
+
+    // Both accessories sign Sigma2 at the same time, on two threads of the pool.
+    gDeviceOperationalKeystore.HoldSignatures();
+    for (size_t i = 0; i < kConcurrentHandshakeCount; i++)
+    {
+        startHandshake(i);
+    }
+    NL_TEST_ASSERT(inSuite, gDeviceOperationalKeystore.WaitForHeldSignatures(kConcurrentHandshakeCount));
+    gDeviceOperationalKeystore.ReleaseSignatures();
+
+    // Each Sigma2 and Sigma3 is then validated in the background as well, the Sigma2 ones by HandleSigma2b.
+    for (int round = 0; round < 5; round++)
+    {
+        ServiceEvents(ctx);
+    }
+
+    for (size_t i = 0; i < kConcurrentHandshakeCount; i++)
+    {
+        NL_TEST_ASSERT(inSuite, delegateAccessory[i].mNumPairingComplete == 1);
+        NL_TEST_ASSERT(inSuite, delegateCommissioner[i].mNumPairingComplete == 1);
+        NL_TEST_ASSERT(inSuite, delegateAccessory[i].mNumPairingErrors == 0);
+        NL_TEST_ASSERT(inSuite, delegateCommissioner[i].mNumPairingErrors == 0);
+    }
+
+    // Clearing the accessory while it signs cancels its work: no Sigma2 is sent once the signature is made.
+    constexpr size_t kAbandoned = kConcurrentHandshakeCount;
+    gDeviceOperationalKeystore.HoldSignatures();
+    startHandshake(kAbandoned);
+    NL_TEST_ASSERT(inSuite, gDeviceOperationalKeystore.WaitForHeldSignatures(1));
+    pairingAccessory[kAbandoned].Clear();
+    gDeviceOperationalKeystore.ReleaseSignatures();
+    ServiceEvents(ctx);
+
+    NL_TEST_ASSERT(inSuite, pairingAccessory[kAbandoned].mState == CASESession::State::kInitialized);
+    NL_TEST_ASSERT(inSuite, pairingCommissioner[kAbandoned].mState == CASESession::State::kSentSigma1);
+    NL_TEST_ASSERT(inSuite, delegateAccessory[kAbandoned].mNumPairingComplete == 0);
+    NL_TEST_ASSERT(inSuite, delegateAccessory[kAbandoned].mNumPairingErrors == 0);
+    NL_TEST_ASSERT(inSuite, delegateCommissioner[kAbandoned].mNumPairingComplete == 0);
+
+    pairingCommissioner[kAbandoned].Clear();
+    gDeviceOperationalKeystore.SetSignInBackground(false);
+}
+#endif // CASE_TEST_BACKGROUND_WORK_POOL && CHIP_DEVICE_CONFIG_BG_THREAD_POOL_SIZE >= 2
+
 } // namespace chip
 
 // Test Suite
@@ -1107,6 +1337,9 @@ static const nlTest sTests[] =
     NL_TEST_DEF("Start",       chip::TestCASESession::SecurePairingStartTest),
     NL_TEST_DEF("Handshake",   chip::TestCASESession::SecurePairingHandshakeTest),
     NL_TEST_DEF("ServerHandshake", chip::TestCASESession::SecurePairingHandshakeServerTest),
+#if CHIP_CONFIG_CASE_SERVER_MAX_CONCURRENT_HANDSHAKES >= 2
+    NL_TEST_DEF("ConcurrentServerHandshakes", chip::TestCASESession::ConcurrentServerHandshakesTest),
+#endif // CHIP_CONFIG_CASE_SERVER_MAX_CONCURRENT_HANDSHAKES >= 2
     NL_TEST_DEF("Sigma1Parsing", chip::TestCASESession::Sigma1ParsingTest),
     NL_TEST_DEF("DestinationId", chip::TestCASESession::DestinationIdTest),
     NL_TEST_DEF("SessionResumptionStorage", chip::TestCASESession::SessionResumptionStorage),
@@ -1116,6 +1349,9 @@ static const nlTest sTests[] =
     NL_TEST_DEF("InvalidatePendingSessionEstablishment", chip::TestCASESession::SimulateUpdateNOCInvalidatePendingEstablishment),
 #endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
     NL_TEST_DEF("Sigma1BadDestinationId", chip::TestCASESession::Sigma1BadDestinationIdTest),
+#if CASE_TEST_BACKGROUND_WORK_POOL && CHIP_DEVICE_CONFIG_BG_THREAD_POOL_SIZE >= 2
+    NL_TEST_DEF("ConcurrentHandshakes", chip::TestCASESession::ConcurrentHandshakesTest),
+#endif // CASE_TEST_BACKGROUND_WORK_POOL && CHIP_DEVICE_CONFIG_BG_THREAD_POOL_SIZE >= 2
 
     NL_TEST_SENTINEL()
 };
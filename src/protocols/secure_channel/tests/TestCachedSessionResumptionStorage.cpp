@@ -0,0 +1,282 @@
+/*
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <lib/support/UnitTestRegistration.h>
+#include <nlunit-test.h>
+
+#include <lib/support/TestPersistentStorageDelegate.h>
+#include <protocols/secure_channel/CachedSessionResumptionStorage.h>
+#include <system/SystemLayerImpl.h>
+
+constexpr chip::FabricIndex fabric1 = 10;
+constexpr chip::NodeId node1        = 12344321;
+constexpr chip::FabricIndex fabric2 = 14;
+constexpr chip::NodeId node2        = 11223344;
+
+namespace {
+
+struct Record
+{
+    chip::ScopedNodeId node;
+    chip::CachedSessionResumptionStorage::ResumptionIdStorage resumptionId;
+    chip::Crypto::P256ECDHDerivedSecret sharedSecret;
+    chip::CATValues peerCATs;
+
+    Record(chip::NodeId nodeId, chip::FabricIndex fabricIndex) : node(nodeId, fabricIndex)
+    {
+        VerifyOrDie(chip::Crypto::DRBG_get_bytes(resumptionId.data(), resumptionId.size()) == CHIP_NO_ERROR);
+        sharedSecret.SetLength(sharedSecret.Capacity());
+        VerifyOrDie(chip::Crypto::DRBG_get_bytes(sharedSecret.Bytes(), sharedSecret.Length()) == CHIP_NO_ERROR);
+    }
+
+    chip::SessionResumptionStorage::ConstResumptionIdView ResumptionIdView() const
+    {
+        return chip::SessionResumptionStorage::ConstResumptionIdView(resumptionId.data());
+    }
+
+    CHIP_ERROR SaveTo(chip::CachedSessionResumptionStorage & sessionStorage) const
+    {
+        return sessionStorage.Save(node, ResumptionIdView(), sharedSecret, peerCATs);
+    }
+};
+
+bool IsPersisted(chip::TestPersistentStorageDelegate & storage, const chip::ScopedNodeId & node)
+{
+    return storage.HasKey(chip::SimpleSessionResumptionStorage::GetStorageKey(node).KeyName());
+}
+
+bool CanResume(chip::CachedSessionResumptionStorage & sessionStorage, const Record & record)
+{
+    chip::ScopedNodeId node;
+    chip::Crypto::P256ECDHDerivedSecret sharedSecret;
+    chip::CATValues peerCATs;
+    if (sessionStorage.FindByResumptionId(record.ResumptionIdView(), node, sharedSecret, peerCATs) != CHIP_NO_ERROR)
+    {
+        return false;
+    }
+    return node == record.node && sharedSecret.Length() == record.sharedSecret.Length() &&
+        memcmp(sharedSecret.ConstBytes(), record.sharedSecret.ConstBytes(), sharedSecret.Length()) == 0;
+}
+
+void TestWriteThrough(nlTestSuite * inSuite, void * inContext)
+{
+    chip::TestPersistentStorageDelegate storage;
+    chip::CachedSessionResumptionStorage sessionStorage;
+    NL_TEST_ASSERT(inSuite, sessionStorage.Init(&storage) == CHIP_NO_ERROR);
+
+    Record record(node1, fabric1);
+    NL_TEST_ASSERT(inSuite, record.SaveTo(sessionStorage) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, IsPersisted(storage, record.node));
+    NL_TEST_ASSERT(inSuite, sessionStorage.GetStats().mStorageWrites == 1);
+
+    // Both lookups are served from memory.
+    chip::CachedSessionResumptionStorage::ResumptionIdStorage resumptionId;
+    chip::Crypto::P256ECDHDerivedSecret sharedSecret;
+    chip::CATValues peerCATs;
+    NL_TEST_ASSERT(inSuite, sessionStorage.FindByScopedNodeId(record.node, resumptionId, sharedSecret, peerCATs) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, resumptionId == record.resumptionId);
+    NL_TEST_ASSERT(inSuite, CanResume(sessionStorage, record));
+    NL_TEST_ASSERT(inSuite, sessionStorage.GetStats().mCacheHits == 2);
+    NL_TEST_ASSERT(inSuite, sessionStorage.GetStats().mResumptionHits == 2);
+    NL_TEST_ASSERT(inSuite, sessionStorage.GetStats().mStorageReads == 0);
+
+    // An unknown peer needs a full CASE handshake.
+    NL_TEST_ASSERT(inSuite,
+                   sessionStorage.FindByScopedNodeId(chip::ScopedNodeId(node2, fabric2), resumptionId, sharedSecret, peerCATs) !=
+                       CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sessionStorage.GetStats().mResumptionMisses == 1);
+    NL_TEST_ASSERT(inSuite, sessionStorage.GetStats().mStorageReads == 1);
+
+    // A fresh instance reads the record from storage once, then keeps it in memory.
+    chip::CachedSessionResumptionStorage restarted;
+    NL_TEST_ASSERT(inSuite, restarted.Init(&storage) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, CanResume(restarted, record));
+    NL_TEST_ASSERT(inSuite, CanResume(restarted, record));
+    NL_TEST_ASSERT(inSuite, restarted.GetStats().mStorageReads == 1);
+    NL_TEST_ASSERT(inSuite, restarted.GetStats().mCacheHits == 1);
+
+    sessionStorage.Shutdown();
+    restarted.Shutdown();
+}
+
+void TestWriteBehind(nlTestSuite * inSuite, void * inContext)
+{
+    chip::TestPersistentStorageDelegate storage;
+    chip::System::LayerImpl systemLayer;
+    NL_TEST_ASSERT(inSuite, systemLayer.Init() == CHIP_NO_ERROR);
+
+    chip::CachedSessionResumptionStorage sessionStorage;
+    NL_TEST_ASSERT(inSuite, sessionStorage.Init(&storage, &systemLayer) == CHIP_NO_ERROR);
+
+    // The peer resumes twice before the records are written out; only the latest one is kept.
+    Record first(node1, fabric1);
+    Record second(node1, fabric1);
+    NL_TEST_ASSERT(inSuite, first.SaveTo(sessionStorage) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, second.SaveTo(sessionStorage) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, !IsPersisted(storage, first.node));
+    NL_TEST_ASSERT(inSuite, sessionStorage.GetStats().mCoalescedSaves == 1);
+    NL_TEST_ASSERT(inSuite, sessionStorage.GetStats().mStorageWrites == 0);
+
+    NL_TEST_ASSERT(inSuite, CanResume(sessionStorage, second));
+    NL_TEST_ASSERT(inSuite, !CanResume(sessionStorage, first));
+
+    NL_TEST_ASSERT(inSuite, sessionStorage.Flush() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, IsPersisted(storage, second.node));
+    NL_TEST_ASSERT(inSuite, sessionStorage.GetStats().mStorageWrites == 1);
+
+    // Shutdown writes out what is still pending.
+    Record other(node2, fabric2);
+    NL_TEST_ASSERT(inSuite, other.SaveTo(sessionStorage) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, !IsPersisted(storage, other.node));
+    sessionStorage.Shutdown();
+    NL_TEST_ASSERT(inSuite, IsPersisted(storage, other.node));
+
+    chip::CachedSessionResumptionStorage restarted;
+    NL_TEST_ASSERT(inSuite, restarted.Init(&storage) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, CanResume(restarted, second));
+    NL_TEST_ASSERT(inSuite, !CanResume(restarted, first));
+    NL_TEST_ASSERT(inSuite, CanResume(restarted, other));
+    restarted.Shutdown();
+
+    systemLayer.Shutdown();
+}
+
+void TestDeleteAll(nlTestSuite * inSuite, void * inContext)
+{
+    chip::TestPersistentStorageDelegate storage;
+    chip::System::LayerImpl systemLayer;
+    NL_TEST_ASSERT(inSuite, systemLayer.Init() == CHIP_NO_ERROR);
+
+    chip::CachedSessionResumptionStorage sessionStorage;
+    NL_TEST_ASSERT(inSuite, sessionStorage.Init(&storage, &systemLayer) == CHIP_NO_ERROR);
+
+    Record written(node1, fabric1);
+    Record pending(node2, fabric1);
+    Record kept(node1, fabric2);
+    NL_TEST_ASSERT(inSuite, written.SaveTo(sessionStorage) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sessionStorage.Flush() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, pending.SaveTo(sessionStorage) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, kept.SaveTo(sessionStorage) == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, sessionStorage.DeleteAll(fabric1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, !IsPersisted(storage, written.node));
+    NL_TEST_ASSERT(inSuite, !CanResume(sessionStorage, written));
+    NL_TEST_ASSERT(inSuite, !CanResume(sessionStorage, pending));
+    NL_TEST_ASSERT(inSuite, CanResume(sessionStorage, kept));
+
+    sessionStorage.Shutdown();
+    NL_TEST_ASSERT(inSuite, !IsPersisted(storage, pending.node));
+    NL_TEST_ASSERT(inSuite, IsPersisted(storage, kept.node));
+
+    systemLayer.Shutdown();
+}
+
+void TestDelete(nlTestSuite * inSuite, void * inContext)
+{
+    chip::TestPersistentStorageDelegate storage;
+    chip::System::LayerImpl systemLayer;
+    NL_TEST_ASSERT(inSuite, systemLayer.Init() == CHIP_NO_ERROR);
+
+    chip::CachedSessionResumptionStorage sessionStorage;
+    NL_TEST_ASSERT(inSuite, sessionStorage.Init(&storage, &systemLayer) == CHIP_NO_ERROR);
+
+    Record written(node1, fabric1);
+    Record pending(node2, fabric1);
+    Record kept(node1, fabric2);
+    NL_TEST_ASSERT(inSuite, written.SaveTo(sessionStorage) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sessionStorage.Flush() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, pending.SaveTo(sessionStorage) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, kept.SaveTo(sessionStorage) == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, sessionStorage.Delete(written.node) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sessionStorage.Delete(pending.node) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, !IsPersisted(storage, written.node));
+    NL_TEST_ASSERT(inSuite, !CanResume(sessionStorage, written));
+    NL_TEST_ASSERT(inSuite, !CanResume(sessionStorage, pending));
+    NL_TEST_ASSERT(inSuite, CanResume(sessionStorage, kept));
+
+    // The deleted record that was still pending is not written back.
+    sessionStorage.Shutdown();
+    NL_TEST_ASSERT(inSuite, !IsPersisted(storage, pending.node));
+    NL_TEST_ASSERT(inSuite, IsPersisted(storage, kept.node));
+
+    systemLayer.Shutdown();
+}
+
+} // namespace
+
+// Test Suite
+
+/**
+ *  Test Suite that lists all the test functions.
+ */
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("TestWriteThrough", TestWriteThrough),
+    NL_TEST_DEF("TestWriteBehind", TestWriteBehind),
+    NL_TEST_DEF("TestDelete", TestDelete),
+    NL_TEST_DEF("TestDeleteAll", TestDeleteAll),
+
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+/**
+ *  Set up the test suite.
+ */
+int TestCachedSessionResumptionStorage_Setup(void * inContext)
+{
+    CHIP_ERROR error = chip::Platform::MemoryInit();
+    if (error != CHIP_NO_ERROR)
+    {
+        return FAILURE;
+    }
+    return SUCCESS;
+}
+
+/**
+ *  Tear down the test suite.
+ */
+int TestCachedSessionResumptionStorage_Teardown(void * inContext)
+{
+    chip::Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+// clang-format off
+static nlTestSuite sSuite =
+{
+    "Test-CHIP-CachedSessionResumptionStorage",
+    &sTests[0],
+    TestCachedSessionResumptionStorage_Setup,
+    TestCachedSessionResumptionStorage_Teardown,
+};
+// clang-format on
+
+/**
+ *  Main
+ */
+int TestCachedSessionResumptionStorage()
+{
+    // Run test suit against one context
+    nlTestRunner(&sSuite, nullptr);
+
+    return (nlTestRunnerStats(&sSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestCachedSessionResumptionStorage)
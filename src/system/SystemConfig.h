@@ -422,6 +422,81 @@
 
 #endif /* !CHIP_SYSTEM_CONFIG_USE_LWIP */
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+ *
+ *  @brief
+ *      Allocate packet buffers on socket platforms from three pools of different sizes, instead of a single pool of maximum
+ *      size buffers (or the heap, when #CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE is zero).
+ *
+ *      A new buffer is taken from the pool of the smallest buffers that fit the requested size, or from a pool of larger
+ *      buffers when that one is empty. Acknowledgments and other short messages then no longer take a full MTU-sized buffer.
+ *      Each pool reports its usage through SystemStats.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES 0
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES */
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY
+ *
+ *  @brief
+ *      The size, including the reserved space, of the buffers of the pool of small packet buffers, when
+ *      #CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES is enabled.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY 128
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY */
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_POOL_SIZE
+ *
+ *  @brief
+ *      The number of small packet buffers, when #CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES is enabled.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_POOL_SIZE
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_POOL_SIZE 16
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_POOL_SIZE */
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY
+ *
+ *  @brief
+ *      The size, including the reserved space, of the buffers of the pool of medium packet buffers, when
+ *      #CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES is enabled.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY 512
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY */
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_POOL_SIZE
+ *
+ *  @brief
+ *      The number of medium packet buffers, when #CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES is enabled.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_POOL_SIZE
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_POOL_SIZE 8
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_POOL_SIZE */
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_LARGE_POOL_SIZE
+ *
+ *  @brief
+ *      The number of packet buffers of #CHIP_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX bytes, when
+ *      #CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES is enabled.
+ *
+ *      Defaults to #CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE, or to 15 buffers on platforms that otherwise allocate packet
+ *      buffers from the heap.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_LARGE_POOL_SIZE
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE > 0
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_LARGE_POOL_SIZE CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE
+#else
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_LARGE_POOL_SIZE 15
+#endif
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_LARGE_POOL_SIZE */
+
 /**
  *  @def CHIP_SYSTEM_CONFIG_EVENT_TYPE
  *
@@ -487,6 +562,18 @@ struct LwIPEvent;
 #define CHIP_SYSTEM_CONFIG_NUM_TIMERS 32
 #endif /* CHIP_SYSTEM_CONFIG_NUM_TIMERS */
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+ *
+ *  @brief
+ *      Keep the pending timers of the System::Layer in a hierarchical timing wheel instead of a sorted list, so that starting
+ *      and cancelling a timer does not depend on the number of timers.  This is meant for large systems with many timers,
+ *      and costs a few kilobytes.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+#define CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL 0
+#endif /* CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL */
+
 /**
  *  @def CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
  *
@@ -0,0 +1,483 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements Layer using Linux epoll.
+ */
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/TimeUtils.h>
+#include <platform/LockTracker.h>
+#include <system/SystemFaultInjection.h>
+#include <system/SystemLayer.h>
+#include <system/SystemLayerImplEpoll.h>
+
+#include <algorithm>
+#include <errno.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+// Choose an approximation of PTHREAD_NULL if pthread.h doesn't define one.
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING && !defined(PTHREAD_NULL)
+#define PTHREAD_NULL 0
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING && !defined(PTHREAD_NULL)
+
+namespace chip {
+namespace System {
+
+namespace {
+
+constexpr Clock::Seconds64 kDefaultMinSleepPeriod = Clock::Seconds64(60 * 60 * 24 * 30); // Month [sec]
+
+// Sockets are watched level-triggered, like select(): a callback that does not drain a socket is called again.
+uint32_t EpollEventsFor(SocketEvents pendingIO)
+{
+    return (pendingIO.Has(SocketEventFlags::kRead) ? static_cast<uint32_t>(EPOLLIN) : 0u) |
+        (pendingIO.Has(SocketEventFlags::kWrite) ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+}
+
+SocketEvents SocketEventsFromEpoll(uint32_t events, SocketEvents pendingIO)
+{
+    SocketEvents res;
+
+    // As with select(), errors and hang-ups make the socket readable and writable, so that the callback sees them.
+    bool failed = (events & (EPOLLERR | EPOLLHUP)) != 0;
+    if (pendingIO.Has(SocketEventFlags::kRead) && (failed || (events & EPOLLIN) != 0))
+    {
+        res.Set(SocketEventFlags::kRead);
+    }
+    if (pendingIO.Has(SocketEventFlags::kWrite) && (failed || (events & EPOLLOUT) != 0))
+    {
+        res.Set(SocketEventFlags::kWrite);
+    }
+
+    return res;
+}
+
+} // namespace
+
+CHIP_ERROR LayerImplEpoll::Init()
+{
+    VerifyOrReturnError(mLayerState.SetInitializing(), CHIP_ERROR_INCORRECT_STATE);
+
+    RegisterPOSIXErrorFormatter();
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    mHandleEventsThread = PTHREAD_NULL;
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+    mEpollFd = epoll_create1(EPOLL_CLOEXEC);
+    VerifyOrReturnError(mEpollFd != -1, CHIP_ERROR_POSIX(errno));
+
+    mTimerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    VerifyOrReturnError(mTimerFd != -1, CHIP_ERROR_POSIX(errno));
+    mTimerFdAwakenTime = Clock::kZero;
+
+    // The timerfd is the only entry of the epoll set without a SocketWatch.
+    struct epoll_event event = {};
+    event.events             = EPOLLIN;
+    event.data.ptr           = nullptr;
+    VerifyOrReturnError(epoll_ctl(mEpollFd, EPOLL_CTL_ADD, mTimerFd, &event) == 0, CHIP_ERROR_POSIX(errno));
+
+    // Create an event to allow an arbitrary thread to wake the thread in the epoll loop.
+    ReturnErrorOnFailure(mWakeEvent.Open(*this));
+
+    VerifyOrReturnError(mLayerState.SetInitialized(), CHIP_ERROR_INCORRECT_STATE);
+    return CHIP_NO_ERROR;
+}
+
+void LayerImplEpoll::Shutdown()
+{
+    VerifyOrReturn(mLayerState.SetShuttingDown());
+
+    mTimerList.Clear();
+    mTimerPool.ReleaseAll();
+
+    mWakeEvent.Close(*this);
+
+    mSocketWatchPool.ReleaseAll();
+    mStoppedWatches = nullptr;
+
+    VerifyOrDie(close(mTimerFd) == 0);
+    VerifyOrDie(close(mEpollFd) == 0);
+    mTimerFd = -1;
+    mEpollFd = -1;
+
+    mLayerState.ResetFromShuttingDown(); // Return to uninitialized state to permit re-initialization.
+}
+
+void LayerImplEpoll::Signal()
+{
+    /*
+     * Wake up the I/O thread by setting the wake event.
+     *
+     * If this is being called from within an I/O event callback, then setting the event can be skipped,
+     * since the I/O thread is already awake.
+     */
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    if (pthread_equal(mHandleEventsThread, pthread_self()))
+    {
+        return;
+    }
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+    CHIP_ERROR status = mWakeEvent.Notify();
+    if (status != CHIP_NO_ERROR)
+    {
+        ChipLogError(chipSystemLayer, "System wake event notify failed: %" CHIP_ERROR_FORMAT, status.Format());
+    }
+}
+
+CHIP_ERROR LayerImplEpoll::StartTimer(Clock::Timeout delay, TimerCompleteCallback onComplete, void * appState)
+{
+    assertChipStackLockedByCurrentThread();
+
+    VerifyOrReturnError(mLayerState.IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+
+    CHIP_SYSTEM_FAULT_INJECT(FaultInjection::kFault_TimeoutImmediate, delay = System::Clock::kZero);
+
+    CancelTimer(onComplete, appState);
+
+    TimerList::Node * timer = mTimerPool.Create(*this, SystemClock().GetMonotonicTimestamp() + delay, onComplete, appState);
+    VerifyOrReturnError(timer != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    if (mTimerList.Add(timer) == timer)
+    {
+        // The new timer is the earliest, so the time until the next event has probably changed.
+        Signal();
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR LayerImplEpoll::ExtendTimerTo(Clock::Timeout delay, TimerCompleteCallback onComplete, void * appState)
+{
+    VerifyOrReturnError(delay.count() > 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    assertChipStackLockedByCurrentThread();
+
+    Clock::Timeout remainingTime = mTimerList.GetRemainingTime(onComplete, appState);
+    if (remainingTime.count() < delay.count())
+    {
+        if (remainingTime == Clock::kZero)
+        {
+            // If remaining time is Clock::kZero, it might possible that our timer is in
+            // the mExpiredTimers list and about to be fired. Remove it from that list, since we are extending it.
+            mExpiredTimers.Remove(onComplete, appState);
+        }
+        return StartTimer(delay, onComplete, appState);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+bool LayerImplEpoll::IsTimerActive(TimerCompleteCallback onComplete, void * appState)
+{
+    bool timerIsActive = (mTimerList.GetRemainingTime(onComplete, appState) > Clock::kZero);
+
+    if (!timerIsActive)
+    {
+        // check if the timer is in the mExpiredTimers list about to be fired.
+        for (TimerList::Node * timer = mExpiredTimers.Earliest(); timer != nullptr; timer = timer->mNextTimer)
+        {
+            if (timer->GetCallback().GetOnComplete() == onComplete && timer->GetCallback().GetAppState() == appState)
+            {
+                return true;
+            }
+        }
+    }
+
+    return timerIsActive;
+}
+
+void LayerImplEpoll::CancelTimer(TimerCompleteCallback onComplete, void * appState)
+{
+    assertChipStackLockedByCurrentThread();
+
+    VerifyOrReturn(mLayerState.IsInitialized());
+
+    TimerList::Node * timer = mTimerList.Remove(onComplete, appState);
+    if (timer == nullptr)
+    {
+        // The timer might be in the chunk of expired timers being fired, cancel it there too.
+        timer = mExpiredTimers.Remove(onComplete, appState);
+    }
+    VerifyOrReturn(timer != nullptr);
+
+    mTimerPool.Release(timer);
+    Signal();
+}
+
+CHIP_ERROR LayerImplEpoll::ScheduleWork(TimerCompleteCallback onComplete, void * appState)
+{
+    assertChipStackLockedByCurrentThread();
+
+    VerifyOrReturnError(mLayerState.IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+
+    // Same as LayerImplSelect: use an expires-ASAP timer, without cancelling existing timers with the same callback and
+    // appState, so that ScheduleWork invocations don't stomp on each other.
+    TimerList::Node * timer = mTimerPool.Create(*this, SystemClock().GetMonotonicTimestamp(), onComplete, appState);
+    VerifyOrReturnError(timer != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    if (mTimerList.Add(timer) == timer)
+    {
+        // The new timer is the earliest, so the time until the next event has probably changed.
+        Signal();
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR LayerImplEpoll::StartWatchingSocket(int fd, SocketWatchToken * tokenOut)
+{
+    VerifyOrReturnError(fd >= 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    // The socket only enters the epoll set once a callback is requested, so look for a duplicate registration here.
+    bool duplicate = false;
+    mSocketWatchPool.ForEachActiveObject([&](SocketWatch * w) {
+        duplicate = (w->mFD == fd);
+        return duplicate ? Loop::Break : Loop::Continue;
+    });
+    VerifyOrReturnError(!duplicate, CHIP_ERROR_INVALID_ARGUMENT);
+
+    SocketWatch * watch = mSocketWatchPool.CreateObject(fd);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_ENDPOINT_POOL_FULL);
+
+    *tokenOut = reinterpret_cast<SocketWatchToken>(watch);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR LayerImplEpoll::SetCallback(SocketWatchToken token, SocketWatchCallback callback, intptr_t data)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    watch->mCallback     = callback;
+    watch->mCallbackData = data;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR LayerImplEpoll::RequestCallbackOnPendingRead(SocketWatchToken token)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    watch->mPendingIO.Set(SocketEventFlags::kRead);
+    return UpdateRegistration(*watch);
+}
+
+CHIP_ERROR LayerImplEpoll::RequestCallbackOnPendingWrite(SocketWatchToken token)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    watch->mPendingIO.Set(SocketEventFlags::kWrite);
+    return UpdateRegistration(*watch);
+}
+
+CHIP_ERROR LayerImplEpoll::ClearCallbackOnPendingRead(SocketWatchToken token)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    watch->mPendingIO.Clear(SocketEventFlags::kRead);
+    return UpdateRegistration(*watch);
+}
+
+CHIP_ERROR LayerImplEpoll::ClearCallbackOnPendingWrite(SocketWatchToken token)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    watch->mPendingIO.Clear(SocketEventFlags::kWrite);
+    return UpdateRegistration(*watch);
+}
+
+CHIP_ERROR LayerImplEpoll::StopWatchingSocket(SocketWatchToken * tokenInOut)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(*tokenInOut);
+    *tokenInOut         = InvalidSocketWatchToken();
+
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(watch->mFD >= 0, CHIP_ERROR_INCORRECT_STATE);
+
+    watch->mPendingIO.ClearAll();
+    CHIP_ERROR err = UpdateRegistration(*watch);
+    watch->mFD     = kInvalidFd;
+
+    if (mHandlingEvents)
+    {
+        // Events for this watch may still be pending in mEvents: keep it until they have been skipped.
+        watch->mNextStopped = mStoppedWatches;
+        mStoppedWatches     = watch;
+    }
+    else
+    {
+        mSocketWatchPool.ReleaseObject(watch);
+    }
+
+    return err;
+}
+
+CHIP_ERROR LayerImplEpoll::UpdateRegistration(SocketWatch & watch)
+{
+    uint32_t events = EpollEventsFor(watch.mPendingIO);
+    VerifyOrReturnError(events != watch.mRegisteredEvents, CHIP_NO_ERROR);
+
+    // Sockets without requested events are kept out of the epoll set, which would otherwise report their errors and
+    // hang-ups with nobody to handle them.
+    struct epoll_event event = {};
+    event.events             = events;
+    event.data.ptr           = &watch;
+
+    int op = EPOLL_CTL_MOD;
+    if (watch.mRegisteredEvents == 0)
+    {
+        op = EPOLL_CTL_ADD;
+    }
+    else if (events == 0)
+    {
+        op = EPOLL_CTL_DEL;
+    }
+
+    if (epoll_ctl(mEpollFd, op, watch.mFD, &event) != 0)
+    {
+        CHIP_ERROR err = CHIP_ERROR_POSIX(errno);
+        ChipLogError(chipSystemLayer, "epoll_ctl failed for fd %d: %" CHIP_ERROR_FORMAT, watch.mFD, err.Format());
+        return err;
+    }
+
+    watch.mRegisteredEvents = events;
+    return CHIP_NO_ERROR;
+}
+
+void LayerImplEpoll::ArmTimerFd(Clock::Timestamp awakenTime, Clock::Timestamp currentTime)
+{
+    VerifyOrReturn(awakenTime != mTimerFdAwakenTime);
+
+    // Arm with a relative delay: the System::Clock may not be CLOCK_MONOTONIC, and is replaced by a mock in tests.
+    Clock::Microseconds64 delay = awakenTime - currentTime;
+
+    struct itimerspec spec = {};
+    spec.it_value.tv_sec   = static_cast<time_t>(delay.count() / kMicrosecondsPerSecond);
+    spec.it_value.tv_nsec  = static_cast<long>((delay.count() % kMicrosecondsPerSecond) * 1000);
+
+    if (timerfd_settime(mTimerFd, 0, &spec, nullptr) != 0)
+    {
+        ChipLogError(chipSystemLayer, "timerfd_settime failed: %" CHIP_ERROR_FORMAT, CHIP_ERROR_POSIX(errno).Format());
+
+        // Fall back to polling on the epoll_wait() timeout.
+        mTimerFdAwakenTime = Clock::kZero;
+        uint64_t delayMs   = std::chrono::duration_cast<Clock::Milliseconds64>(delay).count() + 1;
+        mWaitTimeout       = static_cast<int>(std::min<uint64_t>(delayMs, INT32_MAX));
+        return;
+    }
+
+    mTimerFdAwakenTime = awakenTime;
+}
+
+void LayerImplEpoll::PrepareEvents()
+{
+    assertChipStackLockedByCurrentThread();
+
+    const Clock::Timestamp currentTime = SystemClock().GetMonotonicTimestamp();
+    Clock::Timestamp awakenTime        = currentTime + kDefaultMinSleepPeriod;
+
+    TimerList::Node * timer = mTimerList.Earliest();
+    if (timer && timer->AwakenTime() < awakenTime)
+    {
+        awakenTime = timer->AwakenTime();
+    }
+
+    mWaitTimeout = -1;
+    if (awakenTime <= currentTime)
+    {
+        // A timer is already due: poll the sockets and handle it right away.
+        mWaitTimeout = 0;
+        return;
+    }
+
+    ArmTimerFd(awakenTime, currentTime);
+}
+
+void LayerImplEpoll::WaitForEvents()
+{
+    mEventCount = epoll_wait(mEpollFd, mEvents, kMaxEventsPerWait, mWaitTimeout);
+}
+
+void LayerImplEpoll::HandleEvents()
+{
+    assertChipStackLockedByCurrentThread();
+
+    if (!IsSelectResultValid())
+    {
+        if (errno != EINTR)
+        {
+            ChipLogError(DeviceLayer, "epoll_wait failed: %" CHIP_ERROR_FORMAT, CHIP_ERROR_POSIX(errno).Format());
+        }
+        return;
+    }
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    mHandleEventsThread = pthread_self();
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+    // Obtain the list of currently expired timers. Any new timers added by timer callback are NOT handled on this pass,
+    // since that could result in infinite handling of new timers blocking any other progress.
+    VerifyOrDieWithMsg(mExpiredTimers.Empty(), DeviceLayer, "Re-entry into HandleEvents from a timer callback?");
+    mExpiredTimers          = mTimerList.ExtractEarlier(Clock::Timeout(1) + SystemClock().GetMonotonicTimestamp());
+    TimerList::Node * timer = nullptr;
+    while ((timer = mExpiredTimers.PopEarliest()) != nullptr)
+    {
+        mTimerPool.Invoke(timer);
+    }
+
+    mHandlingEvents = true;
+    for (int i = 0; i < mEventCount; i++)
+    {
+        SocketWatch * watch = static_cast<SocketWatch *>(mEvents[i].data.ptr);
+        if (watch == nullptr)
+        {
+            // The timerfd fired: consume the expiration so that it gets rearmed for the next timer.
+            uint64_t expirations;
+            (void) ::read(mTimerFd, &expirations, sizeof(expirations));
+            mTimerFdAwakenTime = Clock::kZero;
+            continue;
+        }
+
+        // The watch may have been stopped, or stopped listening for these events, by an earlier callback.
+        SocketEvents events = SocketEventsFromEpoll(mEvents[i].events, watch->mPendingIO);
+        if (watch->mFD != kInvalidFd && events.HasAny() && watch->mCallback != nullptr)
+        {
+            watch->mCallback(events, watch->mCallbackData);
+        }
+    }
+    mHandlingEvents = false;
+
+    while (mStoppedWatches != nullptr)
+    {
+        SocketWatch * watch = mStoppedWatches;
+        mStoppedWatches     = watch->mNextStopped;
+        mSocketWatchPool.ReleaseObject(watch);
+    }
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    mHandleEventsThread = PTHREAD_NULL;
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+}
+
+} // namespace System
+} // namespace chip
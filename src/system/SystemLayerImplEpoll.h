@@ -0,0 +1,146 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file declares an implementation of System::Layer using Linux epoll.
+ *
+ *      Unlike LayerImplSelect, the set of watched sockets is kept by the kernel and only updated when a watch changes,
+ *      and each wakeup only visits the sockets that have events, so the cost of a loop iteration does not depend on the
+ *      number of watched sockets.  The earliest timer is armed on a timerfd, which is only reprogrammed when it changes.
+ */
+
+#pragma once
+
+#include <sys/epoll.h>
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+#include <atomic>
+#include <pthread.h>
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+#if CHIP_SYSTEM_CONFIG_USE_DISPATCH || CHIP_SYSTEM_CONFIG_USE_LIBEV
+#error "LayerImplEpoll runs its own event loop and cannot be used with CHIP_SYSTEM_CONFIG_USE_DISPATCH or _USE_LIBEV"
+#endif
+
+#include <lib/support/ObjectLifeCycle.h>
+#include <lib/support/Pool.h>
+#include <system/SystemLayer.h>
+#include <system/SystemTimer.h>
+#include <system/WakeEvent.h>
+
+namespace chip {
+namespace System {
+
+class LayerImplEpoll : public LayerSocketsLoop
+{
+public:
+    LayerImplEpoll() = default;
+    ~LayerImplEpoll() override { VerifyOrDie(mLayerState.Destroy()); }
+
+    // Layer overrides.
+    CHIP_ERROR Init() override;
+    void Shutdown() override;
+    bool IsInitialized() const override { return mLayerState.IsInitialized(); }
+    CHIP_ERROR StartTimer(Clock::Timeout delay, TimerCompleteCallback onComplete, void * appState) override;
+    CHIP_ERROR ExtendTimerTo(Clock::Timeout delay, TimerCompleteCallback onComplete, void * appState) override;
+    bool IsTimerActive(TimerCompleteCallback onComplete, void * appState) override;
+    void CancelTimer(TimerCompleteCallback onComplete, void * appState) override;
+    CHIP_ERROR ScheduleWork(TimerCompleteCallback onComplete, void * appState) override;
+
+    // LayerSocket overrides.
+    CHIP_ERROR StartWatchingSocket(int fd, SocketWatchToken * tokenOut) override;
+    CHIP_ERROR SetCallback(SocketWatchToken token, SocketWatchCallback callback, intptr_t data) override;
+    CHIP_ERROR RequestCallbackOnPendingRead(SocketWatchToken token) override;
+    CHIP_ERROR RequestCallbackOnPendingWrite(SocketWatchToken token) override;
+    CHIP_ERROR ClearCallbackOnPendingRead(SocketWatchToken token) override;
+    CHIP_ERROR ClearCallbackOnPendingWrite(SocketWatchToken token) override;
+    CHIP_ERROR StopWatchingSocket(SocketWatchToken * tokenInOut) override;
+    SocketWatchToken InvalidSocketWatchToken() override { return reinterpret_cast<SocketWatchToken>(nullptr); }
+
+    // LayerSocketLoop overrides.
+    void Signal() override;
+    void EventLoopBegins() override {}
+    void PrepareEvents() override;
+    void WaitForEvents() override;
+    void HandleEvents() override;
+    void EventLoopEnds() override {}
+
+    // Expose the result of WaitForEvents() for non-blocking socket implementations.
+    bool IsSelectResultValid() const { return mEventCount >= 0; }
+
+protected:
+    static constexpr int kSocketWatchMax = (INET_CONFIG_ENABLE_TCP_ENDPOINT ? INET_CONFIG_NUM_TCP_ENDPOINTS : 0) +
+        (INET_CONFIG_ENABLE_UDP_ENDPOINT ? INET_CONFIG_NUM_UDP_ENDPOINTS : 0);
+
+    // Number of events retrieved by a single epoll_wait().  Sockets that remain ready are reported again on the next wait.
+    static constexpr int kMaxEventsPerWait = 64;
+
+    struct SocketWatch
+    {
+        explicit SocketWatch(int fd) : mFD(fd) {}
+
+        int mFD;
+        SocketEvents mPendingIO;
+        SocketWatchCallback mCallback = nullptr;
+        intptr_t mCallbackData        = 0;
+
+        // Events the socket is registered for in the epoll set, 0 while it is not in the set.
+        uint32_t mRegisteredEvents = 0;
+
+        // Watches stopped while events are handled are only released once all the events returned by epoll_wait() are.
+        SocketWatch * mNextStopped = nullptr;
+    };
+
+    CHIP_ERROR UpdateRegistration(SocketWatch & watch);
+    void ArmTimerFd(Clock::Timestamp awakenTime, Clock::Timestamp currentTime);
+
+    ObjectPool<SocketWatch, kSocketWatchMax> mSocketWatchPool;
+    SocketWatch * mStoppedWatches = nullptr;
+
+    TimerPool<TimerList::Node> mTimerPool;
+    TimerQueue mTimerList;
+    // List of expired timers being processed right now.  Stored in a member so
+    // we can cancel them.
+    TimerList mExpiredTimers;
+
+    int mEpollFd = -1;
+    int mTimerFd = -1;
+
+    // Expiration time the timerfd is armed for, kZero if disarmed.
+    Clock::Timestamp mTimerFdAwakenTime = Clock::kZero;
+
+    // Timeout of the next epoll_wait(), in milliseconds: 0 when a timer is already due, -1 to only wait for events.
+    int mWaitTimeout = -1;
+
+    // Events returned by epoll_wait(), carried between WaitForEvents() and HandleEvents().
+    struct epoll_event mEvents[kMaxEventsPerWait];
+    int mEventCount      = 0;
+    bool mHandlingEvents = false;
+
+    ObjectLifeCycle mLayerState;
+    WakeEvent mWakeEvent;
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    std::atomic<pthread_t> mHandleEventsThread;
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+};
+
+using LayerImpl = LayerImplEpoll;
+
+} // namespace System
+} // namespace chip
@@ -65,16 +65,8 @@
 namespace chip {
 namespace System {
 
-#if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL
-//
-// Pool allocation for PacketBuffer objects.
-//
-
-PacketBuffer::BufferPoolElement PacketBuffer::sBufferPool[CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE];
-
-PacketBuffer * PacketBuffer::sFreeList = PacketBuffer::BuildFreeList();
-
-#if !CHIP_SYSTEM_CONFIG_NO_LOCKING
+#if (CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL || CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_SIZE_CLASSES) &&                                \
+    !CHIP_SYSTEM_CONFIG_NO_LOCKING
 static Mutex sBufferPoolMutex;
 
 #define LOCK_BUF_POOL()                                                                                                            \
@@ -89,6 +81,29 @@ static Mutex sBufferPoolMutex;
     } while (0)
 #endif // !CHIP_SYSTEM_CONFIG_NO_LOCKING
 
+#ifndef LOCK_BUF_POOL
+#define LOCK_BUF_POOL()                                                                                                            \
+    do                                                                                                                             \
+    {                                                                                                                              \
+    } while (0)
+#endif // !defined(LOCK_BUF_POOL)
+
+#ifndef UNLOCK_BUF_POOL
+#define UNLOCK_BUF_POOL()                                                                                                          \
+    do                                                                                                                             \
+    {                                                                                                                              \
+    } while (0)
+#endif // !defined(UNLOCK_BUF_POOL)
+
+#if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL
+//
+// Pool allocation for PacketBuffer objects.
+//
+
+PacketBuffer::BufferPoolElement PacketBuffer::sBufferPool[CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE];
+
+PacketBuffer * PacketBuffer::sFreeList = PacketBuffer::BuildFreeList();
+
 PacketBuffer * PacketBuffer::BuildFreeList()
 {
     pbuf * lHead = nullptr;
@@ -108,6 +123,105 @@ PacketBuffer * PacketBuffer::BuildFreeList()
     return static_cast<PacketBuffer *>(lHead);
 }
 
+#elif CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_SIZE_CLASSES
+//
+// Size-classed pool allocation for PacketBuffer objects.
+//
+
+PacketBuffer::SizeClassPoolElement<CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY>
+    PacketBuffer::sSmallBufferPool[CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_POOL_SIZE];
+PacketBuffer::SizeClassPoolElement<CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY>
+    PacketBuffer::sMediumBufferPool[CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_POOL_SIZE];
+PacketBuffer::SizeClassPoolElement<PacketBuffer::kMaxSizeWithoutReserve>
+    PacketBuffer::sLargeBufferPool[CHIP_SYSTEM_CONFIG_PACKETBUFFER_LARGE_POOL_SIZE];
+
+std::array<PacketBuffer::SizeClass, PacketBuffer::kNumSizeClasses> PacketBuffer::sSizeClasses = PacketBuffer::BuildSizeClasses();
+
+template <uint16_t kAllocSize, size_t N>
+PacketBuffer::SizeClass PacketBuffer::BuildSizeClass(SizeClassPoolElement<kAllocSize> (&aPool)[N])
+{
+    pbuf * lHead = nullptr;
+
+    for (size_t i = 0; i < N; i++)
+    {
+        pbuf * lCursor      = &aPool[i].Header;
+        lCursor->next       = lHead;
+        lCursor->ref        = 0;
+        lCursor->alloc_size = kAllocSize;
+        lHead               = lCursor;
+    }
+
+    return SizeClass{ static_cast<PacketBuffer *>(lHead), kAllocSize };
+}
+
+std::array<PacketBuffer::SizeClass, PacketBuffer::kNumSizeClasses> PacketBuffer::BuildSizeClasses()
+{
+    static_assert(CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY < CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY &&
+                      CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY < kMaxSizeWithoutReserve,
+                  "Packet buffer size classes must be ordered by increasing size");
+
+#if !CHIP_SYSTEM_CONFIG_NO_LOCKING
+    Mutex::Init(sBufferPoolMutex);
+#endif // !CHIP_SYSTEM_CONFIG_NO_LOCKING
+
+    return { { BuildSizeClass(sSmallBufferPool), BuildSizeClass(sMediumBufferPool), BuildSizeClass(sLargeBufferPool) } };
+}
+
+PacketBuffer * PacketBuffer::TakeFromSizeClasses(size_t aMinAllocSize, size_t aMaxAllocSize)
+{
+    PacketBuffer * lPacket = nullptr;
+
+    LOCK_BUF_POOL();
+
+    for (size_t i = 0; i < kNumSizeClasses && sSizeClasses[i].mAllocSize <= aMaxAllocSize; i++)
+    {
+        SizeClass & sizeClass = sSizeClasses[i];
+        if (sizeClass.mAllocSize >= aMinAllocSize && sizeClass.mFreeList != nullptr)
+        {
+            lPacket             = sizeClass.mFreeList;
+            sizeClass.mFreeList = lPacket->ChainedBuffer();
+            SYSTEM_STATS_INCREMENT(chip::System::Stats::kSystemLayer_NumPacketBufs);
+            SYSTEM_STATS_INCREMENT(chip::System::Stats::kSystemLayer_NumSmallPacketBufs + i);
+            break;
+        }
+    }
+
+    UNLOCK_BUF_POOL();
+
+    return lPacket;
+}
+
+void PacketBufferHandle::InternalRightSize()
+{
+    // Require a single buffer with no other references.
+    if ((mBuffer == nullptr) || mBuffer->HasChainedBuffer() || (mBuffer->ref != 1))
+    {
+        return;
+    }
+
+    // Move the data to a buffer of a smaller size class, if one is free.
+    const uint8_t * const start   = mBuffer->ReserveStart();
+    const uint8_t * const payload = mBuffer->Start();
+    const uint16_t usedSize       = static_cast<uint16_t>(payload - start + mBuffer->len);
+
+    PacketBuffer * newBuffer = PacketBuffer::TakeFromSizeClasses(usedSize, static_cast<size_t>(mBuffer->alloc_size - 1));
+    if (newBuffer == nullptr)
+    {
+        return;
+    }
+
+    uint8_t * const newStart = newBuffer->ReserveStart();
+    newBuffer->next          = nullptr;
+    newBuffer->payload       = newStart + (payload - start);
+    newBuffer->tot_len       = mBuffer->tot_len;
+    newBuffer->len           = mBuffer->len;
+    newBuffer->ref           = 1;
+    memcpy(newStart, start, usedSize);
+
+    PacketBuffer::Free(mBuffer);
+    mBuffer = newBuffer;
+}
+
 #elif CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
 //
 // Heap allocation for PacketBuffer objects.
@@ -182,20 +296,6 @@ void PacketBufferHandle::InternalRightSize()
 
 #endif
 
-#ifndef LOCK_BUF_POOL
-#define LOCK_BUF_POOL()                                                                                                            \
-    do                                                                                                                             \
-    {                                                                                                                              \
-    } while (0)
-#endif // !defined(LOCK_BUF_POOL)
-
-#ifndef UNLOCK_BUF_POOL
-#define UNLOCK_BUF_POOL()                                                                                                          \
-    do                                                                                                                             \
-    {                                                                                                                              \
-    } while (0)
-#endif // !defined(UNLOCK_BUF_POOL)
-
 void PacketBuffer::SetStart(uint8_t * aNewStart)
 {
     uint8_t * const kStart = ReserveStart();
@@ -525,6 +625,19 @@ PacketBufferHandle PacketBufferHandle::New(size_t aAvailableSize, uint16_t aRese
 
     UNLOCK_BUF_POOL();
 
+#elif CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_SIZE_CLASSES
+
+    static_cast<void>(lBlockSize);
+#if !CHIP_SYSTEM_CONFIG_NO_LOCKING && CHIP_SYSTEM_CONFIG_FREERTOS_LOCKING
+    if (!sBufferPoolMutex.isInitialized())
+    {
+        Mutex::Init(sBufferPoolMutex);
+    }
+#endif
+
+    // Take the smallest buffer that fits, or a larger one when the pool of that size is exhausted.
+    lPacket = PacketBuffer::TakeFromSizeClasses(lAllocSize, PacketBuffer::kMaxSizeWithoutReserve);
+
 #elif CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
 
     lPacket = reinterpret_cast<PacketBuffer *>(chip::Platform::MemoryAlloc(lBlockSize));
@@ -590,7 +703,8 @@ void PacketBuffer::Free(PacketBuffer * aPacket)
         SYSTEM_STATS_UPDATE_LWIP_PBUF_COUNTS();
     }
 
-#elif CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP || CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL
+#elif CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP || CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL ||                                   \
+    CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_SIZE_CLASSES
 
     LOCK_BUF_POOL();
 
@@ -611,6 +725,16 @@ void PacketBuffer::Free(PacketBuffer * aPacket)
 #if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL
             aPacket->next = sFreeList;
             sFreeList     = aPacket;
+#elif CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_SIZE_CLASSES
+            size_t i = 0;
+            while (sSizeClasses[i].mAllocSize != aPacket->alloc_size)
+            {
+                i++;
+                VerifyOrDieWithMsg(i < kNumSizeClasses, chipSystemLayer, "invalid packet buffer size %u", aPacket->alloc_size);
+            }
+            SYSTEM_STATS_DECREMENT(chip::System::Stats::kSystemLayer_NumSmallPacketBufs + i);
+            aPacket->next             = sSizeClasses[i].mFreeList;
+            sSizeClasses[i].mFreeList = aPacket;
 #elif CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
             chip::Platform::MemoryFree(aPacket);
 #endif
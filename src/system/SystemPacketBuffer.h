@@ -35,6 +35,7 @@
 #include <system/SystemAlignSize.h>
 #include <system/SystemError.h>
 
+#include <array>
 #include <stddef.h>
 #include <utility>
 
@@ -59,7 +60,7 @@ struct pbuf
     uint16_t tot_len;
     uint16_t len;
     uint16_t ref;
-#if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
+#if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP || CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_SIZE_CLASSES
     uint16_t alloc_size;
 #endif
 };
@@ -73,7 +74,8 @@ struct pbuf
  *
  *      In LwIP-based environments, this class is built on top of the pbuf structure defined in that library. In the absence of
  *      LwIP, chip provides either a malloc-based implementation, or a pool-based implementation that closely approximates the
- *      memory challenges of deeply embedded devices.
+ *      memory challenges of deeply embedded devices, with either a single pool of maximum size buffers or pools of small,
+ *      medium and maximum size buffers (see #CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES).
  *
  *      The PacketBuffer class, like many similar structures used in layered network stacks, provide a mechanism to reserve space
  *      for protocol headers at each layer of a configurable communication stack.  For details, see `PacketBufferHandle::New()`
@@ -152,7 +154,7 @@ public:
     {
 #if CHIP_SYSTEM_PACKETBUFFER_FROM_LWIP_STANDARD_POOL || CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL
         return kMaxSizeWithoutReserve;
-#elif CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
+#elif CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP || CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_SIZE_CLASSES
         return this->alloc_size;
 #elif CHIP_SYSTEM_PACKETBUFFER_FROM_LWIP_CUSTOM_POOL
         // Temporary workaround for custom pbufs by assuming size to be PBUF_POOL_BUFSIZE
@@ -369,6 +371,38 @@ private:
     static PacketBuffer * BuildFreeList();
 #endif // CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL || defined(DOXYGEN)
 
+#if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_SIZE_CLASSES || defined(DOXYGEN)
+    template <uint16_t kAllocSize>
+    union SizeClassPoolElement
+    {
+        pbuf Header;
+        uint8_t Block[PacketBuffer::kStructureSize + kAllocSize];
+    };
+
+    // A pool of buffers of the same size. Buffers are allocated from the first class that fits, so classes are ordered by
+    // increasing size.
+    struct SizeClass
+    {
+        PacketBuffer * mFreeList;
+        uint16_t mAllocSize;
+    };
+    static constexpr size_t kNumSizeClasses = 3;
+
+    static SizeClassPoolElement<CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY>
+        sSmallBufferPool[CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_POOL_SIZE];
+    static SizeClassPoolElement<CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY>
+        sMediumBufferPool[CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_POOL_SIZE];
+    static SizeClassPoolElement<kMaxSizeWithoutReserve> sLargeBufferPool[CHIP_SYSTEM_CONFIG_PACKETBUFFER_LARGE_POOL_SIZE];
+    static std::array<SizeClass, kNumSizeClasses> sSizeClasses;
+
+    template <uint16_t kAllocSize, size_t N>
+    static SizeClass BuildSizeClass(SizeClassPoolElement<kAllocSize> (&aPool)[N]);
+    static std::array<SizeClass, kNumSizeClasses> BuildSizeClasses();
+
+    // Takes a free buffer from the smallest size class of at least aMinAllocSize and at most aMaxAllocSize bytes.
+    static PacketBuffer * TakeFromSizeClasses(size_t aMinAllocSize, size_t aMaxAllocSize);
+#endif // CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_SIZE_CLASSES || defined(DOXYGEN)
+
 #if CHIP_SYSTEM_PACKETBUFFER_HAS_CHECK
     static void InternalCheck(const PacketBuffer * buffer);
 #endif
@@ -32,7 +32,8 @@
  *
  * True if packet buffers are allocated in the SDK using Platform::MemoryAlloc.
  */
-#if !CHIP_SYSTEM_CONFIG_USE_LWIP && (CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE == 0)
+#if !CHIP_SYSTEM_CONFIG_USE_LWIP && (CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE == 0) &&                                            \
+    !CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
 #define CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP 1
 #else
 #define CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP 0
@@ -43,12 +44,23 @@
  *
  * True if packet buffers are allocated in the SDK using an internal pool.
  */
-#if !CHIP_SYSTEM_CONFIG_USE_LWIP && (CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE > 0)
+#if !CHIP_SYSTEM_CONFIG_USE_LWIP && (CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE > 0) && !CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
 #define CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL 1
 #else
 #define CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL 0
 #endif
 
+/**
+ * CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_SIZE_CLASSES
+ *
+ * True if packet buffers are allocated in the SDK using internal pools of small, medium and maximum size buffers.
+ */
+#if !CHIP_SYSTEM_CONFIG_USE_LWIP && CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+#define CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_SIZE_CLASSES 1
+#else
+#define CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_SIZE_CLASSES 0
+#endif
+
 /**
  * CHIP_SYSTEM_PACKETBUFFER_FROM_LWIP_POOL
  *
@@ -87,7 +99,8 @@
  *
  * True if RightSize() has a nontrivial implementation.
  */
-#if CHIP_SYSTEM_PACKETBUFFER_FROM_LWIP_CUSTOM_POOL || CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
+#if CHIP_SYSTEM_PACKETBUFFER_FROM_LWIP_CUSTOM_POOL || CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP ||                                   \
+    CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_SIZE_CLASSES
 #define CHIP_SYSTEM_PACKETBUFFER_HAS_RIGHTSIZE 1
 #else
 #define CHIP_SYSTEM_PACKETBUFFER_HAS_RIGHTSIZE 0
@@ -106,7 +119,8 @@
 
 // Sanity checks
 
-#if (CHIP_SYSTEM_CONFIG_USE_LWIP + CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP + CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL) != 1
+#if (CHIP_SYSTEM_CONFIG_USE_LWIP + CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP + CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL +             \
+     CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_SIZE_CLASSES) != 1
 #error "Inconsistent PacketBuffer allocation configuration"
 #endif
 
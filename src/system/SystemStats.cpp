@@ -44,6 +44,11 @@ static const Label sStatsStrings[chip::System::Stats::kNumEntries] = {
 #undef LWIP_PBUF_MEMPOOL
 #else
     "SystemLayer_NumPacketBufs",
+#endif
+#if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_SIZE_CLASSES
+    "SystemLayer_NumSmallPacketBufs",
+    "SystemLayer_NumMediumPacketBufs",
+    "SystemLayer_NumLargePacketBufs",
 #endif
     "SystemLayer_NumTimersInUse",
 #if INET_CONFIG_NUM_TCP_ENDPOINTS
@@ -33,6 +33,7 @@
 #include <system/SystemFaultInjection.h>
 #include <system/SystemLayer.h>
 
+#include <lib/support/CHIPMem.h>
 #include <lib/support/CodeUtils.h>
 
 namespace chip {
@@ -178,5 +179,415 @@ Clock::Timeout TimerList::GetRemainingTime(TimerCompleteCallback aOnComplete, vo
     return Clock::kZero;
 }
 
+#if CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
+namespace {
+
+// Clear the bits of v below bit @a bits, which may be 64 or more.
+uint64_t ClearBitsBelow(uint64_t v, unsigned bits)
+{
+    return (bits >= 64) ? 0 : (v & ~((static_cast<uint64_t>(1) << bits) - 1));
+}
+
+} // namespace
+
+TimerWheel::TimerWheel() : mBuckets(mInlineBuckets), mBucketCount(kInlineBucketCount)
+{
+    Clear();
+}
+
+TimerWheel::~TimerWheel()
+{
+    ResetIndex();
+}
+
+bool TimerWheel::IsBefore(const Node * a, const Node * b)
+{
+    if (a->AwakenTime() != b->AwakenTime())
+    {
+        return a->AwakenTime() < b->AwakenTime();
+    }
+    // Timers expiring at the same time stay in the order they were added, as in TimerList.
+    return static_cast<int32_t>(a->mSequence - b->mSequence) < 0;
+}
+
+size_t TimerWheel::BucketFor(TimerCompleteCallback onComplete, void * appState) const
+{
+    uint64_t hash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(appState)) * 0x9E3779B97F4A7C15ull;
+    hash ^= static_cast<uint64_t>(reinterpret_cast<uintptr_t>(onComplete));
+    hash ^= hash >> 29;
+    return static_cast<size_t>(hash) & (mBucketCount - 1);
+}
+
+TimerWheel::Node * TimerWheel::Add(Node * add)
+{
+    VerifyOrDie(add->mWheelSlot == kNotQueued);
+
+    add->mSequence = mNextSequence++;
+    Place(add);
+    if (mEarliest != nullptr && IsBefore(add, mEarliest))
+    {
+        mEarliest = add;
+    }
+
+    size_t bucket      = BucketFor(add->GetCallback().GetOnComplete(), add->GetCallback().GetAppState());
+    add->mNextInBucket = mBuckets[bucket];
+    mBuckets[bucket]   = add;
+    if (++mCount > 2 * mBucketCount)
+    {
+        GrowIndex();
+    }
+
+    return Earliest();
+}
+
+TimerWheel::Node * TimerWheel::Remove(Node * remove)
+{
+    if (remove != nullptr && remove->mWheelSlot != kNotQueued)
+    {
+        Detach(remove);
+    }
+    return Earliest();
+}
+
+TimerWheel::Node * TimerWheel::Remove(TimerCompleteCallback aOnComplete, void * aAppState)
+{
+    Node * timer = Find(aOnComplete, aAppState);
+    if (timer != nullptr)
+    {
+        Detach(timer);
+    }
+    return timer;
+}
+
+TimerWheel::Node * TimerWheel::PopEarliest()
+{
+    Node * earliest = Earliest();
+    if (earliest != nullptr)
+    {
+        Detach(earliest);
+    }
+    return earliest;
+}
+
+TimerWheel::Node * TimerWheel::PopIfEarlier(Clock::Timestamp t)
+{
+    Node * earliest;
+    while ((earliest = Earliest()) != nullptr && earliest->AwakenTime() < t && earliest->mWheelSlot >= kSlotsPerLevel &&
+           earliest->mWheelSlot != kDueSlot)
+    {
+        // Time has reached the slot of the earliest timer: spread the slot over the lower levels, so that the timers
+        // that follow it are found without searching the slot again.
+        AdvanceTo(SlotStart(earliest->mWheelSlot));
+    }
+
+    if (earliest == nullptr || !(earliest->AwakenTime() < t))
+    {
+        return nullptr;
+    }
+    Detach(earliest);
+    return earliest;
+}
+
+TimerWheel::Node * TimerWheel::Earliest()
+{
+    VerifyOrReturnValue(mEarliest == nullptr, mEarliest);
+
+    if (mSlots[kDueSlot] != nullptr)
+    {
+        mEarliest = mSlots[kDueSlot];
+        return mEarliest;
+    }
+
+    unsigned level = 0;
+    while (level < kLevels && mOccupiedSlots[level] == 0)
+    {
+        level++;
+    }
+    VerifyOrReturnValue(level < kLevels, nullptr);
+
+    // Timers at lower levels expire before those at higher levels, and the timers of a level 0 slot are in order.  The
+    // current time of the wheel is not moved to the slot here, since timers may still be added before it.
+    Node * head = mSlots[level * kSlotsPerLevel + static_cast<unsigned>(__builtin_ctzll(mOccupiedSlots[level]))];
+    mEarliest   = head;
+    if (level > 0)
+    {
+        for (Node * timer = head->mNextTimer; timer != head; timer = timer->mNextTimer)
+        {
+            if (IsBefore(timer, mEarliest))
+            {
+                mEarliest = timer;
+            }
+        }
+    }
+    return mEarliest;
+}
+
+TimerList TimerWheel::ExtractEarlier(Clock::Timestamp t)
+{
+    TimerList out;
+    Node * last = nullptr;
+
+    Node * timer;
+    while ((timer = PopIfEarlier(t)) != nullptr)
+    {
+        if (last == nullptr)
+        {
+            out.mEarliestTimer = timer;
+        }
+        else
+        {
+            last->mNextTimer = timer;
+        }
+        last = timer;
+    }
+
+    // All remaining timers expire at or after t: keep the current time of the wheel close to the actual time, so that new
+    // timers are added at low levels.
+    uint64_t now = t.count();
+    if (now > 0 && now - 1 > mNow)
+    {
+        AdvanceTo(now - 1);
+    }
+
+    return out;
+}
+
+void TimerWheel::Clear()
+{
+    memset(mSlots, 0, sizeof(mSlots));
+    memset(mOccupiedSlots, 0, sizeof(mOccupiedSlots));
+    mEarliest     = nullptr;
+    mNow          = 0;
+    mCount        = 0;
+    mNextSequence = 0;
+    ResetIndex();
+}
+
+Clock::Timeout TimerWheel::GetRemainingTime(TimerCompleteCallback aOnComplete, void * aAppState)
+{
+    Node * timer = Find(aOnComplete, aAppState);
+    if (timer != nullptr)
+    {
+        Clock::Timestamp currentTime = SystemClock().GetMonotonicTimestamp();
+
+        if (currentTime < timer->AwakenTime())
+        {
+            return Clock::Timeout(timer->AwakenTime() - currentTime);
+        }
+    }
+    return Clock::kZero;
+}
+
+void TimerWheel::Place(Node * timer)
+{
+    uint64_t awakenTime = timer->AwakenTime().count();
+    if (awakenTime <= mNow)
+    {
+        LinkOrdered(kDueSlot, timer);
+        return;
+    }
+
+    unsigned level = static_cast<unsigned>(63 - __builtin_clzll(awakenTime ^ mNow)) / kSlotBits;
+    unsigned digit = static_cast<unsigned>(awakenTime >> (level * kSlotBits)) & (kSlotsPerLevel - 1);
+    uint16_t slot  = static_cast<uint16_t>(level * kSlotsPerLevel + digit);
+    if (level == 0)
+    {
+        // Timers moved down from higher levels may have been added before the timers already in the slot.
+        LinkOrdered(slot, timer);
+    }
+    else
+    {
+        LinkLast(slot, timer);
+    }
+}
+
+uint64_t TimerWheel::SlotStart(uint16_t slot) const
+{
+    unsigned shift = (slot / kSlotsPerLevel) * kSlotBits;
+    return ClearBitsBelow(mNow, shift + kSlotBits) | (static_cast<uint64_t>(slot % kSlotsPerLevel) << shift);
+}
+
+void TimerWheel::LinkLast(uint16_t slot, Node * timer)
+{
+    Node *& head = mSlots[slot];
+    if (head == nullptr)
+    {
+        timer->mNextTimer = timer;
+        timer->mPrevTimer = timer;
+        head              = timer;
+        if (slot != kDueSlot)
+        {
+            mOccupiedSlots[slot / kSlotsPerLevel] |= static_cast<uint64_t>(1) << (slot % kSlotsPerLevel);
+        }
+    }
+    else
+    {
+        Node * last       = head->mPrevTimer;
+        timer->mNextTimer = head;
+        timer->mPrevTimer = last;
+        last->mNextTimer  = timer;
+        head->mPrevTimer  = timer;
+    }
+    timer->mWheelSlot = slot;
+}
+
+void TimerWheel::LinkOrdered(uint16_t slot, Node * timer)
+{
+    Node * head = mSlots[slot];
+    if (head == nullptr || !IsBefore(timer, head->mPrevTimer))
+    {
+        LinkLast(slot, timer);
+        return;
+    }
+    if (IsBefore(timer, head))
+    {
+        LinkLast(slot, timer);
+        mSlots[slot] = timer;
+        return;
+    }
+
+    // Timers are mostly added in order: look for the insertion point from the end of the slot.
+    Node * previous = head->mPrevTimer->mPrevTimer;
+    while (IsBefore(timer, previous))
+    {
+        previous = previous->mPrevTimer;
+    }
+    timer->mNextTimer                = previous->mNextTimer;
+    timer->mPrevTimer                = previous;
+    previous->mNextTimer->mPrevTimer = timer;
+    previous->mNextTimer             = timer;
+    timer->mWheelSlot                = slot;
+}
+
+void TimerWheel::Unlink(Node * timer)
+{
+    uint16_t slot = timer->mWheelSlot;
+    if (timer->mNextTimer == timer)
+    {
+        mSlots[slot] = nullptr;
+        if (slot != kDueSlot)
+        {
+            mOccupiedSlots[slot / kSlotsPerLevel] &= ~(static_cast<uint64_t>(1) << (slot % kSlotsPerLevel));
+        }
+    }
+    else
+    {
+        timer->mPrevTimer->mNextTimer = timer->mNextTimer;
+        timer->mNextTimer->mPrevTimer = timer->mPrevTimer;
+        if (mSlots[slot] == timer)
+        {
+            mSlots[slot] = timer->mNextTimer;
+        }
+    }
+    timer->mNextTimer = nullptr;
+    timer->mPrevTimer = nullptr;
+    timer->mWheelSlot = kNotQueued;
+}
+
+void TimerWheel::Detach(Node * timer)
+{
+    Unlink(timer);
+    if (mEarliest == timer)
+    {
+        mEarliest = nullptr;
+    }
+
+    Node ** link = &mBuckets[BucketFor(timer->GetCallback().GetOnComplete(), timer->GetCallback().GetAppState())];
+    while (*link != timer)
+    {
+        link = &(*link)->mNextInBucket;
+    }
+    *link                = timer->mNextInBucket;
+    timer->mNextInBucket = nullptr;
+    mCount--;
+}
+
+void TimerWheel::AdvanceTo(uint64_t now)
+{
+    // No timer expires before the new current time, so the only timers to move are those in the slots that the new time
+    // falls in: those are spread over the lower levels, or become due.
+    mNow = now;
+    for (unsigned level = kLevels; level-- > 0;)
+    {
+        unsigned digit = static_cast<unsigned>(now >> (level * kSlotBits)) & (kSlotsPerLevel - 1);
+        if ((mOccupiedSlots[level] & (static_cast<uint64_t>(1) << digit)) == 0)
+        {
+            continue;
+        }
+
+        // Empty the slot, and open its circular list, before placing its timers again.
+        uint16_t slot                 = static_cast<uint16_t>(level * kSlotsPerLevel + digit);
+        Node * timer                  = mSlots[slot];
+        timer->mPrevTimer->mNextTimer = nullptr;
+        mSlots[slot]                  = nullptr;
+
+        mOccupiedSlots[level] &= ~(static_cast<uint64_t>(1) << digit);
+        while (timer != nullptr)
+        {
+            Node * next = timer->mNextTimer;
+            Place(timer);
+            timer = next;
+        }
+    }
+}
+
+TimerWheel::Node * TimerWheel::Find(TimerCompleteCallback onComplete, void * appState)
+{
+    Node * found = nullptr;
+    for (Node * timer = mBuckets[BucketFor(onComplete, appState)]; timer != nullptr; timer = timer->mNextInBucket)
+    {
+        if (timer->GetCallback().GetOnComplete() == onComplete && timer->GetCallback().GetAppState() == appState &&
+            (found == nullptr || IsBefore(timer, found)))
+        {
+            found = timer;
+        }
+    }
+    return found;
+}
+
+void TimerWheel::GrowIndex()
+{
+    size_t bucketCount = 2 * mBucketCount;
+    Node ** buckets    = static_cast<Node **>(Platform::MemoryCalloc(bucketCount, sizeof(Node *)));
+    // Lookups get slower, but remain correct, if the table cannot grow.
+    VerifyOrReturn(buckets != nullptr);
+
+    Node ** oldBuckets    = mBuckets;
+    size_t oldBucketCount = mBucketCount;
+    mBuckets              = buckets;
+    mBucketCount          = bucketCount;
+    for (size_t i = 0; i < oldBucketCount; i++)
+    {
+        Node * timer = oldBuckets[i];
+        while (timer != nullptr)
+        {
+            Node * next          = timer->mNextInBucket;
+            size_t bucket        = BucketFor(timer->GetCallback().GetOnComplete(), timer->GetCallback().GetAppState());
+            timer->mNextInBucket = mBuckets[bucket];
+            mBuckets[bucket]     = timer;
+            timer                = next;
+        }
+    }
+
+    if (oldBuckets != mInlineBuckets)
+    {
+        Platform::MemoryFree(oldBuckets);
+    }
+}
+
+void TimerWheel::ResetIndex()
+{
+    if (mBuckets != mInlineBuckets)
+    {
+        Platform::MemoryFree(mBuckets);
+    }
+    mBuckets     = mInlineBuckets;
+    mBucketCount = kInlineBucketCount;
+    memset(mInlineBuckets, 0, sizeof(mInlineBuckets));
+}
+
+#endif // CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
 } // namespace System
 } // namespace chip
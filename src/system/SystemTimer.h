@@ -117,6 +117,15 @@ public:
             TimerData(systemLayer, awakenTime, onComplete, appState), mNextTimer(nullptr)
         {}
         Node * mNextTimer;
+
+#if CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    private:
+        friend class TimerWheel;
+        Node * mPrevTimer    = nullptr;
+        Node * mNextInBucket = nullptr;
+        uint32_t mSequence   = 0;
+        uint16_t mWheelSlot  = UINT16_MAX;
+#endif // CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
     };
 
     TimerList() : mEarliestTimer(nullptr) {}
@@ -187,9 +196,149 @@ public:
     Clock::Timeout GetRemainingTime(TimerCompleteCallback aOnComplete, void * aAppState);
 
 private:
+#if CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    friend class TimerWheel;
+#endif // CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
     Node * mEarliestTimer;
 };
 
+#if CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
+/**
+ * Hierarchical timing wheel of `Timer`s, with the same interface and ordering as TimerList.
+ *
+ * Level L of the wheel has 64 slots of 64^L milliseconds.  A timer is kept at the level of the most significant 6-bit digit
+ * in which its expiration time differs from the current time of the wheel, in the slot given by that digit, so adding and
+ * removing a timer is O(1).  When the current time of the wheel reaches a slot, its timers are moved down to lower levels.
+ * Lookups by callback go through a hash table of the timers.
+ */
+class TimerWheel
+{
+public:
+    using Node = TimerList::Node;
+
+    TimerWheel();
+    ~TimerWheel();
+
+    TimerWheel(const TimerWheel &) = delete;
+    TimerWheel & operator=(const TimerWheel &) = delete;
+
+    /**
+     * Add a timer to the wheel.
+     *
+     * @return  The new earliest timer in the wheel. If this is the newly added timer, that implies it is earlier
+     *          than any existing timer.
+     */
+    Node * Add(Node * timer);
+
+    /**
+     * Remove the given timer from the wheel, if present. It is not an error for the timer not to be present.
+     *
+     * @return  The new earliest timer in the wheel, or nullptr if the wheel is empty.
+     */
+    Node * Remove(Node * remove);
+
+    /**
+     * Remove the earliest timer with the given properties, if present. It is not an error for no such timer to be present.
+     *
+     * @return  The removed timer, or nullptr if the wheel contains no matching timer.
+     */
+    Node * Remove(TimerCompleteCallback onComplete, void * appState);
+
+    /**
+     * Remove and return the earliest timer in the wheel.
+     *
+     * @return  The earliest timer, or nullptr if the wheel is empty.
+     */
+    Node * PopEarliest();
+
+    /**
+     * Remove and return the earliest timer in the wheel, provided it expires earlier than the given time @a t.
+     *
+     * @return  The earliest timer expiring before @a t, or nullptr if there is no such timer.
+     */
+    Node * PopIfEarlier(Clock::Timestamp t);
+
+    /**
+     * Get the earliest timer in the wheel.
+     *
+     * @return  The earliest timer, or nullptr if there are no timers.
+     */
+    Node * Earliest();
+
+    /**
+     * Test whether there are any timers.
+     */
+    bool Empty() const { return mCount == 0; }
+
+    /**
+     * Remove and return all timers that expire before the given time @a t.
+     */
+    TimerList ExtractEarlier(Clock::Timestamp t);
+
+    /**
+     * Remove all timers.
+     */
+    void Clear();
+
+    /**
+     * Find the earliest timer with the given properties, if present, and return its remaining time
+     *
+     * @return The remaining time on this particular timer or 0 if not found.
+     */
+    Clock::Timeout GetRemainingTime(TimerCompleteCallback aOnComplete, void * aAppState);
+
+private:
+    static constexpr unsigned kSlotBits      = 6;
+    static constexpr unsigned kSlotsPerLevel = 1u << kSlotBits;
+    static constexpr unsigned kLevels        = (64 + kSlotBits - 1) / kSlotBits;
+
+    // Timers that expire at or before the current time of the wheel are kept in order in an extra slot.
+    static constexpr uint16_t kDueSlot   = kLevels * kSlotsPerLevel;
+    static constexpr uint16_t kNotQueued = UINT16_MAX;
+
+    static constexpr size_t kInlineBucketCount = 64;
+
+    static bool IsBefore(const Node * a, const Node * b);
+    size_t BucketFor(TimerCompleteCallback onComplete, void * appState) const;
+
+    void Place(Node * timer);
+    uint64_t SlotStart(uint16_t slot) const;
+    void LinkLast(uint16_t slot, Node * timer);
+    void LinkOrdered(uint16_t slot, Node * timer);
+    void Unlink(Node * timer);
+    void Detach(Node * timer);
+    void AdvanceTo(uint64_t now);
+    Node * Find(TimerCompleteCallback onComplete, void * appState);
+    void GrowIndex();
+    void ResetIndex();
+
+    // Each slot is a circular list through mNextTimer and mPrevTimer, starting at its head.
+    Node * mSlots[kDueSlot + 1];
+    uint64_t mOccupiedSlots[kLevels];
+    // Earliest timer, or nullptr if it has to be looked up again.
+    Node * mEarliest;
+    uint64_t mNow;
+    size_t mCount;
+    uint32_t mNextSequence;
+
+    // Hash table of the timers by callback, chained through mNextInBucket.
+    Node ** mBuckets;
+    size_t mBucketCount;
+    Node * mInlineBuckets[kInlineBucketCount];
+};
+
+#endif // CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
+/**
+ * The timer list used by the System::Layer implementations.
+ */
+#if CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+using TimerQueue = TimerWheel;
+#else
+using TimerQueue = TimerList;
+#endif // CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
 /**
  * ObjectPool wrapper that keeps System Timer statistics.
  */
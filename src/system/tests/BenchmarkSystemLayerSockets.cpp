@@ -0,0 +1,168 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Measures the cost of one event loop iteration of the configured System::Layer implementation while it watches
+ *      many idle sockets, of which only one is ready.  Build with chip_system_config_event_loop = "Select" or "Epoll"
+ *      to compare the implementations.
+ *
+ */
+
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <system/SystemLayerImpl.h>
+
+#include <chrono>
+#include <stdio.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace chip;
+using namespace chip::System;
+
+namespace {
+
+constexpr size_t kSocketCounts[] = { 10, 100, 1000 };
+constexpr unsigned kIterations   = 10000;
+
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+constexpr const char kImplementationName[] = "epoll";
+#else
+constexpr const char kImplementationName[] = "select";
+#endif
+
+using Clock = std::chrono::steady_clock;
+
+std::chrono::microseconds CpuTime()
+{
+    struct rusage usage;
+    VerifyOrDie(getrusage(RUSAGE_SELF, &usage) == 0);
+    return std::chrono::seconds(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+        std::chrono::microseconds(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+}
+
+struct Watch
+{
+    int mFd;
+    int mPeerFd;
+    SocketWatchToken mToken;
+    unsigned mCallbacks;
+};
+
+void OnReadable(SocketEvents events, intptr_t data)
+{
+    Watch * watch = reinterpret_cast<Watch *>(data);
+    uint8_t datagram;
+    VerifyOrDie(recv(watch->mFd, &datagram, sizeof(datagram), 0) == static_cast<ssize_t>(sizeof(datagram)));
+    watch->mCallbacks++;
+}
+
+void RunScenario(size_t socketCount)
+{
+    LayerImpl layer;
+    VerifyOrDie(layer.Init() == CHIP_NO_ERROR);
+
+    // The sockets are idle datagram socket pairs, made readable one at a time by sending on the peer.
+    std::vector<Watch> watches(socketCount);
+    size_t watched = 0;
+    for (Watch & watch : watches)
+    {
+        int fds[2];
+        VerifyOrDie(socketpair(AF_UNIX, SOCK_DGRAM, 0, fds) == 0);
+        watch.mFd        = fds[0];
+        watch.mPeerFd    = fds[1];
+        watch.mCallbacks = 0;
+
+        if (layer.StartWatchingSocket(watch.mFd, &watch.mToken) != CHIP_NO_ERROR ||
+            layer.SetCallback(watch.mToken, OnReadable, reinterpret_cast<intptr_t>(&watch)) != CHIP_NO_ERROR ||
+            layer.RequestCallbackOnPendingRead(watch.mToken) != CHIP_NO_ERROR)
+        {
+            break;
+        }
+        watched++;
+    }
+
+    if (watched == socketCount)
+    {
+        std::chrono::microseconds cpuStart = CpuTime();
+        Clock::time_point start            = Clock::now();
+        for (unsigned i = 0; i < kIterations; i++)
+        {
+            const Watch & watch = watches[(i * 7919u) % socketCount];
+            uint8_t datagram    = 0;
+            VerifyOrDie(send(watch.mPeerFd, &datagram, sizeof(datagram), 0) == static_cast<ssize_t>(sizeof(datagram)));
+
+            layer.PrepareEvents();
+            layer.WaitForEvents();
+            layer.HandleEvents();
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+        auto cpu     = std::chrono::duration_cast<std::chrono::nanoseconds>(CpuTime() - cpuStart);
+
+        unsigned callbacks = 0;
+        for (const Watch & watch : watches)
+        {
+            callbacks += watch.mCallbacks;
+        }
+        VerifyOrDie(callbacks == kIterations);
+
+        printf("%-7s sockets=%-5u wakeup=%10.1f ns/iteration  cpu=%10.1f ns/iteration\n", kImplementationName,
+               static_cast<unsigned>(socketCount), static_cast<double>(elapsed.count()) / kIterations,
+               static_cast<double>(cpu.count()) / kIterations);
+    }
+    else
+    {
+        printf("%-7s sockets=%-5u not supported, only %u sockets could be watched\n", kImplementationName,
+               static_cast<unsigned>(socketCount), static_cast<unsigned>(watched));
+    }
+
+    for (size_t i = 0; i < socketCount; i++)
+    {
+        if (i < watched)
+        {
+            VerifyOrDie(layer.StopWatchingSocket(&watches[i].mToken) == CHIP_NO_ERROR);
+        }
+        close(watches[i].mFd);
+        close(watches[i].mPeerFd);
+    }
+    layer.Shutdown();
+}
+
+} // namespace
+
+int main()
+{
+    VerifyOrDie(Platform::MemoryInit() == CHIP_NO_ERROR);
+
+    // Each socket takes two descriptors, which is more than the default soft limit allows for the largest count.
+    struct rlimit limit;
+    VerifyOrDie(getrlimit(RLIMIT_NOFILE, &limit) == 0);
+    limit.rlim_cur = limit.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &limit);
+
+    for (size_t socketCount : kSocketCounts)
+    {
+        RunScenario(socketCount);
+    }
+
+    Platform::MemoryShutdown();
+    return 0;
+}
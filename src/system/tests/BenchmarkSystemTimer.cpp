@@ -0,0 +1,145 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Compares the timer wheel of the System::Layer against the sorted TimerList, for the operations the layer performs
+ *      when a controller keeps many timers running: starting them, restarting them (StartTimer cancels the previous timer
+ *      with the same callback), cancelling them and expiring them.
+ *
+ */
+
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <system/SystemLayerImpl.h>
+#include <system/SystemTimer.h>
+
+#include <chrono>
+#include <stdio.h>
+#include <vector>
+
+using namespace chip;
+using namespace chip::System;
+
+namespace {
+
+constexpr size_t kTimerCounts[] = { 100, 1000, 10000 };
+
+// Delays of MRP retransmissions, session establishment timeouts and subscription liveness timers, in milliseconds.
+constexpr uint32_t kDelayRanges[] = { 300, 5000, 30000, 3600000 };
+
+using BenchmarkClock = std::chrono::steady_clock;
+using Timer          = TimerList::Node;
+
+void OnTimer(Layer * layer, void * appState) {}
+
+double NanosecondsPerOperation(BenchmarkClock::time_point start, size_t operations)
+{
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(BenchmarkClock::now() - start).count()) /
+        static_cast<double>(operations);
+}
+
+template <typename Queue>
+void RunScenario(const char * name, Layer & layer, size_t timerCount)
+{
+    Queue queue;
+    TimerPool<Timer> pool;
+    std::vector<uint8_t> appStates(timerCount);
+
+    // Timers are created up front, so that only the operations of the queue are measured.
+    uint32_t seed = 1;
+    std::vector<Timer *> timers(timerCount);
+    std::vector<Timer *> restartedTimers(timerCount);
+    for (size_t i = 0; i < timerCount; i++)
+    {
+        seed           = seed * 1103515245 + 12345;
+        uint32_t range = kDelayRanges[(seed >> 8) % (sizeof(kDelayRanges) / sizeof(kDelayRanges[0]))];
+        seed           = seed * 1103515245 + 12345;
+        Clock::Timestamp awakenTime(1000 + (seed >> 4) % range);
+
+        timers[i]          = pool.Create(layer, awakenTime, OnTimer, &appStates[i]);
+        restartedTimers[i] = pool.Create(layer, awakenTime + Clock::Milliseconds64(10), OnTimer, &appStates[i]);
+        VerifyOrDie(timers[i] != nullptr && restartedTimers[i] != nullptr);
+    }
+
+    BenchmarkClock::time_point start = BenchmarkClock::now();
+    for (size_t i = 0; i < timerCount; i++)
+    {
+        queue.Add(timers[i]);
+    }
+    double startNs = NanosecondsPerOperation(start, timerCount);
+
+    // Restart every timer 10ms later, the way Layer::StartTimer does.
+    start = BenchmarkClock::now();
+    for (size_t i = 0; i < timerCount; i++)
+    {
+        VerifyOrDie(queue.Remove(OnTimer, &appStates[i]) == timers[i]);
+        queue.Add(restartedTimers[i]);
+    }
+    double restartNs = NanosecondsPerOperation(start, timerCount);
+
+    // Cancel every other timer.
+    start = BenchmarkClock::now();
+    for (size_t i = 0; i < timerCount; i += 2)
+    {
+        VerifyOrDie(queue.Remove(OnTimer, &appStates[i]) == restartedTimers[i]);
+    }
+    double cancelNs = NanosecondsPerOperation(start, (timerCount + 1) / 2);
+
+    // Expire the others, advancing time by 100ms steps like an event loop waking up.
+    size_t expired = 0;
+    size_t steps   = 0;
+    start          = BenchmarkClock::now();
+    for (Clock::Timestamp now = Clock::kZero; !queue.Empty(); now += Clock::Milliseconds64(100))
+    {
+        TimerList expiredTimers = queue.ExtractEarlier(now);
+        while (expiredTimers.PopEarliest() != nullptr)
+        {
+            expired++;
+        }
+        steps++;
+    }
+    double expireNs = NanosecondsPerOperation(start, steps);
+    VerifyOrDie(expired == timerCount / 2);
+
+    printf("%-6s timers=%-6u start=%8.1f ns/op  restart=%8.1f ns/op  cancel=%8.1f ns/op  expire=%8.1f ns/wakeup\n", name,
+           static_cast<unsigned>(timerCount), startNs, restartNs, cancelNs, expireNs);
+
+    pool.ReleaseAll();
+}
+
+} // namespace
+
+int main()
+{
+    VerifyOrDie(Platform::MemoryInit() == CHIP_NO_ERROR);
+
+    // Timers only keep a pointer to their layer, which does not need to be initialized.
+    LayerImpl layer;
+
+    for (size_t timerCount : kTimerCounts)
+    {
+        RunScenario<TimerList>("list", layer, timerCount);
+#if CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+        RunScenario<TimerWheel>("wheel", layer, timerCount);
+#endif // CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    }
+
+    Platform::MemoryShutdown();
+    return 0;
+}
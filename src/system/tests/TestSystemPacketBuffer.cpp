@@ -40,6 +40,7 @@
 #include <lib/support/UnitTestRegistration.h>
 #include <platform/CHIPDeviceLayer.h>
 #include <system/SystemPacketBuffer.h>
+#include <system/SystemStats.h>
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
 #include <lwip/init.h>
@@ -133,6 +134,7 @@ public:
     static void CheckHandleRightSize(nlTestSuite * inSuite, void * inContext);
     static void CheckHandleCloneData(nlTestSuite * inSuite, void * inContext);
     static void CheckPacketBufferWriter(nlTestSuite * inSuite, void * inContext);
+    static void CheckSizeClasses(nlTestSuite * inSuite, void * inContext);
     static void CheckBuildFreeList(nlTestSuite * inSuite, void * inContext);
 
     static void PrintHandle(const char * tag, const PacketBuffer * buffer)
@@ -401,7 +403,8 @@ void PacketBufferTest::CheckNew(nlTestSuite * inSuite, void * inContext)
         }
     }
 
-#if CHIP_SYSTEM_PACKETBUFFER_FROM_LWIP_POOL || CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL
+#if CHIP_SYSTEM_PACKETBUFFER_FROM_LWIP_POOL || CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL ||                                          \
+    CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_SIZE_CLASSES
     // Use the rest of the buffer space
     std::vector<PacketBufferHandle> allocate_all_the_things;
     for (;;)
@@ -1963,6 +1966,68 @@ void PacketBufferTest::CheckPacketBufferWriter(nlTestSuite * inSuite, void * inC
     NL_TEST_ASSERT(inSuite, memcmp(yayBuffer->Start(), kPayload, sizeof kPayload) == 0);
 }
 
+void PacketBufferTest::CheckSizeClasses(nlTestSuite * inSuite, void * inContext)
+{
+#if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_SIZE_CLASSES
+    constexpr uint16_t kSmall  = CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY;
+    constexpr uint16_t kMedium = CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY;
+
+    // A buffer comes from the smallest size class that fits.
+    PacketBufferHandle small  = PacketBufferHandle::New(kSmall, 0);
+    PacketBufferHandle medium = PacketBufferHandle::New(kSmall + 1, 0);
+    PacketBufferHandle large  = PacketBufferHandle::New(kMedium + 1, 0);
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, !small.IsNull() && !medium.IsNull() && !large.IsNull());
+    NL_TEST_ASSERT(inSuite, small->AllocSize() == kSmall);
+    NL_TEST_ASSERT(inSuite, medium->AllocSize() == kMedium);
+    NL_TEST_ASSERT(inSuite, large->AllocSize() == PacketBuffer::kMaxSizeWithoutReserve);
+    NL_TEST_ASSERT(inSuite, SYSTEM_STATS_TEST_IN_USE(chip::System::Stats::kSystemLayer_NumSmallPacketBufs, 1));
+    NL_TEST_ASSERT(inSuite, SYSTEM_STATS_TEST_IN_USE(chip::System::Stats::kSystemLayer_NumMediumPacketBufs, 1));
+    NL_TEST_ASSERT(inSuite, SYSTEM_STATS_TEST_IN_USE(chip::System::Stats::kSystemLayer_NumLargePacketBufs, 1));
+
+    // Once the small buffers are exhausted, small allocations are served by the next size class.
+    std::vector<PacketBufferHandle> smallBuffers;
+    smallBuffers.push_back(std::move(small));
+    while (smallBuffers.size() < CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_POOL_SIZE)
+    {
+        smallBuffers.push_back(PacketBufferHandle::New(0, 0));
+        NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, !smallBuffers.back().IsNull());
+        NL_TEST_ASSERT(inSuite, smallBuffers.back()->AllocSize() == kSmall);
+    }
+
+    const char kPayload[]       = "Joy!";
+    PacketBufferHandle overflow = PacketBufferHandle::NewWithData(kPayload, sizeof kPayload);
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, !overflow.IsNull());
+    NL_TEST_ASSERT(inSuite, overflow->AllocSize() == kMedium);
+    NL_TEST_ASSERT(inSuite,
+                   SYSTEM_STATS_TEST_IN_USE(chip::System::Stats::kSystemLayer_NumSmallPacketBufs,
+                                            CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_POOL_SIZE));
+    NL_TEST_ASSERT(inSuite, SYSTEM_STATS_TEST_IN_USE(chip::System::Stats::kSystemLayer_NumMediumPacketBufs, 2));
+
+    // RightSize() moves the data to a smaller size class when a buffer is free there.
+    overflow.RightSize();
+    NL_TEST_ASSERT(inSuite, overflow->AllocSize() == kMedium);
+
+    smallBuffers.pop_back();
+    overflow.RightSize();
+    NL_TEST_ASSERT(inSuite, overflow->AllocSize() == kSmall);
+    NL_TEST_ASSERT(inSuite, overflow->DataLength() == sizeof kPayload);
+    NL_TEST_ASSERT(inSuite, memcmp(overflow->Start(), kPayload, sizeof kPayload) == 0);
+    NL_TEST_ASSERT(inSuite, SYSTEM_STATS_TEST_IN_USE(chip::System::Stats::kSystemLayer_NumMediumPacketBufs, 1));
+
+    // Freed buffers go back to their own size class.
+    smallBuffers.clear();
+    overflow = nullptr;
+    medium   = nullptr;
+    large    = nullptr;
+    NL_TEST_ASSERT(inSuite, SYSTEM_STATS_TEST_IN_USE(chip::System::Stats::kSystemLayer_NumSmallPacketBufs, 0));
+    NL_TEST_ASSERT(inSuite, SYSTEM_STATS_TEST_IN_USE(chip::System::Stats::kSystemLayer_NumMediumPacketBufs, 0));
+    NL_TEST_ASSERT(inSuite, SYSTEM_STATS_TEST_IN_USE(chip::System::Stats::kSystemLayer_NumLargePacketBufs, 0));
+    NL_TEST_ASSERT(inSuite,
+                   SYSTEM_STATS_TEST_HIGH_WATER_MARK(chip::System::Stats::kSystemLayer_NumSmallPacketBufs,
+                                                     CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_POOL_SIZE));
+#endif // CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_SIZE_CLASSES
+}
+
 /**
  *   Test Suite. It lists all the test functions.
  */
@@ -2003,6 +2068,7 @@ const nlTest sTests[] =
     NL_TEST_DEF("PacketBuffer::HandleRightSize",        PacketBufferTest::CheckHandleRightSize),
     NL_TEST_DEF("PacketBuffer::HandleCloneData",        PacketBufferTest::CheckHandleCloneData),
     NL_TEST_DEF("PacketBuffer::PacketBufferWriter",     PacketBufferTest::CheckPacketBufferWriter),
+    NL_TEST_DEF("PacketBuffer::SizeClasses",            PacketBufferTest::CheckSizeClasses),
 
     NL_TEST_SENTINEL()
 };
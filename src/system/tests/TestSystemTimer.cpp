@@ -43,6 +43,7 @@
 #include <lwip/tcpip.h>
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 
+#include <algorithm>
 #include <errno.h>
 #include <stdint.h>
 #include <string.h>
@@ -580,6 +581,132 @@ void chip::System::TestTimer::CheckTimerPool(nlTestSuite * inSuite, void * aCont
     NL_TEST_ASSERT(suite, SYSTEM_STATS_TEST_HIGH_WATER_MARK(Stats::kSystemLayer_NumTimers, 4));
 }
 
+#if CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
+// Check that TimerWheel orders and finds timers exactly as TimerList does, for a random sequence of operations.
+static void CheckTimerWheel(nlTestSuite * inSuite, void * aContext)
+{
+    TestContext & testContext = *static_cast<TestContext *>(aContext);
+    Layer & systemLayer       = *testContext.mLayer;
+    nlTestSuite * const suite = testContext.mTestSuite;
+
+    using Timer = TimerList::Node;
+    struct TestState
+    {
+        static void A(Layer * layer, void * state) {}
+        static void B(Layer * layer, void * state) {}
+    };
+    constexpr size_t kStateCount = 32;
+    char states[kStateCount];
+
+    TimerPool<Timer> listPool;
+    TimerPool<Timer> wheelPool;
+    TimerList list;
+    TimerWheel wheel;
+
+    uint32_t seed   = 1;
+    auto nextRandom = [&seed](uint32_t range) {
+        seed = seed * 1103515245 + 12345;
+        return (seed >> 8) % range;
+    };
+
+    // Both timers must be either absent or have the same properties.
+    auto same = [](const Timer * a, const Timer * b) {
+        return (a == nullptr) ? (b == nullptr)
+                              : (b != nullptr && a->AwakenTime() == b->AwakenTime() &&
+                                 a->GetCallback().GetOnComplete() == b->GetCallback().GetOnComplete() &&
+                                 a->GetCallback().GetAppState() == b->GetCallback().GetAppState());
+    };
+
+    uint64_t now = 1000;
+    for (int i = 0; i < 20000; i++)
+    {
+        uint32_t operation              = nextRandom(100);
+        TimerCompleteCallback onComplete = nextRandom(2) ? TestState::A : TestState::B;
+        void * appState                 = &states[nextRandom(kStateCount)];
+
+        if (operation < 45)
+        {
+            // Delays from immediate to years, plus a few timers that are already late.
+            static const uint32_t kRanges[] = { 1, 10, 100, 5000, 1000000, 1u << 30 };
+            uint64_t awakenTime             = now + nextRandom(kRanges[nextRandom(6)]);
+            if (nextRandom(100) == 0)
+            {
+                awakenTime += 1ull << 40;
+            }
+            else if (nextRandom(20) == 0)
+            {
+                awakenTime -= std::min<uint64_t>(awakenTime, nextRandom(50));
+            }
+
+            Timer * listTimer  = listPool.Create(systemLayer, Clock::Timestamp(awakenTime), onComplete, appState);
+            Timer * wheelTimer = wheelPool.Create(systemLayer, Clock::Timestamp(awakenTime), onComplete, appState);
+            NL_TEST_ASSERT(suite, same(list.Add(listTimer), wheel.Add(wheelTimer)));
+        }
+        else if (operation < 70)
+        {
+            Timer * listTimer  = list.Remove(onComplete, appState);
+            Timer * wheelTimer = wheel.Remove(onComplete, appState);
+            NL_TEST_ASSERT(suite, same(listTimer, wheelTimer));
+            if (listTimer != nullptr && wheelTimer != nullptr)
+            {
+                listPool.Release(listTimer);
+                wheelPool.Release(wheelTimer);
+            }
+        }
+        else if (operation < 75)
+        {
+            Timer * listTimer  = list.PopEarliest();
+            Timer * wheelTimer = wheel.PopEarliest();
+            NL_TEST_ASSERT(suite, same(listTimer, wheelTimer));
+            if (listTimer != nullptr && wheelTimer != nullptr)
+            {
+                listPool.Release(listTimer);
+                wheelPool.Release(wheelTimer);
+            }
+        }
+        else
+        {
+            now += nextRandom(2) ? nextRandom(20) : nextRandom(100000);
+            TimerList listExpired  = list.ExtractEarlier(Clock::Timestamp(now));
+            TimerList wheelExpired = wheel.ExtractEarlier(Clock::Timestamp(now));
+            Timer * listTimer;
+            Timer * wheelTimer;
+            do
+            {
+                listTimer  = listExpired.PopEarliest();
+                wheelTimer = wheelExpired.PopEarliest();
+                NL_TEST_ASSERT(suite, same(listTimer, wheelTimer));
+                if (listTimer != nullptr && wheelTimer != nullptr)
+                {
+                    listPool.Release(listTimer);
+                    wheelPool.Release(wheelTimer);
+                }
+            } while (listTimer != nullptr && wheelTimer != nullptr);
+        }
+
+        NL_TEST_ASSERT(suite, same(list.Earliest(), wheel.Earliest()));
+        NL_TEST_ASSERT(suite, list.Empty() == wheel.Empty());
+    }
+
+    // Drain both in order.
+    Timer * listTimer;
+    Timer * wheelTimer;
+    do
+    {
+        listTimer  = list.PopEarliest();
+        wheelTimer = wheel.PopEarliest();
+        NL_TEST_ASSERT(suite, same(listTimer, wheelTimer));
+    } while (listTimer != nullptr && wheelTimer != nullptr);
+
+    list.Clear();
+    wheel.Clear();
+    listPool.ReleaseAll();
+    wheelPool.ReleaseAll();
+}
+
+#endif // CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
 static void ExtendTimerToTest(nlTestSuite * inSuite, void * aContext)
 {
     if (!LayerEvents<LayerImpl>::HasServiceEvents())
@@ -723,6 +850,9 @@ static const nlTest sTests[] =
     NL_TEST_DEF("Timer::TestTimerOrder",           CheckOrder),
     NL_TEST_DEF("Timer::TestTimerCancellation",    CheckCancellation),
     NL_TEST_DEF("Timer::TestTimerPool",            chip::System::TestTimer::CheckTimerPool),
+#if CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    NL_TEST_DEF("Timer::TestTimerWheel",           CheckTimerWheel),
+#endif // CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
     NL_TEST_DEF("Timer::TestCancelTimer",          CancelTimerTest::Test),
     NL_TEST_DEF("Timer::ExtendTimerTo",            ExtendTimerToTest),
     NL_TEST_DEF("Timer::TestIsTimerActive",        IsTimerActiveTest),
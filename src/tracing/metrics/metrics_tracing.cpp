@@ -0,0 +1,611 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <tracing/metrics/metrics_tracing.h>
+
+#include <lib/address_resolve/TracingStructs.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/EnforceFormat.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <transport/TracingStructs.h>
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+
+namespace chip {
+namespace Tracing {
+namespace Metrics {
+
+namespace {
+
+constexpr const char * kMessageTypeNames[] = { "group", "secure", "unauthenticated" };
+
+static_assert(static_cast<size_t>(OutgoingMessageType::kUnauthenticated) + 1 == ArraySize(kMessageTypeNames),
+              "Message type names do not match OutgoingMessageType");
+static_assert(static_cast<size_t>(IncomingMessageType::kUnauthenticated) + 1 == ArraySize(kMessageTypeNames),
+              "Message type names do not match IncomingMessageType");
+
+// Scopes that are still open on the current thread. Entries are tagged with their backend, as
+// every registered backend sees the same begin/end calls.
+struct OpenScope
+{
+    const void * backend;
+    const char * label;
+    const char * group;
+    uint64_t startMicroseconds;
+};
+
+struct OpenScopeStack
+{
+    OpenScope scopes[MetricsBackend::kMaxOpenScopes];
+    size_t depth = 0;
+};
+
+thread_local OpenScopeStack tOpenScopes;
+
+uint64_t NowMicroseconds()
+{
+    return System::SystemClock().GetMonotonicMicroseconds64().count();
+}
+
+size_t BucketIndex(uint64_t microseconds)
+{
+    if (microseconds <= 1)
+    {
+        return 0;
+    }
+    // Smallest N such that microseconds <= 2^N
+    size_t index = static_cast<size_t>(64 - __builtin_clzll(microseconds - 1));
+    return std::min(index, kHistogramBucketCount - 1);
+}
+
+size_t ScopeHash(const char * label, const char * group)
+{
+    uintptr_t value = reinterpret_cast<uintptr_t>(label) * 31 + reinterpret_cast<uintptr_t>(group);
+    return static_cast<size_t>(value ^ (value >> 7)) % MetricsBackend::kMaxScopes;
+}
+
+// Only meant for numbers: the output of a single call is cut at the size of its buffer, so names and labels,
+// which can be of any length, are appended as strings.
+void AppendFormat(std::string & out, const char * format, ...) ENFORCE_FORMAT(2, 3);
+
+void AppendFormat(std::string & out, const char * format, ...)
+{
+    char buffer[128];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if (length > 0)
+    {
+        out.append(buffer, std::min(static_cast<size_t>(length), sizeof(buffer) - 1));
+    }
+}
+
+// Both Prometheus label values and JSON strings escape the same characters, as far as
+// constant trace labels are concerned.
+void AppendEscaped(std::string & out, const char * value)
+{
+    for (; *value != '\0'; value++)
+    {
+        switch (*value)
+        {
+        case '\\':
+            out += "\\\\";
+            break;
+        case '"':
+            out += "\\\"";
+            break;
+        case '\n':
+            out += "\\n";
+            break;
+        default:
+            out += *value;
+            break;
+        }
+    }
+}
+
+// Formats a duration in seconds without losing precision.
+void AppendSeconds(std::string & out, uint64_t microseconds)
+{
+    AppendFormat(out, "%" PRIu64 ".%06" PRIu64, microseconds / 1000000, microseconds % 1000000);
+}
+
+void AppendPrometheusHistogram(std::string & out, const char * name, const std::string & labels,
+                               const HistogramSnapshot & histogram)
+{
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < kHistogramBucketCount; i++)
+    {
+        cumulative += histogram.mBuckets[i];
+        out.append(name).append("_bucket{").append(labels).append(labels.empty() ? "le=\"" : ",le=\"");
+        if (i + 1 < kHistogramBucketCount)
+        {
+            AppendSeconds(out, uint64_t{ 1 } << i);
+        }
+        else
+        {
+            out += "+Inf";
+        }
+        AppendFormat(out, "\"} %" PRIu64 "\n", cumulative);
+    }
+
+    const std::string series = labels.empty() ? std::string() : "{" + labels + "}";
+    out.append(name).append("_sum").append(series).append(" ");
+    AppendSeconds(out, histogram.mSumMicroseconds);
+    out.append("\n").append(name).append("_count").append(series).append(" ");
+    AppendFormat(out, "%" PRIu64 "\n", histogram.mCount);
+}
+
+// Only non-empty buckets are listed, keyed by their upper bound in microseconds.
+void AppendJsonHistogram(std::string & out, const HistogramSnapshot & histogram)
+{
+    AppendFormat(out, "\"count\":%" PRIu64 ",\"sum_us\":%" PRIu64 ",\"buckets\":{", histogram.mCount,
+                 histogram.mSumMicroseconds);
+    bool first = true;
+    for (size_t i = 0; i < kHistogramBucketCount; i++)
+    {
+        if (histogram.mBuckets[i] == 0)
+        {
+            continue;
+        }
+        out += first ? "\"" : ",\"";
+        first = false;
+        if (i + 1 < kHistogramBucketCount)
+        {
+            AppendFormat(out, "%" PRIu64, uint64_t{ 1 } << i);
+        }
+        else
+        {
+            out += "+Inf";
+        }
+        AppendFormat(out, "\":%" PRIu64, histogram.mBuckets[i]);
+    }
+    out += "}";
+}
+
+} // namespace
+
+void MetricsBackend::Histogram::Record(uint64_t microseconds)
+{
+    mCount.fetch_add(1, std::memory_order_relaxed);
+    mSumMicroseconds.fetch_add(microseconds, std::memory_order_relaxed);
+    mBuckets[BucketIndex(microseconds)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void MetricsBackend::Histogram::Reset()
+{
+    mCount.store(0, std::memory_order_relaxed);
+    mSumMicroseconds.store(0, std::memory_order_relaxed);
+    for (auto & bucket : mBuckets)
+    {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+HistogramSnapshot MetricsBackend::Histogram::Snapshot() const
+{
+    HistogramSnapshot snapshot;
+    snapshot.mCount           = mCount.load(std::memory_order_relaxed);
+    snapshot.mSumMicroseconds = mSumMicroseconds.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < kHistogramBucketCount; i++)
+    {
+        snapshot.mBuckets[i] = mBuckets[i].load(std::memory_order_relaxed);
+    }
+    return snapshot;
+}
+
+void MetricsBackend::MessageCounters::Record(size_t type, size_t bytes)
+{
+    VerifyOrReturn(type < kMessageTypeCount);
+    mMessages[type].fetch_add(1, std::memory_order_relaxed);
+    mBytes[type].fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void MetricsBackend::MessageCounters::Reset()
+{
+    for (size_t i = 0; i < kMessageTypeCount; i++)
+    {
+        mMessages[i].store(0, std::memory_order_relaxed);
+        mBytes[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+MetricsBackend::~MetricsBackend()
+{
+    StopPeriodicOutput();
+}
+
+MetricsBackend::ScopeMetrics * MetricsBackend::FindOrAllocateScope(const char * label, const char * group)
+{
+    // Labels and groups are constant strings, so they are identified by address. Open addressing
+    // keeps lookups lock-free: a slot is claimed once and never released.
+    size_t index = ScopeHash(label, group);
+    for (size_t probe = 0; probe < kMaxScopes; probe++, index = (index + 1) % kMaxScopes)
+    {
+        ScopeMetrics & scope      = mScopes[index];
+        ScopeMetrics::State state = scope.mState.load(std::memory_order_acquire);
+
+        if (state == ScopeMetrics::State::kFree &&
+            scope.mState.compare_exchange_strong(state, ScopeMetrics::State::kClaimed, std::memory_order_acquire))
+        {
+            scope.mLabel = label;
+            scope.mGroup = group;
+            scope.mState.store(ScopeMetrics::State::kReady, std::memory_order_release);
+            return &scope;
+        }
+
+        // Another thread may be claiming the slot right now; this only lasts for two stores.
+        while (state != ScopeMetrics::State::kReady)
+        {
+            std::this_thread::yield();
+            state = scope.mState.load(std::memory_order_acquire);
+        }
+
+        if (scope.mLabel == label && scope.mGroup == group)
+        {
+            return &scope;
+        }
+    }
+    return nullptr;
+}
+
+void MetricsBackend::TraceBegin(const char * label, const char * group)
+{
+    OpenScopeStack & stack = tOpenScopes;
+    if (stack.depth >= kMaxOpenScopes)
+    {
+        mDroppedScopes.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    stack.scopes[stack.depth++] = OpenScope{ this, label, group, NowMicroseconds() };
+}
+
+void MetricsBackend::TraceEnd(const char * label, const char * group)
+{
+    const uint64_t now     = NowMicroseconds();
+    OpenScopeStack & stack = tOpenScopes;
+
+    // Scopes are nested, so this is the last entry unless several backends are registered.
+    for (size_t i = stack.depth; i > 0; i--)
+    {
+        OpenScope & scope = stack.scopes[i - 1];
+        if (scope.backend != this || scope.label != label || scope.group != group)
+        {
+            continue;
+        }
+
+        const uint64_t duration = now - scope.startMicroseconds;
+        std::move(stack.scopes + i, stack.scopes + stack.depth, stack.scopes + i - 1);
+        stack.depth--;
+
+        ScopeMetrics * metrics = FindOrAllocateScope(label, group);
+        if (metrics == nullptr)
+        {
+            mDroppedScopes.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        metrics->mHistogram.Record(duration);
+        return;
+    }
+
+    // No matching TraceBegin: the scope started before registration or the stack was full.
+}
+
+void MetricsBackend::LogMessageSend(MessageSendInfo & info)
+{
+    mSent.Record(static_cast<size_t>(info.messageType), info.payload.size());
+}
+
+void MetricsBackend::LogMessageReceived(MessageReceivedInfo & info)
+{
+    mReceived.Record(static_cast<size_t>(info.messageType), info.payload.size());
+}
+
+void MetricsBackend::LogNodeLookup(NodeLookupInfo & info)
+{
+    const PeerId & peerId = info.request->GetPeerId();
+    const uint64_t now    = NowMicroseconds();
+
+    std::lock_guard<std::mutex> lock(mLookupMutex);
+    PendingLookup * freeLookup = nullptr;
+    for (auto & lookup : mPendingLookups)
+    {
+        if (lookup.mInUse && lookup.mPeerId == peerId)
+        {
+            // A new lookup for the same node supersedes the previous one.
+            lookup.mStartMicroseconds = now;
+            return;
+        }
+        if (!lookup.mInUse && freeLookup == nullptr)
+        {
+            freeLookup = &lookup;
+        }
+    }
+
+    VerifyOrReturn(freeLookup != nullptr);
+    freeLookup->mPeerId            = peerId;
+    freeLookup->mStartMicroseconds = now;
+    freeLookup->mInUse             = true;
+}
+
+void MetricsBackend::LogNodeDiscovered(NodeDiscoveredInfo & info)
+{
+    if (info.type == DiscoveryInfoType::kResolutionDone)
+    {
+        EndLookup(*info.peerId, true /* success */);
+    }
+}
+
+void MetricsBackend::LogNodeDiscoveryFailed(NodeDiscoveryFailedInfo & info)
+{
+    EndLookup(*info.peerId, false /* success */);
+}
+
+void MetricsBackend::EndLookup(const PeerId & peerId, bool success)
+{
+    const uint64_t now = NowMicroseconds();
+
+    std::lock_guard<std::mutex> lock(mLookupMutex);
+    for (auto & lookup : mPendingLookups)
+    {
+        if (lookup.mInUse && lookup.mPeerId == peerId)
+        {
+            lookup.mInUse = false;
+            if (success)
+            {
+                mLookupLatency.Record(now - lookup.mStartMicroseconds);
+            }
+            else
+            {
+                mLookupFailures.fetch_add(1, std::memory_order_relaxed);
+            }
+            return;
+        }
+    }
+}
+
+void MetricsBackend::Reset()
+{
+    for (auto & scope : mScopes)
+    {
+        scope.mHistogram.Reset();
+    }
+    mDroppedScopes.store(0, std::memory_order_relaxed);
+    mSent.Reset();
+    mReceived.Reset();
+    mLookupLatency.Reset();
+    mLookupFailures.store(0, std::memory_order_relaxed);
+}
+
+std::vector<MetricsBackend::ScopeSnapshot> MetricsBackend::CollectScopes() const
+{
+    std::vector<ScopeSnapshot> scopes;
+    for (const auto & scope : mScopes)
+    {
+        if (scope.mState.load(std::memory_order_acquire) == ScopeMetrics::State::kReady)
+        {
+            scopes.push_back(ScopeSnapshot{ scope.mLabel, scope.mGroup, scope.mHistogram.Snapshot() });
+        }
+    }
+
+    auto compare = [](const ScopeSnapshot & a, const ScopeSnapshot & b) {
+        int result = strcmp(a.mGroup, b.mGroup);
+        return (result != 0) ? result : strcmp(a.mLabel, b.mLabel);
+    };
+    std::sort(scopes.begin(), scopes.end(),
+              [&compare](const ScopeSnapshot & a, const ScopeSnapshot & b) { return compare(a, b) < 0; });
+
+    std::vector<ScopeSnapshot> merged;
+    for (const auto & scope : scopes)
+    {
+        if (merged.empty() || compare(merged.back(), scope) != 0)
+        {
+            merged.push_back(scope);
+            continue;
+        }
+        HistogramSnapshot & histogram = merged.back().mHistogram;
+        histogram.mCount += scope.mHistogram.mCount;
+        histogram.mSumMicroseconds += scope.mHistogram.mSumMicroseconds;
+        for (size_t i = 0; i < kHistogramBucketCount; i++)
+        {
+            histogram.mBuckets[i] += scope.mHistogram.mBuckets[i];
+        }
+    }
+    return merged;
+}
+
+std::string MetricsBackend::GetSnapshot(OutputFormat format) const
+{
+    return (format == OutputFormat::kJson) ? GetJsonSnapshot() : GetPrometheusSnapshot();
+}
+
+std::string MetricsBackend::GetPrometheusSnapshot() const
+{
+    std::string out;
+
+    out += "# HELP matter_trace_scope_duration_seconds Time spent in traced scopes.\n"
+           "# TYPE matter_trace_scope_duration_seconds histogram\n";
+    for (const auto & scope : CollectScopes())
+    {
+        std::string labels = "group=\"";
+        AppendEscaped(labels, scope.mGroup);
+        labels += "\",label=\"";
+        AppendEscaped(labels, scope.mLabel);
+        labels += "\"";
+        AppendPrometheusHistogram(out, "matter_trace_scope_duration_seconds", labels, scope.mHistogram);
+    }
+
+    out += "# HELP matter_trace_scopes_dropped_total Traced scopes that could not be recorded.\n"
+           "# TYPE matter_trace_scopes_dropped_total counter\n";
+    AppendFormat(out, "matter_trace_scopes_dropped_total %" PRIu64 "\n", mDroppedScopes.load(std::memory_order_relaxed));
+
+    struct
+    {
+        const char * name;
+        const char * help;
+        const std::atomic<uint64_t> * values;
+    } counters[] = {
+        { "matter_messages_sent_total", "Messages sent.", mSent.mMessages },
+        { "matter_messages_received_total", "Messages received.", mReceived.mMessages },
+        { "matter_message_payload_bytes_sent_total", "Payload bytes of messages sent.", mSent.mBytes },
+        { "matter_message_payload_bytes_received_total", "Payload bytes of messages received.", mReceived.mBytes },
+    };
+    for (const auto & counter : counters)
+    {
+        out.append("# HELP ").append(counter.name).append(" ").append(counter.help).append("\n");
+        out.append("# TYPE ").append(counter.name).append(" counter\n");
+        for (size_t i = 0; i < kMessageTypeCount; i++)
+        {
+            out.append(counter.name).append("{type=\"").append(kMessageTypeNames[i]).append("\"} ");
+            AppendFormat(out, "%" PRIu64 "\n", counter.values[i].load(std::memory_order_relaxed));
+        }
+    }
+
+    out += "# HELP matter_dnssd_lookup_duration_seconds Time taken by successful DNSSD node lookups.\n"
+           "# TYPE matter_dnssd_lookup_duration_seconds histogram\n";
+    AppendPrometheusHistogram(out, "matter_dnssd_lookup_duration_seconds", "", mLookupLatency.Snapshot());
+
+    out += "# HELP matter_dnssd_lookup_failures_total DNSSD node lookups that failed.\n"
+           "# TYPE matter_dnssd_lookup_failures_total counter\n";
+    AppendFormat(out, "matter_dnssd_lookup_failures_total %" PRIu64 "\n", mLookupFailures.load(std::memory_order_relaxed));
+
+    return out;
+}
+
+std::string MetricsBackend::GetJsonSnapshot() const
+{
+    std::string out = "{\"scopes\":[";
+
+    bool first = true;
+    for (const auto & scope : CollectScopes())
+    {
+        out += first ? "{\"group\":\"" : ",{\"group\":\"";
+        first = false;
+        AppendEscaped(out, scope.mGroup);
+        out += "\",\"label\":\"";
+        AppendEscaped(out, scope.mLabel);
+        out += "\",";
+        AppendJsonHistogram(out, scope.mHistogram);
+        out += "}";
+    }
+
+    AppendFormat(out, "],\"dropped_scopes\":%" PRIu64 ",\"messages\":{", mDroppedScopes.load(std::memory_order_relaxed));
+
+    const MessageCounters * directions[] = { &mSent, &mReceived };
+    for (const MessageCounters * counters : directions)
+    {
+        out += (counters == &mSent) ? "\"sent\":{" : ",\"received\":{";
+        for (size_t i = 0; i < kMessageTypeCount; i++)
+        {
+            out.append((i == 0) ? "\"" : ",\"").append(kMessageTypeNames[i]).append("\":");
+            AppendFormat(out, "{\"count\":%" PRIu64 ",\"payload_bytes\":%" PRIu64 "}",
+                         counters->mMessages[i].load(std::memory_order_relaxed),
+                         counters->mBytes[i].load(std::memory_order_relaxed));
+        }
+        out += "}";
+    }
+
+    out += "},\"dnssd\":{\"lookups\":{";
+    AppendJsonHistogram(out, mLookupLatency.Snapshot());
+    AppendFormat(out, "},\"failures\":%" PRIu64 "}}\n", mLookupFailures.load(std::memory_order_relaxed));
+
+    return out;
+}
+
+CHIP_ERROR MetricsBackend::WriteSnapshot(const char * path, OutputFormat format) const
+{
+    const std::string content = GetSnapshot(format);
+    const std::string tmpPath = std::string(path) + ".tmp";
+
+    FILE * file = fopen(tmpPath.c_str(), "w");
+    VerifyOrReturnError(file != nullptr, CHIP_ERROR_POSIX(errno));
+
+    const bool written = fwrite(content.data(), 1, content.size(), file) == content.size();
+    const int error    = errno;
+    if (fclose(file) != 0 || !written)
+    {
+        CHIP_ERROR err = CHIP_ERROR_POSIX(written ? errno : error);
+        remove(tmpPath.c_str());
+        return err;
+    }
+
+    VerifyOrReturnError(rename(tmpPath.c_str(), path) == 0, CHIP_ERROR_POSIX(errno));
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR MetricsBackend::StartPeriodicOutput(const char * path, OutputFormat format, System::Clock::Seconds32 interval)
+{
+    VerifyOrReturnError(path != nullptr && interval.count() > 0, CHIP_ERROR_INVALID_ARGUMENT);
+    StopPeriodicOutput();
+
+    // Report an unusable destination right away rather than from the output thread.
+    ReturnErrorOnFailure(WriteSnapshot(path, format));
+
+    std::lock_guard<std::mutex> lock(mOutputMutex);
+    mOutputPath     = path;
+    mOutputFormat   = format;
+    mOutputInterval = interval;
+    mStopOutput     = false;
+    mOutputThread   = std::thread(&MetricsBackend::PeriodicOutputLoop, this);
+    return CHIP_NO_ERROR;
+}
+
+void MetricsBackend::StopPeriodicOutput()
+{
+    {
+        std::lock_guard<std::mutex> lock(mOutputMutex);
+        if (!mOutputThread.joinable())
+        {
+            return;
+        }
+        mStopOutput = true;
+    }
+    mOutputCondition.notify_all();
+    mOutputThread.join();
+
+    CHIP_ERROR err = WriteSnapshot(mOutputPath.c_str(), mOutputFormat);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(Automation, "Failed to write metrics to %s: %" CHIP_ERROR_FORMAT, mOutputPath.c_str(), err.Format());
+    }
+    mOutputPath.clear();
+}
+
+void MetricsBackend::PeriodicOutputLoop()
+{
+    std::unique_lock<std::mutex> lock(mOutputMutex);
+    while (!mOutputCondition.wait_for(lock, mOutputInterval, [this] { return mStopOutput; }))
+    {
+        CHIP_ERROR err = WriteSnapshot(mOutputPath.c_str(), mOutputFormat);
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(Automation, "Failed to write metrics to %s: %" CHIP_ERROR_FORMAT, mOutputPath.c_str(), err.Format());
+        }
+    }
+}
+
+} // namespace Metrics
+} // namespace Tracing
+} // namespace chip
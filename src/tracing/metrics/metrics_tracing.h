@@ -0,0 +1,223 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <lib/core/PeerId.h>
+#include <system/SystemClock.h>
+#include <tracing/backend.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace chip {
+namespace Tracing {
+namespace Metrics {
+
+/// Number of buckets of latency histograms. Bucket N counts durations of
+/// at most 2^N microseconds, the last bucket counts everything longer
+/// (i.e. more than ~4 seconds).
+constexpr size_t kHistogramBucketCount = 24;
+
+/// A point in time copy of a latency histogram.
+struct HistogramSnapshot
+{
+    uint64_t mCount                          = 0;
+    uint64_t mSumMicroseconds                = 0;
+    uint64_t mBuckets[kHistogramBucketCount] = {};
+};
+
+/// A Backend that aggregates tracing data into metrics instead of recording
+/// individual events:
+///   - a latency histogram for every traced scope (label/group pair)
+///   - counters of sent and received messages and their payload sizes
+///   - a latency histogram of DNSSD node lookups
+///
+/// Aggregates are output as a snapshot in Prometheus text or JSON format,
+/// either on demand or periodically into a file.
+///
+/// Scope latencies are only reported if the tracing macros are routed
+/// to backends (i.e. matter_trace_config is "multiplexed"). Besides the
+/// commissioning and CASE/PASE scopes, the interaction model traces its
+/// entry points in the "ReadClient", "ReadHandler" and "CommandHandler"
+/// groups, so reads, subscriptions and invokes show up on both sides.
+///
+/// Scopes that cannot be recorded, because more than kMaxScopes distinct
+/// scopes were seen or more than kMaxOpenScopes were open at once on a
+/// thread, are counted in matter_trace_scopes_dropped_total ("dropped_scopes"
+/// in JSON) rather than reported with a wrong latency.
+///
+/// THREAD SAFETY:
+///    Recording scopes and messages is lock-free: open scopes are kept
+///    in a thread-local stack and aggregates are updated with relaxed
+///    atomic operations. The first thread to end a new scope claims its
+///    slot with a compare-and-swap, so concurrent threads may record the
+///    same or different new scopes. Snapshots may be taken from any thread.
+class MetricsBackend : public ::chip::Tracing::Backend
+{
+public:
+    enum class OutputFormat
+    {
+        kPrometheus,
+        kJson,
+    };
+
+    /// Number of distinct label/group pairs that can be tracked. Scopes
+    /// beyond that are counted as dropped.
+    static constexpr size_t kMaxScopes = 128;
+
+    /// Number of scopes that can be open at once on a thread, across all
+    /// registered backends. Scopes nested deeper are counted as dropped.
+    static constexpr size_t kMaxOpenScopes = 32;
+
+    /// Number of DNSSD lookups whose latency can be tracked at once.
+    static constexpr size_t kMaxPendingLookups = 16;
+
+    MetricsBackend() = default;
+    ~MetricsBackend();
+
+    /// Formats the current value of all metrics.
+    std::string GetSnapshot(OutputFormat format) const;
+
+    /// Writes the current value of all metrics to the given file.
+    ///
+    /// The file is replaced atomically, so that collectors (e.g. the
+    /// Prometheus node exporter textfile collector) never read partial content.
+    CHIP_ERROR WriteSnapshot(const char * path, OutputFormat format) const;
+
+    /// Start writing a snapshot to the given file every `interval`, stopping
+    /// any previously started periodic output.
+    ///
+    /// Output stops when StopPeriodicOutput is called or when the backend is
+    /// unregistered, at which point a final snapshot is written.
+    CHIP_ERROR StartPeriodicOutput(const char * path, OutputFormat format, System::Clock::Seconds32 interval);
+
+    /// Stop periodic output if started, writing a final snapshot.
+    void StopPeriodicOutput();
+
+    /// Reset all metrics to zero
+    void Reset();
+
+    void TraceBegin(const char * label, const char * group) override;
+    void TraceEnd(const char * label, const char * group) override;
+    void TraceInstant(const char * label, const char * group) override {}
+    void LogMessageSend(MessageSendInfo &) override;
+    void LogMessageReceived(MessageReceivedInfo &) override;
+    void LogNodeLookup(NodeLookupInfo &) override;
+    void LogNodeDiscovered(NodeDiscoveredInfo &) override;
+    void LogNodeDiscoveryFailed(NodeDiscoveryFailedInfo &) override;
+    void Close() override { StopPeriodicOutput(); }
+
+private:
+    struct Histogram
+    {
+        std::atomic<uint64_t> mCount{ 0 };
+        std::atomic<uint64_t> mSumMicroseconds{ 0 };
+        std::atomic<uint64_t> mBuckets[kHistogramBucketCount] = {};
+
+        void Record(uint64_t microseconds);
+        void Reset();
+        HistogramSnapshot Snapshot() const;
+    };
+
+    struct ScopeMetrics
+    {
+        enum class State : uint8_t
+        {
+            kFree,
+            kClaimed, // label and group are being set
+            kReady,
+        };
+
+        std::atomic<State> mState{ State::kFree };
+        const char * mLabel = nullptr;
+        const char * mGroup = nullptr;
+        Histogram mHistogram;
+    };
+
+    // Indexed by OutgoingMessageType/IncomingMessageType, which have the same number of values.
+    static constexpr size_t kMessageTypeCount = 3;
+
+    struct MessageCounters
+    {
+        std::atomic<uint64_t> mMessages[kMessageTypeCount] = {};
+        std::atomic<uint64_t> mBytes[kMessageTypeCount]    = {};
+
+        void Record(size_t type, size_t bytes);
+        void Reset();
+    };
+
+    struct ScopeSnapshot
+    {
+        const char * mLabel;
+        const char * mGroup;
+        HistogramSnapshot mHistogram;
+    };
+
+    struct PendingLookup
+    {
+        PeerId mPeerId;
+        uint64_t mStartMicroseconds = 0;
+        bool mInUse                 = false;
+    };
+
+    /// Returns the metrics of the given scope, allocating them if needed, or
+    /// nullptr if all kMaxScopes are in use.
+    ScopeMetrics * FindOrAllocateScope(const char * label, const char * group);
+
+    /// Completes the pending lookup for the given peer, if any.
+    void EndLookup(const PeerId & peerId, bool success);
+
+    /// Returns the histograms of all scopes sorted by group and label. Scopes using different
+    /// copies of the same label or group strings are merged.
+    std::vector<ScopeSnapshot> CollectScopes() const;
+
+    std::string GetPrometheusSnapshot() const;
+    std::string GetJsonSnapshot() const;
+
+    void PeriodicOutputLoop();
+
+    ScopeMetrics mScopes[kMaxScopes];
+    std::atomic<uint64_t> mDroppedScopes{ 0 };
+
+    MessageCounters mSent;
+    MessageCounters mReceived;
+
+    Histogram mLookupLatency;
+    std::atomic<uint64_t> mLookupFailures{ 0 };
+
+    // DNSSD lookups are rare, so a lock is acceptable there.
+    std::mutex mLookupMutex;
+    PendingLookup mPendingLookups[kMaxPendingLookups];
+
+    std::mutex mOutputMutex;
+    std::condition_variable mOutputCondition;
+    std::thread mOutputThread;
+    std::string mOutputPath;
+    OutputFormat mOutputFormat = OutputFormat::kPrometheus;
+    System::Clock::Seconds32 mOutputInterval{ 0 };
+    bool mStopOutput = false;
+};
+
+} // namespace Metrics
+} // namespace Tracing
+} // namespace chip
@@ -0,0 +1,435 @@
+/*
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <lib/address_resolve/TracingStructs.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <system/SystemClock.h>
+#include <tracing/metrics/metrics_tracing.h>
+#include <transport/TracingStructs.h>
+
+#include <nlunit-test.h>
+
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace chip;
+using namespace chip::Tracing;
+using namespace chip::Tracing::Metrics;
+
+namespace {
+
+// Makes trace durations deterministic for the lifetime of the object.
+class ScopedMockClock
+{
+public:
+    ScopedMockClock() : mRealClock(&System::SystemClock()) { System::Clock::Internal::SetSystemClockForTesting(&mClock); }
+    ~ScopedMockClock() { System::Clock::Internal::SetSystemClockForTesting(mRealClock); }
+
+    void Advance(uint64_t microseconds) { mClock.mSystemTime += System::Clock::Microseconds64(microseconds); }
+
+private:
+    System::Clock::Internal::MockClock mClock;
+    System::Clock::ClockBase * mRealClock;
+};
+
+bool Contains(const std::string & haystack, const std::string & needle)
+{
+    return haystack.find(needle) != std::string::npos;
+}
+
+size_t CountOccurrences(const std::string & haystack, const std::string & needle)
+{
+    size_t count = 0;
+    for (size_t pos = haystack.find(needle); pos != std::string::npos; pos = haystack.find(needle, pos + needle.size()))
+    {
+        count++;
+    }
+    return count;
+}
+
+// Formats a line of the scope duration histogram for group "G", e.g. ScopeLine("count", "A", "", "1").
+std::string ScopeLine(const char * suffix, const char * label, const char * le, const char * value)
+{
+    std::string line = std::string("matter_trace_scope_duration_seconds_") + suffix + "{group=\"G\",label=\"" + label + "\"";
+    if (*le != '\0')
+    {
+        line += std::string(",le=\"") + le + "\"";
+    }
+    return line + "} " + value + "\n";
+}
+
+void TestScopeHistograms(nlTestSuite * inSuite, void * inContext)
+{
+    ScopedMockClock clock;
+    MetricsBackend backend;
+
+    backend.TraceBegin("Outer", "G");
+    clock.Advance(3);
+    backend.TraceBegin("Inner", "G");
+    clock.Advance(1000);
+    backend.TraceEnd("Inner", "G");
+    backend.TraceEnd("Outer", "G");
+
+    backend.TraceBegin("Inner", "G");
+    clock.Advance(1);
+    backend.TraceEnd("Inner", "G");
+
+    // Without a matching begin, an end is ignored.
+    backend.TraceEnd("Unknown", "G");
+
+    std::string snapshot = backend.GetSnapshot(MetricsBackend::OutputFormat::kPrometheus);
+
+    // Buckets are cumulative, with upper bounds in seconds.
+    NL_TEST_ASSERT(inSuite, Contains(snapshot, ScopeLine("bucket", "Inner", "0.000001", "1")));
+    NL_TEST_ASSERT(inSuite, Contains(snapshot, ScopeLine("bucket", "Inner", "0.000512", "1")));
+    NL_TEST_ASSERT(inSuite, Contains(snapshot, ScopeLine("bucket", "Inner", "0.001024", "2")));
+    NL_TEST_ASSERT(inSuite, Contains(snapshot, ScopeLine("bucket", "Inner", "+Inf", "2")));
+    NL_TEST_ASSERT(inSuite, Contains(snapshot, ScopeLine("sum", "Inner", "", "0.001001")));
+    NL_TEST_ASSERT(inSuite, Contains(snapshot, ScopeLine("count", "Inner", "", "2")));
+    NL_TEST_ASSERT(inSuite, Contains(snapshot, ScopeLine("sum", "Outer", "", "0.001003")));
+    NL_TEST_ASSERT(inSuite, Contains(snapshot, ScopeLine("count", "Outer", "", "1")));
+    NL_TEST_ASSERT(inSuite, !Contains(snapshot, "Unknown"));
+
+    // Scopes are sorted by group and label.
+    NL_TEST_ASSERT(inSuite, snapshot.find("label=\"Inner\"") < snapshot.find("label=\"Outer\""));
+
+    std::string json = backend.GetSnapshot(MetricsBackend::OutputFormat::kJson);
+    NL_TEST_ASSERT(inSuite,
+                   Contains(json,
+                            "{\"group\":\"G\",\"label\":\"Inner\",\"count\":2,\"sum_us\":1001,"
+                            "\"buckets\":{\"1\":1,\"1024\":1}}"));
+    NL_TEST_ASSERT(inSuite,
+                   Contains(json,
+                            "{\"group\":\"G\",\"label\":\"Outer\",\"count\":1,\"sum_us\":1003,"
+                            "\"buckets\":{\"1024\":1}}"));
+
+    backend.Reset();
+    snapshot = backend.GetSnapshot(MetricsBackend::OutputFormat::kPrometheus);
+    NL_TEST_ASSERT(inSuite, Contains(snapshot, ScopeLine("count", "Inner", "", "0")));
+}
+
+void TestScopesWithCopiedStrings(nlTestSuite * inSuite, void * inContext)
+{
+    ScopedMockClock clock;
+    MetricsBackend backend;
+
+    // The same label may live at different addresses, e.g. when used from several libraries.
+    static const char kLabel1[] = "Label";
+    static const char kLabel2[] = "Label";
+
+    backend.TraceBegin(kLabel1, "G");
+    clock.Advance(10);
+    backend.TraceEnd(kLabel1, "G");
+    backend.TraceBegin(kLabel2, "G");
+    clock.Advance(20);
+    backend.TraceEnd(kLabel2, "G");
+
+    std::string snapshot = backend.GetSnapshot(MetricsBackend::OutputFormat::kPrometheus);
+    NL_TEST_ASSERT(inSuite, Contains(snapshot, ScopeLine("count", "Label", "", "2")));
+    NL_TEST_ASSERT(inSuite, Contains(snapshot, ScopeLine("sum", "Label", "", "0.000030")));
+}
+
+void TestLongLabels(nlTestSuite * inSuite, void * inContext)
+{
+    ScopedMockClock clock;
+    MetricsBackend backend;
+
+    // Along with the metric name and the group, this label makes lines well over 128 characters.
+    static const char kLabel[] = "ALongTraceScopeLabelThatGoesOnWellPastTheSixtyFourCharacterMark_0123456789";
+    static_assert(sizeof(kLabel) - 1 > 64, "The label must be longer than 64 characters");
+
+    backend.TraceBegin(kLabel, "G");
+    clock.Advance(5);
+    backend.TraceEnd(kLabel, "G");
+
+    std::string snapshot = backend.GetSnapshot(MetricsBackend::OutputFormat::kPrometheus);
+    NL_TEST_ASSERT(inSuite, Contains(snapshot, ScopeLine("bucket", kLabel, "0.000004", "0")));
+    NL_TEST_ASSERT(inSuite, Contains(snapshot, ScopeLine("bucket", kLabel, "0.000008", "1")));
+    NL_TEST_ASSERT(inSuite, Contains(snapshot, ScopeLine("bucket", kLabel, "+Inf", "1")));
+    NL_TEST_ASSERT(inSuite, Contains(snapshot, ScopeLine("sum", kLabel, "", "0.000005")));
+    NL_TEST_ASSERT(inSuite, Contains(snapshot, ScopeLine("count", kLabel, "", "1")));
+
+    std::string json = backend.GetSnapshot(MetricsBackend::OutputFormat::kJson);
+    NL_TEST_ASSERT(inSuite,
+                   Contains(json, std::string("{\"group\":\"G\",\"label\":\"") + kLabel +
+                                "\",\"count\":1,\"sum_us\":5,\"buckets\":{\"8\":1}}"));
+}
+
+void TestMultipleBackends(nlTestSuite * inSuite, void * inContext)
+{
+    ScopedMockClock clock;
+    MetricsBackend b1;
+    MetricsBackend b2;
+
+    // Every registered backend sees the same calls, interleaved.
+    b1.TraceBegin("A", "G");
+    b2.TraceBegin("A", "G");
+    clock.Advance(5);
+    b1.TraceBegin("B", "G");
+    clock.Advance(7);
+    b1.TraceEnd("B", "G");
+    b1.TraceEnd("A", "G");
+    b2.TraceEnd("A", "G");
+
+    std::string snapshot1 = b1.GetSnapshot(MetricsBackend::OutputFormat::kPrometheus);
+    std::string snapshot2 = b2.GetSnapshot(MetricsBackend::OutputFormat::kPrometheus);
+
+    NL_TEST_ASSERT(inSuite, Contains(snapshot1, ScopeLine("sum", "A", "", "0.000012")));
+    NL_TEST_ASSERT(inSuite, Contains(snapshot1, ScopeLine("sum", "B", "", "0.000007")));
+    NL_TEST_ASSERT(inSuite, Contains(snapshot2, ScopeLine("sum", "A", "", "0.000012")));
+    NL_TEST_ASSERT(inSuite, !Contains(snapshot2, "label=\"B\""));
+}
+
+void TestConcurrentScopes(nlTestSuite * inSuite, void * inContext)
+{
+    MetricsBackend backend;
+
+    static const char * const kLabels[] = { "L0", "L1", "L2", "L3", "L4", "L5", "L6", "L7", "L8", "L9", "L10", "L11", "L12", "L13",
+                                            "L14", "L15" };
+    constexpr size_t kThreadCount = 4;
+    constexpr size_t kIterations  = 200;
+
+    // All threads start together and walk the labels from different offsets, so they race to allocate the same and
+    // neighboring scopes.
+    std::atomic<bool> start{ false };
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < kThreadCount; t++)
+    {
+        threads.emplace_back([&backend, &start, t] {
+            while (!start.load())
+            {
+                std::this_thread::yield();
+            }
+            for (size_t i = 0; i < kIterations; i++)
+            {
+                for (size_t l = 0; l < ArraySize(kLabels); l++)
+                {
+                    const char * label = kLabels[(l + t * 5) % ArraySize(kLabels)];
+                    backend.TraceBegin(label, "G");
+                    backend.TraceEnd(label, "G");
+                }
+            }
+        });
+    }
+    start.store(true);
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    std::string snapshot    = backend.GetSnapshot(MetricsBackend::OutputFormat::kPrometheus);
+    const std::string count = std::to_string(kThreadCount * kIterations);
+    for (const char * label : kLabels)
+    {
+        NL_TEST_ASSERT(inSuite, Contains(snapshot, ScopeLine("count", label, "", count.c_str())));
+    }
+    NL_TEST_ASSERT(inSuite, CountOccurrences(snapshot, "matter_trace_scope_duration_seconds_count{") == ArraySize(kLabels));
+    NL_TEST_ASSERT(inSuite, Contains(snapshot, "matter_trace_scopes_dropped_total 0\n"));
+}
+
+void TestScopeOverflow(nlTestSuite * inSuite, void * inContext)
+{
+    ScopedMockClock clock;
+
+    // Distinct scopes past kMaxScopes are dropped; the scopes already tracked are still recorded.
+    {
+        MetricsBackend backend;
+        constexpr size_t kExtraScopes = 3;
+        std::vector<std::string> labels;
+        for (size_t i = 0; i < MetricsBackend::kMaxScopes + kExtraScopes; i++)
+        {
+            labels.push_back("Scope" + std::to_string(i));
+        }
+        for (const auto & label : labels)
+        {
+            backend.TraceBegin(label.c_str(), "G");
+            clock.Advance(1);
+            backend.TraceEnd(label.c_str(), "G");
+        }
+        backend.TraceBegin(labels[0].c_str(), "G");
+        backend.TraceEnd(labels[0].c_str(), "G");
+
+        std::string snapshot = backend.GetSnapshot(MetricsBackend::OutputFormat::kPrometheus);
+        NL_TEST_ASSERT(inSuite,
+                       CountOccurrences(snapshot, "matter_trace_scope_duration_seconds_count{") == MetricsBackend::kMaxScopes);
+        NL_TEST_ASSERT(inSuite, Contains(snapshot, ScopeLine("count", "Scope0", "", "2")));
+        NL_TEST_ASSERT(inSuite, Contains(snapshot, "matter_trace_scopes_dropped_total 3\n"));
+
+        std::string json = backend.GetSnapshot(MetricsBackend::OutputFormat::kJson);
+        NL_TEST_ASSERT(inSuite, Contains(json, "\"dropped_scopes\":3,"));
+    }
+
+    // Scopes opened past kMaxOpenScopes on a thread are dropped, and so are their ends; the outer ones are recorded.
+    {
+        MetricsBackend backend;
+        constexpr size_t kExtraDepth = 2;
+        for (size_t i = 0; i < MetricsBackend::kMaxOpenScopes + kExtraDepth; i++)
+        {
+            backend.TraceBegin("Nested", "G");
+        }
+        clock.Advance(10);
+        for (size_t i = 0; i < MetricsBackend::kMaxOpenScopes + kExtraDepth; i++)
+        {
+            backend.TraceEnd("Nested", "G");
+        }
+
+        // Nothing is left open on this thread.
+        backend.TraceBegin("After", "G");
+        backend.TraceEnd("After", "G");
+
+        std::string snapshot          = backend.GetSnapshot(MetricsBackend::OutputFormat::kPrometheus);
+        const std::string nestedCount = std::to_string(MetricsBackend::kMaxOpenScopes);
+        NL_TEST_ASSERT(inSuite, Contains(snapshot, ScopeLine("count", "Nested", "", nestedCount.c_str())));
+        NL_TEST_ASSERT(inSuite, Contains(snapshot, ScopeLine("count", "After", "", "1")));
+        NL_TEST_ASSERT(inSuite, Contains(snapshot, "matter_trace_scopes_dropped_total 2\n"));
+    }
+}
+
+void TestMessageCounters(nlTestSuite * inSuite, void * inContext)
+{
+    MetricsBackend backend;
+    uint8_t payload[10] = {};
+
+    MessageSendInfo sent{ OutgoingMessageType::kSecureSession, nullptr, nullptr, ByteSpan(payload) };
+    backend.LogMessageSend(sent);
+    backend.LogMessageSend(sent);
+
+    MessageReceivedInfo received{
+        IncomingMessageType::kUnauthenticated, nullptr, nullptr, nullptr, nullptr, ByteSpan(payload, 4),
+    };
+    backend.LogMessageReceived(received);
+
+    std::string snapshot = backend.GetSnapshot(MetricsBackend::OutputFormat::kPrometheus);
+    NL_TEST_ASSERT(inSuite, Contains(snapshot, "matter_messages_sent_total{type=\"secure\"} 2\n"));
+    NL_TEST_ASSERT(inSuite, Contains(snapshot, "matter_messages_sent_total{type=\"group\"} 0\n"));
+    NL_TEST_ASSERT(inSuite, Contains(snapshot, "matter_message_payload_bytes_sent_total{type=\"secure\"} 20\n"));
+    NL_TEST_ASSERT(inSuite, Contains(snapshot, "matter_messages_received_total{type=\"unauthenticated\"} 1\n"));
+    NL_TEST_ASSERT(inSuite, Contains(snapshot, "matter_message_payload_bytes_received_total{type=\"unauthenticated\"} 4\n"));
+
+    std::string json = backend.GetSnapshot(MetricsBackend::OutputFormat::kJson);
+    NL_TEST_ASSERT(inSuite, Contains(json, "\"sent\":{\"group\":{\"count\":0,\"payload_bytes\":0},\"secure\":{\"count\":2,"));
+    NL_TEST_ASSERT(inSuite, Contains(json, "\"unauthenticated\":{\"count\":1,\"payload_bytes\":4}}"));
+}
+
+void TestNodeLookups(nlTestSuite * inSuite, void * inContext)
+{
+    ScopedMockClock clock;
+    MetricsBackend backend;
+
+    PeerId peer1 = PeerId().SetCompressedFabricId(1).SetNodeId(1);
+    PeerId peer2 = PeerId().SetCompressedFabricId(1).SetNodeId(2);
+    AddressResolve::NodeLookupRequest request1(peer1);
+    AddressResolve::NodeLookupRequest request2(peer2);
+
+    NodeLookupInfo lookup1{ &request1 };
+    NodeLookupInfo lookup2{ &request2 };
+    backend.LogNodeLookup(lookup1);
+    backend.LogNodeLookup(lookup2);
+    clock.Advance(1500);
+
+    // Intermediate results do not complete the lookup.
+    NodeDiscoveredInfo intermediate{ DiscoveryInfoType::kIntermediateResult, &peer1, nullptr };
+    backend.LogNodeDiscovered(intermediate);
+    clock.Advance(500);
+    NodeDiscoveredInfo done{ DiscoveryInfoType::kResolutionDone, &peer1, nullptr };
+    backend.LogNodeDiscovered(done);
+
+    NodeDiscoveryFailedInfo failed{ &peer2, CHIP_ERROR_TIMEOUT };
+    backend.LogNodeDiscoveryFailed(failed);
+
+    // A second completion for the same lookup is ignored.
+    backend.LogNodeDiscovered(done);
+
+    std::string snapshot = backend.GetSnapshot(MetricsBackend::OutputFormat::kPrometheus);
+    NL_TEST_ASSERT(inSuite, Contains(snapshot, "matter_dnssd_lookup_duration_seconds_bucket{le=\"0.002048\"} 1\n"));
+    NL_TEST_ASSERT(inSuite, Contains(snapshot, "matter_dnssd_lookup_duration_seconds_sum 0.002000\n"));
+    NL_TEST_ASSERT(inSuite, Contains(snapshot, "matter_dnssd_lookup_duration_seconds_count 1\n"));
+    NL_TEST_ASSERT(inSuite, Contains(snapshot, "matter_dnssd_lookup_failures_total 1\n"));
+
+    std::string json = backend.GetSnapshot(MetricsBackend::OutputFormat::kJson);
+    NL_TEST_ASSERT(inSuite,
+                   Contains(json, "\"dnssd\":{\"lookups\":{\"count\":1,\"sum_us\":2000,\"buckets\":{\"2048\":1}},\"failures\":1}"));
+}
+
+void TestWriteSnapshot(nlTestSuite * inSuite, void * inContext)
+{
+    MetricsBackend backend;
+    uint8_t payload[3] = {};
+    MessageSendInfo sent{ OutgoingMessageType::kGroupMessage, nullptr, nullptr, ByteSpan(payload) };
+    backend.LogMessageSend(sent);
+
+    char path[] = "/tmp/matter-metrics-XXXXXX";
+    int fd      = mkstemp(path);
+    NL_TEST_ASSERT(inSuite, fd >= 0);
+    close(fd);
+
+    NL_TEST_ASSERT(inSuite, backend.WriteSnapshot(path, MetricsBackend::OutputFormat::kJson) == CHIP_NO_ERROR);
+
+    std::ifstream file(path);
+    std::stringstream content;
+    content << file.rdbuf();
+    NL_TEST_ASSERT(inSuite, content.str() == backend.GetSnapshot(MetricsBackend::OutputFormat::kJson));
+
+    // Periodic output writes a snapshot right away and a final one when stopped.
+    NL_TEST_ASSERT(inSuite,
+                   backend.StartPeriodicOutput(path, MetricsBackend::OutputFormat::kPrometheus, System::Clock::Seconds32(3600)) ==
+                       CHIP_NO_ERROR);
+    backend.LogMessageSend(sent);
+    backend.StopPeriodicOutput();
+
+    std::ifstream periodicFile(path);
+    std::stringstream periodicContent;
+    periodicContent << periodicFile.rdbuf();
+    NL_TEST_ASSERT(inSuite, Contains(periodicContent.str(), "matter_messages_sent_total{type=\"group\"} 2\n"));
+
+    remove(path);
+
+    NL_TEST_ASSERT(inSuite,
+                   backend.WriteSnapshot("/nonexistent-directory/metrics", MetricsBackend::OutputFormat::kJson) != CHIP_NO_ERROR);
+}
+
+const nlTest sTests[] = {
+    NL_TEST_DEF("ScopeHistograms", TestScopeHistograms),                 //
+    NL_TEST_DEF("ScopesWithCopiedStrings", TestScopesWithCopiedStrings), //
+    NL_TEST_DEF("LongLabels", TestLongLabels),                           //
+    NL_TEST_DEF("MultipleBackends", TestMultipleBackends),               //
+    NL_TEST_DEF("ConcurrentScopes", TestConcurrentScopes),               //
+    NL_TEST_DEF("ScopeOverflow", TestScopeOverflow),                     //
+    NL_TEST_DEF("MessageCounters", TestMessageCounters),                 //
+    NL_TEST_DEF("NodeLookups", TestNodeLookups),                         //
+    NL_TEST_DEF("WriteSnapshot", TestWriteSnapshot),                     //
+    NL_TEST_SENTINEL()                                                   //
+};
+
+} // namespace
+
+int TestMetricsTracing()
+{
+    nlTestSuite theSuite = { "Metrics tracing tests", &sTests[0], nullptr, nullptr };
+
+    // Run test suite against one context.
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestMetricsTracing)
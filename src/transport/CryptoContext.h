@@ -162,6 +162,9 @@ private:
     bool mKeyAvailable;
     Crypto::Aes128KeyHandle mEncryptionKey;
     Crypto::Aes128KeyHandle mDecryptionKey;
+    // Bound to the keys above, so that the cipher is set up once per session rather than once per message.
+    Crypto::Aes128CcmCipher mEncryptionCipher;
+    Crypto::Aes128CcmCipher mDecryptionCipher;
     Crypto::AttestationChallenge mAttestationChallenge;
     Crypto::SessionKeystore * mKeystore       = nullptr;
     Crypto::SymmetricKeyContext * mKeyContext = nullptr;
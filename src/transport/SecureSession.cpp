@@ -40,12 +40,11 @@ void SecureSession::Activate(const ScopedNodeId & localNode, const ScopedNodeId
     VerifyOrDie(!((mSecureSessionType == Type::kCASE) &&
                   (!IsOperationalNodeId(peerNode.GetNodeId()) || !IsOperationalNodeId(localNode.GetNodeId()))));
 
-    mPeerNodeId      = peerNode.GetNodeId();
+    SetPeer(peerNode);
     mLocalNodeId     = localNode.GetNodeId();
     mPeerCATs        = peerCATs;
     mPeerSessionId   = peerSessionId;
     mRemoteMRPConfig = config;
-    SetFabricIndex(peerNode.GetFabricIndex());
     MarkActiveRx(); // Initialize SessionTimestamp and ActiveTimestamp per spec.
 
     Retain(); // This ref is released inside MarkForEviction
@@ -57,6 +56,14 @@ void SecureSession::Activate(const ScopedNodeId & localNode, const ScopedNodeId
     ChipLogDetail(Inet, "SecureSession[%p]: Activated - Type:%d LSID:%d", this, to_underlying(mSecureSessionType), mLocalSessionId);
 }
 
+void SecureSession::SetPeer(const ScopedNodeId & peer)
+{
+    mTable.RemoveFromPeerIndex(*this);
+    mPeerNodeId = peer.GetNodeId();
+    SetFabricIndex(peer.GetFabricIndex());
+    mTable.AddToPeerIndex(*this);
+}
+
 const char * SecureSession::StateToString(State state) const
 {
     switch (state)
@@ -202,7 +202,7 @@ public:
         {
             return CHIP_ERROR_INVALID_ARGUMENT;
         }
-        SetFabricIndex(fabricIndex);
+        SetPeer(ScopedNodeId(mPeerNodeId, fabricIndex));
         return CHIP_NO_ERROR;
     }
 
@@ -291,7 +291,11 @@ private:
     const char * StateToString(State state) const;
     void MoveToState(State targetState);
 
+    // Changes the peer of the session, keeping the peer index of the SecureSessionTable up to date.
+    void SetPeer(const ScopedNodeId & peer);
+
     friend class SecureSessionDeleter;
+    friend class SecureSessionTable;
     friend class TestSecureSessionTable;
 
     SecureSessionTable & mTable;
@@ -314,6 +318,10 @@ private:
     ReliableMessageProtocolConfig mRemoteMRPConfig = GetDefaultMRPConfig();
     CryptoContext mCryptoContext;
     SessionMessageCounter mSessionMessageCounter;
+
+    // Next sessions in the buckets of the SecureSessionTable indexes.
+    SecureSession * mNextByLocalSessionId = nullptr;
+    SecureSession * mNextByPeer           = nullptr;
 };
 
 } // namespace Transport
@@ -22,6 +22,8 @@
 #include <transport/SecureSession.h>
 #include <transport/SecureSessionTable.h>
 
+#include <algorithm>
+
 namespace chip {
 namespace Transport {
 
@@ -52,8 +54,8 @@ Optional<SessionHandle> SecureSessionTable::CreateNewSecureSessionForTest(Secure
         }
     }
 
-    SecureSession * result = mEntries.CreateObject(*this, secureSessionType, localSessionId, localNodeId, peerNodeId, peerCATs,
-                                                   peerSessionId, fabricIndex, config);
+    SecureSession * result =
+        CreateSession(secureSessionType, localSessionId, localNodeId, peerNodeId, peerCATs, peerSessionId, fabricIndex, config);
     return result != nullptr ? MakeOptional<SessionHandle>(*result) : Optional<SessionHandle>::Missing();
 }
 
@@ -73,7 +75,7 @@ Optional<SessionHandle> SecureSessionTable::CreateNewSecureSession(SecureSession
     //
     if (mEntries.Allocated() < GetMaxSessionTableSize())
     {
-        allocated = mEntries.CreateObject(*this, secureSessionType, sessionId.Value());
+        allocated = CreateSession(secureSessionType, sessionId.Value());
     }
     else
     {
@@ -137,27 +139,20 @@ SecureSession * SecureSessionTable::EvictAndAllocate(uint16_t localSessionId, Se
     // Compute two key stats for each session - the number of other sessions that
     // match its fabric, as well as the number of other sessions that match its peer.
     //
-    // This will be used by the session eviction algorithm later.
+    // This will be used by the session eviction algorithm later. The sessions matching
+    // on peer are the ones sharing its bucket of the peer index, and the sessions matching
+    // on fabric are counted once the list is grouped by fabric.
     //
     ForEachSession([&index, &sortableSessions, this](auto * session) {
         sortableSessions[index].mSession             = session;
         sortableSessions[index].mNumMatchingOnFabric = 0;
         sortableSessions[index].mNumMatchingOnPeer   = 0;
 
-        ForEachSession([session, index, &sortableSessions](auto * otherSession) {
+        ForEachSessionWithPeer(session->GetPeer(), [session, index, &sortableSessions](auto * otherSession) {
             if (session != otherSession)
             {
-                if (session->GetFabricIndex() == otherSession->GetFabricIndex())
-                {
-                    sortableSessions[index].mNumMatchingOnFabric++;
-
-                    if (session->GetPeerNodeId() == otherSession->GetPeerNodeId())
-                    {
-                        sortableSessions[index].mNumMatchingOnPeer++;
-                    }
-                }
+                sortableSessions[index].mNumMatchingOnPeer++;
             }
-
             return Loop::Continue;
         });
 
@@ -165,6 +160,24 @@ SecureSession * SecureSessionTable::EvictAndAllocate(uint16_t localSessionId, Se
         return Loop::Continue;
     });
 
+    std::stable_sort(sortableSessions, sortableSessions + index, [](const SortableSession & a, const SortableSession & b) {
+        return a.mSession->GetFabricIndex() < b.mSession->GetFabricIndex();
+    });
+
+    for (unsigned int begin = 0, end = 0; begin < index; begin = end)
+    {
+        FabricIndex fabricIndex = sortableSessions[begin].mSession->GetFabricIndex();
+        while (end < index && sortableSessions[end].mSession->GetFabricIndex() == fabricIndex)
+        {
+            end++;
+        }
+
+        for (unsigned int i = begin; i < end; i++)
+        {
+            sortableSessions[i].mNumMatchingOnFabric = static_cast<uint16_t>(end - begin - 1);
+        }
+    }
+
     auto sortableSessionSpan = Span<SortableSession>(sortableSessions, mEntries.Allocated());
     EvictionPolicyContext policyContext(sortableSessionSpan, sessionEvictionHint);
 
@@ -216,7 +229,7 @@ SecureSession * SecureSessionTable::EvictAndAllocate(uint16_t localSessionId, Se
         if (newCount < prevCount)
         {
             ChipLogProgress(SecureChannel, "Successfully evicted a session!");
-            auto * retSession = mEntries.CreateObject(*this, secureSessionType, localSessionId);
+            auto * retSession = CreateSession(secureSessionType, localSessionId);
             VerifyOrDie(session != nullptr);
             return retSession;
         }
@@ -312,65 +325,74 @@ void SecureSessionTable::DefaultEvictionPolicy(EvictionPolicyContext & evictionC
 
 Optional<SessionHandle> SecureSessionTable::FindSecureSessionByLocalKey(uint16_t localSessionId)
 {
-    SecureSession * result = nullptr;
-    mEntries.ForEachActiveObject([&](auto session) {
-        if (session->GetLocalSessionId() == localSessionId)
-        {
-            result = session;
-            return Loop::Break;
-        }
-        return Loop::Continue;
-    });
+    SecureSession * result = FindByLocalSessionId(localSessionId);
     return result != nullptr ? MakeOptional<SessionHandle>(*result) : Optional<SessionHandle>::Missing();
 }
 
-Optional<uint16_t> SecureSessionTable::FindUnusedSessionId()
+SecureSession * SecureSessionTable::FindByLocalSessionId(uint16_t localSessionId) const
+{
+    SecureSession * session = mByLocalSessionId[LocalSessionIdBucket(localSessionId)];
+    while (session != nullptr && session->GetLocalSessionId() != localSessionId)
+    {
+        session = session->mNextByLocalSessionId;
+    }
+    return session;
+}
+
+void SecureSessionTable::AddToLocalSessionIdIndex(SecureSession & session)
+{
+    SecureSession *& head = mByLocalSessionId[LocalSessionIdBucket(session.GetLocalSessionId())];
+
+    session.mNextByLocalSessionId = head;
+    head                          = &session;
+}
+
+void SecureSessionTable::RemoveFromLocalSessionIdIndex(SecureSession & session)
 {
-    uint16_t candidate_base = 0;
-    uint64_t candidate_mask = 0;
-    for (uint32_t i = 0; i <= kMaxSessionID; i += 64)
+    SecureSession ** bucket = &mByLocalSessionId[LocalSessionIdBucket(session.GetLocalSessionId())];
+    for (SecureSession ** link = bucket; *link != nullptr; link = &(*link)->mNextByLocalSessionId)
     {
-        // candidate_base is the base session ID we are searching from.
-        // We have a 64-bit mask anchored at this ID and iterate over the
-        // whole session table, setting bits in the mask for in-use IDs.
-        // If we can iterate through the entire session table and have
-        // any bits clear in the mask, we have available session IDs.
-        candidate_base = static_cast<uint16_t>(i + mNextSessionId);
-        candidate_mask = 0;
+        if (*link == &session)
         {
-            uint16_t shift = static_cast<uint16_t>(kUnsecuredSessionId - candidate_base);
-            if (shift <= 63)
-            {
-                candidate_mask |= (1ULL << shift); // kUnsecuredSessionId is never available
-            }
+            *link                         = session.mNextByLocalSessionId;
+            session.mNextByLocalSessionId = nullptr;
+            return;
         }
-        mEntries.ForEachActiveObject([&](auto session) {
-            uint16_t shift = static_cast<uint16_t>(session->GetLocalSessionId() - candidate_base);
-            if (shift <= 63)
-            {
-                candidate_mask |= (1ULL << shift);
-            }
-            if (candidate_mask == UINT64_MAX)
-            {
-                return Loop::Break; // No bits clear means this bucket is full.
-            }
-            return Loop::Continue;
-        });
-        if (candidate_mask != UINT64_MAX)
+    }
+}
+
+void SecureSessionTable::AddToPeerIndex(SecureSession & session)
+{
+    SecureSession *& head = mByPeer[PeerBucket(session.GetPeer())];
+
+    session.mNextByPeer = head;
+    head                = &session;
+}
+
+void SecureSessionTable::RemoveFromPeerIndex(SecureSession & session)
+{
+    for (SecureSession ** link = &mByPeer[PeerBucket(session.GetPeer())]; *link != nullptr; link = &(*link)->mNextByPeer)
+    {
+        if (*link == &session)
         {
-            break; // Any bit clear means we have an available ID in this bucket.
+            *link               = session.mNextByPeer;
+            session.mNextByPeer = nullptr;
+            return;
         }
     }
-    if (candidate_mask != UINT64_MAX)
+}
+
+Optional<uint16_t> SecureSessionTable::FindUnusedSessionId()
+{
+    for (uint32_t i = 0; i <= kMaxSessionID; i++)
     {
-        uint16_t offset = 0;
-        while (candidate_mask & 1)
+        uint16_t candidate = static_cast<uint16_t>(mNextSessionId + i);
+
+        // kUnsecuredSessionId is never available
+        if (candidate != kUnsecuredSessionId && FindByLocalSessionId(candidate) == nullptr)
         {
-            candidate_mask >>= 1;
-            ++offset;
+            return MakeOptional<uint16_t>(candidate);
         }
-        uint16_t available = static_cast<uint16_t>(candidate_base + offset);
-        return MakeOptional<uint16_t>(available);
     }
 
     return NullOptional;
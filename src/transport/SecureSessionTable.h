@@ -19,22 +19,32 @@
 #include <lib/core/CHIPError.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/Pool.h>
-#include <lib/support/SortUtils.h>
 #include <system/TimeSource.h>
 #include <transport/SecureSession.h>
 
+#include <algorithm>
+
 namespace chip {
 namespace Transport {
 
 constexpr uint16_t kMaxSessionID       = UINT16_MAX;
 constexpr uint16_t kUnsecuredSessionId = 0;
 
+// Smallest power of two that is at least the secure session pool size.
+constexpr size_t SessionIndexBucketCount(size_t count = 1)
+{
+    return count >= CHIP_CONFIG_SECURE_SESSION_POOL_SIZE ? count : SessionIndexBucketCount(count * 2);
+}
+
 /**
  * Handles a set of sessions.
  *
  * Intended for:
  *   - handle session active time and expiration
  *   - allocate and free space for sessions.
+ *
+ * Sessions are indexed by local session ID and by peer, so that looking up the session of an incoming message or the
+ * sessions to a node does not depend on the number of sessions in the table.
  */
 class SecureSessionTable
 {
@@ -76,7 +86,12 @@ public:
     CHECK_RETURN_VALUE
     Optional<SessionHandle> CreateNewSecureSession(SecureSession::Type secureSessionType, ScopedNodeId sessionEvictionHint);
 
-    void ReleaseSession(SecureSession * session) { mEntries.ReleaseObject(session); }
+    void ReleaseSession(SecureSession * session)
+    {
+        RemoveFromLocalSessionIdIndex(*session);
+        RemoveFromPeerIndex(*session);
+        mEntries.ReleaseObject(session);
+    }
 
     template <typename Function>
     Loop ForEachSession(Function && function)
@@ -84,6 +99,27 @@ public:
         return mEntries.ForEachActiveObject(std::forward<Function>(function));
     }
 
+    /**
+     * Iterate over the sessions to the given peer, whatever their state and type.
+     *
+     * The function may release the session it is called with, but not other sessions.
+     */
+    template <typename Function>
+    Loop ForEachSessionWithPeer(const ScopedNodeId & peer, Function && function)
+    {
+        SecureSession * session = mByPeer[PeerBucket(peer)];
+        while (session != nullptr)
+        {
+            SecureSession * next = session->mNextByPeer;
+            if (session->GetPeer() == peer && function(session) == Loop::Break)
+            {
+                return Loop::Break;
+            }
+            session = next;
+        }
+        return Loop::Finish;
+    }
+
     /**
      * Get a secure session given its session ID.
      *
@@ -100,7 +136,7 @@ public:
     void NewerSessionAvailable(SecureSession * session)
     {
         VerifyOrDie(session->GetSecureSessionType() == SecureSession::Type::kCASE);
-        mEntries.ForEachActiveObject([&](SecureSession * oldSession) {
+        ForEachSessionWithPeer(session->GetPeer(), [&](SecureSession * oldSession) {
             if (session == oldSession)
                 return Loop::Continue;
 
@@ -110,7 +146,7 @@ public:
             //
             // See documentation for SessionDelegate::GetNewSessionHandlingPolicy about how session auto-shifting works, and how
             // to disable it for a specific SessionHolder in a specific scenario.
-            if (oldSession->GetSecureSessionType() == SecureSession::Type::kCASE && oldSession->GetPeer() == session->GetPeer() &&
+            if (oldSession->GetSecureSessionType() == SecureSession::Type::kCASE &&
                 oldSession->GetPeerCATs() == session->GetPeerCATs())
             {
                 oldSession->NewerSessionAvailable(SessionHandle(*session));
@@ -121,8 +157,44 @@ public:
     }
 
 private:
+    friend class SecureSession;
     friend class TestSecureSessionTable;
 
+    // Number of buckets of each index, so that chains stay short even with a full table.
+    static constexpr size_t kIndexBucketCount = SessionIndexBucketCount();
+
+    // Local session IDs are allocated sequentially, so their low bits spread them evenly over the buckets.
+    static size_t LocalSessionIdBucket(uint16_t localSessionId) { return localSessionId & (kIndexBucketCount - 1); }
+    static size_t PeerBucket(const ScopedNodeId & peer)
+    {
+        uint64_t hash = (peer.GetNodeId() ^ peer.GetFabricIndex()) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(hash >> 32) & (kIndexBucketCount - 1);
+    }
+
+    /**
+     * Allocate a session out of the pool and add it to the indexes.
+     */
+    template <typename... Args>
+    SecureSession * CreateSession(Args &&... args)
+    {
+        SecureSession * session = mEntries.CreateObject(*this, std::forward<Args>(args)...);
+        if (session != nullptr)
+        {
+            AddToLocalSessionIdIndex(*session);
+            AddToPeerIndex(*session);
+        }
+        return session;
+    }
+
+    SecureSession * FindByLocalSessionId(uint16_t localSessionId) const;
+
+    void AddToLocalSessionIdIndex(SecureSession & session);
+    void RemoveFromLocalSessionIdIndex(SecureSession & session);
+
+    // Called by SecureSession around changes of its peer.
+    void AddToPeerIndex(SecureSession & session);
+    void RemoveFromPeerIndex(SecureSession & session);
+
     /**
      * This provides a sortable wrapper for a SecureSession object. A SecureSession
      * isn't directly sortable since it is not swappable (i.e meet criteria for ValueSwappable).
@@ -176,6 +248,7 @@ private:
          * bool CompareFunc(const SortableSession &a, const SortableSession &b);
          *
          * If a is a better candidate than b, true should be returned. Else, return false.
+         * Sessions that compare equal keep their relative order.
          *
          * NOTE: Sort() can be called multiple times.
          *
@@ -183,7 +256,7 @@ private:
         template <typename CompareFunc>
         void Sort(CompareFunc func)
         {
-            Sorting::BubbleSort(mSessionList.begin(), mSessionList.size(), func);
+            std::stable_sort(mSessionList.begin(), mSessionList.end(), func);
         }
 
         const ScopedNodeId & GetSessionEvictionHint() const { return mSessionEvictionHint; }
@@ -243,13 +316,10 @@ private:
     /**
      * Find an available session ID that is unused in the secure session table.
      *
-     * The search algorithm iterates over the session ID space in the outer loop
-     * and the session table in the inner loop to locate an available session ID
-     * from the starting mNextSessionId clue.
-     *
-     * The outer-loop considers 64 session IDs in each iteration to give a
-     * runtime complexity of O(CHIP_CONFIG_PEER_CONNECTION_POOL_SIZE^2/64).  Speed up could be
-     * achieved with a sorted session table or additional storage.
+     * The search walks the session ID space from the starting mNextSessionId clue
+     * and looks each candidate up in the local session ID index.  Since there are
+     * at most CHIP_CONFIG_SECURE_SESSION_POOL_SIZE sessions, at most that many
+     * candidates are rejected before an available one is found.
      *
      * @return an unused session ID if any is found, else NullOptional
      */
@@ -274,6 +344,10 @@ private:
 #endif
 
     uint16_t mNextSessionId = 0;
+
+    // Heads of the chains of sessions hashed by local session ID and by peer, linked through the sessions themselves.
+    SecureSession * mByLocalSessionId[kIndexBucketCount] = {};
+    SecureSession * mByPeer[kIndexBucketCount]           = {};
 };
 
 } // namespace Transport
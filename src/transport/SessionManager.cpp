@@ -56,6 +56,23 @@ using System::PacketBufferHandle;
 using Transport::PeerAddress;
 using Transport::SecureSession;
 
+namespace {
+
+// Reserves the room for both message headers in front of the payload in one step, so that the payload is moved at most
+// once (and not at all when the buffer was allocated with enough reserve) before it is encrypted and the headers are
+// encoded in front of it.
+CHIP_ERROR ReserveHeaderSpace(const PacketHeader & packetHeader, const PayloadHeader & payloadHeader,
+                              const System::PacketBufferHandle & message)
+{
+    VerifyOrReturnError(!message.IsNull(), CHIP_ERROR_INVALID_ARGUMENT);
+    const size_t headerSize = static_cast<size_t>(packetHeader.EncodeSizeBytes()) + payloadHeader.EncodeSizeBytes();
+    VerifyOrReturnError(CanCastTo<uint16_t>(headerSize), CHIP_ERROR_MESSAGE_TOO_LONG);
+    VerifyOrReturnError(message->EnsureReservedSize(static_cast<uint16_t>(headerSize)), CHIP_ERROR_NO_MEMORY);
+    return CHIP_NO_ERROR;
+}
+
+} // namespace
+
 uint32_t EncryptedPacketBufferHandle::GetMessageCounter() const
 {
     PacketHeader header;
@@ -126,6 +143,15 @@ void SessionManager::Shutdown()
 
     mMessageCounterManager = nullptr;
 
+#if CHIP_CONFIG_SEND_BATCH_SIZE > 1
+    // Messages of a batch still in scope are dropped with the transport.
+    for (size_t i = 0; i < mBatchedMessageCount; i++)
+    {
+        mBatchedMessages[i] = nullptr;
+    }
+    mBatchedMessageCount = 0;
+#endif // CHIP_CONFIG_SEND_BATCH_SIZE > 1
+
     mSystemLayer  = nullptr;
     mTransportMgr = nullptr;
     mCB           = nullptr;
@@ -189,6 +215,9 @@ CHIP_ERROR SessionManager::PrepareMessage(const SessionHandle & sessionHandle, P
 
         CHIP_TRACE_MESSAGE_SENT(payloadHeader, packetHeader, destination_address, message->Start(), message->TotalLength());
 
+        // The session ID set below is the key hash, which does not change the size of the packet header.
+        ReturnErrorOnFailure(ReserveHeaderSpace(packetHeader, payloadHeader, message));
+
         Crypto::SymmetricKeyContext * keyContext =
             groups->GetKeyContext(groupSession->GetFabricIndex(), groupSession->GetGroupId());
         VerifyOrReturnError(nullptr != keyContext, CHIP_ERROR_INTERNAL);
@@ -232,6 +261,7 @@ CHIP_ERROR SessionManager::PrepareMessage(const SessionHandle & sessionHandle, P
         NodeId sourceNodeId = session->GetLocalScopedNodeId().GetNodeId();
         CryptoContext::BuildNonce(nonce, packetHeader.GetSecurityFlags(), messageCounter, sourceNodeId);
 
+        ReturnErrorOnFailure(ReserveHeaderSpace(packetHeader, payloadHeader, message));
         ReturnErrorOnFailure(SecureMessageCodec::Encrypt(session->GetCryptoContext(), nonce, payloadHeader, packetHeader, message));
 
 #if CHIP_PROGRESS_LOGGING
@@ -264,6 +294,7 @@ CHIP_ERROR SessionManager::PrepareMessage(const SessionHandle & sessionHandle, P
                                 chip::ByteSpan(message->Start(), message->TotalLength()));
         CHIP_TRACE_MESSAGE_SENT(payloadHeader, packetHeader, destination_address, message->Start(), message->TotalLength());
 
+        ReturnErrorOnFailure(ReserveHeaderSpace(packetHeader, payloadHeader, message));
         ReturnErrorOnFailure(payloadHeader.EncodeBeforeData(message));
 
 #if CHIP_PROGRESS_LOGGING
@@ -388,6 +419,10 @@ CHIP_ERROR SessionManager::SendPreparedMessage(const SessionHandle & sessionHand
         chip::Inet::IPAddress addr;
         bool interfaceFound = false;
 
+        // Send the message on all the interfaces together.  Every send shares the encrypted buffer: transports that need to
+        // modify it (e.g. LwIP, to prepend its own headers) copy it when it is not solely owned.
+        SendBatch batch(*this);
+
         while (interfaceIt.Next())
         {
             char name[chip::Inet::InterfaceId::kMaxIfNameLength];
@@ -399,15 +434,11 @@ CHIP_ERROR SessionManager::SendPreparedMessage(const SessionHandle & sessionHand
                 {
                     ChipLogDetail(Inet, "Interface %s has a link local address", name);
 
-                    interfaceFound             = true;
-                    PacketBufferHandle tempBuf = msgBuf.CloneData();
-                    VerifyOrReturnError(!tempBuf.IsNull(), CHIP_ERROR_INVALID_ARGUMENT);
-                    VerifyOrReturnError(!tempBuf->HasChainedBuffer(), CHIP_ERROR_INVALID_MESSAGE_LENGTH);
-
-                    destination = &(multicastAddress.SetInterface(interfaceId));
+                    interfaceFound = true;
+                    destination    = &(multicastAddress.SetInterface(interfaceId));
                     if (mTransportMgr != nullptr)
                     {
-                        if (CHIP_NO_ERROR != mTransportMgr->SendMessage(*destination, std::move(tempBuf)))
+                        if (CHIP_NO_ERROR != SendMessageToTransport(*destination, msgBuf.Retain()))
                         {
                             ChipLogError(Inet, "Failed to send Multicast message on interface %s", name);
                         }
@@ -435,13 +466,56 @@ CHIP_ERROR SessionManager::SendPreparedMessage(const SessionHandle & sessionHand
 
     if (mTransportMgr != nullptr)
     {
-        return mTransportMgr->SendMessage(*destination, std::move(msgBuf));
+        return SendMessageToTransport(*destination, std::move(msgBuf));
     }
 
     ChipLogError(Inet, "The transport manager is not initialized. Unable to send the message");
     return CHIP_ERROR_INCORRECT_STATE;
 }
 
+CHIP_ERROR SessionManager::SendMessageToTransport(const Transport::PeerAddress & destination, System::PacketBufferHandle && msgBuf)
+{
+#if CHIP_CONFIG_SEND_BATCH_SIZE > 1
+    if (mSendBatchDepth == 0 || destination.GetTransportType() != Transport::Type::kUdp)
+    {
+        return mTransportMgr->SendMessage(destination, std::move(msgBuf));
+    }
+
+    if (mBatchedMessageCount == ArraySize(mBatchedMessages))
+    {
+        FlushSendBatch();
+    }
+
+    mBatchedDestinations[mBatchedMessageCount] = destination;
+    mBatchedMessages[mBatchedMessageCount]     = std::move(msgBuf);
+    mBatchedMessageCount++;
+    return CHIP_NO_ERROR;
+#else
+    return mTransportMgr->SendMessage(destination, std::move(msgBuf));
+#endif // CHIP_CONFIG_SEND_BATCH_SIZE > 1
+}
+
+#if CHIP_CONFIG_SEND_BATCH_SIZE > 1
+void SessionManager::FlushSendBatch()
+{
+    VerifyOrReturn(mBatchedMessageCount > 0);
+
+    // Messages sent while the batch is passed to the transport are not added to it.
+    size_t count         = mBatchedMessageCount;
+    unsigned depth       = mSendBatchDepth;
+    mBatchedMessageCount = 0;
+    mSendBatchDepth      = 0;
+
+    CHIP_ERROR err = mTransportMgr->SendMessages(mBatchedDestinations, mBatchedMessages, count);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(Inet, "Failed to send batched messages: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+
+    mSendBatchDepth = depth;
+}
+#endif // CHIP_CONFIG_SEND_BATCH_SIZE > 1
+
 void SessionManager::ExpireAllSessions(const ScopedNodeId & node)
 {
     ChipLogDetail(Inet, "Expiring all sessions for node " ChipLogFormatScopedNodeId "!!", ChipLogValueScopedNodeId(node));
@@ -485,9 +559,8 @@ void SessionManager::ExpireAllPASESessions()
 
 void SessionManager::MarkSessionsAsDefunct(const ScopedNodeId & node, const Optional<Transport::SecureSession::Type> & type)
 {
-    mSecureSessions.ForEachSession([&node, &type](auto session) {
-        if (session->IsActiveSession() && session->GetPeer() == node &&
-            (!type.HasValue() || type.Value() == session->GetSecureSessionType()))
+    mSecureSessions.ForEachSessionWithPeer(node, [&type](auto session) {
+        if (session->IsActiveSession() && (!type.HasValue() || type.Value() == session->GetSecureSessionType()))
         {
             session->MarkAsDefunct();
         }
@@ -497,10 +570,10 @@ void SessionManager::MarkSessionsAsDefunct(const ScopedNodeId & node, const Opti
 
 void SessionManager::UpdateAllSessionsPeerAddress(const ScopedNodeId & node, const Transport::PeerAddress & addr)
 {
-    mSecureSessions.ForEachSession([&node, &addr](auto session) {
+    mSecureSessions.ForEachSessionWithPeer(node, [&addr](auto session) {
         // Arguably we should only be updating active and defunct sessions, but there is no harm
         // in updating evicted sessions.
-        if (session->GetPeer() == node && Transport::SecureSession::Type::kCASE == session->GetSecureSessionType())
+        if (Transport::SecureSession::Type::kCASE == session->GetSecureSessionType())
         {
             session->SetPeerAddress(addr);
         }
@@ -1013,9 +1086,8 @@ Optional<SessionHandle> SessionManager::FindSecureSessionForNode(ScopedNodeId pe
 {
     SecureSession * found = nullptr;
 
-    mSecureSessions.ForEachSession([&peerNodeId, &type, &found](auto session) {
-        if (session->IsActiveSession() && session->GetPeer() == peerNodeId &&
-            (!type.HasValue() || type.Value() == session->GetSecureSessionType()))
+    mSecureSessions.ForEachSessionWithPeer(peerNodeId, [&type, &found](auto session) {
+        if (session->IsActiveSession() && (!type.HasValue() || type.Value() == session->GetSecureSessionType()))
         {
             //
             // Select the active session with the most recent activity to return back to the caller.
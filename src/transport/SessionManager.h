@@ -147,6 +147,41 @@ public:
      */
     CHIP_ERROR SendPreparedMessage(const SessionHandle & session, const EncryptedPacketBufferHandle & preparedMessage);
 
+    /**
+     * @brief
+     *   Groups the messages to UDP peers sent through SendPreparedMessage while it is in scope.  They are passed to the
+     *   transport together when the outermost batch goes out of scope, or when the batch is full, so that the transport
+     *   can send them with fewer system calls.
+     *
+     * @details
+     *   SendPreparedMessage returns before a batched message is sent, so errors sending it are only logged.  A batch does
+     *   nothing when CHIP_CONFIG_SEND_BATCH_SIZE is 1.
+     */
+    class SendBatch
+    {
+    public:
+#if CHIP_CONFIG_SEND_BATCH_SIZE > 1
+        explicit SendBatch(SessionManager & sessionManager) : mSessionManager(sessionManager) { mSessionManager.mSendBatchDepth++; }
+        ~SendBatch()
+        {
+            if (--mSessionManager.mSendBatchDepth == 0)
+            {
+                mSessionManager.FlushSendBatch();
+            }
+        }
+#else
+        explicit SendBatch(SessionManager &) {}
+#endif // CHIP_CONFIG_SEND_BATCH_SIZE > 1
+
+        SendBatch(const SendBatch &) = delete;
+        SendBatch & operator=(const SendBatch &) = delete;
+
+#if CHIP_CONFIG_SEND_BATCH_SIZE > 1
+    private:
+        SessionManager & mSessionManager;
+#endif // CHIP_CONFIG_SEND_BATCH_SIZE > 1
+    };
+
     /// @brief Set the delegate for handling incoming messages. There can be only one message delegate (probably the
     /// ExchangeManager)
     void SetMessageDelegate(SessionMessageDelegate * cb) { mCB = cb; }
@@ -484,6 +519,18 @@ private:
 
     GlobalUnencryptedMessageCounter mGlobalUnencryptedMessageCounter;
 
+#if CHIP_CONFIG_SEND_BATCH_SIZE > 1
+    // Messages to UDP peers held while a SendBatch is in scope.
+    Transport::PeerAddress mBatchedDestinations[CHIP_CONFIG_SEND_BATCH_SIZE];
+    System::PacketBufferHandle mBatchedMessages[CHIP_CONFIG_SEND_BATCH_SIZE];
+    size_t mBatchedMessageCount = 0;
+    unsigned mSendBatchDepth    = 0;
+
+    void FlushSendBatch();
+#endif // CHIP_CONFIG_SEND_BATCH_SIZE > 1
+
+    CHIP_ERROR SendMessageToTransport(const Transport::PeerAddress & destination, System::PacketBufferHandle && msgBuf);
+
     /**
      * @brief Parse, decrypt, validate, and dispatch a secure unicast message.
      *
@@ -28,6 +28,12 @@ CHIP_ERROR TransportMgrBase::SendMessage(const Transport::PeerAddress & address,
     return mTransport->SendMessage(address, std::move(msgBuf));
 }
 
+CHIP_ERROR TransportMgrBase::SendMessages(const Transport::PeerAddress * addresses, System::PacketBufferHandle * msgBufs,
+                                          size_t count)
+{
+    return mTransport->SendMessages(addresses, msgBufs, count);
+}
+
 void TransportMgrBase::Disconnect(const Transport::PeerAddress & address)
 {
     mTransport->Disconnect(address);
@@ -65,6 +65,29 @@ public:
      */
     virtual CHIP_ERROR SendMessage(const PeerAddress & address, System::PacketBufferHandle && msgBuf) = 0;
 
+    /**
+     * @brief Send several messages, each to the target with the same index.
+     *
+     * Every message is attempted, even when an earlier one fails, and every buffer in msgBufs is released.  Transports
+     * that can pass several messages to the network stack at once override this.
+     *
+     * @return the first error encountered, if any message could not be sent.
+     */
+    virtual CHIP_ERROR SendMessages(const PeerAddress * addresses, System::PacketBufferHandle * msgBufs, size_t count)
+    {
+        CHIP_ERROR result = CHIP_NO_ERROR;
+        for (size_t i = 0; i < count; i++)
+        {
+            CHIP_ERROR err = SendMessage(addresses[i], std::move(msgBufs[i]));
+            msgBufs[i]     = nullptr;
+            if (result == CHIP_NO_ERROR)
+            {
+                result = err;
+            }
+        }
+        return result;
+    }
+
     /**
      * Determine if this transport can SendMessage to the specified peer address.
      *
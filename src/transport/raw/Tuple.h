@@ -86,6 +86,40 @@ public:
         return SendMessageImpl<0>(address, std::move(msgBuf));
     }
 
+    CHIP_ERROR SendMessages(const PeerAddress * addresses, System::PacketBufferHandle * msgBufs, size_t count) override
+    {
+        CHIP_ERROR result = CHIP_NO_ERROR;
+        while (count > 0)
+        {
+            // Consecutive messages that go through the same transport are passed to it together.
+            Base * base   = FindTransportImpl<0>(addresses[0]);
+            size_t runLen = 1;
+            while (runLen < count && FindTransportImpl<0>(addresses[runLen]) == base)
+            {
+                runLen++;
+            }
+
+            CHIP_ERROR err = CHIP_ERROR_NO_MESSAGE_HANDLER;
+            if (base != nullptr)
+            {
+                err = base->SendMessages(addresses, msgBufs, runLen);
+            }
+            else
+            {
+                for (size_t i = 0; i < runLen; i++)
+                {
+                    msgBufs[i] = nullptr;
+                }
+            }
+            result = (result == CHIP_NO_ERROR) ? err : result;
+
+            addresses += runLen;
+            msgBufs += runLen;
+            count -= runLen;
+        }
+        return result;
+    }
+
     CHIP_ERROR MulticastGroupJoinLeave(const Transport::PeerAddress & address, bool join) override
     {
         return MulticastGroupJoinLeaveImpl<0>(address, join);
@@ -208,6 +242,34 @@ private:
         return CHIP_ERROR_NO_MESSAGE_HANDLER;
     }
 
+    /**
+     * Recursive lookup of the transport a message to the given address is sent through, which is the first transport
+     * from index N or above that returns 'CanSendToPeer'.
+     *
+     * @tparam N the index of the first underlying transport to check.
+     *
+     * @param address where the message is sent.
+     */
+    template <size_t N, typename std::enable_if<(N < sizeof...(TransportTypes))>::type * = nullptr>
+    Base * FindTransportImpl(const PeerAddress & address)
+    {
+        Base * base = &std::get<N>(mTransports);
+        if (base->CanSendToPeer(address))
+        {
+            return base;
+        }
+        return FindTransportImpl<N + 1>(address);
+    }
+
+    /**
+     * FindTransportImpl when N is out of range. Always returns nullptr.
+     */
+    template <size_t N, typename std::enable_if<(N >= sizeof...(TransportTypes))>::type * = nullptr>
+    Base * FindTransportImpl(const PeerAddress & address)
+    {
+        return nullptr;
+    }
+
     /**
      * Recursive GroupJoinLeave implementation iterating through transport members.
      *
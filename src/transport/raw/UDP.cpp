@@ -117,6 +117,53 @@ CHIP_ERROR UDP::SendMessage(const Transport::PeerAddress & address, System::Pack
     return mUDPEndPoint->SendMsg(&addrInfo, std::move(msgBuf));
 }
 
+CHIP_ERROR UDP::SendMessages(const Transport::PeerAddress * addresses, System::PacketBufferHandle * msgBufs, size_t count)
+{
+    VerifyOrReturnError(mState == State::kInitialized, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(mUDPEndPoint != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    CHIP_ERROR result = CHIP_NO_ERROR;
+    Inet::IPPacketInfo addrInfos[kMaxMessagesPerSend];
+    System::PacketBufferHandle batch[kMaxMessagesPerSend];
+
+    while (count > 0)
+    {
+        size_t batchSize = 0;
+        for (; count > 0 && batchSize < kMaxMessagesPerSend; addresses++, msgBufs++, count--)
+        {
+            System::PacketBufferHandle msgBuf = std::move(*msgBufs);
+            if (addresses->GetTransportType() != Type::kUdp)
+            {
+                result = (result == CHIP_NO_ERROR) ? CHIP_ERROR_INVALID_ARGUMENT : result;
+                continue;
+            }
+
+            // Drop the message. Free the buffer.
+            bool drop = false;
+            CHIP_FAULT_INJECT(FaultInjection::kFault_DropOutgoingUDPMsg, drop = true;);
+            if (drop)
+            {
+                result = (result == CHIP_NO_ERROR) ? CHIP_ERROR_CONNECTION_ABORTED : result;
+                continue;
+            }
+
+            Inet::IPPacketInfo & addrInfo = addrInfos[batchSize];
+            addrInfo.Clear();
+
+            addrInfo.DestAddress = addresses->GetIPAddress();
+            addrInfo.DestPort    = addresses->GetPort();
+            addrInfo.Interface   = addresses->GetInterface();
+
+            batch[batchSize++] = std::move(msgBuf);
+        }
+
+        CHIP_ERROR err = mUDPEndPoint->SendMsgs(addrInfos, batch, batchSize);
+        result         = (result == CHIP_NO_ERROR) ? err : result;
+    }
+
+    return result;
+}
+
 void UDP::OnUdpReceive(Inet::UDPEndPoint * endPoint, System::PacketBufferHandle && buffer, const Inet::IPPacketInfo * pktInfo)
 {
     CHIP_ERROR err          = CHIP_NO_ERROR;
@@ -131,6 +131,8 @@ public:
 
     CHIP_ERROR SendMessage(const Transport::PeerAddress & address, System::PacketBufferHandle && msgBuf) override;
 
+    CHIP_ERROR SendMessages(const Transport::PeerAddress * addresses, System::PacketBufferHandle * msgBufs, size_t count) override;
+
     CHIP_ERROR MulticastGroupJoinLeave(const Transport::PeerAddress & address, bool join) override;
 
     bool CanListenMulticast() override
@@ -145,6 +147,9 @@ public:
     }
 
 private:
+    // Number of messages SendMessages passes to the endpoint at once.
+    static constexpr size_t kMaxMessagesPerSend = INET_CONFIG_UDP_SOCKET_MMSG_MAX_MESSAGES;
+
     // UDP message receive handler.
     static void OnUdpReceive(Inet::UDPEndPoint * endPoint, System::PacketBufferHandle && buffer,
                              const Inet::IPPacketInfo * pktInfo);
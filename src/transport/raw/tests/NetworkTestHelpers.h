@@ -108,7 +108,8 @@ public:
             ReturnErrorOnFailure(mMessageSendError);
         }
         mSentMessageCount++;
-        bool dropMessage = false;
+        mLastSentMessageStart = msgBuf.IsNull() ? nullptr : msgBuf->Start();
+        bool dropMessage      = false;
         if (mNumMessagesToAllowBeforeError > 0)
         {
             --mNumMessagesToAllowBeforeError;
@@ -150,6 +151,7 @@ public:
         mNumMessagesToAllowBeforeDropping = 0;
         mNumMessagesToAllowBeforeError    = 0;
         mMessageSendError                 = CHIP_NO_ERROR;
+        mLastSentMessageStart             = nullptr;
     }
 
     struct PendingMessageItem
@@ -171,6 +173,10 @@ public:
     uint32_t mNumMessagesToAllowBeforeError    = 0;
     CHIP_ERROR mMessageSendError               = CHIP_NO_ERROR;
     LoopbackTransportDelegate * mDelegate      = nullptr;
+
+    // Start of the data of the last message handed to the transport, which lets tests check that the buffer they sent was
+    // not copied on its way down.
+    const uint8_t * mLastSentMessageStart = nullptr;
 };
 
 } // namespace Test
@@ -47,6 +47,12 @@ public:
     //
     static void ValidateSessionSorting(nlTestSuite * inSuite, void * inContext);
 
+    //
+    // This test validates that the indexes by local session ID and by peer follow
+    // sessions as they are allocated, activated, moved to a fabric and released.
+    //
+    static void ValidateSessionIndexes(nlTestSuite * inSuite, void * inContext);
+
 private:
     struct SessionParameters
     {
@@ -361,6 +367,101 @@ void TestSecureSessionTable::ValidateSessionSorting(nlTestSuite * inSuite, void
         _this->CreateSessionTable(sessionParamList);
         _this->AllocateSession(ScopedNodeId(4, kFabric3), sessionParamList, 5);
     }
+
+    //
+    // This validates that sessions tied on every key are evicted in the order they are in the table, even when the
+    // table is large enough for the sessions of a fabric to be reordered while grouping them by fabric.
+    //
+    // Fabric1 has more sessions than Fabric2, all of them to Node 2 and with the same activity time, so the first
+    // session of Fabric1 in the table is selected.
+    //
+    {
+        ChipLogProgress(SecureChannel, "-------- Tied Sessions Eviction ---------");
+
+        std::vector<SessionParameters> sessionParamList;
+        for (unsigned int i = 0; i < 20; i++)
+        {
+            sessionParamList.push_back(
+                { { 2, (i % 3 == 0) ? kFabric2 : kFabric1 }, System::Clock::Timestamp(5), SecureSession::State::kActive });
+        }
+
+        _this->CreateSessionTable(sessionParamList);
+        _this->AllocateSession(ScopedNodeId(4, kFabric3), sessionParamList, 1);
+    }
+}
+
+void TestSecureSessionTable::ValidateSessionIndexes(nlTestSuite * inSuite, void * inContext)
+{
+    SecureSessionTable sessionTable;
+    sessionTable.Init();
+
+    const ReliableMessageProtocolConfig config(System::Clock::Milliseconds32(0), System::Clock::Milliseconds32(0));
+    const ScopedNodeId peer1(2, kFabric1);
+    const ScopedNodeId peer2(3, kFabric1);
+
+    auto countSessionsWithPeer = [&sessionTable](const ScopedNodeId & peer) {
+        unsigned count = 0;
+        sessionTable.ForEachSessionWithPeer(peer, [&count](auto * session) {
+            count++;
+            return Loop::Continue;
+        });
+        return count;
+    };
+
+    // Allocate session IDs across the wrap around of the session ID space.
+    sessionTable.mNextSessionId = static_cast<uint16_t>(kMaxSessionID - 2);
+
+    std::vector<SessionHolder> holders(6);
+    for (unsigned i = 0; i < holders.size(); i++)
+    {
+        auto session = sessionTable.CreateNewSecureSession(SecureSession::Type::kCASE, ScopedNodeId());
+        NL_TEST_ASSERT(inSuite, session.HasValue());
+        NL_TEST_ASSERT(inSuite, session.Value()->AsSecureSession()->GetLocalSessionId() != kUnsecuredSessionId);
+        NL_TEST_ASSERT(inSuite, holders[i].GrabPairingSession(session.Value()));
+    }
+    NL_TEST_ASSERT(inSuite, countSessionsWithPeer(ScopedNodeId()) == holders.size());
+
+    for (unsigned i = 0; i < holders.size(); i++)
+    {
+        SecureSession * session = holders[i]->AsSecureSession();
+        session->Activate(ScopedNodeId(1, kFabric1), (i % 2) ? peer2 : peer1, CATValues(), static_cast<uint16_t>(i), config);
+
+        auto found = sessionTable.FindSecureSessionByLocalKey(session->GetLocalSessionId());
+        NL_TEST_ASSERT(inSuite, found.HasValue() && found.Value()->AsSecureSession() == session);
+    }
+    NL_TEST_ASSERT(inSuite, countSessionsWithPeer(ScopedNodeId()) == 0);
+    NL_TEST_ASSERT(inSuite, countSessionsWithPeer(peer1) == 3);
+    NL_TEST_ASSERT(inSuite, countSessionsWithPeer(peer2) == 3);
+    NL_TEST_ASSERT(inSuite, countSessionsWithPeer(ScopedNodeId(2, kFabric2)) == 0);
+
+    // A session ID in use is skipped when looking for an unused one.
+    uint16_t usedSessionId      = holders[0]->AsSecureSession()->GetLocalSessionId();
+    sessionTable.mNextSessionId = usedSessionId;
+    auto unusedSessionId        = sessionTable.FindUnusedSessionId();
+    NL_TEST_ASSERT(inSuite, unusedSessionId.HasValue() && unusedSessionId.Value() != usedSessionId);
+    NL_TEST_ASSERT(inSuite, !sessionTable.FindSecureSessionByLocalKey(unusedSessionId.Value()).HasValue());
+
+    // Released sessions leave both indexes.
+    holders[0]->AsSecureSession()->MarkForEviction();
+    NL_TEST_ASSERT(inSuite, !holders[0]);
+    NL_TEST_ASSERT(inSuite, !sessionTable.FindSecureSessionByLocalKey(usedSessionId).HasValue());
+    NL_TEST_ASSERT(inSuite, countSessionsWithPeer(peer1) == 2);
+
+    // A PASE session that adopts a fabric moves to its new peer.
+    SessionHolder paseHolder;
+    auto paseSession = sessionTable.CreateNewSecureSession(SecureSession::Type::kPASE, ScopedNodeId());
+    NL_TEST_ASSERT(inSuite, paseSession.HasValue() && paseHolder.GrabPairingSession(paseSession.Value()));
+    SecureSession * pase = paseHolder->AsSecureSession();
+    pase->Activate(ScopedNodeId(), ScopedNodeId(), CATValues(), 0, config);
+    NL_TEST_ASSERT(inSuite, countSessionsWithPeer(ScopedNodeId()) == 1);
+    NL_TEST_ASSERT(inSuite, pase->AdoptFabricIndex(kFabric2) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, countSessionsWithPeer(ScopedNodeId()) == 0);
+    NL_TEST_ASSERT(inSuite, countSessionsWithPeer(ScopedNodeId(kUndefinedNodeId, kFabric2)) == 1);
+
+    sessionTable.ForEachSession([](auto * session) {
+        session->MarkForEviction();
+        return Loop::Continue;
+    });
 }
 
 Platform::UniquePtr<TestSecureSessionTable> gTestSecureSessionTable;
@@ -379,6 +480,7 @@ namespace {
 const nlTest sTests[] =
 {
     NL_TEST_DEF("Validate Session Sorting (Over Minima)",               chip::Transport::TestSecureSessionTable::ValidateSessionSorting),
+    NL_TEST_DEF("Validate Session Indexes",                             chip::Transport::TestSecureSessionTable::ValidateSessionIndexes),
     NL_TEST_SENTINEL()
 };
 // clang-format on